@@ -0,0 +1,3 @@
+#!/bin/bash
+set echo off
+./generic_builder.sh Release "" x64
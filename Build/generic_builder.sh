@@ -1,3 +1,3 @@
 #!/bin/bash
-cmake -G"Ninja" -DCMAKE_C_COMPILER=gcc -DCMAKE_CXX_COMPILER=g++ -DCMAKE_BUILD_TYPE=$1 -DCMAKE_BUILD_MODE=$2 .
+cmake -G"Ninja" -DCMAKE_C_COMPILER=gcc -DCMAKE_CXX_COMPILER=g++ -DCMAKE_BUILD_TYPE=$1 -DCMAKE_BUILD_MODE=$2 -DCMAKE_BUILD_ARCH=$3 .
 cmake --build .
\ No newline at end of file
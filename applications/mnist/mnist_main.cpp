@@ -78,9 +78,9 @@ int main(int argc , char** argv) {
     auto layer_relu_4 = ActivationLayer(layer_dense_2, ActivationFun::LeakyReLU);
     auto dropout_2 = DropoutLayer(layer_relu_4, 0.3f);
     auto layer_dense_5 = DenseLayer(dropout_2, 10);
-    auto layer_sigmoid = ActivationLayer(layer_dense_5, ActivationFun::Sigmoid);
 
-    auto nn = NeuralNetwork(flatten, layer_sigmoid, CostFun::BinaryCrossentropy);
+    // sigmoid of the output is fused with the cost function, so the network returns logits
+    auto nn = NeuralNetwork(flatten, layer_dense_5, CostFun::SigmoidBinaryCrossentropy);
 
     // conv model
 
@@ -139,7 +139,7 @@ int main(int argc , char** argv) {
             uint32_t max_idx{ 0 };
             for (uint32_t k{ 0 }; k < pred_label.getShape()[1]; ++k)
             {
-                if (max_val < 0 || max_val < pred_label[{ j, k }]) {
+                if (0 == k || max_val < pred_label[{ j, k }]) {
                     max_val = pred_label[{ j, k }];
                     max_idx = k;
                 }
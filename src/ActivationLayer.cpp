@@ -1,5 +1,79 @@
 #include "ActivationLayer.h"
 
+#include <bit>
+
+#include "BlockOps.h"
+#include "Gemm.h"
+#include "Softmax.h"
+#include "ThreadPool.h"
+
+/**
+ * Number of values whose signs are stored in a word of the sign mask.
+ */
+constexpr uint32_t SIGN_MASK_WORD_BITS{ 32 };
+
+/**
+ * Applies LeakyReLU (ReLU for slope 0) to count values in place and returns their signs, bit k is set if values[k] > 0.
+ */
+static inline uint32_t leakyReLUWord(float* values, const float slope, const uint32_t count) {
+	uint32_t word{ 0 };
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		word |= static_cast<uint32_t>(values[k] > 0.0f) << k;
+	}
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		values[k] = std::max(values[k], slope * values[k]);
+	}
+	return word;
+}
+
+/**
+ * dx[k] = dy[k] if bit k of word is set, otherwise slope * dy[k], for k in [0, count).
+ * The value is selected with a bit mask, a conditional multiplication would be compiled to a branch.
+ */
+static inline void leakyReLUBackwardWord(const uint32_t word, const float* dy, const float slope, float* dx, const uint32_t count) {
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		const uint32_t select{ 0u - ((word >> k) & 1u) };
+		dx[k] = std::bit_cast<float>((std::bit_cast<uint32_t>(dy[k]) & select) | (std::bit_cast<uint32_t>(slope * dy[k]) & ~select));
+	}
+}
+
+/**
+ * Applies LeakyReLU to size values in place, signs of the values are written to mask if it is not nullptr.
+ */
+static void leakyReLU(float* values, const uint32_t size, const float slope, uint32_t* mask) {
+	if (nullptr == mask) {
+		ThreadPool::forEachChunk(size, ThreadPool::getParallelChunkSize(size, SIGN_MASK_WORD_BITS), [&](uint32_t begin, uint32_t end) {
+			for (uint32_t i{ begin }; i < end; ++i) {
+				values[i] = std::max(values[i], slope * values[i]);
+			}
+		});
+		return;
+	}
+
+	ThreadPool::forEachChunk(size, ThreadPool::getParallelChunkSize(size, SIGN_MASK_WORD_BITS), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; i += SIGN_MASK_WORD_BITS) {
+			const uint32_t count{ std::min(SIGN_MASK_WORD_BITS, end - i) };
+			forFullOrTailBlock<SIGN_MASK_WORD_BITS>(count, [&](const auto n) {
+				mask[i / SIGN_MASK_WORD_BITS] = leakyReLUWord(values + i, slope, n);
+			});
+		}
+	});
+}
+
+/**
+ * Gradient of leakyReLU computed from the mask of signs of its output.
+ */
+static void leakyReLUBackward(const uint32_t* mask, const float* dy, const uint32_t size, const float slope, float* dx) {
+	ThreadPool::forEachChunk(size, ThreadPool::getParallelChunkSize(size, SIGN_MASK_WORD_BITS), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; i += SIGN_MASK_WORD_BITS) {
+			const uint32_t count{ std::min(SIGN_MASK_WORD_BITS, end - i) };
+			forFullOrTailBlock<SIGN_MASK_WORD_BITS>(count, [&](const auto n) {
+				leakyReLUBackwardWord(mask[i / SIGN_MASK_WORD_BITS], dy + i, slope, dx + i, n);
+			});
+		}
+	});
+}
+
 ActivationLayer::ActivationLayer(std::vector<uint32_t> input_shape, const Tensor (*activation_fun)(const Tensor&), const Tensor (*activation_fun_d)(const Tensor&, const Tensor&)) : Layer() {
 	_input_shape = input_shape;
 	_output_shape = input_shape;
@@ -29,6 +103,10 @@ ActivationLayer::ActivationLayer(Layer& prev_layer, ActivationFun activation_fun
 }
 
 void ActivationLayer::initActivationFun(const Tensor (*activation_fun)(const Tensor&), const Tensor (*activation_fun_d)(const Tensor&, const Tensor&)) {
+	if ((nullptr == activation_fun) || (nullptr == activation_fun_d)) {
+		throw std::invalid_argument(format_string("%s %d : Activation function and its derivative must be provided.",
+			__FILE__, __LINE__));
+	}
 	_activation_fun = activation_fun;
 	_activation_fun_d = activation_fun_d;
 }
@@ -36,24 +114,13 @@ void ActivationLayer::initActivationFun(const Tensor (*activation_fun)(const Ten
 void ActivationLayer::initActivationFun(ActivationFun activation_fun) {
 	switch (activation_fun) {
 	case ActivationFun::ReLU:
-		_activation_fun = ReLU_fun;
-		_activation_fun_d = ReLU_fun_d;
-		break;
 	case ActivationFun::LeakyReLU:
-		_activation_fun = LeakyReLU_fun;
-		_activation_fun_d = LeakyReLU_fun_d;
-		break;
 	case ActivationFun::Sigmoid:
-		_activation_fun = Sigmoid_fun;
-		_activation_fun_d = Sigmoid_fun_d;
-		break;
 	case ActivationFun::Tanh:
-		_activation_fun = Tanh_fun;
-		_activation_fun_d = Tanh_fun_d;
-		break;
 	case ActivationFun::Softmax:
-		_activation_fun = Softmax_fun;
-		_activation_fun_d = Softmax_fun_d;
+		_activation_fun = nullptr;
+		_activation_fun_d = nullptr;
+		_activation = activation_fun;
 		break;
 	default:
 		_activation_fun = nullptr;
@@ -63,7 +130,11 @@ void ActivationLayer::initActivationFun(ActivationFun activation_fun) {
 	}
 }
 
-const Tensor ActivationLayer::forwardPropagation(const Tensor& x, bool inference) {
+Tensor ActivationLayer::forwardPropagation(const Tensor& x, bool inference) {
+	if (nullptr == _activation_fun) {
+		return forwardPropagationInPlace(Tensor(x), inference);
+	}
+
 	Tensor result = _activation_fun(x);
 	if (!inference) {
 		_cached_input = x;
@@ -72,11 +143,87 @@ const Tensor ActivationLayer::forwardPropagation(const Tensor& x, bool inference
 	return result;
 }
 
-const Tensor ActivationLayer::backwardPropagation(const Tensor& dx) {
-	Tensor result = _activation_fun_d(_cached_input, dx);
+Tensor ActivationLayer::forwardPropagationInPlace(Tensor&& x, bool inference) {
+	if (nullptr != _activation_fun) {
+		return forwardPropagation(x, inference);
+	}
+
+	Tensor result{ std::move(x) };
+	const uint32_t size{ result.getSize() };
+
+	switch (_activation) {
+	case ActivationFun::ReLU:
+	case ActivationFun::LeakyReLU: {
+		const float slope{ ActivationFun::ReLU == _activation ? 0.0f : LEAKY_RELU_SLOPE };
+		if (!inference) {
+			_sign_mask.resize((size + SIGN_MASK_WORD_BITS - 1) / SIGN_MASK_WORD_BITS);
+			// the output of an earlier step must not be mistaken for the current one
+			_cached_output = Tensor({ 0 });
+		}
+		leakyReLU(result.getDataPointer(), size, slope, inference ? nullptr : _sign_mask.data());
+		break;
+	}
+	case ActivationFun::Sigmoid:
+		result.sigmoidInPlace();
+		break;
+	case ActivationFun::Tanh:
+		result.tanhInPlace();
+		break;
+	case ActivationFun::Softmax: {
+		if (0 == size) {
+			// an empty batch has no rows to normalize
+			break;
+		}
+		const uint32_t rows = result.getShape()[0];
+		softmax(result.getDataPointer(), rows, size / rows, result.getDataPointer());
+		break;
+	}
+	default:
+		break;
+	}
+
+	if (!inference && (ActivationFun::ReLU != _activation) && (ActivationFun::LeakyReLU != _activation)) {
+		_cached_output = result;
+	}
 	return result;
 }
 
+Tensor ActivationLayer::backwardPropagation(const Tensor& dx) {
+	if (nullptr != _activation_fun_d) {
+		return _activation_fun_d(_cached_input, dx);
+	}
+
+	switch (_activation) {
+	case ActivationFun::ReLU:
+	case ActivationFun::LeakyReLU: {
+		if (_sign_mask.size() != (dx.getSize() + SIGN_MASK_WORD_BITS - 1) / SIGN_MASK_WORD_BITS) {
+			throw std::invalid_argument(format_string("%s %d : Gradient size does not match the last output. size=%d, mask words=%d.",
+				__FILE__, __LINE__, dx.getSize(), _sign_mask.size()));
+		}
+		const float slope{ ActivationFun::ReLU == _activation ? 0.0f : LEAKY_RELU_SLOPE };
+		Tensor dx_prev(dx.getShape());
+		leakyReLUBackward(_sign_mask.data(), dx.getDataPointer(), dx.getSize(), slope, dx_prev.getDataPointer());
+		return dx_prev;
+	}
+	case ActivationFun::Sigmoid:
+		return dx.zip(_cached_output, [](float d, float sig) { return d * sig * (1.0f - sig); });
+	case ActivationFun::Tanh:
+		return dx.zip(_cached_output, [](float d, float t) { return d * (1.0f - t * t); });
+	case ActivationFun::Softmax: {
+		// dx_prev = s * (dx - sum(dx * s)) for every row, where s is softmax of the row
+		Tensor dx_prev(dx.getShape());
+		if (0 == dx.getSize()) {
+			return dx_prev;
+		}
+		const uint32_t rows = dx.getShape()[0];
+		softmaxBackward(_cached_output.getDataPointer(), dx.getDataPointer(), rows, dx.getSize() / rows, dx_prev.getDataPointer());
+		return dx_prev;
+	}
+	default:
+		return dx;
+	}
+}
+
 void ActivationLayer::summary() const {
 	printf("Activation Layer    ");
 	printf("  in shape:  (*");
@@ -94,68 +241,3 @@ void ActivationLayer::summary() const {
 uint32_t ActivationLayer::getParamsCount() const {
 	return 0;
 }
-
-const Tensor ActivationLayer::ReLU_fun(const Tensor& x) {
-	return x * (x > 0.0f);
-}
-
-const Tensor ActivationLayer::ReLU_fun_d(const Tensor& x, const Tensor& dx) {
-	return dx * (x > 0.0f);
-}
-
-const Tensor ActivationLayer::LeakyReLU_fun(const Tensor& x) {
-	return x.applyFunction([](float value) {return value > 0.0f ? value * 1.0f : value * 0.1f; });
-}
-
-const Tensor ActivationLayer::LeakyReLU_fun_d(const Tensor& x, const Tensor& dx) {
-	return dx * x.applyFunction([](float value) {return value > 0.0f ? 1.0f : 0.1f; });
-}
-
-const Tensor ActivationLayer::Sigmoid_fun(const Tensor& x) {
-	return x.applyFunction([](float value) {return powf(1.0f + expf(-value), -1); });
-}
-
-const Tensor ActivationLayer::Sigmoid_fun_d(const Tensor& x, const Tensor& dx) {
-	Tensor sig = Sigmoid_fun(x);
-	return dx * (sig * (1.0f - sig));
-}
-
-const Tensor ActivationLayer::Tanh_fun(const Tensor& x) {
-	return x.applyFunction(tanhf);
-}
-
-const Tensor ActivationLayer::Tanh_fun_d(const Tensor& x, const Tensor& dx) {
-	Tensor t = std::move(x.applyFunction(tanhf));
-	return dx * (1 - (t * t));
-}
-
-const Tensor ActivationLayer::Softmax_fun(const Tensor& x) {
-	Tensor x_next(x.getShape());
-	
-	for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
-		Tensor x_row = x[{ { i }, { 0, x.getShape()[1] }}];
-		Tensor exp_x_row = (x_row - x_row.max()).applyFunction(expf);
-		x_next[{ { i }, { 0, x.getShape()[1] }}] = exp_x_row / exp_x_row.sum();
-	}
-	
-	return x_next;
-}
-
-const Tensor ActivationLayer::Softmax_fun_d(const Tensor& x, const Tensor& dx) {
-	Tensor dx_prev(x.getShape());
-
-	for (uint32_t i{ 0 }; i < x.getShape()[0]; ++i) {
-		for (uint32_t j{ 0 }; j < x.getShape()[1]; ++j) {
-			for (uint32_t k{ 0 }; k < x.getShape()[1]; ++k) {
-				if (j == k) {
-					dx_prev[{{ i }, { j }}] = dx[{{ i }, { j }}] * (1.0f - dx[{{ i }, { k }}]);
-				}
-				else {
-					dx_prev[{{ i }, { j }}] = - dx[{{ i }, { j }}] * dx[{{ i }, { k }}];
-				}
-			}
-		}
-	}
-
-	return dx_prev;
-}
\ No newline at end of file
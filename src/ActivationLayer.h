@@ -47,8 +47,20 @@ public:
 	 */
 	ActivationLayer(Layer& prev_layer, ActivationFun activation_fun);
 
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	/**
+	 * Built-in activation functions are computed in the buffer of x. Their derivatives are expressed with the output,
+	 * so in training only the output (Sigmoid, Tanh, Softmax) or a mask of its signs with one bit per value
+	 * (ReLU, LeakyReLU, getCachedOutput returns an empty tensor then) is kept for backward propagation.
+	 * Functions given by pointers are not computed in place.
+	 * @brief Forward propagation of the layer which overwrites the input.
+	 * 
+	 * @param x Input tensor, its buffer is used for the output.
+	 * @param inference Inference indicator.
+	 * @return Output of the layer for given x.
+	 */
+	virtual Tensor forwardPropagationInPlace(Tensor&& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum) { };
 	virtual void initCachedGradient() { };
 	virtual void summary() const;
@@ -70,25 +82,16 @@ private:
 	void initActivationFun(ActivationFun activation_fun);
 
 	/**
-	 * Activation function.
+	 * Activation function and its derivative given by pointers, nullptr for built-in activation functions.
 	 */
 	const Tensor (*_activation_fun)(const Tensor&);
+	const Tensor (*_activation_fun_d)(const Tensor&, const Tensor&);
 	/**
-	 * Activation function derivative.
+	 * Built-in activation function, used if _activation_fun is nullptr.
 	 */
-	const Tensor (*_activation_fun_d)(const Tensor&, const Tensor&);
-
+	ActivationFun _activation;
 	/**
-	 * Activation functions and their derivatives.
+	 * Signs of the last ReLU or LeakyReLU output, bit k of word w is set if value 32 * w + k is positive.
 	 */
-	static const Tensor ReLU_fun(const Tensor& x);
-	static const Tensor ReLU_fun_d(const Tensor& x, const Tensor& dx);
-	static const Tensor LeakyReLU_fun(const Tensor& x);
-	static const Tensor LeakyReLU_fun_d(const Tensor& x, const Tensor& dx);
-	static const Tensor Sigmoid_fun(const Tensor& x);
-	static const Tensor Sigmoid_fun_d(const Tensor& x, const Tensor& dx);
-	static const Tensor Tanh_fun(const Tensor& x);
-	static const Tensor Tanh_fun_d(const Tensor& x, const Tensor& dx);
-	static const Tensor Softmax_fun(const Tensor& x);
-	static const Tensor Softmax_fun_d(const Tensor& x, const Tensor& dx);
+	std::vector<uint32_t> _sign_mask;
 };
\ No newline at end of file
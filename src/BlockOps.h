@@ -0,0 +1,47 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Element-wise operations on short blocks of values (e.g. channels of a pixel or a chunk of a row), inlined into
+ * the loops of kernels, so the compiler can vectorize them for a constant block size.
+ */
+
+/**
+ * Calls func(count) for a block of count values. A full block (count == BLOCK) is passed as
+ * std::integral_constant, so a generic func is instantiated separately for it, loops of the inlined func have
+ * constant trip count and values kept in local arrays of BLOCK elements are vectorized and unrolled.
+ * The shorter tail block is passed as uint32_t and falls back to the generic loop.
+ *
+ * @param count Number of values of the block, not greater than BLOCK.
+ * @param func Generic callable taking the number of values of the block (auto parameter).
+ */
+template <uint32_t BLOCK, typename Func>
+inline void forFullOrTailBlock(const uint32_t count, Func&& func) {
+	if (BLOCK == count) {
+		func(std::integral_constant<uint32_t, BLOCK>{});
+	}
+	else {
+		func(count);
+	}
+}
+
+/**
+ * best[k] = max(best[k], values[k]) for k in [0, count).
+ */
+inline void blockMaximum(const float* values, float* best, const uint32_t count) {
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		best[k] = std::max(best[k], values[k]);
+	}
+}
+
+/**
+ * acc[k] += values[k] for k in [0, count).
+ */
+inline void blockAdd(const float* values, float* acc, const uint32_t count) {
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		acc[k] += values[k];
+	}
+}
@@ -0,0 +1,55 @@
+#include "Conv2DGeometry.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Utils.h"
+
+/**
+ * Returns output size and padding before the input along one axis.
+ */
+static void computeAxis(const uint32_t size, const uint32_t effective_filter_size, const uint32_t stride, const ConvPadding padding,
+	uint32_t& output_size, uint32_t& padding_before) {
+	if (ConvPadding::Valid == padding) {
+		if (size < effective_filter_size) {
+			throw std::invalid_argument(format_string("%s %d : Input size %d is smaller than filter size %d with valid padding.",
+				__FILE__, __LINE__, size, effective_filter_size));
+		}
+		output_size = (size - effective_filter_size) / stride + 1;
+		padding_before = 0;
+		return;
+	}
+
+	output_size = (size + stride - 1) / stride;
+	const uint32_t needed{ (output_size - 1) * stride + effective_filter_size };
+	padding_before = (needed > size) ? (needed - size) / 2 : 0;
+}
+
+Conv2DGeometry::Conv2DGeometry(uint32_t height, uint32_t width, uint32_t filter_size, uint32_t stride, uint32_t dilation, ConvPadding padding)
+	: height{ height }, width{ width }, filter_size{ filter_size }, stride{ stride }, dilation{ dilation } {
+	if ((0 == filter_size) || (0 == stride) || (0 == dilation)) {
+		throw std::invalid_argument(format_string("%s %d : Filter size, stride and dilation should be positive, but are %d, %d and %d.",
+			__FILE__, __LINE__, filter_size, stride, dilation));
+	}
+
+	computeAxis(height, getEffectiveFilterSize(), stride, padding, output_height, padding_top);
+	computeAxis(width, getEffectiveFilterSize(), stride, padding, output_width, padding_left);
+}
+
+uint32_t Conv2DGeometry::getEffectiveFilterSize() const {
+	return (filter_size - 1) * dilation + 1;
+}
+
+bool Conv2DGeometry::isUnitSame() const {
+	return (1 == stride) && (1 == dilation) && (output_height == height) && (output_width == width)
+		&& (padding_top == (filter_size - 1) / 2) && (padding_left == (filter_size - 1) / 2);
+}
+
+void Conv2DGeometry::getTapsRange(int32_t first, uint32_t size, uint32_t& begin, uint32_t& end) const {
+	const int32_t step{ static_cast<int32_t>(dilation) };
+	const int32_t last{ static_cast<int32_t>(size) - first };
+
+	begin = (first < 0) ? static_cast<uint32_t>((step - 1 - first) / step) : 0;
+	end = (last > 0) ? std::min(filter_size, static_cast<uint32_t>((last + step - 1) / step)) : 0;
+	begin = std::min(begin, end);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Padding of convolution input.
+ * Same pads the input with zeros so the output has ceil(size / stride) rows and columns,
+ * Valid uses only filter positions fully inside of the input.
+ */
+enum class ConvPadding {
+	Same,
+	Valid
+};
+
+/**
+ * @brief Spatial geometry of a 2D convolution shared by all convolution kernels.
+ * Output pixel (y, x) is computed from input pixels (y * stride + a * dilation - padding_top,
+ * x * stride + b * dilation - padding_left) for filter positions (a, b), pixels outside of the input are zeros.
+ */
+struct Conv2DGeometry {
+	/**
+	 * @brief Construct geometry of a convolution.
+	 * Same padding splits padding as evenly as possible, the extra row/column is added after the input.
+	 *
+	 * @param height Height of input images.
+	 * @param width Width of input images.
+	 * @param filter_size Size of square filters.
+	 * @param stride Step between positions of filters.
+	 * @param dilation Step between filter taps.
+	 * @param padding Padding mode.
+	 */
+	Conv2DGeometry(uint32_t height, uint32_t width, uint32_t filter_size, uint32_t stride=1, uint32_t dilation=1,
+		ConvPadding padding=ConvPadding::Same);
+
+	uint32_t height;
+	uint32_t width;
+	uint32_t filter_size;
+	uint32_t stride;
+	uint32_t dilation;
+	/**
+	 * Number of zero rows/columns added before the input.
+	 */
+	uint32_t padding_top;
+	uint32_t padding_left;
+	uint32_t output_height;
+	uint32_t output_width;
+
+	/**
+	 * @brief Returns size of the area covered by a dilated filter, (filter_size - 1) * dilation + 1.
+	 *
+	 * @return Effective filter size.
+	 */
+	uint32_t getEffectiveFilterSize() const;
+	/**
+	 * @brief Checks if the convolution has stride 1, no dilation and output of the same size as the input.
+	 *
+	 * @return True for stride 1 and dilation 1 with Same padding.
+	 */
+	bool isUnitSame() const;
+	/**
+	 * @brief Returns range of filter taps inside of the input along one axis.
+	 *
+	 * @param first Input position of the first tap (output position * stride - padding).
+	 * @param size Size of the input along the axis.
+	 * @param begin First tap inside of the input.
+	 * @param end Tap after the last one inside of the input, equal to begin if there are none.
+	 */
+	void getTapsRange(int32_t first, uint32_t size, uint32_t& begin, uint32_t& end) const;
+};
@@ -1,6 +1,11 @@
 #include "Conv2DLayer.h"
+#include "DirectConv.h"
+#include "FFTConv.h"
+#include "Im2col.h"
+#include "WinogradConv.h"
 
-Conv2DLayer::Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size) : Layer() {
+Conv2DLayer::Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size, uint32_t stride,
+	ConvPadding padding, uint32_t dilation, uint32_t groups, ConvAlgorithm algorithm) : Layer() {
 	_input_shape = input_shape;
 	if (2 == _input_shape.size()) {
 		_input_shape.push_back(1);
@@ -9,14 +14,27 @@ Conv2DLayer::Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_cou
 		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Dim should be 3, but is %d.",
 			__FILE__, __LINE__, _input_shape.size()));
 	}
-	_output_shape = _input_shape;
-    _output_shape[_output_shape.size() - 1] = filters_count;
 	_filters_count = filters_count;
 	_filter_size = filter_size;
+	_stride = stride;
+	_dilation = dilation;
+	_padding = padding;
+	_groups = groups;
+	_algorithm = algorithm;
+	const Conv2DGeometry geometry = getGeometry(_input_shape[0], _input_shape[1]);
+	_output_shape = { geometry.output_height, geometry.output_width, filters_count };
+	_transformed_filters_valid = false;
+	_fft_filters_height = 0;
+	_fft_filters_width = 0;
+	if ((0 == groups) || (0 != _input_shape[2] % groups) || (0 != filters_count % groups)) {
+		throw std::invalid_argument(format_string("%s %d : Groups count %d should divide channels count %d and filters count %d.",
+			__FILE__, __LINE__, groups, _input_shape[2], filters_count));
+	}
 	initWeights(_input_shape, filters_count, filter_size);
 }
 
-Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size) : Layer() {
+Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size, uint32_t stride,
+	ConvPadding padding, uint32_t dilation, uint32_t groups, ConvAlgorithm algorithm) : Layer() {
 	_input_shape = prev_layer.getOutputShape();
 	if (2 == _input_shape.size()) {
 		_input_shape.push_back(1);
@@ -25,10 +43,22 @@ Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t fil
 		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Dim should be 3, but is %d.",
 			__FILE__, __LINE__, _input_shape.size()));
 	}
-	_output_shape = _input_shape;
-    _output_shape[_output_shape.size() - 1] = filters_count;
 	_filters_count = filters_count;
 	_filter_size = filter_size;
+	_stride = stride;
+	_dilation = dilation;
+	_padding = padding;
+	_groups = groups;
+	_algorithm = algorithm;
+	const Conv2DGeometry geometry = getGeometry(_input_shape[0], _input_shape[1]);
+	_output_shape = { geometry.output_height, geometry.output_width, filters_count };
+	_transformed_filters_valid = false;
+	_fft_filters_height = 0;
+	_fft_filters_width = 0;
+	if ((0 == groups) || (0 != _input_shape[2] % groups) || (0 != filters_count % groups)) {
+		throw std::invalid_argument(format_string("%s %d : Groups count %d should divide channels count %d and filters count %d.",
+			__FILE__, __LINE__, groups, _input_shape[2], filters_count));
+	}
 	initWeights(_input_shape, filters_count, filter_size);
 	this->setPrevLayer(&prev_layer);
 	prev_layer.setNextLayer(this);
@@ -36,18 +66,71 @@ Conv2DLayer::Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t fil
 
 void Conv2DLayer::setWeights(std::vector<float> weights) {
 	_weights.setValues(weights);
+	_transformed_filters_valid = false;
 }
 
 void Conv2DLayer::setBiases(std::vector<float> biases) {
 	_biases.setValues(biases);
 }
 
+void Conv2DLayer::setAlgorithm(ConvAlgorithm algorithm) {
+	_algorithm = algorithm;
+	_cached_rects = Tensor();
+	_transformed_filters_valid = false;
+}
+
+ConvAlgorithm Conv2DLayer::getAlgorithm() const {
+	return _algorithm;
+}
+
+Conv2DGeometry Conv2DLayer::getGeometry(uint32_t height, uint32_t width) const {
+	return Conv2DGeometry(height, width, _filter_size, _stride, _dilation, _padding);
+}
+
+ConvAlgorithm Conv2DLayer::selectAlgorithm(const Conv2DGeometry& geometry) const {
+	if ((ConvAlgorithm::Auto == _algorithm) || (1 != _groups)) {
+		return ((_filter_size >= 11) && (1 == _stride) && (1 == _groups)) ? ConvAlgorithm::FFT : ConvAlgorithm::Direct;
+	}
+	if ((ConvAlgorithm::Winograd == _algorithm) && ((3 != _filter_size) || !geometry.isUnitSame())) {
+		return ConvAlgorithm::Direct;
+	}
+	if ((ConvAlgorithm::FFT == _algorithm) && (1 != _stride)) {
+		return ConvAlgorithm::Direct;
+	}
+	return _algorithm;
+}
+
+void Conv2DLayer::updateTransformedFilters(ConvAlgorithm algorithm, const Conv2DGeometry& geometry) {
+	if (_transformed_filters_valid && ((ConvAlgorithm::FFT != algorithm) ||
+		((geometry.height == _fft_filters_height) && (geometry.width == _fft_filters_width)))) {
+		return;
+	}
+
+	// transforms are cached across training steps, so they must not be taken from the step arena
+	TensorAllocatorScope scope(getDefaultTensorAllocator());
+	const uint32_t channels = _input_shape[2];
+	if (ConvAlgorithm::Winograd == algorithm) {
+		_winograd_filters = Tensor({ WINOGRAD_TILE_SIZE, channels, _filters_count });
+		_winograd_filters_backward = Tensor({ WINOGRAD_TILE_SIZE, _filters_count, channels });
+		winogradTransformFilters(_weights.getDataPointer(), channels, _filters_count, _winograd_filters.getDataPointer());
+		winogradTransformFiltersBackward(_weights.getDataPointer(), channels, _filters_count, _winograd_filters_backward.getDataPointer());
+	}
+	else {
+		// spectra depend on the size of input images, which may differ from the declared input shape
+		_fft_filters = Tensor({ channels, _filters_count, 2, fftConvSpectrumSize(geometry) });
+		_fft_filters_height = geometry.height;
+		_fft_filters_width = geometry.width;
+		fftConvTransformFilters(_weights.getDataPointer(), channels, _filters_count, geometry, _fft_filters.getDataPointer());
+	}
+	_transformed_filters_valid = true;
+}
+
 void Conv2DLayer::initWeights(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size) {
 	_filters_count = filters_count;
 
-	_weights = Tensor({ filter_size, filter_size, input_shape[2], filters_count });
+	_weights = Tensor({ filter_size, filter_size, input_shape[2] / _groups, filters_count });
 
-	_weights.applyFunction([](float value) {return randNormalDistribution(); });
+	_weights.mapInPlace([](float) { return randNormalDistribution(); });
 	_weights /=  filter_size * filter_size;
     //_weights.applyFunction([](float value) {return randUniform(-1.0f, 1.0f) * sqrtf(6.0f); });
 
@@ -92,44 +175,64 @@ void Conv2DLayer::updateWeights(float learning_step, float momentum) {
 
 	_weights -= _cached_weights_d_velocity;
 	_biases -= _cached_biases_d_velocity;
+	_transformed_filters_valid = false;
 }
 
-const Tensor Conv2DLayer::forwardPropagation(const Tensor& x, bool inference) {
-
-	const Tensor x_pad = x.addPadding({ 1, 2 }, { Both, Both }, { (_filter_size - 1) >> 1, (_filter_size - 1) >> 1 });
-
+Tensor Conv2DLayer::forwardPropagation(const Tensor& x, bool inference) {
 	uint32_t batch_size = x.getShape()[0]; 	// b
 	uint32_t height = x.getShape()[1];		// h
 	uint32_t width = x.getShape()[2];		// w
 	uint32_t channels = x.getShape()[3];	// c
 
-	Tensor rects = Tensor({ batch_size * height * width, _filter_size * _filter_size * channels });
+	const Conv2DGeometry geometry = getGeometry(height, width);
+	const uint32_t out_height = geometry.output_height;	// oh
+	const uint32_t out_width = geometry.output_width;	// ow
+	const ConvAlgorithm algorithm = selectAlgorithm(geometry);
+	Tensor x_next;
+
+	if (ConvAlgorithm::FFT == algorithm) {
+		updateTransformedFilters(algorithm, geometry);
+		x_next = Tensor({ batch_size, out_height, out_width, _filters_count });
+		fftConv(x.getDataPointer(), batch_size, channels, _fft_filters.getDataPointer(), _filters_count, geometry,
+			_biases.getDataPointer(), x_next.getDataPointer());
+	}
+	else if (ConvAlgorithm::Winograd == algorithm) {
+		updateTransformedFilters(algorithm, geometry);
+		x_next = Tensor({ batch_size, height, width, _filters_count });
+		winogradConv(x.getDataPointer(), batch_size, height, width, channels, _winograd_filters.getDataPointer(), _filters_count,
+			_biases.getDataPointer(), x_next.getDataPointer());
+	}
+	else if (ConvAlgorithm::Direct == algorithm) {
+		// [b, h, w, c] * [s, s, c, f] = [b, oh, ow, f]
+		x_next = Tensor({ batch_size, out_height, out_width, _filters_count });
+		directConv(x.getDataPointer(), batch_size, channels, _weights.getDataPointer(), _filters_count, geometry,
+			_biases.getDataPointer(), x_next.getDataPointer(), _groups);
+	}
+	else {
+		// [b, h, w, c] -> [b oh ow, ssc]
+		Tensor rects = Tensor({ batch_size * out_height * out_width, _filter_size * _filter_size * channels });
+		im2col(x.getDataPointer(), batch_size, channels, geometry, rects.getDataPointer());
+
+		// [b oh ow, ssc] * [ssc, f] = [b oh ow, f] -> [b, oh, ow, f]
+		x_next = std::move(rects.dotProduct(_weights.view().reshape({ _filter_size * _filter_size * channels, _filters_count })).reshape({ batch_size, out_height, out_width, _filters_count }));
+
+		x_next += _biases;
 
-	for (uint32_t i{ 0 }; i < batch_size; ++i) {
-		for (uint32_t j{ 0 }; j < height; ++j) {
-			for (uint32_t k{ 0 }; k < width; ++k) {
-				rects[{ { i * width * height + j * width + k }, { 0, _filter_size * _filter_size * channels }}] =
-					x_pad[{{ i }, { j, j + _filter_size }, { k, k + _filter_size }, { 0, channels } }].reshape({ _filter_size * _filter_size * channels });
-			}
+		if (!inference) {
+			_cached_rects = std::move(rects);
 		}
 	}
-	
-	// [bhw, ssc] * [ssc, f] = [bhw, f] -> [b, h, w, f]
-	Tensor x_next = std::move(rects.dotProductTranspose(_weights.reshape({ _filter_size * _filter_size * channels, _filters_count }).transpose()).reshape({ batch_size, height, width, _filters_count }));
-
-	x_next += _biases;
 
 	if (!inference)
 	{
 		_cached_input = x;
 		_cached_output = x_next;
-		_cached_rects = rects;
 	}
 
 	return x_next;
 }
 
-const Tensor Conv2DLayer::backwardPropagation(const Tensor& dx) {
+Tensor Conv2DLayer::backwardPropagation(const Tensor& dx) {
 	_samples += _cached_input.getShape()[0];
 
 	uint32_t batch_size = _cached_input.getShape()[0];	// b
@@ -137,55 +240,48 @@ const Tensor Conv2DLayer::backwardPropagation(const Tensor& dx) {
 	uint32_t width = _cached_input.getShape()[2];		// w
 	uint32_t channels = _cached_input.getShape()[3];	// c
 
-	const Tensor x_pad = _cached_input.addPadding({ 1, 2 }, { Both, Both }, { (_filter_size - 1) >> 1, (_filter_size - 1) >> 1 });
-	const Tensor dx_pad = dx.addPadding({ 1, 2 }, { Both, Both }, { (_filter_size - 1) >> 1, (_filter_size - 1) >> 1 });
-
-	Tensor x_rects = _cached_rects;
-	Tensor dx_rects = Tensor({ batch_size * height * width, _filter_size * _filter_size * _filters_count });
-	
-	for (uint32_t i{ 0 }; i < batch_size; ++i) {
-		for (uint32_t j{ 0 }; j < height; ++j) {
-			for (uint32_t k{ 0 }; k < width; ++k) {
-				// for (uint32_t i_x{ 0 }; i_x < _filter_size; ++i_x) {
-				// 	for (uint32_t i_y{ 0 }; i_y < _filter_size; ++i_y) {
-				// 		for (uint32_t i_c{ 0 }; i_c < _filters_count; ++i_c) {
-				// 			dx_rects[{ { i * width * height + j * width + k }, { i_x * _filter_size * _filters_count + i_y * _filters_count + i_c }}] =
-				// 				dx_pad[{{ i }, { j + (_filter_size - 1 - i_x) }, { k + (_filter_size - 1 - i_y) }, { i_c } }];
-				// 		}
-				// 	}
-				// }
-				dx_rects[{ { i * width * height + j * width + k }, { 0, _filter_size * _filter_size * _filters_count }}] =
-					dx_pad[{{ i }, { j, j + _filter_size }, { k, k + _filter_size }, { 0, _filters_count } }].reshape({ _filter_size * _filter_size * _filters_count });
-			}
-		}
-	}
-
-	// [ssc, bhw] * [bhw, f] = [ssc, f] -> [s, s, c, f]
-	Tensor weights_d = std::move(x_rects.transpose().dotProduct(dx.reshape({ batch_size * width * height, _filters_count })).reshape(_weights.getShape()));
-	Tensor biases_d({ _filters_count });
+	const Conv2DGeometry geometry = getGeometry(height, width);
+	const uint32_t out_height = geometry.output_height;	// oh
+	const uint32_t out_width = geometry.output_width;	// ow
 
-	for (uint32_t i{ 0 }; i < _filters_count; ++i) {
-		biases_d[{ i }] = dx[{ { 0, batch_size }, { 0, height }, { 0, width }, { i }}].sum();
-	}
-
-	_cached_weights_d += weights_d;
+	const TensorView dx_flat = dx.view().reshape({ batch_size * out_height * out_width, _filters_count });
+	Tensor biases_d = Tensor(dx_flat).sum(0);
 	_cached_biases_d += biases_d;
 
-	// [s, s, c, f] -> [s, s, f, c]
-	Tensor filters_transformed({ _filter_size, _filter_size, _filters_count, channels });
+	const ConvAlgorithm algorithm = selectAlgorithm(geometry);
+	if (ConvAlgorithm::Im2col != algorithm) {
+		directConvBackwardFilter(_cached_input.getDataPointer(), dx.getDataPointer(), batch_size, channels, _filters_count, geometry,
+			_cached_weights_d.getDataPointer(), _groups);
 
-	for (uint32_t i{ 0 }; i < _filter_size; ++i) {
-		for (uint32_t j{ 0 }; j < _filter_size; ++j) {
-			filters_transformed[{ { i }, { j }, { 0, _filters_count}, { 0, channels }}] =
-				const_cast<const Tensor&>(_weights)[{ { i }, { j }, { 0, channels }, { 0, _filters_count} }].transpose();
+		Tensor dx_prev({ batch_size, height, width, channels });
+		if (ConvAlgorithm::FFT == algorithm) {
+			updateTransformedFilters(algorithm, geometry);
+			fftConvBackwardData(dx.getDataPointer(), batch_size, channels, _fft_filters.getDataPointer(), _filters_count, geometry,
+				dx_prev.getDataPointer());
 		}
+		else if (ConvAlgorithm::Winograd == algorithm) {
+			updateTransformedFilters(algorithm, geometry);
+			winogradConv(dx.getDataPointer(), batch_size, height, width, _filters_count, _winograd_filters_backward.getDataPointer(), channels,
+				nullptr, dx_prev.getDataPointer());
+		}
+		else {
+			directConvBackwardData(dx.getDataPointer(), batch_size, channels, _weights.getDataPointer(), _filters_count, geometry,
+				dx_prev.getDataPointer(), _groups);
+		}
+
+		return dx_prev;
 	}
 
-	// [s, s, f, c] -> [ssf, c] -> [c, ssf]
-	filters_transformed = std::move(filters_transformed.reshape({ _filter_size * _filter_size * _filters_count, channels }).transpose());
+	// [ssc, b oh ow] * [b oh ow, f] = [ssc, f] -> [s, s, c, f]
+	const TensorView weights_flat = _weights.view().reshape({ _filter_size * _filter_size * channels, _filters_count });
+
+	Tensor weights_d = std::move(_cached_rects.view().transpose().dotProduct(dx_flat).reshape(_weights.getShape()));
+	_cached_weights_d += weights_d;
 
-	// [bhw, ssf] * [ssf, c] = [bhw, c] -> [b, h, w, c]
-	Tensor dx_prev = std::move(dx_rects.dotProductTranspose(filters_transformed).reshape({ batch_size, height, width, channels }));
+	// [b oh ow, f] * [ssc, f]^T = [b oh ow, ssc] -> [b, h, w, c]
+	Tensor dx_rects = dx_flat.dotProduct(weights_flat.transpose());
+	Tensor dx_prev({ batch_size, height, width, channels });
+	col2im(dx_rects.getDataPointer(), batch_size, channels, geometry, dx_prev.getDataPointer());
 
 	return dx_prev;
 }
\ No newline at end of file
@@ -3,9 +3,18 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "Conv2DGeometry.h"
 #include "Utils.h"
 #include "Layer.h"
 
+enum class ConvAlgorithm {
+	Auto,
+	Im2col,
+	Direct,
+	Winograd,
+	FFT
+};
+
 class Conv2DLayer : public Layer {
 public:
 	/**
@@ -14,16 +23,28 @@ public:
 	 * @param input_shape Shape of input Tensor.
 	 * @param filters_count Convolution filters count.
 	 * @param filter_size Convolution filters size.
+	 * @param stride Step between positions of filters, outputs are computed only at these positions.
+	 * @param padding Padding mode, Same keeps ceil(size / stride) outputs, Valid uses only filters inside of the input.
+	 * @param dilation Step between filter taps.
+	 * @param groups Number of groups of channels and filters, filters of a group see only channels of the same group.
+	 * @param algorithm Convolution algorithm.
 	 */
-	Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size);
+	Conv2DLayer(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size, uint32_t stride=1,
+		ConvPadding padding=ConvPadding::Same, uint32_t dilation=1, uint32_t groups=1, ConvAlgorithm algorithm=ConvAlgorithm::Auto);
 	/**
 	 * @brief Construct a new Conv2D Layer.
 	 * 
 	 * @param prev_layer Previous layer.
 	 * @param filters_count Convolution filters count.
 	 * @param filter_size Convolution filters size.
+	 * @param stride Step between positions of filters, outputs are computed only at these positions.
+	 * @param padding Padding mode, Same keeps ceil(size / stride) outputs, Valid uses only filters inside of the input.
+	 * @param dilation Step between filter taps.
+	 * @param groups Number of groups of channels and filters, filters of a group see only channels of the same group.
+	 * @param algorithm Convolution algorithm.
 	 */
-	Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size);
+	Conv2DLayer(Layer& prev_layer, uint32_t filters_count, uint32_t filter_size, uint32_t stride=1,
+		ConvPadding padding=ConvPadding::Same, uint32_t dilation=1, uint32_t groups=1, ConvAlgorithm algorithm=ConvAlgorithm::Auto);
 	
 	/**
 	 * @brief Set the layer weights.
@@ -37,9 +58,28 @@ public:
 	 * @param biases Biases values to be set.
 	 */
 	void setBiases(std::vector<float> biases);
+	/**
+	 * @brief Set the convolution algorithm.
+	 * Im2col multiplies the patch matrix of the input by the filters. Direct convolves NHWC input in place and
+	 * keeps no patch matrix between forward and backward propagation. Winograd computes forward propagation and
+	 * the input gradient with Winograd F(2x2, 3x3) and filters gradient as Direct, it works only with 3x3 filters
+	 * with stride 1, no dilation and Same padding (Direct is used otherwise). FFT multiplies spectra of the input and
+	 * filters, its cost does not grow with filter size, the filters gradient is computed as Direct. It works only with
+	 * stride 1 (Direct is used otherwise). Grouped convolution is computed only by Direct. Auto picks FFT for filters
+	 * 11x11 and larger with stride 1 and a single group and Direct otherwise.
+	 * 
+	 * @param algorithm Convolution algorithm.
+	 */
+	void setAlgorithm(ConvAlgorithm algorithm);
+	/**
+	 * @brief Get the convolution algorithm set for the layer.
+	 * 
+	 * @return Convolution algorithm.
+	 */
+	ConvAlgorithm getAlgorithm() const;
 
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum);
 	virtual void initCachedGradient();
 	virtual void summary() const;
@@ -54,6 +94,26 @@ private:
 	 * Size of the convolution filters.
 	 */
 	uint32_t _filter_size;
+	/**
+	 * Step between positions of the convolution filters.
+	 */
+	uint32_t _stride;
+	/**
+	 * Step between taps of the convolution filters.
+	 */
+	uint32_t _dilation;
+	/**
+	 * Padding mode of the convolution input.
+	 */
+	ConvPadding _padding;
+	/**
+	 * Number of groups of channels and filters.
+	 */
+	uint32_t _groups;
+	/**
+	 * Convolution algorithm.
+	 */
+	ConvAlgorithm _algorithm;
 	/**
 	 * Convolution weights.
 	 */
@@ -83,9 +143,24 @@ private:
 	 */
 	Tensor _cached_biases_d_velocity;
 	/**
-	 * Cached input slices (used for optimization).
+	 * Cached input slices (used by Im2col algorithm).
 	 */
 	Tensor _cached_rects;
+	/**
+	 * Winograd transforms of weights for forward propagation and for the input gradient (used by Winograd algorithm).
+	 */
+	Tensor _winograd_filters;
+	Tensor _winograd_filters_backward;
+	/**
+	 * Spectra of weights (used by FFT algorithm) and size of input images they were computed for.
+	 */
+	Tensor _fft_filters;
+	uint32_t _fft_filters_height;
+	uint32_t _fft_filters_width;
+	/**
+	 * False if weights or algorithm changed since transforms of weights were computed.
+	 */
+	bool _transformed_filters_valid;
 
 	/**
 	 * @brief Initializes convolution weights and biases.
@@ -95,4 +170,27 @@ private:
 	 * @param filter_size Convolution filters size.
 	 */
 	void initWeights(std::vector<uint32_t> input_shape, uint32_t filters_count, uint32_t filter_size);
+	/**
+	 * @brief Returns geometry of the convolution of input images of given size.
+	 * 
+	 * @param height Height of input images.
+	 * @param width Width of input images.
+	 * @return Convolution geometry.
+	 */
+	Conv2DGeometry getGeometry(uint32_t height, uint32_t width) const;
+	/**
+	 * @brief Returns algorithm used for propagation (resolves Auto and algorithms not supporting the geometry).
+	 * 
+	 * @param geometry Convolution geometry.
+	 * @return Convolution algorithm.
+	 */
+	ConvAlgorithm selectAlgorithm(const Conv2DGeometry& geometry) const;
+	/**
+	 * @brief Computes Winograd transforms or spectra of weights if they changed since the last call.
+	 * Spectra are also recomputed if size of input images changed.
+	 * 
+	 * @param algorithm Algorithm the transforms are used by (Winograd or FFT).
+	 * @param geometry Convolution geometry of the input.
+	 */
+	void updateTransformedFilters(ConvAlgorithm algorithm, const Conv2DGeometry& geometry);
 };
\ No newline at end of file
@@ -14,6 +14,22 @@ DenseLayer::DenseLayer(Layer& prev_layer, uint32_t neurons_count) : Layer() {
 	prev_layer.setNextLayer(this);
 }
 
+DenseLayer::DenseLayer(std::vector<uint32_t> input_shape, uint32_t neurons_count, ActivationFun activation_fun) : Layer() {
+	_input_shape = input_shape;
+	_output_shape = { neurons_count };
+	initWeights(_input_shape, neurons_count);
+	initActivationFun(activation_fun);
+}
+
+DenseLayer::DenseLayer(Layer& prev_layer, uint32_t neurons_count, ActivationFun activation_fun) : Layer() {
+	_input_shape = prev_layer.getOutputShape();
+	_output_shape = { neurons_count };
+	initWeights(_input_shape, neurons_count);
+	initActivationFun(activation_fun);
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
 void DenseLayer::setWeights(std::vector<float> weights) {
 	_weights.setValues(weights);
 }
@@ -49,6 +65,26 @@ void DenseLayer::initWeights(std::vector<uint32_t> input_shape, uint32_t neurons
 	_cached_biases_d_velocity = Tensor(_biases.getShape());
 }
 
+void DenseLayer::initActivationFun(ActivationFun activation_fun) {
+	switch (activation_fun) {
+	case ActivationFun::ReLU:
+		_activation = GemmActivation::ReLU;
+		break;
+	case ActivationFun::LeakyReLU:
+		_activation = GemmActivation::LeakyReLU;
+		break;
+	case ActivationFun::Sigmoid:
+		_activation = GemmActivation::Sigmoid;
+		break;
+	case ActivationFun::Tanh:
+		_activation = GemmActivation::Tanh;
+		break;
+	default:
+		throw std::invalid_argument(format_string("%s %d : Provided activation function can not be fused with Dense Layer. Provided value: %d",
+			__FILE__, __LINE__, activation_fun));
+	}
+}
+
 void DenseLayer::initCachedGradient() {
 	_cached_weights_d = Tensor(_weights);
 	_cached_biases_d = Tensor(_biases);
@@ -83,8 +119,22 @@ void DenseLayer::updateWeights(float learning_step, float momentum) {
 	_biases -= _cached_biases_d_velocity;
 }
 
-const Tensor DenseLayer::forwardPropagation(const Tensor& x, bool inference) {
-	Tensor x_next = _weights.dotProductTranspose(x).transpose() + _biases;
+Tensor DenseLayer::forwardPropagation(const Tensor& x, bool inference) {
+	const uint32_t batch_size = x.getShape()[0];		// b
+	const uint32_t input_size = _weights.getShape()[1];	// n
+	if (x.getSize() != batch_size * input_size) {
+		throw std::invalid_argument(format_string("%s %d : Provided input has wrong shape. Input shape=%s, weights shape=%s",
+			__FILE__, __LINE__, vector_to_string(x.getShape()).c_str(), vector_to_string(_weights.getShape()).c_str()));
+	}
+
+	// activation([b, n] * [m, n]^T + biases) = [b, m], weights^T is weights with swapped strides
+	Tensor x_next({ batch_size, _neurons_count });
+	const GemmEpilogue epilogue{ _biases.getDataPointer(), _activation };
+	gemm(batch_size, _neurons_count, input_size,
+		x.getDataPointer(), input_size, 1,
+		_weights.getDataPointer(), 1, input_size,
+		x_next.getDataPointer(), _neurons_count, false, &epilogue);
+
 	if (!inference) {
 		_cached_input = x;
 		_cached_output = x_next;
@@ -92,20 +142,36 @@ const Tensor DenseLayer::forwardPropagation(const Tensor& x, bool inference) {
 	return x_next;
 }
 
-const Tensor DenseLayer::backwardPropagation(const Tensor& dx) {
-	uint32_t n;
-	Tensor dx_prev = Tensor(dx);
-
-	n = _cached_input.getShape()[0];
-	_samples += n;
-
-	Tensor weights_d = dx.transpose().dotProductTranspose(_cached_input.transpose());
-	Tensor biases_d = dx.sum(0);
+Tensor DenseLayer::backwardPropagation(const Tensor& dx) {
+	const uint32_t batch_size = _cached_input.getShape()[0];	// b
+	const uint32_t input_size = _weights.getShape()[1];		// n
+	_samples += batch_size;
+
+	// gradient of activation and biases in one pass, without activation dx is used directly
+	Tensor dz;
+	const float* dz_data = dx.getDataPointer();
+	if (GemmActivation::None != _activation) {
+		dz = Tensor(dx.getShape());
+		gemmEpilogueBackward(batch_size, _neurons_count, _cached_output.getDataPointer(), dx.getDataPointer(), _activation,
+			dz.getDataPointer(), _cached_biases_d.getDataPointer());
+		dz_data = dz.getDataPointer();
+	}
+	else {
+		_cached_biases_d += dx.sum(0);
+	}
 
-	dx_prev = dx.dotProductTranspose(_weights.transpose());
+	// [b, m]^T * [b, n] = [m, n] added to cached gradient
+	gemm(_neurons_count, input_size, batch_size,
+		dz_data, 1, _neurons_count,
+		_cached_input.getDataPointer(), input_size, 1,
+		_cached_weights_d.getDataPointer(), input_size, true);
 
-	_cached_weights_d += weights_d;
-	_cached_biases_d += biases_d;
+	// [b, m] * [m, n] = [b, n]
+	Tensor dx_prev({ batch_size, input_size });
+	gemm(batch_size, input_size, _neurons_count,
+		dz_data, _neurons_count, 1,
+		_weights.getDataPointer(), input_size, 1,
+		dx_prev.getDataPointer(), input_size);
 
 	return dx_prev;
-}
\ No newline at end of file
+}
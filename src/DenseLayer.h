@@ -5,6 +5,8 @@
 
 #include "Utils.h"
 #include "Layer.h"
+#include "ActivationLayer.h"
+#include "Gemm.h"
 
 class DenseLayer : public Layer {
 public:
@@ -22,6 +24,24 @@ public:
 	 * @param neurons_count Neurons count in layer.
 	 */
 	DenseLayer(Layer& prev_layer, uint32_t neurons_count);
+	/**
+	 * @brief Construct a new Dense Layer with fused activation function.
+	 * Biases and activation are applied to tiles of the matrix product before they leave the cache, so the layer
+	 * replaces Dense Layer followed by Activation Layer without extra passes over the output.
+	 * 
+	 * @param input_shape Shape of input Tensor.
+	 * @param neurons_count Neurons count in layer.
+	 * @param activation_fun Activation function enum (Softmax is not supported).
+	 */
+	DenseLayer(std::vector<uint32_t> input_shape, uint32_t neurons_count, ActivationFun activation_fun);
+	/**
+	 * @brief Construct a new Dense Layer with fused activation function.
+	 * 
+	 * @param prev_layer Previous layer.
+	 * @param neurons_count Neurons count in layer.
+	 * @param activation_fun Activation function enum (Softmax is not supported).
+	 */
+	DenseLayer(Layer& prev_layer, uint32_t neurons_count, ActivationFun activation_fun);
 	
 	/**
 	 * @brief Set the layer weights.
@@ -36,8 +56,8 @@ public:
 	 */
 	void setBiases(std::vector<float> biases);
 
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum);
 	virtual void initCachedGradient();
 	virtual void summary() const;
@@ -48,6 +68,10 @@ private:
 	 * Neurons count in Layer.
 	 */
 	uint32_t _neurons_count;
+	/**
+	 * Activation function applied in the epilogue of the matrix product.
+	 */
+	GemmActivation _activation{ GemmActivation::None };
 	/**
 	 * Dense Layer weights.
 	 */
@@ -78,4 +102,10 @@ private:
 	Tensor _cached_biases_d_velocity;
 
 	void initWeights(std::vector<uint32_t> input_shape, uint32_t neurons_count);
+	/**
+	 * @brief Initializes fused activation function.
+	 * 
+	 * @param activation_fun Activation function enum.
+	 */
+	void initActivationFun(ActivationFun activation_fun);
 };
\ No newline at end of file
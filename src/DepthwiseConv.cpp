@@ -0,0 +1,251 @@
+#include "DepthwiseConv.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "BlockOps.h"
+#include "Tensor.h"
+#include "ThreadPool.h"
+
+/**
+ * Number of channels accumulated at once in local arrays.
+ */
+constexpr uint32_t DEPTHWISE_CHANNELS_BLOCK{ 16 };
+
+/**
+ * Number of pixels accumulated at once, separate accumulators of pixels hide latency of additions.
+ */
+constexpr uint32_t DEPTHWISE_PIXELS_BLOCK{ 8 };
+
+/**
+ * acc[k] += a[k] * b[k] for k in [0, count).
+ */
+static inline void multiplyAdd(const float* a, const float* b, float* acc, const uint32_t count) {
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		acc[k] += a[k] * b[k];
+	}
+}
+
+/**
+ * multiplyAdd of a block of channels (see forFullOrTailBlock).
+ */
+static inline void accumulateBlock(const float* a, const float* b, float* acc, const uint32_t count) {
+	forFullOrTailBlock<DEPTHWISE_CHANNELS_BLOCK>(count, [&](const auto n) {
+		multiplyAdd(a, b, acc, n);
+	});
+}
+
+/**
+ * Returns values of input channels of outputs [first, first + count), values[k] = pixel[(first + k) / multiplier].
+ * Input pixel is returned as it is for multiplier 1.
+ */
+static inline const float* expandChannels(const float* pixel, const uint32_t first, const uint32_t count, const uint32_t multiplier,
+	float* buffer) {
+	if (1 == multiplier) {
+		return pixel + first;
+	}
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		buffer[k] = pixel[(first + k) / multiplier];
+	}
+	return buffer;
+}
+
+/**
+ * Returns range of output positions o with input position o * stride + offset inside of [0, size).
+ */
+static void getOutputsRange(const int32_t offset, const uint32_t size, const uint32_t stride, const uint32_t output_size,
+	uint32_t& begin, uint32_t& end) {
+	const int32_t step{ static_cast<int32_t>(stride) };
+	const int32_t last{ static_cast<int32_t>(size) - 1 - offset };
+
+	begin = (offset < 0) ? static_cast<uint32_t>((step - 1 - offset) / step) : 0;
+	end = (last >= 0) ? std::min(output_size, static_cast<uint32_t>(last / step + 1)) : 0;
+	begin = std::min(begin, end);
+}
+
+void depthwiseConv(const float* x, const uint32_t batch_size, const uint32_t channels, const float* weights, const uint32_t multiplier,
+	const Conv2DGeometry& geometry, const float* biases, float* y) {
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t outputs{ channels * multiplier };
+	const uint32_t width{ geometry.width };
+	const uint32_t output_width{ geometry.output_width };
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * output_width * filter_size * filter_size * outputs };
+
+	ThreadPool::forEachTask(batch_size * geometry.output_height, size, [&](uint32_t row) {
+		const uint32_t i{ row / geometry.output_height };
+		const int32_t y_first{ static_cast<int32_t>(row % geometry.output_height * geometry.stride) - static_cast<int32_t>(geometry.padding_top) };
+
+		// filter rows [a_begin, a_end) are inside of the image
+		uint32_t a_begin, a_end;
+		geometry.getTapsRange(y_first, geometry.height, a_begin, a_end);
+
+		float acc[DEPTHWISE_PIXELS_BLOCK][DEPTHWISE_CHANNELS_BLOCK];
+		float buffer[DEPTHWISE_CHANNELS_BLOCK];
+		float* out{ y + static_cast<size_t>(row) * output_width * outputs };
+
+		for (uint32_t x_pos{ 0 }; x_pos < output_width; x_pos += DEPTHWISE_PIXELS_BLOCK) {
+			const uint32_t pixels{ std::min(DEPTHWISE_PIXELS_BLOCK, output_width - x_pos) };
+			const int32_t x_first{ static_cast<int32_t>(x_pos * geometry.stride) - static_cast<int32_t>(geometry.padding_left) };
+
+			for (uint32_t o{ 0 }; o < outputs; o += DEPTHWISE_CHANNELS_BLOCK) {
+				const uint32_t count{ std::min(DEPTHWISE_CHANNELS_BLOCK, outputs - o) };
+				for (uint32_t p{ 0 }; p < pixels; ++p) {
+					for (uint32_t k{ 0 }; k < count; ++k) {
+						acc[p][k] = (nullptr != biases) ? biases[o + k] : 0.0f;
+					}
+				}
+
+				// acc[p][k] += x[y_first + a * dilation][x_first + p * stride + b * dilation][(o + k) / multiplier] * weights[a][b][o + k]
+				for (uint32_t a{ a_begin }; a < a_end; ++a) {
+					const float* image_row{ x + (static_cast<size_t>(i) * geometry.height + y_first + a * geometry.dilation) * width * channels };
+					for (uint32_t b{ 0 }; b < filter_size; ++b) {
+						const float* tap{ weights + (a * filter_size + b) * outputs + o };
+						for (uint32_t p{ 0 }; p < pixels; ++p) {
+							const int32_t x_in{ x_first + static_cast<int32_t>(p * geometry.stride + b * geometry.dilation) };
+							if ((x_in < 0) || (x_in >= static_cast<int32_t>(width))) {
+								continue;
+							}
+							accumulateBlock(expandChannels(image_row + x_in * channels, o, count, multiplier, buffer), tap, acc[p], count);
+						}
+					}
+				}
+
+				for (uint32_t p{ 0 }; p < pixels; ++p) {
+					std::copy(acc[p], acc[p] + count, out + (x_pos + p) * outputs + o);
+				}
+			}
+		}
+	});
+}
+
+void depthwiseConvBackwardData(const float* dy, const uint32_t batch_size, const uint32_t channels, const float* weights,
+	const uint32_t multiplier, const Conv2DGeometry& geometry, float* dx) {
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t stride{ geometry.stride };
+	const uint32_t dilation{ geometry.dilation };
+	const uint32_t outputs{ channels * multiplier };
+	const uint32_t output_width{ geometry.output_width };
+
+	// packed[a][b][j][c] = weights[a][b][c][j], so filters of adjacent channels are adjacent
+	std::vector<float> packed(static_cast<size_t>(filter_size) * filter_size * outputs);
+	for (uint32_t t{ 0 }; t < filter_size * filter_size; ++t) {
+		for (uint32_t c{ 0 }; c < channels; ++c) {
+			for (uint32_t j{ 0 }; j < multiplier; ++j) {
+				packed[(t * multiplier + j) * channels + c] = weights[t * outputs + c * multiplier + j];
+			}
+		}
+	}
+
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * output_width * filter_size * filter_size * outputs };
+
+	ThreadPool::forEachTask(batch_size * geometry.height, size, [&](uint32_t row) {
+		const uint32_t i{ row / geometry.height };
+		const uint32_t y_padded{ row % geometry.height + geometry.padding_top };
+
+		// filter rows a with output row (y_padded - a * dilation) / stride inside of the output
+		thread_local std::vector<uint32_t> rows, rows_out;
+		rows.clear();
+		rows_out.clear();
+		for (uint32_t a{ 0 }; (a < filter_size) && (a * dilation <= y_padded); ++a) {
+			const uint32_t y_diff{ y_padded - a * dilation };
+			if ((0 == y_diff % stride) && (y_diff / stride < geometry.output_height)) {
+				rows.push_back(a);
+				rows_out.push_back(y_diff / stride);
+			}
+		}
+
+		float acc[DEPTHWISE_PIXELS_BLOCK][DEPTHWISE_CHANNELS_BLOCK];
+		float buffer[DEPTHWISE_CHANNELS_BLOCK];
+		float* out{ dx + static_cast<size_t>(row) * geometry.width * channels };
+
+		for (uint32_t x_first{ 0 }; x_first < geometry.width; x_first += DEPTHWISE_PIXELS_BLOCK) {
+			const uint32_t pixels{ std::min(DEPTHWISE_PIXELS_BLOCK, geometry.width - x_first) };
+
+			for (uint32_t c{ 0 }; c < channels; c += DEPTHWISE_CHANNELS_BLOCK) {
+				const uint32_t count{ std::min(DEPTHWISE_CHANNELS_BLOCK, channels - c) };
+				for (uint32_t p{ 0 }; p < pixels; ++p) {
+					std::fill(acc[p], acc[p] + count, 0.0f);
+				}
+
+				// acc[p][k] += dy[y_out][x_out][(c + k) * multiplier + j] * weights[a][b][c + k][j]
+				// for taps with x_first + p + padding_left = x_out * stride + b * dilation
+				for (uint32_t r{ 0 }; r < rows.size(); ++r) {
+					const float* dy_row{ dy + (static_cast<size_t>(i) * geometry.output_height + rows_out[r]) * output_width * outputs };
+					for (uint32_t b{ 0 }; b < filter_size; ++b) {
+						const float* tap{ packed.data() + static_cast<size_t>(rows[r] * filter_size + b) * outputs };
+						for (uint32_t p{ 0 }; p < pixels; ++p) {
+							const uint32_t x_padded{ x_first + p + geometry.padding_left };
+							if ((b * dilation > x_padded) || (0 != (x_padded - b * dilation) % stride)
+								|| ((x_padded - b * dilation) / stride >= output_width)) {
+								continue;
+							}
+							const float* dy_pixel{ dy_row + (x_padded - b * dilation) / stride * outputs };
+							for (uint32_t j{ 0 }; j < multiplier; ++j) {
+								const float* values{ dy_pixel + c };
+								if (1 != multiplier) {
+									for (uint32_t k{ 0 }; k < count; ++k) {
+										buffer[k] = dy_pixel[(c + k) * multiplier + j];
+									}
+									values = buffer;
+								}
+								accumulateBlock(values, tap + j * channels + c, acc[p], count);
+							}
+						}
+					}
+				}
+
+				for (uint32_t p{ 0 }; p < pixels; ++p) {
+					std::copy(acc[p], acc[p] + count, out + (x_first + p) * channels + c);
+				}
+			}
+		}
+	});
+}
+
+void depthwiseConvBackwardFilter(const float* x, const float* dy, const uint32_t batch_size, const uint32_t channels,
+	const uint32_t multiplier, const Conv2DGeometry& geometry, float* weights_d) {
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t outputs{ channels * multiplier };
+	const uint32_t blocks{ (outputs + DEPTHWISE_CHANNELS_BLOCK - 1) / DEPTHWISE_CHANNELS_BLOCK };
+	const uint32_t width{ geometry.width };
+	const uint32_t output_width{ geometry.output_width };
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * output_width * filter_size * filter_size * outputs };
+
+	ThreadPool::forEachTask(filter_size * filter_size * blocks, size, [&](uint32_t task) {
+		const uint32_t t{ task / blocks };
+		const uint32_t a{ t / filter_size };
+		const uint32_t b{ t % filter_size };
+		const uint32_t o{ task % blocks * DEPTHWISE_CHANNELS_BLOCK };
+		const uint32_t count{ std::min(DEPTHWISE_CHANNELS_BLOCK, outputs - o) };
+		const int32_t y_offset{ static_cast<int32_t>(a * geometry.dilation) - static_cast<int32_t>(geometry.padding_top) };
+		const int32_t x_offset{ static_cast<int32_t>(b * geometry.dilation) - static_cast<int32_t>(geometry.padding_left) };
+
+		// output pixels whose tap (a, b) is inside of the image
+		uint32_t y_begin, y_end, x_begin, x_end;
+		getOutputsRange(y_offset, geometry.height, geometry.stride, geometry.output_height, y_begin, y_end);
+		getOutputsRange(x_offset, width, geometry.stride, output_width, x_begin, x_end);
+
+		float acc[DEPTHWISE_PIXELS_BLOCK][DEPTHWISE_CHANNELS_BLOCK]{};
+		float buffer[DEPTHWISE_CHANNELS_BLOCK];
+
+		// acc[x mod pixels_block][k] += x[y * stride + y_offset][x * stride + x_offset][(o + k) / multiplier] * dy[y][x][o + k]
+		for (uint32_t i{ 0 }; i < batch_size; ++i) {
+			for (uint32_t y_out{ y_begin }; y_out < y_end; ++y_out) {
+				const float* image_row{ x + (static_cast<size_t>(i) * geometry.height + y_out * geometry.stride + y_offset) * width * channels };
+				const float* dy_row{ dy + (static_cast<size_t>(i) * geometry.output_height + y_out) * output_width * outputs };
+				for (uint32_t x_out{ x_begin }; x_out < x_end; ++x_out) {
+					const float* pixel{ image_row + (static_cast<int32_t>(x_out * geometry.stride) + x_offset) * channels };
+					accumulateBlock(expandChannels(pixel, o, count, multiplier, buffer), dy_row + x_out * outputs + o,
+						acc[x_out % DEPTHWISE_PIXELS_BLOCK], count);
+				}
+			}
+		}
+
+		float* tap_d{ weights_d + t * outputs + o };
+		for (uint32_t p{ 0 }; p < DEPTHWISE_PIXELS_BLOCK; ++p) {
+			for (uint32_t k{ 0 }; k < count; ++k) {
+				tap_d[k] += acc[p][k];
+			}
+		}
+	});
+}
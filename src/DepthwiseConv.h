@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Conv2DGeometry.h"
+
+/**
+ * @brief Depthwise convolution of NHWC images, every channel is convolved with its own multiplier filters.
+ * Output channel c * multiplier + j is channel c convolved with filter j of the channel, it equals grouped convolution
+ * with one group per channel, but costs filter_size^2 multiplications per output value instead of GEMM on tiny
+ * matrices. Blocks of channels of a pixel are accumulated in local arrays, output rows are split between threads
+ * of the global ThreadPool.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param weights Filters of shape [filter_size, filter_size, channels, multiplier].
+ * @param multiplier Number of filters per channel.
+ * @param geometry Geometry of the convolution.
+ * @param biases Biases of shape [channels * multiplier], may be nullptr.
+ * @param y Output of shape [batch_size, output_height, output_width, channels * multiplier].
+ */
+void depthwiseConv(const float* x, const uint32_t batch_size, const uint32_t channels, const float* weights, const uint32_t multiplier,
+	const Conv2DGeometry& geometry, const float* biases, float* y);
+
+/**
+ * @brief Gradient of depthwiseConv with respect to its input.
+ * Every input pixel gathers gradients of output pixels it was used by, so input rows are computed independently.
+ *
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, channels * multiplier].
+ * @param batch_size Number of images.
+ * @param channels Number of channels of the input.
+ * @param weights Filters of shape [filter_size, filter_size, channels, multiplier].
+ * @param multiplier Number of filters per channel.
+ * @param geometry Geometry of the convolution.
+ * @param dx Input gradient of shape [batch_size, height, width, channels], overwritten.
+ */
+void depthwiseConvBackwardData(const float* dy, const uint32_t batch_size, const uint32_t channels, const float* weights,
+	const uint32_t multiplier, const Conv2DGeometry& geometry, float* dx);
+
+/**
+ * @brief Gradient of depthwiseConv with respect to its filters, added to weights_d.
+ * Every task sums a block of channels of one filter tap over all pixels, so tasks never write the same values.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, channels * multiplier].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param multiplier Number of filters per channel.
+ * @param geometry Geometry of the convolution.
+ * @param weights_d Filters gradient of shape [filter_size, filter_size, channels, multiplier].
+ */
+void depthwiseConvBackwardFilter(const float* x, const float* dy, const uint32_t batch_size, const uint32_t channels,
+	const uint32_t multiplier, const Conv2DGeometry& geometry, float* weights_d);
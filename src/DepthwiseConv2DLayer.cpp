@@ -0,0 +1,156 @@
+#include "DepthwiseConv2DLayer.h"
+#include "DepthwiseConv.h"
+
+DepthwiseConv2DLayer::DepthwiseConv2DLayer(std::vector<uint32_t> input_shape, uint32_t filter_size, uint32_t stride,
+	ConvPadding padding, uint32_t dilation, uint32_t multiplier) : Layer() {
+	_input_shape = input_shape;
+	if (2 == _input_shape.size()) {
+		_input_shape.push_back(1);
+	}
+	else if (3 != _input_shape.size()) {
+		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Dim should be 3, but is %d.",
+			__FILE__, __LINE__, _input_shape.size()));
+	}
+	if (0 == multiplier) {
+		throw std::invalid_argument(format_string("%s %d : Depth multiplier should be positive.", __FILE__, __LINE__));
+	}
+	_filter_size = filter_size;
+	_stride = stride;
+	_dilation = dilation;
+	_padding = padding;
+	_multiplier = multiplier;
+	const Conv2DGeometry geometry = getGeometry(_input_shape[0], _input_shape[1]);
+	_output_shape = { geometry.output_height, geometry.output_width, _input_shape[2] * multiplier };
+	initWeights();
+}
+
+DepthwiseConv2DLayer::DepthwiseConv2DLayer(Layer& prev_layer, uint32_t filter_size, uint32_t stride,
+	ConvPadding padding, uint32_t dilation, uint32_t multiplier) : Layer() {
+	_input_shape = prev_layer.getOutputShape();
+	if (2 == _input_shape.size()) {
+		_input_shape.push_back(1);
+	}
+	else if (3 != _input_shape.size()) {
+		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Dim should be 3, but is %d.",
+			__FILE__, __LINE__, _input_shape.size()));
+	}
+	if (0 == multiplier) {
+		throw std::invalid_argument(format_string("%s %d : Depth multiplier should be positive.", __FILE__, __LINE__));
+	}
+	_filter_size = filter_size;
+	_stride = stride;
+	_dilation = dilation;
+	_padding = padding;
+	_multiplier = multiplier;
+	const Conv2DGeometry geometry = getGeometry(_input_shape[0], _input_shape[1]);
+	_output_shape = { geometry.output_height, geometry.output_width, _input_shape[2] * multiplier };
+	initWeights();
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
+void DepthwiseConv2DLayer::setWeights(std::vector<float> weights) {
+	_weights.setValues(weights);
+}
+
+void DepthwiseConv2DLayer::setBiases(std::vector<float> biases) {
+	_biases.setValues(biases);
+}
+
+Conv2DGeometry DepthwiseConv2DLayer::getGeometry(uint32_t height, uint32_t width) const {
+	return Conv2DGeometry(height, width, _filter_size, _stride, _dilation, _padding);
+}
+
+void DepthwiseConv2DLayer::initWeights() {
+	_weights = Tensor({ _filter_size, _filter_size, _input_shape[2], _multiplier });
+
+	_weights.mapInPlace([](float) { return randNormalDistribution(); });
+	_weights /= _filter_size * _filter_size;
+
+	_biases = Tensor({ _input_shape[2] * _multiplier });
+	_biases *= 0.0f;
+
+	_cached_weights_d_velocity = Tensor(_weights.getShape());
+	_cached_biases_d_velocity = Tensor(_biases.getShape());
+}
+
+void DepthwiseConv2DLayer::initCachedGradient() {
+	_cached_weights_d = Tensor(_weights);
+	_cached_biases_d = Tensor(_biases);
+	_cached_weights_d *= 0.0f;
+	_cached_biases_d *= 0.0f;
+	_samples = 0;
+}
+
+void DepthwiseConv2DLayer::summary() const {
+	printf("DepthwiseConv2D     ");
+	printf("  in shape:  (*");
+	for (uint32_t i{ 0u }; i < _input_shape.size(); ++i) {
+		printf(", %d", _input_shape[i]);
+	}
+	printf(")  ");
+	printf("  out shape: (*");
+	for (uint32_t i { 0u }; i < _output_shape.size(); ++i) {
+		printf(", %d", _output_shape[i]);
+	}
+	printf(")  total params: %d\n", _weights.getSize() + _biases.getSize());
+}
+
+uint32_t DepthwiseConv2DLayer::getParamsCount() const {
+	return _weights.getSize() + _biases.getSize();
+}
+
+void DepthwiseConv2DLayer::updateWeights(float learning_step, float momentum) {
+	_cached_weights_d_velocity = (_cached_weights_d * learning_step / _samples) + momentum * _cached_weights_d_velocity;
+	_cached_biases_d_velocity = (_cached_biases_d * learning_step / _samples) + momentum * _cached_biases_d_velocity;
+
+	_weights -= _cached_weights_d_velocity;
+	_biases -= _cached_biases_d_velocity;
+}
+
+Tensor DepthwiseConv2DLayer::forwardPropagation(const Tensor& x, bool inference) {
+	uint32_t batch_size = x.getShape()[0]; 	// b
+	uint32_t height = x.getShape()[1];		// h
+	uint32_t width = x.getShape()[2];		// w
+	uint32_t channels = x.getShape()[3];	// c
+
+	const Conv2DGeometry geometry = getGeometry(height, width);
+
+	// [b, h, w, c] * [s, s, c, m] = [b, oh, ow, cm]
+	Tensor x_next({ batch_size, geometry.output_height, geometry.output_width, channels * _multiplier });
+	depthwiseConv(x.getDataPointer(), batch_size, channels, _weights.getDataPointer(), _multiplier, geometry,
+		_biases.getDataPointer(), x_next.getDataPointer());
+
+	if (!inference)
+	{
+		_cached_input = x;
+		_cached_output = x_next;
+	}
+
+	return x_next;
+}
+
+Tensor DepthwiseConv2DLayer::backwardPropagation(const Tensor& dx) {
+	_samples += _cached_input.getShape()[0];
+
+	uint32_t batch_size = _cached_input.getShape()[0];	// b
+	uint32_t height = _cached_input.getShape()[1];		// h
+	uint32_t width = _cached_input.getShape()[2];		// w
+	uint32_t channels = _cached_input.getShape()[3];	// c
+
+	const Conv2DGeometry geometry = getGeometry(height, width);
+	const uint32_t outputs = channels * _multiplier;
+
+	const TensorView dx_flat = dx.view().reshape({ batch_size * geometry.output_height * geometry.output_width, outputs });
+	Tensor biases_d = Tensor(dx_flat).sum(0);
+	_cached_biases_d += biases_d;
+
+	depthwiseConvBackwardFilter(_cached_input.getDataPointer(), dx.getDataPointer(), batch_size, channels, _multiplier, geometry,
+		_cached_weights_d.getDataPointer());
+
+	Tensor dx_prev({ batch_size, height, width, channels });
+	depthwiseConvBackwardData(dx.getDataPointer(), batch_size, channels, _weights.getDataPointer(), _multiplier, geometry,
+		dx_prev.getDataPointer());
+
+	return dx_prev;
+}
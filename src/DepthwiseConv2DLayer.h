@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Conv2DGeometry.h"
+#include "Utils.h"
+#include "Layer.h"
+
+/**
+ * @brief Depthwise 2D convolution, every channel is convolved with its own filters.
+ * Depthwise-separable convolution is this layer followed by a 1x1 Conv2DLayer.
+ */
+class DepthwiseConv2DLayer : public Layer {
+public:
+	/**
+	 * @brief Construct a new Depthwise Conv2D Layer.
+	 *
+	 * @param input_shape Shape of input Tensor.
+	 * @param filter_size Convolution filters size.
+	 * @param stride Step between positions of filters, outputs are computed only at these positions.
+	 * @param padding Padding mode, Same keeps ceil(size / stride) outputs, Valid uses only filters inside of the input.
+	 * @param dilation Step between filter taps.
+	 * @param multiplier Number of filters per channel, the output has channels * multiplier channels.
+	 */
+	DepthwiseConv2DLayer(std::vector<uint32_t> input_shape, uint32_t filter_size, uint32_t stride=1,
+		ConvPadding padding=ConvPadding::Same, uint32_t dilation=1, uint32_t multiplier=1);
+	/**
+	 * @brief Construct a new Depthwise Conv2D Layer.
+	 *
+	 * @param prev_layer Previous layer.
+	 * @param filter_size Convolution filters size.
+	 * @param stride Step between positions of filters, outputs are computed only at these positions.
+	 * @param padding Padding mode, Same keeps ceil(size / stride) outputs, Valid uses only filters inside of the input.
+	 * @param dilation Step between filter taps.
+	 * @param multiplier Number of filters per channel, the output has channels * multiplier channels.
+	 */
+	DepthwiseConv2DLayer(Layer& prev_layer, uint32_t filter_size, uint32_t stride=1,
+		ConvPadding padding=ConvPadding::Same, uint32_t dilation=1, uint32_t multiplier=1);
+
+	/**
+	 * @brief Set the layer weights.
+	 *
+	 * @param weights Weights values to be set, of shape [filter_size, filter_size, channels, multiplier].
+	 */
+	void setWeights(std::vector<float> weights);
+	/**
+	 * @brief Set the layer biases.
+	 *
+	 * @param biases Biases values to be set.
+	 */
+	void setBiases(std::vector<float> biases);
+
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
+	virtual void updateWeights(float learning_step, float momentum);
+	virtual void initCachedGradient();
+	virtual void summary() const;
+	virtual uint32_t getParamsCount() const;
+
+private:
+	/**
+	 * Size of the convolution filters.
+	 */
+	uint32_t _filter_size;
+	/**
+	 * Step between positions of the convolution filters.
+	 */
+	uint32_t _stride;
+	/**
+	 * Step between taps of the convolution filters.
+	 */
+	uint32_t _dilation;
+	/**
+	 * Padding mode of the convolution input.
+	 */
+	ConvPadding _padding;
+	/**
+	 * Number of filters per channel.
+	 */
+	uint32_t _multiplier;
+	/**
+	 * Convolution weights.
+	 */
+	Tensor _weights;
+	/**
+	 * Convolution biases.
+	 */
+	Tensor _biases;
+	/**
+	 * Number of cached samples.
+	 */
+	uint32_t _samples;
+	/**
+	 * Cached gradient of weights.
+	 */
+	Tensor _cached_weights_d;
+	/**
+	 * Cached gradient velocity of weights.
+	 */
+	Tensor _cached_weights_d_velocity;
+	/**
+	 * Cached biases of weights.
+	 */
+	Tensor _cached_biases_d;
+	/**
+	 * Cached biases velocity of weights.
+	 */
+	Tensor _cached_biases_d_velocity;
+
+	/**
+	 * @brief Initializes convolution weights and biases.
+	 */
+	void initWeights();
+	/**
+	 * @brief Returns geometry of the convolution of input images of given size.
+	 *
+	 * @param height Height of input images.
+	 * @param width Width of input images.
+	 * @return Convolution geometry.
+	 */
+	Conv2DGeometry getGeometry(uint32_t height, uint32_t width) const;
+};
@@ -0,0 +1,324 @@
+#include "DirectConv.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Gemm.h"
+#include "Im2col.h"
+#include "Tensor.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+/**
+ * Upper bound of mr * nr of all GEMM micro-kernels, used for output tiles.
+ */
+constexpr uint32_t DIRECT_CONV_MAX_TILE{ 512 };
+
+/**
+ * Number of output pixels whose patches are packed at once for the filters gradient.
+ */
+constexpr uint32_t DIRECT_CONV_FILTER_PIXELS{ 256 };
+
+/**
+ * Packs filters [filter_size, filter_size, channels, filters_count] into panels of mr filters,
+ * panel f stores filter_size * filter_size * channels rows of mr values (filters past filters_count are zeros).
+ * Rows of weights are row_stride apart, so filters of a single group can be packed.
+ */
+static void packFilters(const float* weights, const uint32_t taps, const uint32_t filters_count, const uint32_t row_stride, const uint32_t mr,
+	float* packed) {
+	const uint32_t panels{ (filters_count + mr - 1) / mr };
+	std::fill(packed, packed + static_cast<size_t>(panels) * taps * mr, 0.0f);
+
+	for (uint32_t f{ 0 }; f < panels; ++f) {
+		const uint32_t filters{ std::min(mr, filters_count - f * mr) };
+		float* panel{ packed + static_cast<size_t>(f) * taps * mr };
+		for (uint32_t t{ 0 }; t < taps; ++t) {
+			std::memcpy(panel + t * mr, weights + t * row_stride + f * mr, sizeof(float) * filters);
+		}
+	}
+}
+
+/**
+ * Packs filters of every group with packFilters, panels of group g start at g * packedGroupSize.
+ */
+static size_t packedGroupSize(const uint32_t taps, const uint32_t filters_count, const uint32_t mr) {
+	return static_cast<size_t>((filters_count + mr - 1) / mr) * taps * mr;
+}
+
+/**
+ * Convolution with filters packed by packFilters. Every task computes one output row: patches of nr adjacent pixels
+ * are packed (with zeros outside of the image) as rows [a_begin, a_end) of the filter, multiplied by filter panels
+ * with the GEMM micro-kernel into [mr filters, nr pixels] tiles kept in registers and stored transposed into NHWC output.
+ * Patches and filters of groups are packed and multiplied separately.
+ */
+static void convolvePacked(const float* x, const uint32_t batch_size, const uint32_t channels, const float* packed_filters,
+	const uint32_t filters_count, const uint32_t groups, const Conv2DGeometry& geometry, const float* biases, float* y) {
+	const TensorKernels& kernels{ getKernels() };
+	const uint32_t mr{ kernels.gemm_mr };
+	const uint32_t nr{ kernels.gemm_nr };
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t group_channels{ channels / groups };
+	const uint32_t group_filters{ filters_count / groups };
+	const uint32_t row_taps{ filter_size * group_channels };
+	const uint32_t taps{ filter_size * row_taps };
+	const size_t group_size{ packedGroupSize(taps, group_filters, mr) };
+	const uint32_t width{ geometry.width };
+	const uint32_t output_width{ geometry.output_width };
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * output_width * taps * groups };
+
+	ThreadPool::forEachTask(batch_size * geometry.output_height, size, [&](uint32_t row) {
+		const uint32_t i{ row / geometry.output_height };
+		const int32_t y_first{ static_cast<int32_t>(row % geometry.output_height * geometry.stride) - static_cast<int32_t>(geometry.padding_top) };
+
+		// filter rows [a_begin, a_end) are inside of the image
+		uint32_t a_begin, a_end;
+		geometry.getTapsRange(y_first, geometry.height, a_begin, a_end);
+		const uint32_t k{ (a_end - a_begin) * row_taps };
+
+		thread_local std::vector<float> patches;
+		patches.resize(static_cast<size_t>(taps) * nr);
+		float tile[DIRECT_CONV_MAX_TILE];
+		float* out{ y + static_cast<size_t>(row) * output_width * filters_count };
+
+		for (uint32_t x_pos{ 0 }; x_pos < output_width; x_pos += nr) {
+			const uint32_t pixels{ std::min(nr, output_width - x_pos) };
+
+			for (uint32_t g{ 0 }; g < groups; ++g) {
+				// patches[(a * s + b) * c + c_in][j] = x[y_first + a * dilation][(x + j) * stride + b * dilation - padding][g * c + c_in]
+				float* patch_row{ patches.data() };
+				for (uint32_t a{ a_begin }; a < a_end; ++a) {
+					const float* image_row{ x + (static_cast<size_t>(i) * geometry.height + y_first + a * geometry.dilation) * width * channels
+						+ g * group_channels };
+					for (uint32_t b{ 0 }; b < filter_size; ++b) {
+						std::fill(patch_row, patch_row + group_channels * nr, 0.0f);
+						for (uint32_t j{ 0 }; j < pixels; ++j) {
+							const int32_t x_in{ static_cast<int32_t>((x_pos + j) * geometry.stride + b * geometry.dilation) - static_cast<int32_t>(geometry.padding_left) };
+							if ((x_in < 0) || (x_in >= static_cast<int32_t>(width))) {
+								continue;
+							}
+							const float* pixel{ image_row + x_in * channels };
+							for (uint32_t c{ 0 }; c < group_channels; ++c) {
+								patch_row[c * nr + j] = pixel[c];
+							}
+						}
+						patch_row += group_channels * nr;
+					}
+				}
+
+				const float* group_packed{ packed_filters + g * group_size };
+				for (uint32_t f{ 0 }; f < group_filters; f += mr) {
+					const uint32_t filters{ std::min(mr, group_filters - f) };
+					const uint32_t first_filter{ g * group_filters + f };
+					for (uint32_t p{ 0 }; p < mr; ++p) {
+						std::fill(tile + p * nr, tile + (p + 1) * nr, (p < filters && nullptr != biases) ? biases[first_filter + p] : 0.0f);
+					}
+
+					kernels.gemm_micro_kernel(k, group_packed + (static_cast<size_t>(f) * taps + a_begin * row_taps * mr), patches.data(), tile, nr);
+
+					for (uint32_t j{ 0 }; j < pixels; ++j) {
+						float* out_pixel{ out + (x_pos + j) * filters_count + first_filter };
+						for (uint32_t p{ 0 }; p < filters; ++p) {
+							out_pixel[p] = tile[p * nr + j];
+						}
+					}
+				}
+			}
+		}
+	});
+}
+
+void directConv(const float* x, const uint32_t batch_size, const uint32_t channels, const float* weights, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, const float* biases, float* y, const uint32_t groups) {
+	const uint32_t mr{ getKernels().gemm_mr };
+	const uint32_t group_filters{ filters_count / groups };
+	const uint32_t taps{ geometry.filter_size * geometry.filter_size * (channels / groups) };
+	const size_t group_size{ packedGroupSize(taps, group_filters, mr) };
+
+	std::vector<float> packed_filters(group_size * groups);
+	for (uint32_t g{ 0 }; g < groups; ++g) {
+		packFilters(weights + g * group_filters, taps, group_filters, filters_count, mr, packed_filters.data() + g * group_size);
+	}
+
+	convolvePacked(x, batch_size, channels, packed_filters.data(), filters_count, groups, geometry, biases, y);
+}
+
+/**
+ * Filter taps contributing to input pixels of one phase, rows a with a * dilation = phase_y (mod stride) and columns b
+ * with b * dilation = phase_x (mod stride). Filters of every group are packed by packFilters as [rows, cols, filters]
+ * taps of channels outputs.
+ */
+struct TransposedPhase {
+	std::vector<uint32_t> rows;
+	std::vector<uint32_t> cols;
+	std::vector<float> packed;
+};
+
+void directConvBackwardData(const float* dy, const uint32_t batch_size, const uint32_t channels, const float* weights, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, float* dx, const uint32_t groups) {
+	const TensorKernels& kernels{ getKernels() };
+	const uint32_t mr{ kernels.gemm_mr };
+	const uint32_t nr{ kernels.gemm_nr };
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t stride{ geometry.stride };
+	const uint32_t dilation{ geometry.dilation };
+	const uint32_t output_width{ geometry.output_width };
+	const uint32_t group_channels{ channels / groups };
+	const uint32_t group_filters{ filters_count / groups };
+
+	std::vector<TransposedPhase> phases(stride * stride);
+	std::vector<float> transposed;
+	for (uint32_t phase_y{ 0 }; phase_y < stride; ++phase_y) {
+		for (uint32_t phase_x{ 0 }; phase_x < stride; ++phase_x) {
+			TransposedPhase& phase{ phases[phase_y * stride + phase_x] };
+			for (uint32_t t{ 0 }; t < filter_size; ++t) {
+				if (t * dilation % stride == phase_y) {
+					phase.rows.push_back(t);
+				}
+				if (t * dilation % stride == phase_x) {
+					phase.cols.push_back(t);
+				}
+			}
+
+			const uint32_t taps{ static_cast<uint32_t>(phase.rows.size() * phase.cols.size()) * group_filters };
+			const size_t group_size{ packedGroupSize(taps, group_channels, mr) };
+			transposed.resize(static_cast<size_t>(taps) * group_channels);
+			phase.packed.resize(group_size * groups);
+
+			for (uint32_t g{ 0 }; g < groups; ++g) {
+				// transposed[(row, col, f)][c] = weights[a][b][c][g * filters + f]
+				float* dst{ transposed.data() };
+				for (const uint32_t a : phase.rows) {
+					for (const uint32_t b : phase.cols) {
+						const float* src{ weights + (a * filter_size + b) * group_channels * filters_count + g * group_filters };
+						for (uint32_t f{ 0 }; f < group_filters; ++f) {
+							for (uint32_t c{ 0 }; c < group_channels; ++c) {
+								dst[f * group_channels + c] = src[c * filters_count + f];
+							}
+						}
+						dst += group_filters * group_channels;
+					}
+				}
+				packFilters(transposed.data(), taps, group_channels, group_channels, mr, phase.packed.data() + g * group_size);
+			}
+		}
+	}
+
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * output_width * filter_size * filter_size * filters_count };
+
+	ThreadPool::forEachTask(batch_size * geometry.height, size, [&](uint32_t row) {
+		const uint32_t i{ row / geometry.height };
+		const uint32_t y_padded{ row % geometry.height + geometry.padding_top };
+		const TransposedPhase* phase_row{ phases.data() + (y_padded % stride) * stride };
+		const std::vector<uint32_t>& rows{ phase_row->rows };
+
+		// filter rows [r_begin, r_end) of the phase have output row (y_padded - a * dilation) / stride inside of the output
+		uint32_t r_begin{ 0 };
+		while ((r_begin < rows.size()) && (rows[r_begin] * dilation <= y_padded)
+			&& ((y_padded - rows[r_begin] * dilation) / stride >= geometry.output_height)) {
+			++r_begin;
+		}
+		uint32_t r_end{ r_begin };
+		while ((r_end < rows.size()) && (rows[r_end] * dilation <= y_padded)) {
+			++r_end;
+		}
+
+		thread_local std::vector<float> patches;
+		patches.resize(static_cast<size_t>(filter_size) * filter_size * group_filters * nr);
+		float tile[DIRECT_CONV_MAX_TILE];
+		float* out{ dx + static_cast<size_t>(row) * geometry.width * channels };
+
+		for (uint32_t phase_x{ 0 }; phase_x < stride; ++phase_x) {
+			const TransposedPhase& phase{ phase_row[phase_x] };
+			const uint32_t cols_count{ static_cast<uint32_t>(phase.cols.size()) };
+			const uint32_t taps{ static_cast<uint32_t>(rows.size()) * cols_count * group_filters };
+			const size_t group_size{ packedGroupSize(taps, group_channels, mr) };
+			const uint32_t k{ (r_end - r_begin) * cols_count * group_filters };
+
+			// input columns x with (x + padding_left) mod stride = phase_x
+			const uint32_t x_begin{ (phase_x + stride - geometry.padding_left % stride) % stride };
+			for (uint32_t x_first{ x_begin }; x_first < geometry.width; x_first += nr * stride) {
+				const uint32_t pixels{ std::min(nr, (geometry.width - x_first + stride - 1) / stride) };
+
+				for (uint32_t g{ 0 }; g < groups; ++g) {
+					// patches[(row, col, f)][j] = dy[(y_padded - a * dilation) / stride][(x_j + padding - b * dilation) / stride][g * filters + f]
+					float* patch_row{ patches.data() };
+					for (uint32_t r{ r_begin }; r < r_end; ++r) {
+						const uint32_t y_out{ (y_padded - rows[r] * dilation) / stride };
+						const float* dy_row{ dy + (static_cast<size_t>(i) * geometry.output_height + y_out) * output_width * filters_count
+							+ g * group_filters };
+						for (const uint32_t b : phase.cols) {
+							std::fill(patch_row, patch_row + group_filters * nr, 0.0f);
+							for (uint32_t j{ 0 }; j < pixels; ++j) {
+								const int32_t x_padded{ static_cast<int32_t>(x_first + j * stride + geometry.padding_left) - static_cast<int32_t>(b * dilation) };
+								const uint32_t x_out{ static_cast<uint32_t>(x_padded) / stride };
+								if ((x_padded < 0) || (x_out >= output_width)) {
+									continue;
+								}
+								const float* pixel{ dy_row + x_out * filters_count };
+								for (uint32_t f{ 0 }; f < group_filters; ++f) {
+									patch_row[f * nr + j] = pixel[f];
+								}
+							}
+							patch_row += group_filters * nr;
+						}
+					}
+
+					const float* group_packed{ phase.packed.data() + g * group_size };
+					for (uint32_t c{ 0 }; c < group_channels; c += mr) {
+						const uint32_t outputs{ std::min(mr, group_channels - c) };
+						std::fill(tile, tile + mr * nr, 0.0f);
+
+						kernels.gemm_micro_kernel(k, group_packed + (static_cast<size_t>(c) * taps + r_begin * cols_count * group_filters * mr),
+							patches.data(), tile, nr);
+
+						for (uint32_t j{ 0 }; j < pixels; ++j) {
+							float* out_pixel{ out + (x_first + j * stride) * channels + g * group_channels + c };
+							for (uint32_t p{ 0 }; p < outputs; ++p) {
+								out_pixel[p] = tile[p * nr + j];
+							}
+						}
+					}
+				}
+			}
+		}
+	});
+}
+
+void directConvBackwardFilter(const float* x, const float* dy, const uint32_t batch_size, const uint32_t channels, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, float* weights_d, const uint32_t groups) {
+	const uint32_t filter_taps{ geometry.filter_size * geometry.filter_size };
+	const uint32_t taps{ filter_taps * channels };
+	const uint32_t group_channels{ channels / groups };
+	const uint32_t group_filters{ filters_count / groups };
+	const uint32_t rows{ batch_size * geometry.output_height };
+	const uint32_t rows_block{ std::max(1u, DIRECT_CONV_FILTER_PIXELS / geometry.output_width) };
+	std::vector<float> patches(static_cast<size_t>(rows_block) * geometry.output_width * taps);
+
+	// weights_d += patches^T * dy, [taps, pixels] * [pixels, f] summed over blocks of output rows
+	for (uint32_t first_row{ 0 }; first_row < rows; first_row += rows_block) {
+		const uint32_t rows_count{ std::min(rows_block, rows - first_row) };
+		const uint32_t pixels{ rows_count * geometry.output_width };
+		const float* dy_block{ dy + static_cast<size_t>(first_row) * geometry.output_width * filters_count };
+
+		im2colRows(x, channels, geometry, first_row, rows_count, patches.data());
+
+		if (1 == groups) {
+			gemm(taps, filters_count, pixels,
+				patches.data(), 1, taps,
+				dy_block, filters_count, 1,
+				weights_d, filters_count, true);
+			continue;
+		}
+
+		// channels of a group are not adjacent in patches, so every filter tap of every group is multiplied separately
+		for (uint32_t t{ 0 }; t < filter_taps; ++t) {
+			for (uint32_t g{ 0 }; g < groups; ++g) {
+				gemm(group_channels, group_filters, pixels,
+					patches.data() + t * channels + g * group_channels, 1, taps,
+					dy_block + g * group_filters, filters_count, 1,
+					weights_d + t * group_channels * filters_count + g * group_filters, filters_count, true);
+			}
+		}
+	}
+}
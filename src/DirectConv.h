@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Conv2DGeometry.h"
+
+/**
+ * @brief Convolution of NHWC images computed directly from the input, without a patch matrix.
+ * Patches of a few adjacent output pixels are packed on the fly and multiplied by the GEMM micro-kernel of the active
+ * kernel set (see TensorKernels.h), so blocks of output pixels and filters are accumulated in registers without a patch
+ * matrix of the whole input. Only output pixels of the geometry are computed, so cost of strided convolutions drops
+ * with stride^2. Output rows are split between threads of the global ThreadPool.
+ * Grouped convolution splits channels and filters into groups, filters of a group see only channels of the same group.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param weights Filters of shape [filter_size, filter_size, channels / groups, filters_count].
+ * @param filters_count Number of filters.
+ * @param geometry Geometry of the convolution.
+ * @param biases Biases of shape [filters_count], may be nullptr.
+ * @param y Output of shape [batch_size, output_height, output_width, filters_count].
+ * @param groups Number of groups, divides channels and filters_count.
+ */
+void directConv(const float* x, const uint32_t batch_size, const uint32_t channels, const float* weights, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, const float* biases, float* y, const uint32_t groups=1);
+
+/**
+ * @brief Gradient of directConv with respect to its input.
+ * Input pixel gets gradients only from filter taps t with (pixel + padding - t * dilation) divisible by stride, so pixels
+ * are split into stride^2 phases of (position + padding) mod stride. Pixels of one phase row are convolved with filters
+ * repacked to taps of the phase, no zeros are inserted between gradient pixels and the cost equals the cost of directConv.
+ *
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, filters_count].
+ * @param batch_size Number of images.
+ * @param channels Number of channels of the input.
+ * @param weights Filters of shape [filter_size, filter_size, channels / groups, filters_count].
+ * @param filters_count Number of filters.
+ * @param geometry Geometry of the convolution.
+ * @param dx Input gradient of shape [batch_size, height, width, channels], overwritten.
+ * @param groups Number of groups used by directConv.
+ */
+void directConvBackwardData(const float* dy, const uint32_t batch_size, const uint32_t channels, const float* weights, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, float* dx, const uint32_t groups=1);
+
+/**
+ * @brief Gradient of directConv with respect to its filters, added to weights_d.
+ * Patches of a few output rows at a time are packed with im2colRows into a small buffer that stays in cache and
+ * multiplied by the output gradient with gemm, so the patch matrix of the whole input is never built.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, filters_count].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param filters_count Number of filters.
+ * @param geometry Geometry of the convolution.
+ * @param weights_d Filters gradient of shape [filter_size, filter_size, channels / groups, filters_count].
+ * @param groups Number of groups used by directConv.
+ */
+void directConvBackwardFilter(const float* x, const float* dy, const uint32_t batch_size, const uint32_t channels, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, float* weights_d, const uint32_t groups=1);
@@ -23,12 +23,11 @@ DropoutLayer::DropoutLayer(Layer& prev_layer, float rate) : _rate(rate) {
 	prev_layer.setNextLayer(this);
 }
 
-const Tensor DropoutLayer::forwardPropagation(const Tensor& x, bool inference) {
+Tensor DropoutLayer::forwardPropagation(const Tensor& x, bool inference) {
     Tensor x_next = x;
     if (!inference) {
-        Tensor mask = x.applyFunction([] (float) { return (static_cast <float> (rand()) / static_cast <float> (RAND_MAX)); });
-        mask = mask > _rate;
-        x_next *= mask;
+        const float rate{ _rate };
+        x_next.mapInPlace([rate](float value) { return randUniform(0.0f, 1.0f) > rate ? value : 0.0f; });
 
         _cached_input = x;
         _cached_output = x_next;
@@ -37,7 +36,7 @@ const Tensor DropoutLayer::forwardPropagation(const Tensor& x, bool inference) {
 	return x_next;
 }
 
-const Tensor DropoutLayer::backwardPropagation(const Tensor& dx) {
+Tensor DropoutLayer::backwardPropagation(const Tensor& dx) {
 	return dx * (_cached_output > 0.0f);
 }
 
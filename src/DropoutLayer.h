@@ -6,6 +6,11 @@
 
 #include "Layer.h"
 
+/**
+ * @brief Zeroes values of the input with probability equal to the dropout rate during training.
+ * The mask is sampled with randUniform (see Utils.h), whose generators are thread_local and seeded from
+ * std::random_device, so srand() does not seed dropout and masks are not reproducible between runs.
+ */
 class DropoutLayer : public Layer {
 public:
 	/**
@@ -23,8 +28,8 @@ public:
 	 */
 	DropoutLayer(Layer& prev_layer, float rate);
 
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum) { };
 	virtual void initCachedGradient() { };
 	virtual void summary() const;
@@ -0,0 +1,122 @@
+#include "FFT.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+#include "Utils.h"
+
+FFT::FFT(uint32_t size) : _size{ size } {
+	if ((0 == size) || !std::has_single_bit(size)) {
+		throw std::invalid_argument(format_string("%s %d : FFT size should be a power of two, but is %d.",
+			__FILE__, __LINE__, size));
+	}
+
+	const uint32_t bits{ static_cast<uint32_t>(std::countr_zero(size)) };
+	_bit_reverse.resize(size);
+	for (uint32_t i{ 0 }; i < size; ++i) {
+		uint32_t reversed{ 0 };
+		for (uint32_t bit{ 0 }; bit < bits; ++bit) {
+			reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+		}
+		_bit_reverse[i] = reversed;
+	}
+
+	_cos.resize(size / 2);
+	_sin.resize(size / 2);
+	for (uint32_t k{ 0 }; k < size / 2; ++k) {
+		const double angle{ -2.0 * std::numbers::pi * k / size };
+		_cos[k] = static_cast<float>(cos(angle));
+		_sin[k] = static_cast<float>(sin(angle));
+	}
+}
+
+void FFT::forward(float* re, float* im) const {
+	transform(re, im, 1.0f);
+}
+
+void FFT::inverse(float* re, float* im) const {
+	transform(re, im, -1.0f);
+}
+
+void FFT::forward(float* re, float* im, uint32_t count) const {
+	transform(re, im, count, 1.0f);
+}
+
+void FFT::inverse(float* re, float* im, uint32_t count) const {
+	transform(re, im, count, -1.0f);
+}
+
+uint32_t FFT::getSize() const {
+	return _size;
+}
+
+uint32_t FFT::transformSize(uint32_t size) {
+	return std::bit_ceil(std::max(size, 1u));
+}
+
+void FFT::transform(float* re, float* im, const float sign) const {
+	for (uint32_t i{ 0 }; i < _size; ++i) {
+		const uint32_t j{ _bit_reverse[i] };
+		if (i < j) {
+			std::swap(re[i], re[j]);
+			std::swap(im[i], im[j]);
+		}
+	}
+
+	// butterflies of length 2 * half, twiddle factors of the length are every step-th factor of the full size
+	for (uint32_t half{ 1 }; half < _size; half *= 2) {
+		const uint32_t step{ _size / (2 * half) };
+		for (uint32_t begin{ 0 }; begin < _size; begin += 2 * half) {
+			float* re_even{ re + begin };
+			float* im_even{ im + begin };
+			float* re_odd{ re + begin + half };
+			float* im_odd{ im + begin + half };
+			for (uint32_t k{ 0 }; k < half; ++k) {
+				const float w_re{ _cos[k * step] };
+				const float w_im{ sign * _sin[k * step] };
+				const float t_re{ re_odd[k] * w_re - im_odd[k] * w_im };
+				const float t_im{ re_odd[k] * w_im + im_odd[k] * w_re };
+				re_odd[k] = re_even[k] - t_re;
+				im_odd[k] = im_even[k] - t_im;
+				re_even[k] += t_re;
+				im_even[k] += t_im;
+			}
+		}
+	}
+}
+
+void FFT::transform(float* re, float* im, const uint32_t count, const float sign) const {
+	for (uint32_t i{ 0 }; i < _size; ++i) {
+		const uint32_t j{ _bit_reverse[i] };
+		if (i < j) {
+			std::swap_ranges(re + i * count, re + (i + 1) * count, re + j * count);
+			std::swap_ranges(im + i * count, im + (i + 1) * count, im + j * count);
+		}
+	}
+
+	for (uint32_t half{ 1 }; half < _size; half *= 2) {
+		const uint32_t step{ _size / (2 * half) };
+		for (uint32_t begin{ 0 }; begin < _size; begin += 2 * half) {
+			for (uint32_t k{ 0 }; k < half; ++k) {
+				const float w_re{ _cos[k * step] };
+				const float w_im{ sign * _sin[k * step] };
+				float* re_even{ re + (begin + k) * count };
+				float* im_even{ im + (begin + k) * count };
+				float* re_odd{ re + (begin + half + k) * count };
+				float* im_odd{ im + (begin + half + k) * count };
+				for (uint32_t j{ 0 }; j < count; ++j) {
+					const float t_re{ re_odd[j] * w_re - im_odd[j] * w_im };
+					const float t_im{ re_odd[j] * w_im + im_odd[j] * w_re };
+					re_odd[j] = re_even[j] - t_re;
+					im_odd[j] = im_even[j] - t_im;
+					re_even[j] += t_re;
+					im_even[j] += t_im;
+				}
+			}
+		}
+	}
+}
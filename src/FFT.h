@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Radix-2 complex fast Fourier transform of a fixed power of two size.
+ * Values are given as separate arrays of real and imaginary parts, so loops over them are vectorized.
+ * Bit reversal permutation and twiddle factors are computed once in the constructor.
+ */
+class FFT {
+public:
+	/**
+	 * @brief Construct a new FFT object.
+	 *
+	 * @param size Size of transforms, must be a power of two.
+	 */
+	explicit FFT(uint32_t size);
+
+	/**
+	 * @brief In-place forward transform X_k = sum_n x_n e^(-2 pi i k n / size).
+	 *
+	 * @param re Real parts of size values.
+	 * @param im Imaginary parts of size values.
+	 */
+	void forward(float* re, float* im) const;
+	/**
+	 * @brief In-place inverse transform x_n = sum_k X_k e^(2 pi i k n / size), the result is not divided by size.
+	 *
+	 * @param re Real parts of size values.
+	 * @param im Imaginary parts of size values.
+	 */
+	void inverse(float* re, float* im) const;
+
+	/**
+	 * @brief In-place forward transforms of count interleaved sequences, value n of sequence j is at index n * count + j.
+	 * Butterflies are applied to whole rows of count values, so columns of 2D arrays are transformed without copying.
+	 *
+	 * @param re Real parts of size * count values.
+	 * @param im Imaginary parts of size * count values.
+	 * @param count Number of sequences.
+	 */
+	void forward(float* re, float* im, uint32_t count) const;
+	/**
+	 * @brief In-place inverse transforms of count interleaved sequences, results are not divided by size.
+	 *
+	 * @param re Real parts of size * count values.
+	 * @param im Imaginary parts of size * count values.
+	 * @param count Number of sequences.
+	 */
+	void inverse(float* re, float* im, uint32_t count) const;
+
+	/**
+	 * @brief Get the size of transforms.
+	 *
+	 * @return Size.
+	 */
+	uint32_t getSize() const;
+
+	/**
+	 * @brief Returns the smallest power of two not less than size.
+	 *
+	 * @param size Minimal size.
+	 * @return Size of transform.
+	 */
+	static uint32_t transformSize(uint32_t size);
+
+private:
+	uint32_t _size;
+	std::vector<uint32_t> _bit_reverse;
+	/**
+	 * Twiddle factors e^(-2 pi i k / size) for k in [0, size / 2).
+	 */
+	std::vector<float> _cos;
+	std::vector<float> _sin;
+
+	void transform(float* re, float* im, const float sign) const;
+	void transform(float* re, float* im, const uint32_t count, const float sign) const;
+};
@@ -0,0 +1,245 @@
+#include "FFTConv.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "FFT.h"
+#include "Tensor.h"
+#include "ThreadPool.h"
+
+/**
+ * 2D FFT of real [rows, cols] images padded with zeros to [fft_rows, fft_cols]. Spectra are stored as
+ * [fft_rows, fft_cols / 2 + 1] arrays of real and imaginary parts, the other columns follow from Hermitian symmetry.
+ * Pairs of real rows are transformed with a single complex FFT.
+ */
+class RealFFT2D {
+public:
+	RealFFT2D(uint32_t rows, uint32_t cols, uint32_t fft_rows, uint32_t fft_cols)
+		: _rows{ rows }, _cols{ cols }, _fft_rows{ fft_rows }, _fft_cols{ fft_cols }, _spectrum_cols{ fft_cols / 2 + 1 },
+		_rows_fft{ fft_rows }, _cols_fft{ fft_cols },
+		_row_re(fft_cols), _row_im(fft_cols) {}
+
+	/**
+	 * Transforms image with value (r, c) at x[r * row_stride + c * col_stride].
+	 */
+	void forward(const float* x, const uint32_t row_stride, const uint32_t col_stride, float* re, float* im) {
+		for (uint32_t r{ 0 }; r < _fft_rows; r += 2) {
+			float* re_a{ re + r * _spectrum_cols };
+			float* im_a{ im + r * _spectrum_cols };
+			const bool has_b{ r + 1 < _fft_rows };
+
+			if (r >= _rows) {
+				std::fill(re_a, re + std::min(r + 2, _fft_rows) * _spectrum_cols, 0.0f);
+				std::fill(im_a, im + std::min(r + 2, _fft_rows) * _spectrum_cols, 0.0f);
+				continue;
+			}
+
+			// z = a + i b
+			std::fill(_row_re.begin(), _row_re.end(), 0.0f);
+			std::fill(_row_im.begin(), _row_im.end(), 0.0f);
+			for (uint32_t c{ 0 }; c < _cols; ++c) {
+				_row_re[c] = x[r * row_stride + c * col_stride];
+			}
+			if (r + 1 < _rows) {
+				for (uint32_t c{ 0 }; c < _cols; ++c) {
+					_row_im[c] = x[(r + 1) * row_stride + c * col_stride];
+				}
+			}
+			_cols_fft.forward(_row_re.data(), _row_im.data());
+
+			// A_k = (Z_k + conj(Z_{n-k})) / 2, B_k = (Z_k - conj(Z_{n-k})) / 2i
+			for (uint32_t k{ 0 }; k < _spectrum_cols; ++k) {
+				const uint32_t k_mirror{ (_fft_cols - k) % _fft_cols };
+				const float z_re{ _row_re[k] };
+				const float z_im{ _row_im[k] };
+				const float z_mirror_re{ _row_re[k_mirror] };
+				const float z_mirror_im{ _row_im[k_mirror] };
+
+				re_a[k] = 0.5f * (z_re + z_mirror_re);
+				im_a[k] = 0.5f * (z_im - z_mirror_im);
+				if (has_b) {
+					re_a[_spectrum_cols + k] = 0.5f * (z_im + z_mirror_im);
+					im_a[_spectrum_cols + k] = 0.5f * (z_mirror_re - z_re);
+				}
+			}
+		}
+
+		_rows_fft.forward(re, im, _spectrum_cols);
+	}
+
+	/**
+	 * Inverse transform of spectrum (overwritten), writes value * scale + offset of (r, c) to y[r * row_stride + c * col_stride]
+	 * for r in [0, rows) and c in [0, cols).
+	 */
+	void inverse(float* re, float* im, float* y, const uint32_t row_stride, const uint32_t col_stride, const float scale, const float offset) {
+		_rows_fft.inverse(re, im, _spectrum_cols);
+
+		for (uint32_t r{ 0 }; r < _rows; r += 2) {
+			const float* re_a{ re + r * _spectrum_cols };
+			const float* im_a{ im + r * _spectrum_cols };
+			const bool has_b{ r + 1 < _rows };
+
+			// Z = A + i B, spectra of real rows are extended with A_{n-k} = conj(A_k)
+			for (uint32_t k{ 0 }; k < _fft_cols; ++k) {
+				const bool mirrored{ k >= _spectrum_cols };
+				const uint32_t index{ mirrored ? _fft_cols - k : k };
+				const float sign{ mirrored ? -1.0f : 1.0f };
+				const float a_re{ re_a[index] };
+				const float a_im{ sign * im_a[index] };
+				const float b_re{ has_b ? re_a[_spectrum_cols + index] : 0.0f };
+				const float b_im{ has_b ? sign * im_a[_spectrum_cols + index] : 0.0f };
+
+				_row_re[k] = a_re - b_im;
+				_row_im[k] = a_im + b_re;
+			}
+			_cols_fft.inverse(_row_re.data(), _row_im.data());
+
+			for (uint32_t c{ 0 }; c < _cols; ++c) {
+				y[r * row_stride + c * col_stride] = _row_re[c] * scale + offset;
+			}
+			if (has_b) {
+				for (uint32_t c{ 0 }; c < _cols; ++c) {
+					y[(r + 1) * row_stride + c * col_stride] = _row_im[c] * scale + offset;
+				}
+			}
+		}
+	}
+
+private:
+	uint32_t _rows;
+	uint32_t _cols;
+	uint32_t _fft_rows;
+	uint32_t _fft_cols;
+	uint32_t _spectrum_cols;
+	FFT _rows_fft;
+	FFT _cols_fft;
+	std::vector<float> _row_re;
+	std::vector<float> _row_im;
+};
+
+/**
+ * Number of frequencies multiplied at once, sums over channels are kept in local arrays.
+ */
+constexpr uint32_t FFT_CONV_FREQUENCIES_BLOCK{ 64 };
+
+uint32_t fftConvSpectrumSize(const Conv2DGeometry& geometry) {
+	const uint32_t filter_size{ geometry.getEffectiveFilterSize() };
+	const uint32_t size{ FFT::transformSize(geometry.height + filter_size - 1) * (FFT::transformSize(geometry.width + filter_size - 1) / 2 + 1) };
+	return (size + FFT_CONV_FREQUENCIES_BLOCK - 1) / FFT_CONV_FREQUENCIES_BLOCK * FFT_CONV_FREQUENCIES_BLOCK;
+}
+
+void fftConvTransformFilters(const float* weights, const uint32_t channels, const uint32_t filters_count, const Conv2DGeometry& geometry,
+	float* spectra) {
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t fft_height{ FFT::transformSize(geometry.height + geometry.getEffectiveFilterSize() - 1) };
+	const uint32_t fft_width{ FFT::transformSize(geometry.width + geometry.getEffectiveFilterSize() - 1) };
+	const uint32_t spectrum_size{ fftConvSpectrumSize(geometry) };
+	RealFFT2D fft(fft_height, fft_width, fft_height, fft_width);
+	std::fill(spectra, spectra + static_cast<size_t>(channels) * filters_count * 2 * spectrum_size, 0.0f);
+	std::vector<float> kernel(static_cast<size_t>(fft_height) * fft_width);
+
+	// y = x * k (circular convolution) for k[(padding - a * dilation) mod n][(padding - b * dilation) mod n] = w[a][b],
+	// transforms are large enough so wrapped values of x are zeros
+	for (uint32_t c{ 0 }; c < channels; ++c) {
+		for (uint32_t f{ 0 }; f < filters_count; ++f) {
+			std::fill(kernel.begin(), kernel.end(), 0.0f);
+			for (uint32_t a{ 0 }; a < filter_size; ++a) {
+				for (uint32_t b{ 0 }; b < filter_size; ++b) {
+					const uint32_t row{ (geometry.padding_top + fft_height - a * geometry.dilation) % fft_height };
+					const uint32_t col{ (geometry.padding_left + fft_width - b * geometry.dilation) % fft_width };
+					kernel[row * fft_width + col] = weights[((a * filter_size + b) * channels + c) * filters_count + f];
+				}
+			}
+
+			float* spectrum{ spectra + (static_cast<size_t>(c) * filters_count + f) * 2 * spectrum_size };
+			fft.forward(kernel.data(), fft_width, 1, spectrum, spectrum + spectrum_size);
+		}
+	}
+}
+
+/**
+ * Transforms all input channels of every image, multiplies them by filter spectra (conjugated for the input gradient)
+ * and transforms sums back into output channels. Input images are [in_height, in_width] and outputs are
+ * [out_height, out_width], the forward convolution and its input gradient swap these sizes.
+ */
+template <bool CONJUGATE>
+static void convolveSpectra(const float* x, const uint32_t batch_size, const uint32_t in_height, const uint32_t in_width,
+	const uint32_t out_height, const uint32_t out_width, const uint32_t in_channels, const uint32_t out_channels, const float* spectra,
+	const Conv2DGeometry& geometry, const float* biases, float* y) {
+	const uint32_t fft_height{ FFT::transformSize(geometry.height + geometry.getEffectiveFilterSize() - 1) };
+	const uint32_t fft_width{ FFT::transformSize(geometry.width + geometry.getEffectiveFilterSize() - 1) };
+	const uint32_t spectrum_size{ fftConvSpectrumSize(geometry) };
+	const float scale{ 1.0f / (static_cast<float>(fft_height) * fft_width) };
+	const uint32_t filters_count{ CONJUGATE ? in_channels : out_channels };
+	const uint64_t transforms_size{ static_cast<uint64_t>(batch_size) * (in_channels + out_channels) * spectrum_size };
+	const uint64_t products_size{ static_cast<uint64_t>(batch_size) * in_channels * out_channels * spectrum_size };
+
+	// [batch_size, channels, 2, spectrum_size]
+	std::vector<float> in_spectra(static_cast<size_t>(batch_size) * in_channels * 2 * spectrum_size);
+	std::vector<float> out_spectra(static_cast<size_t>(batch_size) * out_channels * 2 * spectrum_size);
+
+	ThreadPool::forEachTask(batch_size, transforms_size, [&](uint32_t i) {
+		RealFFT2D fft(in_height, in_width, fft_height, fft_width);
+		const float* image{ x + static_cast<size_t>(i) * in_height * in_width * in_channels };
+		for (uint32_t c{ 0 }; c < in_channels; ++c) {
+			float* spectrum{ in_spectra.data() + (static_cast<size_t>(i) * in_channels + c) * 2 * spectrum_size };
+			fft.forward(image + c, in_width * in_channels, in_channels, spectrum, spectrum + spectrum_size);
+		}
+	});
+
+	const uint32_t blocks{ spectrum_size / FFT_CONV_FREQUENCIES_BLOCK };
+	ThreadPool::forEachTask(blocks, products_size, [&](uint32_t block) {
+		const uint32_t begin{ block * FFT_CONV_FREQUENCIES_BLOCK };
+		const float sign{ CONJUGATE ? -1.0f : 1.0f };
+
+		for (uint32_t i{ 0 }; i < batch_size; ++i) {
+			const float* in{ in_spectra.data() + static_cast<size_t>(i) * in_channels * 2 * spectrum_size + begin };
+			float* out{ out_spectra.data() + static_cast<size_t>(i) * out_channels * 2 * spectrum_size + begin };
+
+			for (uint32_t f{ 0 }; f < out_channels; ++f) {
+				float acc_re[FFT_CONV_FREQUENCIES_BLOCK]{};
+				float acc_im[FFT_CONV_FREQUENCIES_BLOCK]{};
+
+				for (uint32_t c{ 0 }; c < in_channels; ++c) {
+					// spectra are stored as [channels, filters], the input gradient swaps their roles
+					const size_t filter{ CONJUGATE ? static_cast<size_t>(f) * filters_count + c : static_cast<size_t>(c) * filters_count + f };
+					const float* w_re{ spectra + filter * 2 * spectrum_size + begin };
+					const float* w_im{ w_re + spectrum_size };
+					const float* in_re{ in + static_cast<size_t>(c) * 2 * spectrum_size };
+					const float* in_im{ in_re + spectrum_size };
+
+					for (uint32_t k{ 0 }; k < FFT_CONV_FREQUENCIES_BLOCK; ++k) {
+						acc_re[k] += in_re[k] * w_re[k] - sign * in_im[k] * w_im[k];
+						acc_im[k] += in_im[k] * w_re[k] + sign * in_re[k] * w_im[k];
+					}
+				}
+
+				float* out_re{ out + static_cast<size_t>(f) * 2 * spectrum_size };
+				std::copy(acc_re, acc_re + FFT_CONV_FREQUENCIES_BLOCK, out_re);
+				std::copy(acc_im, acc_im + FFT_CONV_FREQUENCIES_BLOCK, out_re + spectrum_size);
+			}
+		}
+	});
+
+	ThreadPool::forEachTask(batch_size, transforms_size, [&](uint32_t i) {
+		RealFFT2D fft(out_height, out_width, fft_height, fft_width);
+		float* out{ y + static_cast<size_t>(i) * out_height * out_width * out_channels };
+		for (uint32_t f{ 0 }; f < out_channels; ++f) {
+			float* spectrum{ out_spectra.data() + (static_cast<size_t>(i) * out_channels + f) * 2 * spectrum_size };
+			fft.inverse(spectrum, spectrum + spectrum_size, out + f, out_width * out_channels, out_channels, scale,
+				(nullptr != biases) ? biases[f] : 0.0f);
+		}
+	});
+}
+
+void fftConv(const float* x, const uint32_t batch_size, const uint32_t channels, const float* spectra, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, const float* biases, float* y) {
+	convolveSpectra<false>(x, batch_size, geometry.height, geometry.width, geometry.output_height, geometry.output_width,
+		channels, filters_count, spectra, geometry, biases, y);
+}
+
+void fftConvBackwardData(const float* dy, const uint32_t batch_size, const uint32_t channels, const float* spectra, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, float* dx) {
+	convolveSpectra<true>(dy, batch_size, geometry.output_height, geometry.output_width, geometry.height, geometry.width,
+		filters_count, channels, spectra, geometry, nullptr, dx);
+}
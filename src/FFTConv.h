@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Conv2DGeometry.h"
+
+/**
+ * @brief Returns number of complex values of the spectrum of a single image or filter used by fftConv.
+ * Images are padded with zeros to [fft_height, fft_width], the smallest powers of two not less than
+ * height + e - 1 and width + e - 1 for effective filter size e, and only fft_width / 2 + 1 columns of their spectra are stored.
+ * The size is rounded up to a multiple of the block of frequencies multiplied at once.
+ *
+ * @param geometry Geometry of the convolution.
+ * @return fft_height * (fft_width / 2 + 1) rounded up to a multiple of 64.
+ */
+uint32_t fftConvSpectrumSize(const Conv2DGeometry& geometry);
+
+/**
+ * @brief Computes spectra of filters for fftConv and fftConvBackwardData.
+ * Padding and dilation of the geometry are included in the spectra.
+ *
+ * @param weights Filters of shape [filter_size, filter_size, channels, filters_count].
+ * @param channels Number of channels.
+ * @param filters_count Number of filters.
+ * @param geometry Geometry of the convolution.
+ * @param spectra Output of shape [channels, filters_count, 2, fftConvSpectrumSize(geometry)] (real and imaginary parts).
+ */
+void fftConvTransformFilters(const float* weights, const uint32_t channels, const uint32_t filters_count, const Conv2DGeometry& geometry,
+	float* spectra);
+
+/**
+ * @brief Convolution of NHWC images computed as products of spectra.
+ * Cost per pixel depends only on the size of transforms, not on filter_size^2, so it is used for large filters.
+ * The geometry should have stride 1, strided outputs would be computed at full resolution.
+ * Images are split between threads of the global ThreadPool.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param spectra Spectra of filters computed by fftConvTransformFilters.
+ * @param filters_count Number of filters.
+ * @param geometry Geometry of the convolution.
+ * @param biases Biases of shape [filters_count], may be nullptr.
+ * @param y Output of shape [batch_size, output_height, output_width, filters_count].
+ */
+void fftConv(const float* x, const uint32_t batch_size, const uint32_t channels, const float* spectra, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, const float* biases, float* y);
+
+/**
+ * @brief Gradient of fftConv with respect to its input, computed with conjugated spectra of the same filters.
+ *
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, filters_count].
+ * @param batch_size Number of images.
+ * @param channels Number of channels of the input.
+ * @param spectra Spectra of filters computed by fftConvTransformFilters.
+ * @param filters_count Number of filters.
+ * @param geometry Geometry of the convolution.
+ * @param dx Input gradient of shape [batch_size, height, width, channels], overwritten.
+ */
+void fftConvBackwardData(const float* dy, const uint32_t batch_size, const uint32_t channels, const float* spectra, const uint32_t filters_count,
+	const Conv2DGeometry& geometry, float* dx);
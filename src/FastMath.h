@@ -0,0 +1,132 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Polynomial approximations of exp, log, tanh and sigmoid used by element-wise kernels (see TensorKernels.h).
+ * They follow Cephes single precision routines, but special values are selected with ternary operators instead of
+ * early returns. They are used by the scalar kernel set, AVX2 and AVX-512 kernel sets implement the same polynomials
+ * with intrinsics.
+ *
+ * Maximal errors measured against double precision libm (every third float of the given range checked):
+ * - fastExp:     1 ulp for x in [-103.9, 88.7] (results below FLT_MIN are denormals),
+ * - fastLog:     1 ulp for x > 0 (including denormals),
+ * - fastTanh:    1 ulp for x in [-20, 20] (the result is +-1 outside),
+ * - fastSigmoid: 2 ulp for x in [-87.3, 88.7].
+ * Intrinsic implementations use fused multiply-add, their results may differ from these functions by 1 ulp.
+ * NaN is propagated, exp(inf) = inf, exp(-inf) = 0, log(0) = -inf and log of negative numbers is NaN.
+ */
+
+/**
+ * Limits of arguments of exp, exp(x) is infinity above FAST_EXP_MAX and zero below FAST_EXP_MIN.
+ */
+constexpr float FAST_EXP_MAX{ 88.72283935546875f };
+constexpr float FAST_EXP_MIN{ -103.97208404541015625f };
+
+/**
+ * ln(2) split into a part with few significant bits and a correction, so n * ln(2) is subtracted without rounding error.
+ */
+constexpr float FAST_LN2_HI{ 0.693359375f };
+constexpr float FAST_LN2_LO{ -2.12194440e-4f };
+constexpr float FAST_LOG2E{ 1.44269504088896341f };
+
+/**
+ * Adding and subtracting 1.5 * 2^23 rounds a float of magnitude below 2^22 to the nearest integer.
+ */
+constexpr float FAST_ROUND_MAGIC{ 12582912.0f };
+
+/**
+ * @brief Computes value * 2^n for integer n in [-252, 254]. value is multiplied by two powers of two in turn,
+ * so each of them is a normal float and the product overflows only if the result does.
+ */
+inline float fastScale(const float value, const int32_t n) {
+	const int32_t half{ n >> 1 };
+	return (value * std::bit_cast<float>((half + 127) << 23)) * std::bit_cast<float>((n - half + 127) << 23);
+}
+
+/**
+ * @brief Exponent e^x. x = n * ln(2) + r with |r| <= ln(2) / 2, e^r is approximated with polynomial of degree 7
+ * and scaled by 2^n.
+ */
+inline float fastExp(const float x) {
+	const float clamped{ x < FAST_EXP_MIN ? FAST_EXP_MIN : (x > FAST_EXP_MAX ? FAST_EXP_MAX : x) };
+	const float n{ (clamped * FAST_LOG2E + FAST_ROUND_MAGIC) - FAST_ROUND_MAGIC };
+	const float r{ (clamped - n * FAST_LN2_HI) - n * FAST_LN2_LO };
+
+	float p{ 1.9875691500e-4f };
+	p = p * r + 1.3981999507e-3f;
+	p = p * r + 8.3334519073e-3f;
+	p = p * r + 4.1665795894e-2f;
+	p = p * r + 1.6666665459e-1f;
+	p = p * r + 5.0000001201e-1f;
+	const float e_r{ p * (r * r) + r + 1.0f };
+
+	const float result{ fastScale(e_r, static_cast<int32_t>(n)) };
+	const float inf{ std::numeric_limits<float>::infinity() };
+	return x != x ? x : (x > FAST_EXP_MAX ? inf : (x < FAST_EXP_MIN ? 0.0f : result));
+}
+
+/**
+ * @brief Natural logarithm ln(x). x = m * 2^e with m in [sqrt(0.5), sqrt(2)), ln(m) is approximated with
+ * polynomial of degree 9 in (m - 1) and e * ln(2) is added.
+ */
+inline float fastLog(const float x) {
+	// denormals are scaled by 2^23 first
+	const bool denormal{ x < std::numeric_limits<float>::min() };
+	const uint32_t bits{ std::bit_cast<uint32_t>(denormal ? x * 8388608.0f : x) };
+	float e{ static_cast<float>(static_cast<int32_t>(bits >> 23) - 126) - (denormal ? 23.0f : 0.0f) };
+	// mantissa in [0.5, 1)
+	float m{ std::bit_cast<float>((bits & 0x007fffffu) | 0x3f000000u) };
+
+	const bool small{ m < 0.707106781186547524f };
+	e = small ? e - 1.0f : e;
+	m = small ? m + m - 1.0f : m - 1.0f;
+
+	const float z{ m * m };
+	float p{ 7.0376836292e-2f };
+	p = p * m - 1.1514610310e-1f;
+	p = p * m + 1.1676998740e-1f;
+	p = p * m - 1.2420140846e-1f;
+	p = p * m + 1.4249322787e-1f;
+	p = p * m - 1.6668057665e-1f;
+	p = p * m + 2.0000714765e-1f;
+	p = p * m - 2.4999993993e-1f;
+	p = p * m + 3.3333331174e-1f;
+	float y{ p * m * z };
+	y = y + e * FAST_LN2_LO;
+	y = y - 0.5f * z;
+	const float result{ (m + y) + e * FAST_LN2_HI };
+
+	const float inf{ std::numeric_limits<float>::infinity() };
+	const float nan{ std::numeric_limits<float>::quiet_NaN() };
+	return (x > 0.0f) ? (x == inf ? inf : result) : (x == 0.0f ? -inf : (x != x ? x : nan));
+}
+
+/**
+ * @brief Hyperbolic tangent. For |x| < 0.625 odd polynomial of degree 11 is used, otherwise
+ * tanh(|x|) = 1 - 2 / (e^(2|x|) + 1) with sign of x.
+ */
+inline float fastTanh(const float x) {
+	const float z{ x * x };
+	float p{ -5.70498872745e-3f };
+	p = p * z + 2.06390887954e-2f;
+	p = p * z - 5.37397155531e-2f;
+	p = p * z + 1.33314422036e-1f;
+	p = p * z - 3.33332819422e-1f;
+	const float small_result{ p * z * x + x };
+
+	const float a{ x < 0.0f ? -x : x };
+	const float large_abs{ 1.0f - 2.0f / (fastExp(a + a) + 1.0f) };
+	const float large_result{ x < 0.0f ? -large_abs : large_abs };
+
+	return a < 0.625f ? small_result : large_result;
+}
+
+/**
+ * @brief Logistic sigmoid 1 / (1 + e^-x).
+ */
+inline float fastSigmoid(const float x) {
+	return 1.0f / (1.0f + fastExp(-x));
+}
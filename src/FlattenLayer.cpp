@@ -23,13 +23,13 @@ FlattenLayer::FlattenLayer(Layer& prev_layer) {
 	prev_layer.setNextLayer(this);
 }
 
-const Tensor FlattenLayer::forwardPropagation(const Tensor& x, bool inference) {
+Tensor FlattenLayer::forwardPropagation(const Tensor& x, bool inference) {
 	auto new_shape = _output_shape;
 	new_shape.insert(new_shape.begin(), x.getShape()[0]);
 	return x.reshape(new_shape);
 }
 
-const Tensor FlattenLayer::backwardPropagation(const Tensor& dx) {
+Tensor FlattenLayer::backwardPropagation(const Tensor& dx) {
 	auto new_shape = _input_shape;
 	new_shape.insert(new_shape.begin(), dx.getShape()[0]);
 	return dx.reshape(new_shape);
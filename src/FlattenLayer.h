@@ -21,8 +21,8 @@ public:
 	 */
 	FlattenLayer(Layer& prev_layer);
 
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum) { };
 	virtual void initCachedGradient() { };
 	virtual void summary() const;
@@ -0,0 +1,333 @@
+#include "Gemm.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "BlockOps.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+/**
+ * Block sizes: packed [GEMM_KC, nr] panel of b stays in L1 while the micro-kernel runs over all panels of a,
+ * packed [GEMM_MC, GEMM_KC] block of a stays in L2 and packed [GEMM_KC, GEMM_NC] block of b in L3.
+ */
+constexpr uint32_t GEMM_MC{ 192 };
+constexpr uint32_t GEMM_KC{ 256 };
+constexpr uint32_t GEMM_NC{ 4096 };
+
+/**
+ * Upper bound of mr * nr of all micro-kernels, used for edge tiles.
+ */
+constexpr uint32_t GEMM_MAX_TILE{ 512 };
+
+/**
+ * Minimal m * n * k for which the product is split between threads of the global ThreadPool.
+ */
+constexpr uint64_t GEMM_PARALLEL_THRESHOLD{ 64 * 64 * 64 };
+
+/**
+ * Packs rows [0, rows) of [rows, kb] block of a into a panel storing kb columns of mr values.
+ * Rows past the block are filled with zeros.
+ */
+static void packAPanel(const uint32_t rows, const uint32_t kb, const uint32_t mr,
+	const float* a, const uint32_t a_row_stride, const uint32_t a_col_stride, float* packed) {
+	for (uint32_t p{ 0 }; p < kb; ++p) {
+		const float* a_col{ a + p * a_col_stride };
+		for (uint32_t i{ 0 }; i < rows; ++i) {
+			packed[i] = a_col[i * a_row_stride];
+		}
+		std::fill(packed + rows, packed + mr, 0.0f);
+		packed += mr;
+	}
+}
+
+/**
+ * Packs columns [0, cols) of [kb, cols] block of b into a panel storing kb rows of nr values.
+ * Columns past the block are filled with zeros.
+ */
+static void packBPanel(const uint32_t kb, const uint32_t cols, const uint32_t nr,
+	const float* b, const uint32_t b_row_stride, const uint32_t b_col_stride, float* packed) {
+	for (uint32_t p{ 0 }; p < kb; ++p) {
+		const float* b_row{ b + p * b_row_stride };
+		if (1 == b_col_stride) {
+			std::memcpy(packed, b_row, sizeof(float) * cols);
+		}
+		else {
+			for (uint32_t j{ 0 }; j < cols; ++j) {
+				packed[j] = b_row[j * b_col_stride];
+			}
+		}
+		std::fill(packed + cols, packed + nr, 0.0f);
+		packed += nr;
+	}
+}
+
+/**
+ * Number of elements of a row of c processed at once by the epilogue in local arrays.
+ */
+constexpr uint32_t GEMM_EPILOGUE_BLOCK{ 16 };
+
+/**
+ * Applies activation function to count values, sigmoid and tanh are computed with math kernels.
+ */
+static inline void activate(const TensorKernels& kernels, const GemmActivation activation, float* values, const uint32_t count) {
+	switch (activation) {
+	case GemmActivation::ReLU:
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			values[k] = std::max(values[k], 0.0f);
+		}
+		break;
+	case GemmActivation::LeakyReLU:
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			values[k] = std::max(values[k], LEAKY_RELU_SLOPE * values[k]);
+		}
+		break;
+	case GemmActivation::Sigmoid:
+		kernels.vector_sigmoid(count, values, values);
+		break;
+	case GemmActivation::Tanh:
+		kernels.vector_tanh(count, values, values);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * Applies the epilogue to count (up to GEMM_EPILOGUE_BLOCK) elements of a row of c.
+ */
+static inline void applyEpilogueBlock(const TensorKernels& kernels, const GemmActivation activation, const float* bias, float* row, const uint32_t count) {
+	float values[GEMM_EPILOGUE_BLOCK];
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		values[k] = row[k];
+	}
+	if (nullptr != bias) {
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			values[k] += bias[k];
+		}
+	}
+	activate(kernels, activation, values, count);
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		row[k] = values[k];
+	}
+}
+
+/**
+ * Applies the epilogue to cols elements of a row of c, bias points to biases of these columns.
+ */
+static void applyEpilogue(const TensorKernels& kernels, const GemmEpilogue& epilogue, const float* bias, const uint32_t cols, float* row) {
+	for (uint32_t j{ 0 }; j < cols; j += GEMM_EPILOGUE_BLOCK) {
+		const uint32_t count{ std::min(GEMM_EPILOGUE_BLOCK, cols - j) };
+		const float* bias_block{ (nullptr != bias) ? bias + j : nullptr };
+		forFullOrTailBlock<GEMM_EPILOGUE_BLOCK>(count, [&](const auto n) {
+			applyEpilogueBlock(kernels, epilogue.activation, bias_block, row + j, n);
+		});
+	}
+}
+
+/**
+ * Multiplies packed panels [ir_begin, ir_end) of a by packed panels [jr_begin, jr_end) of b (panel indices).
+ * If epilogue is given (last block of k) it is applied to every tile right after the tile is computed,
+ * bias points to biases of the first column of c.
+ */
+static void macroKernel(const TensorKernels& kernels, const uint32_t mb, const uint32_t nb, const uint32_t kb,
+	const uint32_t ir_begin, const uint32_t ir_end, const uint32_t jr_begin, const uint32_t jr_end,
+	const float* a_packed, const float* b_packed, float* c, const uint32_t c_row_stride,
+	const GemmEpilogue* epilogue, const float* bias) {
+	const uint32_t mr{ kernels.gemm_mr };
+	const uint32_t nr{ kernels.gemm_nr };
+	float tile[GEMM_MAX_TILE];
+
+	for (uint32_t jr{ jr_begin }; jr < jr_end; ++jr) {
+		const uint32_t cols{ std::min(nr, nb - jr * nr) };
+		const float* b_panel{ b_packed + jr * nr * kb };
+
+		for (uint32_t ir{ ir_begin }; ir < ir_end; ++ir) {
+			const uint32_t rows{ std::min(mr, mb - ir * mr) };
+			const float* a_panel{ a_packed + ir * mr * kb };
+			float* c_tile{ c + ir * mr * c_row_stride + jr * nr };
+
+			if ((rows == mr) && (cols == nr)) {
+				kernels.gemm_micro_kernel(kb, a_panel, b_panel, c_tile, c_row_stride);
+			}
+			else {
+				// edge tile is computed in a local buffer and only its valid part is added to c
+				std::fill(tile, tile + mr * nr, 0.0f);
+				kernels.gemm_micro_kernel(kb, a_panel, b_panel, tile, nr);
+				for (uint32_t i{ 0 }; i < rows; ++i) {
+					for (uint32_t j{ 0 }; j < cols; ++j) {
+						c_tile[i * c_row_stride + j] += tile[i * nr + j];
+					}
+				}
+			}
+
+			if (nullptr != epilogue) {
+				for (uint32_t i{ 0 }; i < rows; ++i) {
+					applyEpilogue(kernels, *epilogue, (nullptr != bias) ? bias + jr * nr : nullptr, cols, c_tile + i * c_row_stride);
+				}
+			}
+		}
+	}
+}
+
+void gemm(const uint32_t m, const uint32_t n, const uint32_t k,
+	const float* a, const uint32_t a_row_stride, const uint32_t a_col_stride,
+	const float* b, const uint32_t b_row_stride, const uint32_t b_col_stride,
+	float* c, const uint32_t c_row_stride, const bool accumulate, const GemmEpilogue* epilogue) {
+	if (!accumulate) {
+		for (uint32_t i{ 0 }; i < m; ++i) {
+			std::fill(c + i * c_row_stride, c + i * c_row_stride + n, 0.0f);
+		}
+	}
+
+	if ((0 == m) || (0 == n)) {
+		return;
+	}
+	if (0 == k) {
+		if (nullptr != epilogue) {
+			for (uint32_t i{ 0 }; i < m; ++i) {
+				applyEpilogue(getKernels(), *epilogue, epilogue->bias, n, c + i * c_row_stride);
+			}
+		}
+		return;
+	}
+
+	const TensorKernels& kernels{ getKernels() };
+	const uint32_t mr{ kernels.gemm_mr };
+	const uint32_t nr{ kernels.gemm_nr };
+
+	ThreadPool& pool{ ThreadPool::getInstance() };
+	const bool parallel{ (1 < pool.getThreadsCount()) && (static_cast<uint64_t>(m) * n * k >= GEMM_PARALLEL_THRESHOLD) };
+	const uint32_t threads_count{ parallel ? pool.getThreadsCount() : 1 };
+	// std::function (and its allocation) is created only when tasks are passed to the pool
+	auto run = [&](uint32_t count, const auto& func) {
+		if (parallel) {
+			pool.parallelFor(count, func);
+		}
+		else {
+			for (uint32_t i{ 0 }; i < count; ++i) {
+				func(i);
+			}
+		}
+	};
+
+	// each task works on up to mc rows, so every thread keeps its own block of a in L2
+	const uint32_t mc{ std::max(mr, GEMM_MC / mr * mr) };
+	const uint32_t mc_block{ mc * threads_count };
+	const uint32_t nc{ std::max(nr, GEMM_NC / nr * nr) };
+
+	// packing buffers are reused between calls
+	thread_local std::vector<float> a_packed;
+	thread_local std::vector<float> b_packed;
+	a_packed.resize(static_cast<size_t>(std::min(mc_block, (m + mr - 1) / mr * mr)) * GEMM_KC);
+	b_packed.resize(static_cast<size_t>(std::min(nc, (n + nr - 1) / nr * nr)) * GEMM_KC);
+	// thread_local variables are not captured by lambdas, so tasks run by workers use these pointers
+	float* a_packed_data{ a_packed.data() };
+	float* b_packed_data{ b_packed.data() };
+
+	for (uint32_t jc{ 0 }; jc < n; jc += nc) {
+		const uint32_t nb{ std::min(nc, n - jc) };
+		const uint32_t b_panels{ (nb + nr - 1) / nr };
+
+		for (uint32_t pc{ 0 }; pc < k; pc += GEMM_KC) {
+			const uint32_t kb{ std::min(GEMM_KC, k - pc) };
+			const float* b_block{ b + pc * b_row_stride + jc * b_col_stride };
+			// epilogue is applied when the last block of k is added, tiles of c are final then
+			const GemmEpilogue* block_epilogue{ (pc + kb == k) ? epilogue : nullptr };
+			const float* block_bias{ ((nullptr != epilogue) && (nullptr != epilogue->bias)) ? epilogue->bias + jc : nullptr };
+
+			run(b_panels, [&](uint32_t jr) {
+				packBPanel(kb, std::min(nr, nb - jr * nr), nr, b_block + jr * nr * b_col_stride, b_row_stride, b_col_stride, b_packed_data + jr * nr * kb);
+			});
+
+			for (uint32_t ic{ 0 }; ic < m; ic += mc_block) {
+				const uint32_t mb{ std::min(mc_block, m - ic) };
+				const uint32_t a_panels{ (mb + mr - 1) / mr };
+				const float* a_block{ a + ic * a_row_stride + pc * a_col_stride };
+
+				run(a_panels, [&](uint32_t ir) {
+					packAPanel(std::min(mr, mb - ir * mr), kb, mr, a_block + ir * mr * a_row_stride, a_row_stride, a_col_stride, a_packed_data + ir * mr * kb);
+				});
+
+				// tasks are [mc, nb / col_tasks] parts of c block, columns are split only when there are too few row parts
+				const uint32_t row_panels{ mc / mr };
+				const uint32_t row_tasks{ (a_panels + row_panels - 1) / row_panels };
+				const uint32_t col_tasks_wanted{ std::clamp((2 * threads_count + row_tasks - 1) / row_tasks, 1u, b_panels) };
+				const uint32_t col_panels{ (b_panels + col_tasks_wanted - 1) / col_tasks_wanted };
+				const uint32_t col_tasks{ (b_panels + col_panels - 1) / col_panels };
+
+				run(row_tasks * col_tasks, [&](uint32_t task) {
+					const uint32_t ir_begin{ (task / col_tasks) * row_panels };
+					const uint32_t jr_begin{ (task % col_tasks) * col_panels };
+					macroKernel(kernels, mb, nb, kb,
+						ir_begin, std::min(ir_begin + row_panels, a_panels), jr_begin, std::min(jr_begin + col_panels, b_panels),
+						a_packed_data, b_packed_data, c + ic * c_row_stride + jc, c_row_stride, block_epilogue, block_bias);
+				});
+			}
+		}
+	}
+}
+
+/**
+ * Gradient of the epilogue for count (up to GEMM_EPILOGUE_BLOCK) elements of a row.
+ * Gradients are chosen with selects, which are compiled to blends instead of branches.
+ */
+static inline void epilogueBackwardBlock(const GemmActivation activation, const float* y, const float* dy, float* dz, float* bias_d,
+	const uint32_t count) {
+	float values[GEMM_EPILOGUE_BLOCK];
+	float grads[GEMM_EPILOGUE_BLOCK];
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		values[k] = y[k];
+		grads[k] = dy[k];
+	}
+
+	switch (activation) {
+	case GemmActivation::ReLU:
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			grads[k] = (values[k] > 0.0f) ? grads[k] : 0.0f;
+		}
+		break;
+	case GemmActivation::LeakyReLU:
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			grads[k] = (values[k] > 0.0f) ? grads[k] : LEAKY_RELU_SLOPE * grads[k];
+		}
+		break;
+	case GemmActivation::Sigmoid:
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			grads[k] *= values[k] * (1.0f - values[k]);
+		}
+		break;
+	case GemmActivation::Tanh:
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			grads[k] *= 1.0f - values[k] * values[k];
+		}
+		break;
+	default:
+		break;
+	}
+
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		dz[k] = grads[k];
+	}
+	if (nullptr != bias_d) {
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			bias_d[k] += grads[k];
+		}
+	}
+}
+
+void gemmEpilogueBackward(const uint32_t m, const uint32_t n, const float* y, const float* dy,
+	const GemmActivation activation, float* dz, float* bias_d) {
+	for (uint32_t i{ 0 }; i < m; ++i) {
+		for (uint32_t j{ 0 }; j < n; j += GEMM_EPILOGUE_BLOCK) {
+			const uint32_t count{ std::min(GEMM_EPILOGUE_BLOCK, n - j) };
+			const uint32_t offset{ i * n + j };
+			float* bias_d_block{ (nullptr != bias_d) ? bias_d + j : nullptr };
+			forFullOrTailBlock<GEMM_EPILOGUE_BLOCK>(count, [&](const auto n) {
+				epilogueBackwardBlock(activation, y + offset, dy + offset, dz + offset, bias_d_block, n);
+			});
+		}
+	}
+}
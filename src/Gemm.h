@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Slope of LeakyReLU for negative values, shared by the gemm epilogue and ActivationLayer.
+ */
+inline constexpr float LEAKY_RELU_SLOPE{ 0.1f };
+
+/**
+ * @brief Activation function applied by the gemm epilogue.
+ */
+enum class GemmActivation {
+	None,
+	ReLU,
+	LeakyReLU,
+	Sigmoid,
+	Tanh
+};
+
+/**
+ * @brief Operation applied to every tile of c after its last product is accumulated, while the tile is still in L1 cache:
+ * c[i, j] = activation(c[i, j] + bias[j]). It replaces separate passes over c adding biases and applying activation.
+ */
+struct GemmEpilogue {
+	/**
+	 * Biases added to columns of c, may be nullptr.
+	 */
+	const float* bias{ nullptr };
+	/**
+	 * Activation function applied after biases are added.
+	 */
+	GemmActivation activation{ GemmActivation::None };
+};
+
+/**
+ * @brief General matrix multiplication c = a * b (or c += a * b).
+ * a is [m, k] matrix, b is [k, n] matrix and c is [m, n] row-major matrix. Operands a and b are given by pointer and
+ * strides, so transposed or sliced operands can be used without copying them first (e.g. b^T is b with swapped strides).
+ * Blocks of a and b are packed into contiguous panels sized for L1/L2 caches and multiplied by the micro-kernel
+ * of active kernel set (see TensorKernels.h). Large products are split between threads of the global ThreadPool.
+ *
+ * @param m Number of rows of a and c.
+ * @param n Number of columns of b and c.
+ * @param k Number of columns of a and rows of b.
+ * @param a Pointer to the first element of a.
+ * @param a_row_stride Distance between rows of a.
+ * @param a_col_stride Distance between columns of a.
+ * @param b Pointer to the first element of b.
+ * @param b_row_stride Distance between rows of b.
+ * @param b_col_stride Distance between columns of b.
+ * @param c Pointer to the first element of c.
+ * @param c_row_stride Distance between rows of c.
+ * @param accumulate If true the product is added to c, otherwise c is overwritten.
+ * @param epilogue Biases and activation applied to c after the product, may be nullptr.
+ */
+void gemm(const uint32_t m, const uint32_t n, const uint32_t k,
+	const float* a, const uint32_t a_row_stride, const uint32_t a_col_stride,
+	const float* b, const uint32_t b_row_stride, const uint32_t b_col_stride,
+	float* c, const uint32_t c_row_stride, const bool accumulate = false,
+	const GemmEpilogue* epilogue = nullptr);
+
+/**
+ * @brief Gradient of the gemm epilogue. Given output y = activation(z) and its gradient dy computes dz and adds
+ * sums of columns of dz (gradient of biases) to bias_d in the same pass. Derivatives are expressed with y,
+ * so z does not have to be stored.
+ *
+ * @param m Number of rows.
+ * @param n Number of columns.
+ * @param y Output of the epilogue, [m, n] row-major matrix.
+ * @param dy Gradient of y, [m, n] row-major matrix.
+ * @param activation Activation function of the epilogue.
+ * @param dz Gradient of z, [m, n] row-major matrix, overwritten. May be the same as dy.
+ * @param bias_d Gradient of biases of n elements, accumulated. May be nullptr.
+ */
+void gemmEpilogueBackward(const uint32_t m, const uint32_t n, const float* y, const float* dy,
+	const GemmActivation activation, float* dz, float* bias_d);
@@ -0,0 +1,103 @@
+#include "Im2col.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Tensor.h"
+#include "ThreadPool.h"
+
+void im2colRows(const float* x, const uint32_t channels, const Conv2DGeometry& geometry, const uint32_t first_row, const uint32_t rows,
+	float* rects) {
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t rect_size{ filter_size * filter_size * channels };
+	const uint64_t size{ static_cast<uint64_t>(rows) * geometry.output_width * rect_size };
+
+	ThreadPool::forEachTask(rows, size, [&](uint32_t row_offset) {
+		const uint32_t row{ first_row + row_offset };
+		const uint32_t i{ row / geometry.output_height };
+		const int32_t y_first{ static_cast<int32_t>(row % geometry.output_height * geometry.stride) - static_cast<int32_t>(geometry.padding_top) };
+		const float* image{ x + static_cast<size_t>(i) * geometry.height * geometry.width * channels };
+		float* rect{ rects + static_cast<size_t>(row_offset) * geometry.output_width * rect_size };
+
+		// patch rows [a_begin, a_end) are inside of the image
+		uint32_t a_begin, a_end;
+		geometry.getTapsRange(y_first, geometry.height, a_begin, a_end);
+
+		for (uint32_t x_pos{ 0 }; x_pos < geometry.output_width; ++x_pos) {
+			const int32_t x_first{ static_cast<int32_t>(x_pos * geometry.stride) - static_cast<int32_t>(geometry.padding_left) };
+			uint32_t b_begin, b_end;
+			geometry.getTapsRange(x_first, geometry.width, b_begin, b_end);
+			// pixels of the patch row are adjacent in NHWC layout for undilated filters, so they are copied at once
+			const uint32_t run{ (1 == geometry.dilation) ? std::max(1u, b_end - b_begin) : 1 };
+
+			for (uint32_t a{ 0 }; a < filter_size; ++a) {
+				float* rect_row{ rect + a * filter_size * channels };
+
+				if ((a < a_begin) || (a >= a_end) || (b_begin >= b_end)) {
+					std::fill(rect_row, rect_row + filter_size * channels, 0.0f);
+					continue;
+				}
+
+				const float* image_row{ image + static_cast<size_t>(y_first + static_cast<int32_t>(a * geometry.dilation)) * geometry.width * channels };
+				std::fill(rect_row, rect_row + b_begin * channels, 0.0f);
+				for (uint32_t b{ b_begin }; b < b_end; b += run) {
+					std::memcpy(rect_row + b * channels,
+						image_row + (x_first + static_cast<int32_t>(b * geometry.dilation)) * static_cast<int32_t>(channels),
+						sizeof(float) * run * channels);
+				}
+				std::fill(rect_row + b_end * channels, rect_row + filter_size * channels, 0.0f);
+			}
+
+			rect += rect_size;
+		}
+	});
+}
+
+void im2col(const float* x, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* rects) {
+	im2colRows(x, channels, geometry, 0, batch_size * geometry.output_height, rects);
+}
+
+void col2im(const float* rects, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* x) {
+	const uint32_t filter_size{ geometry.filter_size };
+	const uint32_t rect_size{ filter_size * filter_size * channels };
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * geometry.output_width * rect_size };
+
+	ThreadPool::forEachTask(batch_size * geometry.height, size, [&](uint32_t row) {
+		const uint32_t i{ row / geometry.height };
+		const int32_t y_pos{ static_cast<int32_t>(row % geometry.height) };
+		float* image_row{ x + static_cast<size_t>(row) * geometry.width * channels };
+
+		std::fill(image_row, image_row + geometry.width * channels, 0.0f);
+
+		// this row is patch row a of output row y if y * stride + a * dilation - padding = y_pos
+		for (uint32_t a{ 0 }; a < filter_size; ++a) {
+			const int32_t offset{ y_pos + static_cast<int32_t>(geometry.padding_top) - static_cast<int32_t>(a * geometry.dilation) };
+			if (offset < 0) {
+				break;
+			}
+			const uint32_t y{ static_cast<uint32_t>(offset) / geometry.stride };
+			if ((0 != static_cast<uint32_t>(offset) % geometry.stride) || (y >= geometry.output_height)) {
+				continue;
+			}
+			const float* rect{ rects + (static_cast<size_t>(i) * geometry.output_height + y) * geometry.output_width * rect_size + a * filter_size * channels };
+
+			for (uint32_t x_pos{ 0 }; x_pos < geometry.output_width; ++x_pos) {
+				const int32_t x_first{ static_cast<int32_t>(x_pos * geometry.stride) - static_cast<int32_t>(geometry.padding_left) };
+				uint32_t b_begin, b_end;
+				geometry.getTapsRange(x_first, geometry.width, b_begin, b_end);
+				const uint32_t run{ (1 == geometry.dilation) ? std::max(1u, b_end - b_begin) : 1 };
+
+				// values of taps [b, b + run) are adjacent pixels of the image row
+				for (uint32_t b{ b_begin }; b < b_end; b += run) {
+					const float* src{ rect + b * channels };
+					float* dst{ image_row + (x_first + static_cast<int32_t>(b * geometry.dilation)) * static_cast<int32_t>(channels) };
+					for (uint32_t j{ 0 }; j < run * channels; ++j) {
+						dst[j] += src[j];
+					}
+				}
+
+				rect += rect_size;
+			}
+		}
+	});
+}
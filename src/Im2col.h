@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Conv2DGeometry.h"
+
+/**
+ * @brief Builds patch matrix of NHWC images for convolution with given geometry.
+ * Row (i * output_height + y) * output_width + x of rects holds [filter_size, filter_size, channels] patch of image i
+ * used by output pixel (y, x), values outside of the image are zeros. Only patches of computed output pixels are built,
+ * so strided convolutions have stride^2 times smaller matrices. Patch rows of undilated filters are copied by contiguous
+ * runs of pixels and output rows are split between threads of the global ThreadPool.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param geometry Geometry of the convolution.
+ * @param rects Output matrix of shape [batch_size * output_height * output_width, filter_size * filter_size * channels].
+ */
+void im2col(const float* x, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* rects);
+
+/**
+ * @brief Builds rows of the patch matrix of im2col for a range of output rows.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param channels Number of channels.
+ * @param geometry Geometry of the convolution.
+ * @param first_row First output row (image index * output_height + y).
+ * @param rows Number of output rows.
+ * @param rects Output matrix of shape [rows * output_width, filter_size * filter_size * channels].
+ */
+void im2colRows(const float* x, const uint32_t channels, const Conv2DGeometry& geometry, const uint32_t first_row, const uint32_t rows,
+	float* rects);
+
+/**
+ * @brief Folds patch matrix back into NHWC images, transpose of im2col.
+ * Every value of rects is added to the pixel it would be taken from by im2col, values of padding are dropped.
+ * Each image row gathers its values from all patches overlapping it, so rows are computed independently
+ * by threads of the global ThreadPool.
+ *
+ * @param rects Matrix of shape [batch_size * output_height * output_width, filter_size * filter_size * channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param geometry Geometry of the convolution.
+ * @param x Output images of shape [batch_size, height, width, channels], overwritten.
+ */
+void col2im(const float* rects, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* x);
@@ -32,6 +32,10 @@ Layer* Layer::getNextLayer() const {
 	return _next_layer;
 }
 
+Tensor Layer::forwardPropagationInPlace(Tensor&& x, bool inference) {
+	return forwardPropagation(x, inference);
+}
+
 Tensor Layer::getCachedOutput() const {
 	return _cached_output;
 }
\ No newline at end of file
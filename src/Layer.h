@@ -72,14 +72,24 @@ public:
 	 * @param inference Inference indicator.
 	 * @return Output of the layer for given x.
 	 */
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true) = 0;
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true) = 0;
+	/**
+	 * Layers computing the output element-wise (e.g. activations) overwrite x instead of allocating a new tensor,
+	 * other layers call forwardPropagation.
+	 * @brief Forward propagation of the layer which may reuse the input buffer.
+	 * 
+	 * @param x Input tensor, its values are not valid after the call.
+	 * @param inference Inference indicator.
+	 * @return Output of the layer for given x.
+	 */
+	virtual Tensor forwardPropagationInPlace(Tensor&& x, bool inference=true);
 	/**
 	 * @brief Backward propagation of the layer.
 	 * 
 	 * @param dx Gradient for the layer output.
 	 * @return Gradient for the input.
 	 */
-	virtual const Tensor backwardPropagation(const Tensor& dx) = 0;
+	virtual Tensor backwardPropagation(const Tensor& dx) = 0;
 	/**
 	 * @brief Updates layer params according to gradient.
 	 * 
@@ -1,7 +1,19 @@
 #include "NeuralNetwork.h"
+#include "TensorExpression.h"
+#include "Softmax.h"
+#include "SigmoidCrossEntropy.h"
 
 extern double g_time;
 
+/**
+ * Arena for temporaries of training steps of the calling thread. Layer members keep their own allocator when a step
+ * temporary is assigned to them, so no tensor outliving the step holds arena memory.
+ */
+static ArenaTensorAllocator& stepArena() {
+	thread_local ArenaTensorAllocator arena;
+	return arena;
+}
+
 NeuralNetwork::NeuralNetwork(Layer& input_layer, Layer& output_layer, float(*cost_function)(const Tensor&, const Tensor&), const Tensor(*cost_function_d)(const Tensor&, const Tensor&)) {
 	_input_layer = &input_layer;
 	_output_layer = &output_layer;
@@ -25,6 +37,14 @@ NeuralNetwork::NeuralNetwork(Layer& input_layer, Layer& output_layer, CostFun co
 		_cost_function = mse;
 		_cost_function_d = mse_d;
 		break;
+	case CostFun::SoftmaxCategoricalCrossentropy:
+		_cost_function = softmax_categorical_crossentropy;
+		_cost_function_d = softmax_categorical_crossentropy_d;
+		break;
+	case CostFun::SigmoidBinaryCrossentropy:
+		_cost_function = sigmoid_binary_crossentropy;
+		_cost_function_d = sigmoid_binary_crossentropy_d;
+		break;
 	default:
 		_cost_function = nullptr;
 		_cost_function_d = nullptr;
@@ -37,7 +57,7 @@ float(*NeuralNetwork::getCostFun())(const Tensor&, const Tensor&) {
 	return _cost_function;
 }
 
-const Tensor NeuralNetwork::predict(const Tensor& input, bool inference) {
+Tensor NeuralNetwork::predict(const Tensor& input, bool inference) {
 	Layer* layer;
 	Tensor output;
 
@@ -46,7 +66,8 @@ const Tensor NeuralNetwork::predict(const Tensor& input, bool inference) {
 
 	while (layer != _output_layer) {
 		layer = layer->getNextLayer();
-		output = layer->forwardPropagation(output, inference);
+		// output of the previous layer is not used anymore, so activation layers overwrite it
+		output = layer->forwardPropagationInPlace(std::move(output), inference);
 	}
 
 	return output;
@@ -78,38 +99,45 @@ FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, cons
 
 		double train_start = perf_counter_ns();
 		for (batch_start = 0; batch_start + batch_size <= train_x.getShape()[0]; batch_start += batch_size) {
-			initLayersCachedGradient();
+			// temporaries of the step are allocated from the arena, weights are updated after leaving it
+			ArenaTensorAllocator& arena{ stepArena() };
+			arena.reset();
+			{
+				TensorAllocatorScope arena_scope(arena);
 
-			Tensor batch_x = train_x_shuffled[Tensor::Range({{ batch_start, batch_start + batch_size }})];
-			Tensor batch_y = train_y_shuffled[Tensor::Range({{ batch_start, batch_start + batch_size }})];
+				initLayersCachedGradient();
 
-			Tensor y_hat = predict(batch_x, false);
+				Tensor batch_x = train_x_shuffled.view(Tensor::Range({{ batch_start, batch_start + batch_size }}));
+				Tensor batch_y = train_y_shuffled.view(Tensor::Range({{ batch_start, batch_start + batch_size }}));
 
-			float batch_cost = _cost_function(y_hat, batch_y);
+				Tensor y_hat = predict(batch_x, false);
 
-			layer = _output_layer;
+				float batch_cost = _cost_function(y_hat, batch_y);
 
-			Tensor dx = _cost_function_d(y_hat, batch_y);
-			dx = layer->backwardPropagation(dx);
+				layer = _output_layer;
 
-			while (layer != _input_layer) {
-				layer = layer->getPrevLayer();
+				Tensor dx = _cost_function_d(y_hat, batch_y);
 				dx = layer->backwardPropagation(dx);
-			}
 
-			train_cost += batch_cost;
-			++batch_count;
+				while (layer != _input_layer) {
+					layer = layer->getPrevLayer();
+					dx = layer->backwardPropagation(dx);
+				}
+
+				train_cost += batch_cost;
+				++batch_count;
 
-			uint32_t done = batch_start / batch_size + 1;
-			uint32_t total = train_x.getShape()[0] / batch_size;
+				uint32_t done = batch_start / batch_size + 1;
+				uint32_t total = train_x.getShape()[0] / batch_size;
 			
-			if (verbose >= 1) {
-				printf("\r%4d ", epoch + 1);
-				print_progress(static_cast<float>(done) / total);
-				printf(" ");
-				print_time(TIME_DIFF_SEC(train_start, perf_counter_ns()) * (total - done) / done);
-				printf(" train cost: %f", train_cost / batch_count);
-				fflush(stdout);
+				if (verbose >= 1) {
+					printf("\r%4d ", epoch + 1);
+					print_progress(static_cast<float>(done) / total);
+					printf(" ");
+					print_time(TIME_DIFF_SEC(train_start, perf_counter_ns()) * (total - done) / done);
+					printf(" train cost: %f", train_cost / batch_count);
+					fflush(stdout);
+				}
 			}
 
 			updateLayersWeights(learning_step, momentum);
@@ -129,8 +157,12 @@ FitHistory NeuralNetwork::fit(const Tensor& train_x, const Tensor& train_y, cons
 		batch_count = 0;
 		uint32_t test_batch_size = batch_size < test_x.getShape()[0] ? batch_size : test_x.getShape()[0];
 		for (batch_start = 0; batch_start + test_batch_size <= test_x.getShape()[0]; batch_start += test_batch_size) {
-			Tensor batch_x = test_x[Tensor::Range({{ batch_start, batch_start + batch_size }})];
-			Tensor batch_y = test_y[Tensor::Range({{ batch_start, batch_start + batch_size }})];
+			ArenaTensorAllocator& arena{ stepArena() };
+			arena.reset();
+			TensorAllocatorScope arena_scope(arena);
+
+			Tensor batch_x = test_x.view(Tensor::Range({{ batch_start, batch_start + test_batch_size }}));
+			Tensor batch_y = test_y.view(Tensor::Range({{ batch_start, batch_start + test_batch_size }}));
 
 			float batch_cost = _cost_function(predict(batch_x), batch_y);
 
@@ -163,32 +195,51 @@ void NeuralNetwork::summary() const {
 }
 
 float NeuralNetwork::binary_crossentropy(const Tensor& y_hat, const Tensor& y) {
-	Tensor result = y * (y_hat + 1e-9f).applyFunction(logf) + (1.0f - y) * (1.0f - y_hat + 1e-9f).applyFunction(logf);
-	return result.sum() * (-1.0f / y.getSize());
+	const float result{ (lazy(y) * (lazy(y_hat) + 1e-9f).log() + (1.0f - lazy(y)) * (1.0f - lazy(y_hat) + 1e-9f).log()).sum() };
+	return result * (-1.0f / y.getSize());
 }
 
 const Tensor NeuralNetwork::binary_crossentropy_d(const Tensor& y_hat, const Tensor& y) {
-	Tensor result = (y / (y_hat + 1e-9f)) - ((1.0f - y) / (1.0f - y_hat + 1e-9f));
-	return -result;
+	return -((lazy(y) / (lazy(y_hat) + 1e-9f)) - ((1.0f - lazy(y)) / (1.0f - lazy(y_hat) + 1e-9f)));
 }
 
 float NeuralNetwork::categorical_crossentropy(const Tensor& y_hat, const Tensor& y) {
-	Tensor result = - y * (y_hat + 1e-9f).applyFunction(logf);
-	return result.sum();
+	return -(lazy(y) * (lazy(y_hat) + 1e-9f).log()).sum();
 }
 
 const Tensor NeuralNetwork::categorical_crossentropy_d(const Tensor& y_hat, const Tensor& y) {
-	Tensor result = (y / (y_hat + 1e-9f));
-	return -result;
+	return -(lazy(y) / (lazy(y_hat) + 1e-9f));
 }
 
 float NeuralNetwork::mse(const Tensor& y_hat, const Tensor& y) {
-	Tensor d = y_hat - y;
+	const auto d = lazy(y_hat) - lazy(y);
 	return (d * d).mean();
 }
 
 const Tensor NeuralNetwork::mse_d(const Tensor& y_hat, const Tensor& y) {
-	return -2*(y - y_hat)/y.getSize();
+	return (lazy(y_hat) - lazy(y)) * (2.0f / y.getSize());
+}
+
+float NeuralNetwork::softmax_categorical_crossentropy(const Tensor& y_hat, const Tensor& y) {
+	const uint32_t rows = y_hat.getShape()[0];
+	return softmaxCrossEntropy(y_hat.getDataPointer(), y.getDataPointer(), rows, y_hat.getSize() / rows);
+}
+
+const Tensor NeuralNetwork::softmax_categorical_crossentropy_d(const Tensor& y_hat, const Tensor& y) {
+	Tensor result(y_hat.getShape());
+	const uint32_t rows = y_hat.getShape()[0];
+	softmaxCrossEntropyBackward(y_hat.getDataPointer(), y.getDataPointer(), rows, y_hat.getSize() / rows, result.getDataPointer());
+	return result;
+}
+
+float NeuralNetwork::sigmoid_binary_crossentropy(const Tensor& y_hat, const Tensor& y) {
+	return sigmoidCrossEntropy(y_hat.getDataPointer(), y.getDataPointer(), y_hat.getSize());
+}
+
+const Tensor NeuralNetwork::sigmoid_binary_crossentropy_d(const Tensor& y_hat, const Tensor& y) {
+	Tensor result(y_hat.getShape());
+	sigmoidCrossEntropyBackward(y_hat.getDataPointer(), y.getDataPointer(), y_hat.getSize(), result.getDataPointer());
+	return result;
 }
 
 void NeuralNetwork::updateLayersWeights(float learning_step, float momentum) {
@@ -33,7 +33,15 @@ struct FitHistory {
 enum class CostFun {
 	BinaryCrossentropy,
 	CategoricalCrossentropy,
-	MSE
+	MSE,
+	/**
+	 * Softmax fused with categorical cross-entropy, the output layer returns logits (no Softmax activation).
+	 */
+	SoftmaxCategoricalCrossentropy,
+	/**
+	 * Sigmoid fused with binary cross-entropy, the output layer returns logits (no Sigmoid activation).
+	 */
+	SigmoidBinaryCrossentropy
 };
 
 class NeuralNetwork {
@@ -69,7 +77,7 @@ public:
 	 * @param inference Inference indicator (by default true).
 	 * @return NN output values.
 	 */
-	const Tensor predict(const Tensor& input, bool inference=true);
+	Tensor predict(const Tensor& input, bool inference=true);
 	/**
 	 * @brief Trains NN on given data.
 	 * 
@@ -100,6 +108,18 @@ public:
 	static const Tensor categorical_crossentropy_d(const Tensor& y_hat, const Tensor& y);
 	static float mse(const Tensor& y_hat, const Tensor& y);
 	static const Tensor mse_d(const Tensor& y_hat, const Tensor& y);
+	/**
+	 * Categorical cross-entropy of softmax of logits y_hat computed with log-sum-exp,
+	 * its derivative with respect to logits is softmax(y_hat) - y.
+	 */
+	static float softmax_categorical_crossentropy(const Tensor& y_hat, const Tensor& y);
+	static const Tensor softmax_categorical_crossentropy_d(const Tensor& y_hat, const Tensor& y);
+	/**
+	 * Binary cross-entropy of sigmoid of logits y_hat computed in numerically stable form,
+	 * its derivative with respect to logits is sigmoid(y_hat) - y.
+	 */
+	static float sigmoid_binary_crossentropy(const Tensor& y_hat, const Tensor& y);
+	static const Tensor sigmoid_binary_crossentropy_d(const Tensor& y_hat, const Tensor& y);
 
 private:
 	/**
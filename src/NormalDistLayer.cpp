@@ -25,7 +25,7 @@ NormalDistLayer::NormalDistLayer(Layer& prev_layer) {
 	prev_layer.setNextLayer(this);
 }
 
-const Tensor NormalDistLayer::forwardPropagation(const Tensor& x, bool inference) {
+Tensor NormalDistLayer::forwardPropagation(const Tensor& x, bool inference) {
 
 	std::vector<uint32_t> random_tensor_shape = x.getShape();
     random_tensor_shape.pop_back(); // [...]
@@ -47,7 +47,7 @@ const Tensor NormalDistLayer::forwardPropagation(const Tensor& x, bool inference
     // [..., 1]
     x_next_shape[x_next_shape.size() - 1] = 1;
 
-    Tensor x_next = (x[mu_slice] + random_tensor*((0.5f * x[var_slice]).applyFunction(expf))).reshape(x_next_shape);
+    Tensor x_next = (x[mu_slice] + random_tensor*((0.5f * x[var_slice]).exp())).reshape(x_next_shape);
 
     if (!inference)
     {
@@ -58,7 +58,7 @@ const Tensor NormalDistLayer::forwardPropagation(const Tensor& x, bool inference
     return x_next;
 }
 
-const Tensor NormalDistLayer::backwardPropagation(const Tensor& dx) {
+Tensor NormalDistLayer::backwardPropagation(const Tensor& dx) {
     std::vector<uint32_t> dx_prev_shape = dx.getShape();
     dx_prev_shape[dx_prev_shape.size() - 1] = 2;
 
@@ -81,7 +81,7 @@ const Tensor NormalDistLayer::backwardPropagation(const Tensor& dx) {
     constexpr float KL_coef = .0001f;
 
     dx_prev[mu_slice] = dx - KL_coef*input_mu;
-    dx_prev[var_slice] = input_var*dx + KL_coef*0.5f*(1 - input_var.applyFunction(expf));
+    dx_prev[var_slice] = input_var*dx + KL_coef*0.5f*(1 - input_var.exp());
 
     return dx_prev;
 }
@@ -0,0 +1,266 @@
+#include "Pool2D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "BlockOps.h"
+#include "Tensor.h"
+#include "ThreadPool.h"
+
+/**
+ * Number of channels pooled at once in local arrays.
+ */
+constexpr uint32_t POOL_CHANNELS_BLOCK{ 16 };
+
+/**
+ * Keeps maxima of values and their indices, index of values[k] is first_index + k.
+ * Indices are selected with masks instead of branches.
+ */
+static inline void maxIndices(const float* values, const uint32_t first_index, float* best, uint32_t* best_indices, const uint32_t count) {
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		const uint32_t greater{ 0u - static_cast<uint32_t>(values[k] > best[k]) };
+		best_indices[k] = (best_indices[k] & ~greater) | ((first_index + k) & greater);
+		best[k] = std::max(best[k], values[k]);
+	}
+}
+
+/**
+ * Output pixels of a row of pooling windows, calls func(out_offset, pixel_offsets, taps) for every output pixel,
+ * where out_offset is the index of the output pixel and pixel_offsets are indices of taps input pixels inside of the window.
+ */
+template <typename Func>
+static void forEachWindow(const uint32_t row, const Conv2DGeometry& geometry, const Func& func) {
+	const uint32_t i{ row / geometry.output_height };
+	const int32_t y_first{ static_cast<int32_t>(row % geometry.output_height * geometry.stride) - static_cast<int32_t>(geometry.padding_top) };
+
+	// window rows [a_begin, a_end) are inside of the image
+	uint32_t a_begin, a_end;
+	geometry.getTapsRange(y_first, geometry.height, a_begin, a_end);
+
+	thread_local std::vector<uint32_t> pixel_offsets;
+	pixel_offsets.resize(static_cast<size_t>(geometry.filter_size) * geometry.filter_size);
+
+	for (uint32_t x_pos{ 0 }; x_pos < geometry.output_width; ++x_pos) {
+		const int32_t x_first{ static_cast<int32_t>(x_pos * geometry.stride) - static_cast<int32_t>(geometry.padding_left) };
+		uint32_t b_begin, b_end;
+		geometry.getTapsRange(x_first, geometry.width, b_begin, b_end);
+
+		uint32_t taps{ 0 };
+		for (uint32_t a{ a_begin }; a < a_end; ++a) {
+			const uint32_t y_in{ static_cast<uint32_t>(y_first + static_cast<int32_t>(a * geometry.dilation)) };
+			for (uint32_t b{ b_begin }; b < b_end; ++b) {
+				const uint32_t x_in{ static_cast<uint32_t>(x_first + static_cast<int32_t>(b * geometry.dilation)) };
+				pixel_offsets[taps++] = (i * geometry.height + y_in) * geometry.width + x_in;
+			}
+		}
+
+		func(row * geometry.output_width + x_pos, pixel_offsets.data(), taps);
+	}
+}
+
+void maxPool2D(const float* x, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* y,
+	uint32_t* indices) {
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * geometry.output_width
+		* geometry.filter_size * geometry.filter_size * channels };
+
+	ThreadPool::forEachTask(batch_size * geometry.output_height, size, [&](uint32_t row) {
+		forEachWindow(row, geometry, [&](const uint32_t out_offset, const uint32_t* pixel_offsets, const uint32_t taps) {
+			float best[POOL_CHANNELS_BLOCK];
+			uint32_t best_indices[POOL_CHANNELS_BLOCK];
+			float* out{ y + static_cast<size_t>(out_offset) * channels };
+
+			for (uint32_t c{ 0 }; c < channels; c += POOL_CHANNELS_BLOCK) {
+				const uint32_t count{ std::min(POOL_CHANNELS_BLOCK, channels - c) };
+				const uint32_t first_index{ (0 < taps) ? pixel_offsets[0] * channels + c : 0 };
+				for (uint32_t k{ 0 }; k < count; ++k) {
+					best[k] = -INFINITY;
+					best_indices[k] = first_index + k;
+				}
+
+				for (uint32_t t{ 0 }; t < taps; ++t) {
+					const uint32_t index{ pixel_offsets[t] * channels + c };
+					if (nullptr == indices) {
+						forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+							blockMaximum(x + index, best, n);
+						});
+					}
+					else {
+						forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+							maxIndices(x + index, index, best, best_indices, n);
+						});
+					}
+				}
+
+				std::copy(best, best + count, out + c);
+				if (nullptr != indices) {
+					std::copy(best_indices, best_indices + count, indices + static_cast<size_t>(out_offset) * channels + c);
+				}
+			}
+		});
+	});
+}
+
+void maxPool2DBackward(const float* dy, const uint32_t* indices, const uint32_t batch_size, const uint32_t channels,
+	const Conv2DGeometry& geometry, float* dx) {
+	const uint32_t image_size{ geometry.height * geometry.width * channels };
+	const uint32_t output_size{ geometry.output_height * geometry.output_width * channels };
+
+	std::fill(dx, dx + static_cast<size_t>(batch_size) * image_size, 0.0f);
+
+	// indices of an output image point into the same input image, so images are independent
+	ThreadPool::forEachTask(batch_size, static_cast<uint64_t>(batch_size) * output_size, [&](uint32_t i) {
+		const float* image_dy{ dy + static_cast<size_t>(i) * output_size };
+		const uint32_t* image_indices{ indices + static_cast<size_t>(i) * output_size };
+		for (uint32_t o{ 0 }; o < output_size; ++o) {
+			dx[image_indices[o]] += image_dy[o];
+		}
+	});
+}
+
+void averagePool2D(const float* x, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* y) {
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * geometry.output_width
+		* geometry.filter_size * geometry.filter_size * channels };
+
+	ThreadPool::forEachTask(batch_size * geometry.output_height, size, [&](uint32_t row) {
+		forEachWindow(row, geometry, [&](const uint32_t out_offset, const uint32_t* pixel_offsets, const uint32_t taps) {
+			float acc[POOL_CHANNELS_BLOCK];
+			float* out{ y + static_cast<size_t>(out_offset) * channels };
+			// average over pixels inside of the image, padding is not counted
+			const float scale{ (0 < taps) ? 1.0f / taps : 0.0f };
+
+			for (uint32_t c{ 0 }; c < channels; c += POOL_CHANNELS_BLOCK) {
+				const uint32_t count{ std::min(POOL_CHANNELS_BLOCK, channels - c) };
+				std::fill(acc, acc + count, 0.0f);
+
+				for (uint32_t t{ 0 }; t < taps; ++t) {
+					const float* pixel{ x + static_cast<size_t>(pixel_offsets[t]) * channels + c };
+					forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+						blockAdd(pixel, acc, n);
+					});
+				}
+
+				for (uint32_t k{ 0 }; k < count; ++k) {
+					out[c + k] = acc[k] * scale;
+				}
+			}
+		});
+	});
+}
+
+void averagePool2DBackward(const float* dy, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* dx) {
+	const uint32_t image_size{ geometry.height * geometry.width * channels };
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * geometry.output_height * geometry.output_width
+		* geometry.filter_size * geometry.filter_size * channels };
+
+	std::fill(dx, dx + static_cast<size_t>(batch_size) * image_size, 0.0f);
+
+	// windows of an image add only to the same image, so images are independent
+	ThreadPool::forEachTask(batch_size, size, [&](uint32_t i) {
+		for (uint32_t row{ i * geometry.output_height }; row < (i + 1) * geometry.output_height; ++row) {
+			forEachWindow(row, geometry, [&](const uint32_t out_offset, const uint32_t* pixel_offsets, const uint32_t taps) {
+				float gradient[POOL_CHANNELS_BLOCK];
+				const float* dy_pixel{ dy + static_cast<size_t>(out_offset) * channels };
+				const float scale{ (0 < taps) ? 1.0f / taps : 0.0f };
+
+				for (uint32_t c{ 0 }; c < channels; c += POOL_CHANNELS_BLOCK) {
+					const uint32_t count{ std::min(POOL_CHANNELS_BLOCK, channels - c) };
+					for (uint32_t k{ 0 }; k < count; ++k) {
+						gradient[k] = dy_pixel[c + k] * scale;
+					}
+
+					for (uint32_t t{ 0 }; t < taps; ++t) {
+						float* dx_pixel{ dx + static_cast<size_t>(pixel_offsets[t]) * channels + c };
+						forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+							blockAdd(gradient, dx_pixel, n);
+						});
+					}
+				}
+			});
+		}
+	});
+}
+
+void globalMaxPool2D(const float* x, const uint32_t batch_size, const uint32_t pixels, const uint32_t channels, float* y,
+	uint32_t* indices) {
+	const uint32_t blocks{ (channels + POOL_CHANNELS_BLOCK - 1) / POOL_CHANNELS_BLOCK };
+
+	ThreadPool::forEachTask(batch_size * blocks, static_cast<uint64_t>(batch_size) * pixels * channels, [&](uint32_t task) {
+		const uint32_t i{ task / blocks };
+		const uint32_t c{ task % blocks * POOL_CHANNELS_BLOCK };
+		const uint32_t count{ std::min(POOL_CHANNELS_BLOCK, channels - c) };
+		const uint32_t first_index{ i * pixels * channels + c };
+		float best[POOL_CHANNELS_BLOCK];
+		uint32_t best_indices[POOL_CHANNELS_BLOCK];
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			best[k] = -INFINITY;
+			best_indices[k] = first_index + k;
+		}
+
+		for (uint32_t p{ 0 }; p < pixels; ++p) {
+			const uint32_t index{ first_index + p * channels };
+			if (nullptr == indices) {
+				forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+					blockMaximum(x + index, best, n);
+				});
+			}
+			else {
+				forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+					maxIndices(x + index, index, best, best_indices, n);
+				});
+			}
+		}
+
+		std::copy(best, best + count, y + static_cast<size_t>(i) * channels + c);
+		if (nullptr != indices) {
+			std::copy(best_indices, best_indices + count, indices + static_cast<size_t>(i) * channels + c);
+		}
+	});
+}
+
+void globalMaxPool2DBackward(const float* dy, const uint32_t* indices, const uint32_t batch_size, const uint32_t pixels,
+	const uint32_t channels, float* dx) {
+	std::fill(dx, dx + static_cast<size_t>(batch_size) * pixels * channels, 0.0f);
+
+	for (uint32_t o{ 0 }; o < batch_size * channels; ++o) {
+		dx[indices[o]] = dy[o];
+	}
+}
+
+void globalAveragePool2D(const float* x, const uint32_t batch_size, const uint32_t pixels, const uint32_t channels, float* y) {
+	const uint32_t blocks{ (channels + POOL_CHANNELS_BLOCK - 1) / POOL_CHANNELS_BLOCK };
+	const float scale{ 1.0f / pixels };
+
+	ThreadPool::forEachTask(batch_size * blocks, static_cast<uint64_t>(batch_size) * pixels * channels, [&](uint32_t task) {
+		const uint32_t i{ task / blocks };
+		const uint32_t c{ task % blocks * POOL_CHANNELS_BLOCK };
+		const uint32_t count{ std::min(POOL_CHANNELS_BLOCK, channels - c) };
+		const float* image{ x + static_cast<size_t>(i) * pixels * channels + c };
+		float acc[POOL_CHANNELS_BLOCK]{};
+
+		for (uint32_t p{ 0 }; p < pixels; ++p) {
+			forFullOrTailBlock<POOL_CHANNELS_BLOCK>(count, [&](const auto n) {
+				blockAdd(image + static_cast<size_t>(p) * channels, acc, n);
+			});
+		}
+
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			y[static_cast<size_t>(i) * channels + c + k] = acc[k] * scale;
+		}
+	});
+}
+
+void globalAveragePool2DBackward(const float* dy, const uint32_t batch_size, const uint32_t pixels, const uint32_t channels, float* dx) {
+	const float scale{ 1.0f / pixels };
+
+	ThreadPool::forEachTask(batch_size, static_cast<uint64_t>(batch_size) * pixels * channels, [&](uint32_t i) {
+		float* image{ dx + static_cast<size_t>(i) * pixels * channels };
+		for (uint32_t c{ 0 }; c < channels; ++c) {
+			image[c] = dy[static_cast<size_t>(i) * channels + c] * scale;
+		}
+		// every pixel gets the same gradient
+		for (uint32_t p{ 1 }; p < pixels; ++p) {
+			std::copy(image, image + channels, image + static_cast<size_t>(p) * channels);
+		}
+	});
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Conv2DGeometry.h"
+
+/**
+ * @brief Max pooling of NHWC images over windows of the geometry (filter_size is the pool size).
+ * Maxima of blocks of channels of a pixel are computed in local arrays together with indices of the pixels they come from,
+ * so backward propagation only scatters the gradient. Output rows are split between threads of the global ThreadPool.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param geometry Geometry of pooling windows.
+ * @param y Output of shape [batch_size, output_height, output_width, channels].
+ * @param indices Output of shape [batch_size, output_height, output_width, channels], index of the maximum in x,
+ * may be nullptr if indices are not needed.
+ */
+void maxPool2D(const float* x, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* y,
+	uint32_t* indices);
+
+/**
+ * @brief Gradient of maxPool2D with respect to its input, every output gradient is added to the input at its index.
+ *
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, channels].
+ * @param indices Indices of maxima computed by maxPool2D.
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param geometry Geometry of pooling windows.
+ * @param dx Input gradient of shape [batch_size, height, width, channels], overwritten.
+ */
+void maxPool2DBackward(const float* dy, const uint32_t* indices, const uint32_t batch_size, const uint32_t channels,
+	const Conv2DGeometry& geometry, float* dx);
+
+/**
+ * @brief Average pooling of NHWC images over windows of the geometry (filter_size is the pool size).
+ * Sums of blocks of channels of a pixel are computed in local arrays, output rows are split between threads of the global ThreadPool.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param geometry Geometry of pooling windows.
+ * @param y Output of shape [batch_size, output_height, output_width, channels].
+ */
+void averagePool2D(const float* x, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* y);
+
+/**
+ * @brief Gradient of averagePool2D with respect to its input, every output gradient is spread evenly over its window.
+ *
+ * @param dy Output gradient of shape [batch_size, output_height, output_width, channels].
+ * @param batch_size Number of images.
+ * @param channels Number of channels.
+ * @param geometry Geometry of pooling windows.
+ * @param dx Input gradient of shape [batch_size, height, width, channels], overwritten.
+ */
+void averagePool2DBackward(const float* dy, const uint32_t batch_size, const uint32_t channels, const Conv2DGeometry& geometry, float* dx);
+
+/**
+ * @brief Global max pooling of NHWC images, maximum of every channel over all pixels of an image.
+ * Every image is reduced in one pass over its pixels with maxima of blocks of channels kept in local arrays.
+ *
+ * @param x Images of shape [batch_size, pixels, channels].
+ * @param batch_size Number of images.
+ * @param pixels Number of pixels of an image (height * width).
+ * @param channels Number of channels.
+ * @param y Output of shape [batch_size, channels].
+ * @param indices Output of shape [batch_size, channels], index of the maximum in x, may be nullptr if indices are not needed.
+ */
+void globalMaxPool2D(const float* x, const uint32_t batch_size, const uint32_t pixels, const uint32_t channels, float* y,
+	uint32_t* indices);
+
+/**
+ * @brief Gradient of globalMaxPool2D with respect to its input, every output gradient is written to the input at its index.
+ *
+ * @param dy Output gradient of shape [batch_size, channels].
+ * @param indices Indices of maxima computed by globalMaxPool2D.
+ * @param batch_size Number of images.
+ * @param pixels Number of pixels of an image (height * width).
+ * @param channels Number of channels.
+ * @param dx Input gradient of shape [batch_size, pixels, channels], overwritten.
+ */
+void globalMaxPool2DBackward(const float* dy, const uint32_t* indices, const uint32_t batch_size, const uint32_t pixels,
+	const uint32_t channels, float* dx);
+
+/**
+ * @brief Global average pooling of NHWC images, mean of every channel over all pixels of an image.
+ * Every image is reduced in one pass over its pixels with sums of blocks of channels kept in local arrays.
+ *
+ * @param x Images of shape [batch_size, pixels, channels].
+ * @param batch_size Number of images.
+ * @param pixels Number of pixels of an image (height * width).
+ * @param channels Number of channels.
+ * @param y Output of shape [batch_size, channels].
+ */
+void globalAveragePool2D(const float* x, const uint32_t batch_size, const uint32_t pixels, const uint32_t channels, float* y);
+
+/**
+ * @brief Gradient of globalAveragePool2D with respect to its input, every output gradient is spread evenly over all pixels.
+ *
+ * @param dy Output gradient of shape [batch_size, channels].
+ * @param batch_size Number of images.
+ * @param pixels Number of pixels of an image (height * width).
+ * @param channels Number of channels.
+ * @param dx Input gradient of shape [batch_size, pixels, channels], overwritten.
+ */
+void globalAveragePool2DBackward(const float* dy, const uint32_t batch_size, const uint32_t pixels, const uint32_t channels, float* dx);
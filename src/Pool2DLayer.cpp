@@ -1,44 +1,53 @@
 #include "Pool2DLayer.h"
+#include "Pool2D.h"
 
-Pool2DLayer::Pool2DLayer(std::vector<uint32_t> input_shape, int32_t pool_size, PoolMode pool_mode) {
+Pool2DLayer::Pool2DLayer(std::vector<uint32_t> input_shape, int32_t pool_size, PoolMode pool_mode, uint32_t stride, ConvPadding padding) {
 	_input_shape = input_shape;
-	if (2 == _input_shape.size()) {
-		_input_shape.push_back(1);
-	}
-	else if (3 != _input_shape.size()) {
-		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Dim should be 3, but is %d.",
-            __FILE__, __LINE__, _input_shape.size()));
-	}
-
-    if ((_input_shape[0] % pool_size) != 0) {
-		throw std::invalid_argument(format_string("%s %d : Invalid input shape. First dimension should be divisible by pool_size, but shape[0]=%d, and pool_size=%d.",
-            __FILE__, __LINE__, _input_shape[0], pool_size));
-    }
-    if ((_input_shape[1] % pool_size) != 0) {
-		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Second dimension should be divisible by pool_size, but shape[1]=%d, and pool_size=%d.",
-            __FILE__, __LINE__, _input_shape[1], pool_size));
-    }
+    _pool_size = pool_size;
+    _stride = (0 == stride) ? pool_size : stride;
+    _padding = padding;
+    _global = false;
+    _pool_mode = pool_mode;
+    initShapes();
+}
 
-	_output_shape = _input_shape;
+Pool2DLayer::Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mode, uint32_t stride, ConvPadding padding) {
+	_input_shape = prev_layer.getOutputShape();
+    _pool_size = pool_size;
+    _stride = (0 == stride) ? pool_size : stride;
+    _padding = padding;
+    _global = false;
+    _pool_mode = pool_mode;
+    initShapes();
 
-    _output_shape[_output_shape.size() - 2] /= pool_size;
-    _output_shape[_output_shape.size() - 3] /= pool_size;
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
 
-    _pool_size = pool_size;
-    switch (pool_mode) {
-        case PoolMode::Max:
-            _pool_function = pool_max;
-            _pool_function_d = pool_max_d;
-            break;
-        case PoolMode::Average:
-            _pool_function = pool_mean;
-            _pool_function_d = pool_mean_d;
-            break;
-    }
+Pool2DLayer::Pool2DLayer(std::vector<uint32_t> input_shape, PoolMode pool_mode) {
+	_input_shape = input_shape;
+    _pool_size = 0;
+    _stride = 1;
+    _padding = ConvPadding::Valid;
+    _global = true;
+    _pool_mode = pool_mode;
+    initShapes();
 }
 
-Pool2DLayer::Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mode) {
+Pool2DLayer::Pool2DLayer(Layer& prev_layer, PoolMode pool_mode) {
 	_input_shape = prev_layer.getOutputShape();
+    _pool_size = 0;
+    _stride = 1;
+    _padding = ConvPadding::Valid;
+    _global = true;
+    _pool_mode = pool_mode;
+    initShapes();
+
+	this->setPrevLayer(&prev_layer);
+	prev_layer.setNextLayer(this);
+}
+
+void Pool2DLayer::initShapes() {
 	if (2 == _input_shape.size()) {
 		_input_shape.push_back(1);
 	}
@@ -47,125 +56,128 @@ Pool2DLayer::Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mod
             __FILE__, __LINE__, _input_shape.size()));
 	}
 
-    if ((_input_shape[_input_shape.size() - 2] % pool_size) != 0) {
-		throw std::invalid_argument(format_string("%s %d : Invalid input shape. First dimension should be divisible by pool_size, but shape[0]=%d, and pool_size=%d",
-            __FILE__, __LINE__, _input_shape[0], pool_size));
-    }
-    if ((_input_shape[_input_shape.size() - 3] % pool_size) != 0) {
-		throw std::invalid_argument(format_string("%s %d : Invalid input shape. Second dimension should be divisible by pool_size, but shape[1]=%d, and pool_size=%d",
-            __FILE__, __LINE__, _input_shape[1], pool_size));
+    if (_global) {
+        _output_shape = { _input_shape[2] };
+        return;
     }
 
-	_output_shape = _input_shape;
-
-    _output_shape[_output_shape.size() - 2] /= pool_size;
-    _output_shape[_output_shape.size() - 3] /= pool_size;
+    const Conv2DGeometry geometry = getGeometry(_input_shape[0], _input_shape[1]);
+    _output_shape = { geometry.output_height, geometry.output_width, _input_shape[2] };
+}
 
-	this->setPrevLayer(&prev_layer);
-	prev_layer.setNextLayer(this);
+Conv2DGeometry Pool2DLayer::getGeometry(uint32_t height, uint32_t width) const {
+    return Conv2DGeometry(height, width, _pool_size, _stride, 1, _padding);
+}
 
-    _pool_size = pool_size;
-    switch (pool_mode) {
-        case PoolMode::Max:
-            _pool_function = pool_max;
-            _pool_function_d = pool_max_d;
-            break;
-        case PoolMode::Average:
-            _pool_function = pool_mean;
-            _pool_function_d = pool_mean_d;
-            break;
+std::vector<uint32_t> Pool2DLayer::getResultShape(const std::vector<uint32_t>& x_shape) const {
+    const uint32_t dim = x_shape.size();
+    if (_global) {
+        // [b, h, w, c] -> [b, c]
+        std::vector<uint32_t> result_shape(x_shape.begin(), x_shape.end() - 2);
+        result_shape.back() = x_shape[dim - 1];
+        return result_shape;
     }
+
+    const Conv2DGeometry geometry = getGeometry(x_shape[dim - 3], x_shape[dim - 2]);
+    std::vector<uint32_t> result_shape = x_shape;
+    result_shape[dim - 3] = geometry.output_height;
+    result_shape[dim - 2] = geometry.output_width;
+    return result_shape;
 }
 
-const Tensor Pool2DLayer::forwardPropagation(const Tensor& x, bool inference) {
+Tensor Pool2DLayer::forwardPropagation(const Tensor& x, bool inference) {
     std::vector<uint32_t> x_shape = x.getShape();
-    std::vector<uint32_t> new_shape = {
-        1,
-        x_shape[x_shape.size() - 3],
-        x_shape[x_shape.size() - 2],
-        x_shape[x_shape.size() - 1] };
-    
-    for (uint32_t i = 0; i < x_shape.size() - 3; ++i) {
-        new_shape[0] *= x_shape[i];
+    const uint32_t dim = x_shape.size();
+
+    // leading dimensions are treated as the batch
+    uint32_t batch_size = 1;                    // b
+    for (uint32_t i = 0; i < dim - 3; ++i) {
+        batch_size *= x_shape[i];
     }
+    const uint32_t channels = x_shape[dim - 1];  // c
+
+    const uint32_t pixels = x_shape[dim - 3] * x_shape[dim - 2];
+
+    if (_global) {
+        Tensor result(getResultShape(x_shape));
 
-    const Tensor reshaped_x = x.reshape(new_shape);
-
-    std::vector<uint32_t> reshaped_result_shape = new_shape;
-    reshaped_result_shape[1] /= _pool_size;
-    reshaped_result_shape[2] /= _pool_size;
-    Tensor reshaped_result = Tensor(reshaped_result_shape);
-
-    for (uint32_t i = 0; i < reshaped_result_shape[0]; ++i) {
-        for (uint32_t x = 0; x < reshaped_result_shape[1]; ++x) {
-            for (uint32_t y = 0; y < reshaped_result_shape[2]; ++y) {
-                for (uint32_t c = 0; c < reshaped_result_shape[3]; ++c) {
-                    reshaped_result[{ i, x, y, c }] =
-                        _pool_function(reshaped_x[
-                            { { i },
-                            { _pool_size*x, _pool_size*(x + 1) },
-                            { _pool_size*y, _pool_size*(y + 1) },
-                            { c }}]);
-                }
+        if (PoolMode::Max == _pool_mode) {
+            if (!inference) {
+                _cached_indices.resize(result.getSize());
             }
+            globalMaxPool2D(x.getDataPointer(), batch_size, pixels, channels, result.getDataPointer(),
+                inference ? nullptr : _cached_indices.data());
         }
+        else {
+            globalAveragePool2D(x.getDataPointer(), batch_size, pixels, channels, result.getDataPointer());
+        }
+
+        if (!inference)
+        {
+            _cached_input_shape = x_shape;
+        }
+        return result;
     }
-    std::vector<uint32_t> result_shape = x_shape;
-    result_shape[result_shape.size() - 3] = x_shape[x_shape.size() - 3]/_pool_size;
-    result_shape[result_shape.size() - 2] = x_shape[x_shape.size() - 2]/_pool_size;
 
-    Tensor result = reshaped_result.reshape(result_shape);
+    const Conv2DGeometry geometry = getGeometry(x_shape[dim - 3], x_shape[dim - 2]);
+    Tensor result(getResultShape(x_shape));
+
+    if (PoolMode::Max == _pool_mode) {
+        // [b, h, w, c] -> [b, oh, ow, c], indices of maxima are needed only for backward propagation
+        if (!inference) {
+            _cached_indices.resize(result.getSize());
+        }
+        maxPool2D(x.getDataPointer(), batch_size, channels, geometry, result.getDataPointer(),
+            inference ? nullptr : _cached_indices.data());
+    }
+    else {
+        averagePool2D(x.getDataPointer(), batch_size, channels, geometry, result.getDataPointer());
+    }
 
     if (!inference)
     {
-        _cached_input = x;
-        _cached_output = result;
+        _cached_input_shape = x_shape;
     }
     return result;
 }
 
-const Tensor Pool2DLayer::backwardPropagation(const Tensor& dx) {
-    std::vector<uint32_t> x_shape = _cached_input.getShape();
-    std::vector<uint32_t> new_shape = {
-        1,
-        x_shape[x_shape.size() - 3],
-        x_shape[x_shape.size() - 2],
-        x_shape[x_shape.size() - 1] };
-    
-    for (uint32_t i = 0; i < x_shape.size() - 3; ++i) {
-        new_shape[0] *= x_shape[i];
+Tensor Pool2DLayer::backwardPropagation(const Tensor& dx) {
+    const std::vector<uint32_t>& x_shape = _cached_input_shape;
+    const uint32_t dim = x_shape.size();
+
+    // indices of maxima and the input shape are cached by the last training forward propagation
+    if (dim < 3 || dx.getShape() != getResultShape(x_shape)) {
+        throw std::invalid_argument(format_string("%s %d : Gradient shape does not match the last output. dim=%d, size=%d.",
+            __FILE__, __LINE__, dx.getDim(), dx.getSize()));
     }
 
-    std::vector<uint32_t> reshaped_result_shape = new_shape;
-    reshaped_result_shape[1] /= _pool_size;
-    reshaped_result_shape[2] /= _pool_size;
-    Tensor reshaped_result = Tensor(new_shape);
-
-    const Tensor reshaped_cached_input = std::move(_cached_input.reshape(new_shape));
-    const Tensor reshaped_dx = std::move(dx.reshape(reshaped_result_shape));
-    
-    for (uint32_t i = 0; i < reshaped_result_shape[0]; ++i) {
-        for (uint32_t x = 0; x < reshaped_result_shape[1]; ++x) {
-            for (uint32_t y = 0; y < reshaped_result_shape[2]; ++y) {
-                for (uint32_t c = 0; c < reshaped_result_shape[3]; ++c) {
-                    reshaped_result[
-                        { { i },
-                          { _pool_size*x, _pool_size*(x + 1) },
-                          { _pool_size*y, _pool_size*(y + 1) },
-                          { c } }] =
-                        _pool_function_d(
-                            reshaped_cached_input[
-                                { { i },
-                                  { _pool_size*x, _pool_size*(x + 1) },
-                                  { _pool_size*y, _pool_size*(y + 1) },
-                                  { c } }],
-                            reshaped_dx[{ i, x, y, c }]);
-                }
-            }
+    uint32_t batch_size = 1;                    // b
+    for (uint32_t i = 0; i < dim - 3; ++i) {
+        batch_size *= x_shape[i];
+    }
+    const uint32_t channels = x_shape[dim - 1];  // c
+
+    const uint32_t pixels = x_shape[dim - 3] * x_shape[dim - 2];
+    Tensor result(x_shape);
+
+    if (_global) {
+        if (PoolMode::Max == _pool_mode) {
+            globalMaxPool2DBackward(dx.getDataPointer(), _cached_indices.data(), batch_size, pixels, channels, result.getDataPointer());
+        }
+        else {
+            globalAveragePool2DBackward(dx.getDataPointer(), batch_size, pixels, channels, result.getDataPointer());
         }
+        return result;
+    }
+
+    const Conv2DGeometry geometry = getGeometry(x_shape[dim - 3], x_shape[dim - 2]);
+
+    if (PoolMode::Max == _pool_mode) {
+        maxPool2DBackward(dx.getDataPointer(), _cached_indices.data(), batch_size, channels, geometry, result.getDataPointer());
+    }
+    else {
+        averagePool2DBackward(dx.getDataPointer(), batch_size, channels, geometry, result.getDataPointer());
     }
-    
-    Tensor result = std::move(reshaped_result.reshape(x_shape));
 
     return result;
 }
@@ -186,42 +198,4 @@ void Pool2DLayer::summary() const {
 
 uint32_t Pool2DLayer::getParamsCount() const {
     return 0;
-}
-
-float Pool2DLayer::pool_max(const Tensor& x) {
-    return x.max();
-}
-
-const Tensor Pool2DLayer::pool_max_d(const Tensor& x, float dx) {
-    float max = x.max();
-    Tensor result = x;
-
-    std::vector<float> x_data = x.getData();
-
-    std::transform(x_data.begin(), x_data.end(), x_data.begin(),
-        [max, dx] (float x) {return x == max ? dx : 0.0f;});
-
-    float c = 0.0f;
-    for (auto v : x_data) {
-        if (v != 0) {
-            c += 1;
-        }
-    }
-
-    if (c > 0) {
-        std::transform(x_data.begin(), x_data.end(), x_data.begin(),
-            [c] (float x) {return x/c;});
-    }
-
-    result.setValues(x_data);
-
-    return result;
-}
-
-float Pool2DLayer::pool_mean(const Tensor& x) {
-    return x.mean();
-}
-
-const Tensor Pool2DLayer::pool_mean_d(const Tensor& x, float dx) {
-    return (x/x.getSize())*dx;
 }
\ No newline at end of file
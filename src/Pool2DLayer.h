@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "Conv2DGeometry.h"
 #include "Utils.h"
 #include "Layer.h"
 
@@ -19,19 +20,43 @@ public:
 	 * @param input_shape Size of the input Tensor.
 	 * @param pool_size Size of pooling square.
 	 * @param pool_mode Pooling function used.
+	 * @param stride Step between pooling squares, 0 uses pool_size (squares do not overlap).
+	 * @param padding Padding mode, Same keeps ceil(size / stride) outputs, Valid uses only squares inside of the input.
+	 * Padding is never pooled, average is computed over pixels inside of the input.
 	 */
-	Pool2DLayer(std::vector<uint32_t> input_shape, int32_t pool_size, PoolMode pool_mode);
+	Pool2DLayer(std::vector<uint32_t> input_shape, int32_t pool_size, PoolMode pool_mode, uint32_t stride=0,
+		ConvPadding padding=ConvPadding::Valid);
 	/**
 	 * @brief Construct a new Pool 2D Layer.
 	 * 
 	 * @param prev_layer Previous layer.
 	 * @param pool_size Size of pooling square.
 	 * @param pool_mode Pooling function used.
+	 * @param stride Step between pooling squares, 0 uses pool_size (squares do not overlap).
+	 * @param padding Padding mode, Same keeps ceil(size / stride) outputs, Valid uses only squares inside of the input.
+	 * Padding is never pooled, average is computed over pixels inside of the input.
 	 */
-	Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mode);
+	Pool2DLayer(Layer& prev_layer, int32_t pool_size, PoolMode pool_mode, uint32_t stride=0,
+		ConvPadding padding=ConvPadding::Valid);
+	/**
+	 * @brief Construct a new global Pool 2D Layer, every channel is pooled over the whole image.
+	 * Output has shape [channels], so it can be followed by a Dense layer directly.
+	 * 
+	 * @param input_shape Size of the input Tensor.
+	 * @param pool_mode Pooling function used.
+	 */
+	Pool2DLayer(std::vector<uint32_t> input_shape, PoolMode pool_mode);
+	/**
+	 * @brief Construct a new global Pool 2D Layer, every channel is pooled over the whole image.
+	 * Output has shape [channels], so it can be followed by a Dense layer directly.
+	 * 
+	 * @param prev_layer Previous layer.
+	 * @param pool_mode Pooling function used.
+	 */
+	Pool2DLayer(Layer& prev_layer, PoolMode pool_mode);
 	
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum) { };
 	virtual void initCachedGradient() { };
 	virtual void summary() const;
@@ -43,19 +68,48 @@ private:
 	 */
 	uint32_t _pool_size;
 	/**
-	 * Function used in pooling.
+	 * Step between pooling squares.
+	 */
+	uint32_t _stride;
+	/**
+	 * Padding mode of the input.
 	 */
-	float (*_pool_function)(const Tensor& x);
+	ConvPadding _padding;
 	/**
-	 * Pooling function derivative.
+	 * True if every channel is pooled over the whole image.
 	 */
-	const Tensor (*_pool_function_d)(const Tensor& x, float dx);
+	bool _global;
+	/**
+	 * Pooling function used.
+	 */
+	PoolMode _pool_mode;
+	/**
+	 * Shape of the cached input.
+	 */
+	std::vector<uint32_t> _cached_input_shape;
+	/**
+	 * Indices of maxima in the cached input (used by Max pooling).
+	 */
+	std::vector<uint32_t> _cached_indices;
 
 	/**
-	 * Pooling functions and their derivatives.
+	 * @brief Returns geometry of pooling windows of input images of given size.
+	 * 
+	 * @param height Height of input images.
+	 * @param width Width of input images.
+	 * @return Pooling geometry.
+	 */
+	Conv2DGeometry getGeometry(uint32_t height, uint32_t width) const;
+	/**
+	 * @brief Returns shape of the result of pooling of input of given shape ([..., h, w, c] -> [..., oh, ow, c]
+	 * or [..., c] for global pooling).
+	 * 
+	 * @param x_shape Shape of the input.
+	 * @return Shape of the result.
+	 */
+	std::vector<uint32_t> getResultShape(const std::vector<uint32_t>& x_shape) const;
+	/**
+	 * @brief Validates the input shape and computes the output shape.
 	 */
-	static float pool_max(const Tensor& x);
-	static const Tensor pool_max_d(const Tensor& x, float dx);
-	static float pool_mean(const Tensor& x);
-	static const Tensor pool_mean_d(const Tensor& x, float dx);
+	void initShapes();
 };
\ No newline at end of file
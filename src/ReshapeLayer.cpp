@@ -13,13 +13,13 @@ ReshapeLayer::ReshapeLayer(Layer& prev_layer, std::vector<uint32_t> output_shape
 	prev_layer.setNextLayer(this);
 }
 
-const Tensor ReshapeLayer::forwardPropagation(const Tensor& x, bool inference) {
+Tensor ReshapeLayer::forwardPropagation(const Tensor& x, bool inference) {
 	auto new_shape = _output_shape;
 	new_shape.insert(new_shape.begin(), x.getShape()[0]);
 	return x.reshape(new_shape);
 }
 
-const Tensor ReshapeLayer::backwardPropagation(const Tensor& dx) {
+Tensor ReshapeLayer::backwardPropagation(const Tensor& dx) {
 	auto new_shape = _input_shape;
 	new_shape.insert(new_shape.begin(), dx.getShape()[0]);
 	return dx.reshape(new_shape);
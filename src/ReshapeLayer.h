@@ -23,8 +23,8 @@ public:
 	 */
 	ReshapeLayer(Layer& prev_layer, std::vector<uint32_t> output_shape);
 
-	virtual const Tensor forwardPropagation(const Tensor& x, bool inference=true);
-	virtual const Tensor backwardPropagation(const Tensor& dx);
+	virtual Tensor forwardPropagation(const Tensor& x, bool inference=true);
+	virtual Tensor backwardPropagation(const Tensor& dx);
 	virtual void updateWeights(float learning_step, float momentum) { };
 	virtual void initCachedGradient() { };
 	virtual void summary() const;
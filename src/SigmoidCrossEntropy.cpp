@@ -0,0 +1,72 @@
+#include "SigmoidCrossEntropy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "Tensor.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+/**
+ * Number of elements processed by a task.
+ */
+constexpr uint32_t SIGMOID_CROSS_ENTROPY_CHUNK{ 4096 };
+
+/**
+ * Number of elements of a chunk whose exponents and logarithms are computed at once in a local array.
+ */
+constexpr uint32_t SIGMOID_CROSS_ENTROPY_BLOCK{ 256 };
+
+float sigmoidCrossEntropy(const float* logits, const float* labels, const uint32_t size) {
+	if (0 == size) {
+		return 0.0f;
+	}
+
+	const TensorKernels& kernels{ getKernels() };
+	const uint32_t chunks{ (size + SIGMOID_CROSS_ENTROPY_CHUNK - 1) / SIGMOID_CROSS_ENTROPY_CHUNK };
+	std::vector<float> losses(chunks);
+
+	ThreadPool::forEachTask(chunks, size, [&](uint32_t chunk) {
+		const uint32_t begin{ chunk * SIGMOID_CROSS_ENTROPY_CHUNK };
+		const uint32_t end{ std::min(size, begin + SIGMOID_CROSS_ENTROPY_CHUNK) };
+		float softplus[SIGMOID_CROSS_ENTROPY_BLOCK];
+		float loss{ 0.0f };
+		for (uint32_t block{ begin }; block < end; block += SIGMOID_CROSS_ENTROPY_BLOCK) {
+			const uint32_t n{ std::min(SIGMOID_CROSS_ENTROPY_BLOCK, end - block) };
+			// log(1 + exp(-|z|))
+			for (uint32_t k{ 0 }; k < n; ++k) {
+				softplus[k] = -fabsf(logits[block + k]);
+			}
+			kernels.vector_exp(n, softplus, softplus);
+			for (uint32_t k{ 0 }; k < n; ++k) {
+				softplus[k] += 1.0f;
+			}
+			kernels.vector_log(n, softplus, softplus);
+
+			for (uint32_t k{ 0 }; k < n; ++k) {
+				const float z{ logits[block + k] };
+				loss += std::max(z, 0.0f) - z * labels[block + k] + softplus[k];
+			}
+		}
+		losses[chunk] = loss;
+	});
+
+	return std::accumulate(losses.begin(), losses.end(), 0.0f) / size;
+}
+
+void sigmoidCrossEntropyBackward(const float* logits, const float* labels, const uint32_t size, float* d) {
+	const TensorKernels& kernels{ getKernels() };
+	const uint32_t chunks{ (size + SIGMOID_CROSS_ENTROPY_CHUNK - 1) / SIGMOID_CROSS_ENTROPY_CHUNK };
+
+	ThreadPool::forEachTask(chunks, size, [&](uint32_t chunk) {
+		const uint32_t begin{ chunk * SIGMOID_CROSS_ENTROPY_CHUNK };
+		const uint32_t end{ std::min(size, begin + SIGMOID_CROSS_ENTROPY_CHUNK) };
+		// sigmoid kernels compute 1 / (1 + exp(-z)), which does not overflow for large logits
+		kernels.vector_sigmoid(end - begin, logits + begin, d + begin);
+		for (uint32_t i{ begin }; i < end; ++i) {
+			d[i] -= labels[i];
+		}
+	});
+}
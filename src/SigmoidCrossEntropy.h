@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Binary cross-entropy of sigmoid of logits, averaged over all elements.
+ * Every element is computed from its logit z in a numerically stable form
+ * max(z, 0) - z * label + log(1 + exp(-|z|)), so neither sigmoid nor its logarithm is materialized.
+ * Exponents and logarithms are computed with math kernels (see TensorKernels.h).
+ * Chunks of elements are split between threads of the global ThreadPool.
+ *
+ * @param logits Logits of size elements.
+ * @param labels Expected probabilities of size elements.
+ * @param size Number of elements.
+ * @return Mean binary cross-entropy.
+ */
+float sigmoidCrossEntropy(const float* logits, const float* labels, const uint32_t size);
+
+/**
+ * @brief Gradient of the sum of binary cross-entropies of sigmoid of logits with respect to logits: sigmoid(logits) - labels.
+ * Sigmoid is computed with math kernels, it saturates to 0 or 1 for large logits without overflow.
+ *
+ * @param logits Logits of size elements.
+ * @param labels Expected probabilities of size elements.
+ * @param size Number of elements.
+ * @param d Gradient of size elements, overwritten.
+ */
+void sigmoidCrossEntropyBackward(const float* logits, const float* labels, const uint32_t size, float* d);
@@ -0,0 +1,186 @@
+#include "Softmax.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "BlockOps.h"
+#include "Tensor.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+/**
+ * Number of elements of a row reduced at once in local arrays.
+ */
+constexpr uint32_t SOFTMAX_BLOCK{ 16 };
+
+/**
+ * acc[k] += a[k] * b[k] for k in [0, count).
+ */
+static inline void multiplyAdd(const float* a, const float* b, float* acc, const uint32_t count) {
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		acc[k] += a[k] * b[k];
+	}
+}
+
+/**
+ * out[k] = a[k] * scale - b[k] for k in [0, count), computed in a local array, so out may be the same as a or b.
+ */
+static inline void multiplySubtract(const float* a, const float scale, const float* b, float* out, const uint32_t count) {
+	float values[SOFTMAX_BLOCK];
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		values[k] = a[k] * scale - b[k];
+	}
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		out[k] = values[k];
+	}
+}
+
+/**
+ * dx[k] = y[k] * (dy[k] - dot) for k in [0, count), computed in a local array, so dx may be the same as dy.
+ */
+static inline void jacobianProduct(const float* y, const float* dy, const float dot, float* dx, const uint32_t count) {
+	float values[SOFTMAX_BLOCK];
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		values[k] = y[k] * (dy[k] - dot);
+	}
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		dx[k] = values[k];
+	}
+}
+
+/**
+ * Maximum of cols values of a row.
+ */
+static float rowMax(const float* x, const uint32_t cols) {
+	float best[SOFTMAX_BLOCK];
+	std::fill(best, best + SOFTMAX_BLOCK, -std::numeric_limits<float>::infinity());
+	for (uint32_t j{ 0 }; j < cols; j += SOFTMAX_BLOCK) {
+		const uint32_t count{ std::min(SOFTMAX_BLOCK, cols - j) };
+		forFullOrTailBlock<SOFTMAX_BLOCK>(count, [&](const auto n) {
+			blockMaximum(x + j, best, n);
+		});
+	}
+	return *std::max_element(best, best + SOFTMAX_BLOCK);
+}
+
+/**
+ * Sum of cols values of a row.
+ */
+static float rowSum(const float* x, const uint32_t cols) {
+	float acc[SOFTMAX_BLOCK]{};
+	for (uint32_t j{ 0 }; j < cols; j += SOFTMAX_BLOCK) {
+		const uint32_t count{ std::min(SOFTMAX_BLOCK, cols - j) };
+		forFullOrTailBlock<SOFTMAX_BLOCK>(count, [&](const auto n) {
+			blockAdd(x + j, acc, n);
+		});
+	}
+	return std::accumulate(acc, acc + SOFTMAX_BLOCK, 0.0f);
+}
+
+/**
+ * Dot product of cols values of rows a and b.
+ */
+static float rowDot(const float* a, const float* b, const uint32_t cols) {
+	float acc[SOFTMAX_BLOCK]{};
+	for (uint32_t j{ 0 }; j < cols; j += SOFTMAX_BLOCK) {
+		const uint32_t count{ std::min(SOFTMAX_BLOCK, cols - j) };
+		forFullOrTailBlock<SOFTMAX_BLOCK>(count, [&](const auto n) {
+			multiplyAdd(a + j, b + j, acc, n);
+		});
+	}
+	return std::accumulate(acc, acc + SOFTMAX_BLOCK, 0.0f);
+}
+
+/**
+ * out = a * scale - b for cols values of rows.
+ */
+static void rowMultiplySubtract(const float* a, const float scale, const float* b, float* out, const uint32_t cols) {
+	for (uint32_t j{ 0 }; j < cols; j += SOFTMAX_BLOCK) {
+		const uint32_t count{ std::min(SOFTMAX_BLOCK, cols - j) };
+		forFullOrTailBlock<SOFTMAX_BLOCK>(count, [&](const auto n) {
+			multiplySubtract(a + j, scale, b + j, out + j, n);
+		});
+	}
+}
+
+/**
+ * Writes exp(x - max(x)) of a row to y and returns sum of the exponents.
+ */
+static float rowShiftedExp(const TensorKernels& kernels, const float* x, const uint32_t cols, float* y) {
+	const float max_value{ rowMax(x, cols) };
+	for (uint32_t j{ 0 }; j < cols; ++j) {
+		y[j] = x[j] - max_value;
+	}
+	kernels.vector_exp(cols, y, y);
+	return rowSum(y, cols);
+}
+
+/**
+ * Sum of exp(x - max_value) of a row, exponents are computed in a local array.
+ */
+static float rowShiftedExpSum(const TensorKernels& kernels, const float* x, const float max_value, const uint32_t cols) {
+	float values[SOFTMAX_BLOCK];
+	float acc[SOFTMAX_BLOCK]{};
+	for (uint32_t j{ 0 }; j < cols; j += SOFTMAX_BLOCK) {
+		const uint32_t count{ std::min(SOFTMAX_BLOCK, cols - j) };
+		for (uint32_t k{ 0 }; k < count; ++k) {
+			values[k] = x[j + k] - max_value;
+		}
+		kernels.vector_exp(count, values, values);
+		blockAdd(values, acc, count);
+	}
+	return std::accumulate(acc, acc + SOFTMAX_BLOCK, 0.0f);
+}
+
+void softmax(const float* x, const uint32_t rows, const uint32_t cols, float* y) {
+	const TensorKernels& kernels{ getKernels() };
+	ThreadPool::forEachTask(rows, static_cast<uint64_t>(rows) * cols, [&](uint32_t i) {
+		float* y_row{ y + static_cast<size_t>(i) * cols };
+		const float scale{ 1.0f / rowShiftedExp(kernels, x + static_cast<size_t>(i) * cols, cols, y_row) };
+		for (uint32_t j{ 0 }; j < cols; ++j) {
+			y_row[j] *= scale;
+		}
+	});
+}
+
+void softmaxBackward(const float* y, const float* dy, const uint32_t rows, const uint32_t cols, float* dx) {
+	ThreadPool::forEachTask(rows, static_cast<uint64_t>(rows) * cols, [&](uint32_t i) {
+		const size_t offset{ static_cast<size_t>(i) * cols };
+		const float dot{ rowDot(y + offset, dy + offset, cols) };
+		for (uint32_t j{ 0 }; j < cols; j += SOFTMAX_BLOCK) {
+			const uint32_t count{ std::min(SOFTMAX_BLOCK, cols - j) };
+			forFullOrTailBlock<SOFTMAX_BLOCK>(count, [&](const auto n) {
+				jacobianProduct(y + offset + j, dy + offset + j, dot, dx + offset + j, n);
+			});
+		}
+	});
+}
+
+float softmaxCrossEntropy(const float* logits, const float* labels, const uint32_t rows, const uint32_t cols) {
+	const TensorKernels& kernels{ getKernels() };
+	std::vector<float> losses(rows);
+
+	ThreadPool::forEachTask(rows, static_cast<uint64_t>(rows) * cols, [&](uint32_t i) {
+		const float* z{ logits + static_cast<size_t>(i) * cols };
+		const float* y{ labels + static_cast<size_t>(i) * cols };
+
+		const float max_value{ rowMax(z, cols) };
+		const float log_sum_exp{ max_value + logf(rowShiftedExpSum(kernels, z, max_value, cols)) };
+
+		losses[i] = log_sum_exp * rowSum(y, cols) - rowDot(y, z, cols);
+	});
+
+	return std::accumulate(losses.begin(), losses.end(), 0.0f);
+}
+
+void softmaxCrossEntropyBackward(const float* logits, const float* labels, const uint32_t rows, const uint32_t cols, float* d) {
+	const TensorKernels& kernels{ getKernels() };
+	ThreadPool::forEachTask(rows, static_cast<uint64_t>(rows) * cols, [&](uint32_t i) {
+		const size_t offset{ static_cast<size_t>(i) * cols };
+		const float sum{ rowShiftedExp(kernels, logits + offset, cols, d + offset) };
+		rowMultiplySubtract(d + offset, rowSum(labels + offset, cols) / sum, labels + offset, d + offset, cols);
+	});
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Softmax of every row of [rows, cols] row-major matrix.
+ * Every row is processed while it is in L1 cache: maximum is found in vectorized pass and exponents of shifted
+ * values are computed with math kernels (see TensorKernels.h), written to y and normalized. Rows are split between threads of the global ThreadPool.
+ *
+ * @param x Input of shape [rows, cols].
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param y Output of shape [rows, cols], may be the same as x.
+ */
+void softmax(const float* x, const uint32_t rows, const uint32_t cols, float* y);
+
+/**
+ * @brief Gradient of softmax with respect to its input, product of the Jacobian of every row and the output gradient
+ * computed in O(cols) per row: dx = y * (dy - sum(dy * y)).
+ *
+ * @param y Output of softmax of shape [rows, cols].
+ * @param dy Output gradient of shape [rows, cols].
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param dx Input gradient of shape [rows, cols], overwritten. May be the same as y or dy.
+ */
+void softmaxBackward(const float* y, const float* dy, const uint32_t rows, const uint32_t cols, float* dx);
+
+/**
+ * @brief Categorical cross-entropy of softmax of logits, summed over all rows.
+ * Log of softmax is computed with log-sum-exp of every row, so the result is finite for large logits and
+ * probabilities are never materialized: loss = sum(labels) * logsumexp(logits) - sum(labels * logits).
+ *
+ * @param logits Logits of shape [rows, cols].
+ * @param labels Expected probabilities of shape [rows, cols].
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @return Sum of cross-entropies of all rows.
+ */
+float softmaxCrossEntropy(const float* logits, const float* labels, const uint32_t rows, const uint32_t cols);
+
+/**
+ * @brief Gradient of softmaxCrossEntropy with respect to logits: softmax(logits) * sum(labels) - labels,
+ * which is softmax(logits) - labels for rows of labels summing to one.
+ *
+ * @param logits Logits of shape [rows, cols].
+ * @param labels Expected probabilities of shape [rows, cols].
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param d Gradient of shape [rows, cols], overwritten.
+ */
+void softmaxCrossEntropyBackward(const float* logits, const float* labels, const uint32_t rows, const uint32_t cols, float* d);
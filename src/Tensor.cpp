@@ -1,4 +1,60 @@
 #include "Tensor.h"
+#include "Gemm.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+#include <iterator>
+#include <limits>
+
+/**
+ * r = v1 <op> v2 using kernel, where v1, v2 and r have size n.
+ */
+static void parallelVectorOp(void (*kernel)(const uint32_t, const float*, const float*, float*),
+	uint32_t n, const float* v1, const float* v2, float* r) {
+	ThreadPool::forEachChunk(n, ThreadPool::getParallelChunkSize(n), [&](uint32_t begin, uint32_t end) {
+		kernel(end - begin, v1 + begin, v2 + begin, r + begin);
+	});
+}
+
+/**
+ * r = v1 <op> v2 using kernel, where v1 and r have size n1 and v2 of size n2 is broadcasted.
+ */
+static void parallelTensorOp(void (*kernel)(const uint32_t, const float*, const uint32_t, const float*, float*),
+	uint32_t n1, const float* v1, uint32_t n2, const float* v2, float* r) {
+	// chunks start at multiples of n2, so broadcasting stays aligned
+	ThreadPool::forEachChunk(n1, ThreadPool::getParallelChunkSize(n1, n2), [&](uint32_t begin, uint32_t end) {
+		kernel(end - begin, v1 + begin, n2, v2, r + begin);
+	});
+}
+
+/**
+ * r = v <op> s using kernel, where v and r have size n.
+ */
+static void parallelTensorScalarOp(void (*kernel)(const uint32_t, const float*, const float*, float*),
+	uint32_t n, const float* v, const float* s, float* r) {
+	ThreadPool::forEachChunk(n, ThreadPool::getParallelChunkSize(n), [&](uint32_t begin, uint32_t end) {
+		kernel(end - begin, v + begin, s, r + begin);
+	});
+}
+
+/**
+ * r = s <op> v using kernel, where v and r have size n.
+ */
+static void parallelScalarTensorOp(void (*kernel)(const float*, const uint32_t, const float*, float*),
+	const float* s, uint32_t n, const float* v, float* r) {
+	ThreadPool::forEachChunk(n, ThreadPool::getParallelChunkSize(n), [&](uint32_t begin, uint32_t end) {
+		kernel(s, end - begin, v + begin, r + begin);
+	});
+}
+
+/**
+ * r = function(v) using kernel, where v and r have size n.
+ */
+static void parallelMathOp(void (*kernel)(const uint32_t, const float*, float*), uint32_t n, const float* v, float* r) {
+	ThreadPool::forEachChunk(n, ThreadPool::getParallelChunkSize(n), [&](uint32_t begin, uint32_t end) {
+		kernel(end - begin, v + begin, r + begin);
+	});
+}
 
 Tensor::Tensor() {
 	// scalar
@@ -24,7 +80,24 @@ Tensor::Tensor(const Tensor& other) {
 	_data = other._data;
 }
 
-const Tensor& Tensor::operator=(const Tensor& other) {
+Tensor::Tensor(const TensorView& view) {
+	_size = view._size;
+	_shape = view._shape;
+	if (_shape.size() == 0) {
+		// scalar
+		_shape.push_back(1);
+	}
+	_data.resize(_size);
+	view.copyTo(_data.data());
+}
+
+Tensor::Tensor(Tensor&& other) noexcept
+	: _shape(std::move(other._shape)), _size{ other._size }, _data(std::move(other._data)) {
+	// the buffer is always taken over together with its allocator
+	other._size = 0;
+}
+
+Tensor& Tensor::operator=(const Tensor& other) {
 	_size = other._size;
 	_shape = other._shape;
 	_data = other._data;
@@ -32,14 +105,27 @@ const Tensor& Tensor::operator=(const Tensor& other) {
 	return *this;
 }
 
-const Tensor& Tensor::operator=(const Tensor&& other) {
+Tensor& Tensor::operator=(Tensor&& other) {
 	_size = other._size;
-	_shape = other._shape;
+	_shape = std::move(other._shape);
 	_data = std::move(other._data);
+	other._size = 0;
 
 	return *this;
 }
 
+void Tensor::setParallelThreshold(uint32_t threshold) {
+	ThreadPool::setParallelThreshold(threshold);
+}
+
+uint32_t Tensor::getParallelThreshold() {
+	return ThreadPool::getParallelThreshold();
+}
+
+uint32_t Tensor::getParallelChunkSize(uint32_t size, uint32_t alignment) {
+	return ThreadPool::getParallelChunkSize(size, alignment);
+}
+
 Tensor Tensor::RandomNormal(const std::vector<uint32_t>& shape) {
 	Tensor ret(shape);
 
@@ -50,120 +136,9 @@ Tensor Tensor::RandomNormal(const std::vector<uint32_t>& shape) {
 	return ret;
 }
 
-const Tensor Tensor::operator[](std::vector<std::vector<uint32_t> > ranges) const {
-	if (ranges.size() > this->_shape.size()) {
-		throw std::invalid_argument(format_string("%s %d : Ranges exceed tensor shape. Ranges dim=%d, tensor dim=%d.",
-			__FILE__, __LINE__, ranges.size(), this->_shape.size()));
-	}
-	while (ranges.size() < this->_shape.size()) {
-		ranges.push_back(std::vector<uint32_t>{});
-	}
-	for (uint32_t i{ 0 }; i < ranges.size(); ++i) {
-		if (ranges[i].size() > 2) {
-			throw std::invalid_argument(format_string("%s %d : Range at %d has wrong format. There should be max 2 numbers but are %d.",
-				__FILE__, __LINE__, ranges[i].size()));
-		}
-		if (2 == ranges[i].size()) {
-			if (ranges[i][0] >= ranges[i][1]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d has wrong format. First number greater or equal to second. %d >= %d.", i,
-					__FILE__, __LINE__, ranges[i][0], ranges[i][1]));
-			}
-			if (ranges[i][0] >= this->_shape[i]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][0]=%d, tensor shape[]=%d.", i, i,
-					__FILE__, __LINE__, ranges[i][0], this->_shape[i]));
-			}
-			if (ranges[i][1] > this->_shape[i]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][1]=%d, tensor shape[]=%d.", i, i,
-					__FILE__, __LINE__, ranges[i][1], this->_shape[i]));
-			}
-		}
-		if (1 == ranges[i].size()) {
-			if (ranges[i][0] >= this->_shape[i]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][0]=%d, tensor shape[]=%d.", i, i,
-					__FILE__, __LINE__, ranges[i][0], this->_shape[i]));
-			}
-		}
-	}
-
-	std::vector<uint32_t> result_shape;
-	std::vector<uint32_t> index;
-
-	for (uint32_t i{ 0 }; i < ranges.size(); ++i) {
-		switch (ranges[i].size()) {
-			case 0:
-				result_shape.push_back(this->_shape[i]);
-				index.push_back(0);
-				break;
-			case 1:
-				index.push_back(ranges[i][0]);
-				break;
-			case 2:
-				result_shape.push_back(ranges[i][1] - ranges[i][0]);
-				index.push_back(ranges[i][0]);
-				break;
-		}
-	}
-	
-	if (result_shape.size() == 0) {
-		Tensor result;
-		result[{ 0 }] = const_cast<const Tensor&>(*this)[index];
-
-		return result;
-	}
-
-	Tensor result(result_shape);
-
-	while (true) {
-		// set value
-		std::vector<uint32_t> sub_index;
-
-		for (uint32_t i{ 0 }; i < index.size(); ++i) {
-			if (2 == ranges[i].size()) {
-				sub_index.push_back(index[i] - ranges[i][0]);
-			}
-			else if (0 == ranges[i].size()) {
-				sub_index.push_back(index[i]);
-			}
-		}
-		
-		result[sub_index] = (*this)[index];
-
-		// increment index
-		bool inc_next{ false };
-		for (int32_t i{ static_cast<int32_t>(index.size() - 1) }; i >= 0; --i) {
-			if (1 != ranges[i].size()) {
-				++index[i];
-			}
-			if (0 == ranges[i].size()) {
-				if (index[i] >= this->_shape[i]) {
-					// overflow
-					index[i] = 0;
-					inc_next = true;
-				}
-				else {
-					inc_next = false;
-					break;
-				}
-			}
-			else if (2 == ranges[i].size()) {
-				if (index[i] >= ranges[i][1]) {
-					// overflow
-					index[i] = ranges[i][0];
-					inc_next = true;
-				}
-				else {
-					inc_next = false;
-					break;
-				}
-			}
-		}
-
-		if (inc_next) {
-			break;
-		}
-	}
-
-	return result;
+Tensor Tensor::operator[](std::vector<std::vector<uint32_t> > ranges) const {
+	// ranges are validated once by the view, values are copied by contiguous runs
+	return Tensor(view(std::move(ranges)));
 }
 
 const float Tensor::operator[](const std::vector<uint32_t>& index) const {
@@ -189,39 +164,7 @@ const float Tensor::operator[](const std::vector<uint32_t>& index) const {
 }
 
 TensorSlice Tensor::operator[](std::vector<std::vector<uint32_t> > ranges) {
-	if (ranges.size() > this->_shape.size()) {
-		throw std::invalid_argument(format_string("%s %d : Ranges exceed tensor shape. Ranges dim=%d, tensor dim=%d.",
-			__FILE__, __LINE__, ranges.size(), this->_shape.size()));
-	}
-	while (ranges.size() < this->_shape.size()) {
-		ranges.push_back(std::vector<uint32_t>{});
-	}
-	for (uint32_t i{ 0 }; i < ranges.size(); ++i) {
-		if (ranges[i].size() > 2) {
-			throw std::invalid_argument(format_string("%s %d : Range at %d has wrong format. There should be max 2 numbers but are %d.",
-				__FILE__, __LINE__, ranges[i].size()));
-		}
-		if (2 == ranges[i].size()) {
-			if (ranges[i][0] >= ranges[i][1]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d has wrong format. First number greater or equal to second. %d >= %d.",
-					__FILE__, __LINE__, i, ranges[i][0], ranges[i][1]));
-			}
-			if (ranges[i][0] >= this->_shape[i]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][0]=%d, tensor shape[]=%d.",
-					__FILE__, __LINE__, i, i, ranges[i][0], this->_shape[i]));
-			}
-			if (ranges[i][1] > this->_shape[i]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][1]=%d, tensor shape[]=%d.",
-					__FILE__, __LINE__, i, i, ranges[i][1], this->_shape[i]));
-			}
-		}
-		if (1 == ranges[i].size()) {
-			if (ranges[i][0] >= this->_shape[i]) {
-				throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][0]=%d, tensor shape[]=%d.",
-					__FILE__, __LINE__, i, i, ranges[i][0], this->_shape[i]));
-			}
-		}
-	}
+	validateRanges(ranges, this->_shape);
 
 	return TensorSlice(*this, ranges);
 }
@@ -242,6 +185,22 @@ TensorCell Tensor::operator[](const std::vector<uint32_t>& index) {
 	return TensorCell(*this, index);
 }
 
+const TensorView Tensor::view() const {
+	std::vector<uint32_t> strides(this->_shape.size());
+
+	uint32_t stride{ 1 };
+	for (int32_t i{ static_cast<int32_t>(this->_shape.size()) - 1 }; i >= 0; --i) {
+		strides[i] = stride;
+		stride *= this->_shape[i];
+	}
+
+	return TensorView(this->_data.data(), 0, this->_shape, strides);
+}
+
+const TensorView Tensor::view(Range ranges) const {
+	return view()[ranges];
+}
+
 uint32_t Tensor::getDim() const {
 	return _shape.size();
 }
@@ -255,7 +214,15 @@ std::vector<uint32_t> Tensor::getShape() const {
 }
 
 std::vector<float> Tensor::getData() const {
-	return _data;
+	return std::vector<float>(_data.begin(), _data.end());
+}
+
+float* Tensor::getDataPointer() {
+	return _data.data();
+}
+
+const float* Tensor::getDataPointer() const {
+	return _data.data();
 }
 
 void Tensor::setValues(const std::vector<float>& values) {
@@ -263,12 +230,18 @@ void Tensor::setValues(const std::vector<float>& values) {
 		throw std::invalid_argument(format_string("%s %d : Provided values vector has wrong size. Values size=%d, tensor size=%d.",
 			__FILE__, __LINE__, values.size(), this->_data.size()));
 	}
-	this->_data = values;
+	this->_data.assign(values.begin(), values.end());
 }
 
-const Tensor Tensor::operator-() const {
+Tensor Tensor::operator-() const & {
 	Tensor result{ *this };
-	return result*(-1.0f);
+	result *= -1.0f;
+	return result;
+}
+
+Tensor Tensor::operator-() && {
+	*this *= -1.0f;
+	return std::move(*this);
 }
 
 Tensor& Tensor::operator+=(const Tensor& other) {
@@ -279,58 +252,61 @@ Tensor& Tensor::operator+=(const Tensor& other) {
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
 
-	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] += other._data[i % other._size];
-	}
-	#else	// SSE
 	if (this->_size == other._size) {
-		SSE_vector_add(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelVectorOp(getKernels().vector_add, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (1 == other._size) {
-		SSE_tensor_add_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelTensorScalarOp(getKernels().tensor_add_scalar, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (this->validateShapeReversed(other)) {
-		SSE_tensor_add(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
+		parallelTensorOp(getKernels().tensor_add, this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
 	} else {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
-	#endif	// SSE
 
 	return *this;
 }
 
-const Tensor Tensor::operator+(const Tensor& other) const {
+Tensor Tensor::operator+(const Tensor& other) const & {
 	Tensor result{ *this };
 	result += other;
 	return result;
 }
 
+Tensor Tensor::operator+(const Tensor& other) && {
+	*this += other;
+	return std::move(*this);
+}
+
 Tensor& Tensor::operator+=(float number) {
-	#ifndef SSE
-	for (uint32_t i{ 0 } ; i < this->_size; ++i) {
-		this->_data[i] += number;
-	}
-	#else	// SSE
-	SSE_tensor_add_scalar(this->_size, this->_data.data(), &number, this->_data.data());
-	#endif	// SSE
+	parallelTensorScalarOp(getKernels().tensor_add_scalar, this->_size, this->_data.data(), &number, this->_data.data());
 
 	return *this;
 }
 
-const Tensor Tensor::operator+(float number) const {
+Tensor Tensor::operator+(float number) const & {
 	Tensor result{ *this };
 	result += number;
 	return result;
 }
 
-const Tensor operator+(float number, const Tensor& other) {
+Tensor Tensor::operator+(float number) && {
+	*this += number;
+	return std::move(*this);
+}
+
+Tensor operator+(float number, const Tensor& other) {
 	Tensor result{ other };
 	result += number;
 	return result;
 }
 
+Tensor operator+(float number, Tensor&& other) {
+	other += number;
+	return std::move(other);
+}
+
 Tensor& Tensor::operator-=(const Tensor& other) {
 	if (((this->_shape.size() < other._shape.size()) ||
 		 (!this->validateShape(other))) &&
@@ -339,58 +315,64 @@ Tensor& Tensor::operator-=(const Tensor& other) {
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
 
-	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] -= other._data[i % other._size];
-	}
-	#else	// SSE
 	if (this->_size == other._size) {
-		SSE_vector_sub(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelVectorOp(getKernels().vector_sub, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (1 == other._size) {
-		SSE_tensor_sub_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelTensorScalarOp(getKernels().tensor_sub_scalar, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (this->validateShapeReversed(other)) {
-		SSE_tensor_sub(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
+		parallelTensorOp(getKernels().tensor_sub, this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
 	} else {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
-	#endif	// SSE
 
 	return *this;
 }
 
-const Tensor Tensor::operator-(const Tensor& other) const {
+Tensor Tensor::operator-(const Tensor& other) const & {
 	Tensor result{ *this };
 	result -= other;
 	return result;
 }
 
+Tensor Tensor::operator-(const Tensor& other) && {
+	*this -= other;
+	return std::move(*this);
+}
+
 Tensor& Tensor::operator-=(float number) {
-	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] -= number;
-	}
-	#else	// SSE
-	SSE_tensor_sub_scalar(this->_size, this->_data.data(), &number, this->_data.data());
-	#endif	// SSE
+	parallelTensorScalarOp(getKernels().tensor_sub_scalar, this->_size, this->_data.data(), &number, this->_data.data());
 
 	return *this;
 }
 
-const Tensor Tensor::operator-(float number) const {
+Tensor Tensor::operator-(float number) const & {
 	Tensor result{ *this };
 	result -= number;
 	return result;
 }
 
-const Tensor operator-(float number, const Tensor& other) {
-	Tensor result{ -other };
-	result += number;
+Tensor Tensor::operator-(float number) && {
+	*this -= number;
+	return std::move(*this);
+}
+
+Tensor operator-(float number, const Tensor& other) {
+	Tensor result(other._shape);
+
+	parallelScalarTensorOp(getKernels().scalar_sub_tensor, &number, other._size, other._data.data(), result._data.data());
+
 	return result;
 }
 
+Tensor operator-(float number, Tensor&& other) {
+	parallelScalarTensorOp(getKernels().scalar_sub_tensor, &number, other._size, other._data.data(), other._data.data());
+
+	return std::move(other);
+}
+
 Tensor& Tensor::operator*=(const Tensor& other) {
 	if (((this->_shape.size() < other._shape.size()) ||
 		 (!this->validateShapeReversed(other))) &&
@@ -399,59 +381,61 @@ Tensor& Tensor::operator*=(const Tensor& other) {
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
 
-	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] *= other._data[i % other._size];
-	}
-	#else	// SSE
 	if (this->_size == other._size) {
-		SSE_vector_mul(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelVectorOp(getKernels().vector_mul, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (1 == other._size) {
-		SSE_tensor_mul_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelTensorScalarOp(getKernels().tensor_mul_scalar, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (this->validateShapeReversed(other)) {
-		SSE_tensor_mul(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
+		parallelTensorOp(getKernels().tensor_mul, this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
 	} else {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
-	#endif	// SSE
 
 	return *this;
 }
 
-const Tensor Tensor::operator*(const Tensor& other) const {
+Tensor Tensor::operator*(const Tensor& other) const & {
 	Tensor result{ *this };
 	result *= other;
 	return result;
 }
 
+Tensor Tensor::operator*(const Tensor& other) && {
+	*this *= other;
+	return std::move(*this);
+}
+
 Tensor& Tensor::operator*=(float number) {
-	#ifndef SSE
-	for (uint32_t i{ 0 } ; i < this->_size; ++i) {
-		this->_data[i] *= number;
-	}
-	#else	// SSE
-	std::vector<float> tmp(this->_data.size());
-	SSE_tensor_mul_scalar(this->_size, this->_data.data(), &number, tmp.data());
-	this->_data = tmp;
-	#endif	// SSE
+	parallelTensorScalarOp(getKernels().tensor_mul_scalar, this->_size, this->_data.data(), &number, this->_data.data());
+
 	return *this;
 }
 
-const Tensor Tensor::operator*(float number) const {
+Tensor Tensor::operator*(float number) const & {
 	Tensor result{ *this };
 	result *= number;
 	return result;
 }
 
-const Tensor operator*(float number, const Tensor& other) {
+Tensor Tensor::operator*(float number) && {
+	*this *= number;
+	return std::move(*this);
+}
+
+Tensor operator*(float number, const Tensor& other) {
 	Tensor result{ other };
 	result *= number;
 	return result;
 }
 
+Tensor operator*(float number, Tensor&& other) {
+	other *= number;
+	return std::move(other);
+}
+
 Tensor& Tensor::operator/=(const Tensor& other) {
 	if (((this->_shape.size() < other._shape.size()) ||
 		 (!this->validateShape(other))) &&
@@ -460,67 +444,65 @@ Tensor& Tensor::operator/=(const Tensor& other) {
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
 
-	#ifndef SSE
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		this->_data[i] /= other._data[i % other._size];
-	}
-	#else	// SSE
 	if (this->_size == other._size) {
-		SSE_vector_div(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelVectorOp(getKernels().vector_div, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (1 == other._size) {
-		SSE_tensor_div_scalar(this->_size, this->_data.data(), other._data.data(), this->_data.data());
+		parallelTensorScalarOp(getKernels().tensor_div_scalar, this->_size, this->_data.data(), other._data.data(), this->_data.data());
 	}
 	else if (this->validateShapeReversed(other)) {
-		SSE_tensor_div(this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
+		parallelTensorOp(getKernels().tensor_div, this->_size, this->_data.data(), other._size, other._data.data(), this->_data.data());
 	} else {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
 	}
-	#endif	// SSE
 
 	return *this;
 }
 
-const Tensor Tensor::operator/(const Tensor& other) const {
+Tensor Tensor::operator/(const Tensor& other) const & {
 	Tensor result{ *this };
 	result /= other;
 	return result;
 }
 
+Tensor Tensor::operator/(const Tensor& other) && {
+	*this /= other;
+	return std::move(*this);
+}
+
 Tensor& Tensor::operator/=(float number) {
-	#ifndef SSE
-	for (uint32_t i{ 0 } ; i < this->_size; ++i) {
-		this->_data[i] /= number;
-	}
-	#else	// SSE
-	SSE_tensor_div_scalar(this->_size, this->_data.data(), &number, this->_data.data());
-	#endif	// SSE
+	parallelTensorScalarOp(getKernels().tensor_div_scalar, this->_size, this->_data.data(), &number, this->_data.data());
 
 	return *this;
 }
 
-const Tensor Tensor::operator/(float number) const {
-	Tensor result = *this;
+Tensor Tensor::operator/(float number) const & {
+	Tensor result{ *this };
 	result /= number;
 	return result;
 }
 
-const Tensor operator/(float number, const Tensor& other) {
-	Tensor result = other;
+Tensor Tensor::operator/(float number) && {
+	*this /= number;
+	return std::move(*this);
+}
 
-	#ifndef SSE
-	for (uint32_t i{ 0 } ; i < other._size; ++i) {
-		result._data[i] = number / result._data[i];
-	}
-	#else	// SSE
-	SSE_scalar_div_tensor(&number, other._size, other._data.data(), result._data.data());
-	#endif	// SSE
+Tensor operator/(float number, const Tensor& other) {
+	Tensor result(other._shape);
+
+	parallelScalarTensorOp(getKernels().scalar_div_tensor, &number, other._size, other._data.data(), result._data.data());
 
 	return result;
 }
 
-const Tensor Tensor::operator==(const Tensor& other) const {
+Tensor operator/(float number, Tensor&& other) {
+	parallelScalarTensorOp(getKernels().scalar_div_tensor, &number, other._size, other._data.data(), other._data.data());
+
+	return std::move(other);
+}
+
+Tensor Tensor::operator==(const Tensor& other) const {
 	if ((this->_shape.size() < other._shape.size()) ||
 		!this->validateShape(other)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
@@ -529,14 +511,16 @@ const Tensor Tensor::operator==(const Tensor& other) const {
 
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] == other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] == other._data[i % other._size] ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator!=(const Tensor& other) const {
+Tensor Tensor::operator!=(const Tensor& other) const {
 	if ((this->_shape.size() < other._shape.size()) ||
 		!this->validateShape(other)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
@@ -545,14 +529,16 @@ const Tensor Tensor::operator!=(const Tensor& other) const {
 
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] != other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] != other._data[i % other._size] ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator>(const Tensor& other) const {
+Tensor Tensor::operator>(const Tensor& other) const {
 	if ((this->_shape.size() < other._shape.size()) ||
 		!this->validateShape(other)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
@@ -561,14 +547,16 @@ const Tensor Tensor::operator>(const Tensor& other) const {
 
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] > other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] > other._data[i % other._size] ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator>=(const Tensor& other) const {
+Tensor Tensor::operator>=(const Tensor& other) const {
 	if ((this->_shape.size() < other._shape.size()) ||
 		!this->validateShape(other)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
@@ -577,14 +565,16 @@ const Tensor Tensor::operator>=(const Tensor& other) const {
 
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] >= other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] >= other._data[i % other._size] ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator<(const Tensor& other) const {
+Tensor Tensor::operator<(const Tensor& other) const {
 	if ((this->_shape.size() < other._shape.size()) ||
 		!this->validateShape(other)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
@@ -593,14 +583,16 @@ const Tensor Tensor::operator<(const Tensor& other) const {
 
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] < other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] < other._data[i % other._size] ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator<=(const Tensor& other) const {
+Tensor Tensor::operator<=(const Tensor& other) const {
 	if ((this->_shape.size() < other._shape.size()) ||
 		!this->validateShape(other)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
@@ -609,74 +601,88 @@ const Tensor Tensor::operator<=(const Tensor& other) const {
 
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] <= other._data[i % other._size] ? 1.0f: 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] <= other._data[i % other._size] ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator==(float number) const {
+Tensor Tensor::operator==(float number) const {
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] == number ? 1.0f : 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] == number ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator!=(float number) const {
+Tensor Tensor::operator!=(float number) const {
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] != number ? 1.0f : 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] != number ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator>(float number) const {
+Tensor Tensor::operator>(float number) const {
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] > number ? 1.0f : 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] > number ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator>=(float number) const {
+Tensor Tensor::operator>=(float number) const {
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] >= number ? 1.0f : 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] >= number ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator<(float number) const {
+Tensor Tensor::operator<(float number) const {
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] < number ? 1.0f : 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] < number ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::operator<=(float number) const {
+Tensor Tensor::operator<=(float number) const {
 	Tensor result{ *this };
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = this->_data[i] <= number ? 1.0f : 0.0f;
-	}
+	ThreadPool::forEachChunk(this->_size, ThreadPool::getParallelChunkSize(this->_size), [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i{ begin }; i < end; ++i) {
+			result._data[i] = this->_data[i] <= number ? 1.0f : 0.0f;
+		}
+	});
 
 	return result;
 }
 
-const Tensor Tensor::addPadding(const std::vector<uint32_t>& axes, const std::vector<Padding>& paddings, const std::vector<uint32_t>& counts) const {
+Tensor Tensor::addPadding(const std::vector<uint32_t>& axes, const std::vector<Padding>& paddings, const std::vector<uint32_t>& counts) const {
 	if (axes.size() != paddings.size() || axes.size() != counts.size()) {
 		throw std::invalid_argument(format_string("%s %d : Provided arguments have wrong dim. Axes dim=%d, paddings dim=%d, counts dim=%d. All should be equal.",
 			__FILE__, __LINE__, axes.size(), paddings.size(), counts.size()));
@@ -709,7 +715,7 @@ const Tensor Tensor::addPadding(const std::vector<uint32_t>& axes, const std::ve
 	return result;
 }
 
-const Tensor Tensor::dotProduct(const Tensor& other) const {
+Tensor Tensor::dotProduct(const Tensor& other) const {
 	if (this->_shape.size() == 1 && other._shape.size() == 1) {
 		// vector inner product
 		if (this->_shape[0] != other._shape[0]) {
@@ -718,19 +724,11 @@ const Tensor Tensor::dotProduct(const Tensor& other) const {
 		}
 		Tensor result;
 
-		#ifndef SSE
-		result *= 0.0f;
-		
-		for (uint32_t i{ 0 }; i < this->_size; ++i) {
-			result._data[0] += this->_data[i] * other._data[i];
-		}
-		#else
 		float result_value{ 0.0f };
 
-		SSE_vector_inner_product(this->_size, this->_data.data(), other._data.data(), &result_value);
+		getKernels().vector_inner_product(this->_size, this->_data.data(), other._data.data(), &result_value);
 
 		result._data[0] = result_value;
-		#endif
 
 		return result;
 	}
@@ -745,13 +743,10 @@ const Tensor Tensor::dotProduct(const Tensor& other) const {
 
 		Tensor result(result_shape);
 
-		for (uint32_t i{ 0 }; i < result_shape[0]; ++i) {
-			for (uint32_t j{ 0 }; j < result_shape[1]; ++j) {
-				for (uint32_t k{ 0 }; k < this->_shape[1]; ++k) {
-					result._data[i * result_shape[1] + j] += this->_data[i * this->_shape[1] + k] * other._data[k * other._shape[1] + j];
-				}
-			}
-		}
+		gemm(result_shape[0], result_shape[1], this->_shape[1],
+			this->_data.data(), this->_shape[1], 1,
+			other._data.data(), other._shape[1], 1,
+			result._data.data(), result_shape[1]);
 
 		return result;
 	}
@@ -806,7 +801,7 @@ const Tensor Tensor::dotProduct(const Tensor& other) const {
 	}
 }
 
-const Tensor Tensor::dotProductTranspose(const Tensor& other) const {
+Tensor Tensor::dotProductTranspose(const Tensor& other) const {
 	if ((this->_shape.size() != 2) || (other._shape.size() != 2)) {
 		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
 			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
@@ -820,24 +815,24 @@ const Tensor Tensor::dotProductTranspose(const Tensor& other) const {
 
 	Tensor result(result_shape);
 
-	#ifndef SSE
-	for (uint32_t i{ 0 }; i < result_shape[0]; ++i) {
-		for (uint32_t j{ 0 }; j < result_shape[1]; ++j) {
-			for (uint32_t k{ 0 }; k < this->_shape[1]; ++k) {
-				result._data[i * result_shape[1] + j] += this->_data[i * this->_shape[1] + k] * other._data[j * other._shape[1] + k];
-			}
-		}
-	}
-	#else	// SSE
-
-	SSE_tensor_dot_product_transpose(result_shape[0], result_shape[1], this->_shape[1], this->_data.data(), other._data.data(), result._data.data());
-	
-	#endif	// SSE
+	// other^T is other with swapped strides
+	gemm(result_shape[0], result_shape[1], this->_shape[1],
+		this->_data.data(), this->_shape[1], 1,
+		other._data.data(), 1, other._shape[1],
+		result._data.data(), result_shape[1]);
 
 	return result;
 }
 
-const Tensor Tensor::tensorProduct(const Tensor& other) const {
+Tensor Tensor::dotProduct(const TensorView& other) const {
+	return view().dotProduct(other);
+}
+
+Tensor Tensor::dotProductTranspose(const TensorView& other) const {
+	return view().dotProductTranspose(other);
+}
+
+Tensor Tensor::tensorProduct(const Tensor& other) const {
 	std::vector<uint32_t> result_shape{ this->_shape };
 	result_shape.insert(result_shape.end(), other._shape.begin(), other._shape.end());
 
@@ -852,17 +847,55 @@ const Tensor Tensor::tensorProduct(const Tensor& other) const {
 	return result;
 }
 
-const Tensor Tensor::applyFunction(float (*function)(float)) const {
+Tensor Tensor::applyFunction(float (*function)(float)) const {
+	return map(function);
+}
+
+Tensor Tensor::exp() const {
 	Tensor result{ *this };
+	result.expInPlace();
+	return result;
+}
 
-	for (uint32_t i{ 0 }; i < this->_size; ++i) {
-		result._data[i] = function(result._data[i]);
-	}
+Tensor Tensor::log() const {
+	Tensor result{ *this };
+	result.logInPlace();
+	return result;
+}
+
+Tensor Tensor::tanh() const {
+	Tensor result{ *this };
+	result.tanhInPlace();
+	return result;
+}
 
+Tensor Tensor::sigmoid() const {
+	Tensor result{ *this };
+	result.sigmoidInPlace();
 	return result;
 }
 
-const Tensor Tensor::flatten(uint32_t start_axis) const {
+Tensor& Tensor::expInPlace() {
+	parallelMathOp(getKernels().vector_exp, this->_size, this->_data.data(), this->_data.data());
+	return *this;
+}
+
+Tensor& Tensor::logInPlace() {
+	parallelMathOp(getKernels().vector_log, this->_size, this->_data.data(), this->_data.data());
+	return *this;
+}
+
+Tensor& Tensor::tanhInPlace() {
+	parallelMathOp(getKernels().vector_tanh, this->_size, this->_data.data(), this->_data.data());
+	return *this;
+}
+
+Tensor& Tensor::sigmoidInPlace() {
+	parallelMathOp(getKernels().vector_sigmoid, this->_size, this->_data.data(), this->_data.data());
+	return *this;
+}
+
+Tensor Tensor::flatten(uint32_t start_axis) const {
 	if (start_axis >= this->_shape.size()) {
 		throw std::invalid_argument(format_string("%s %d : Provided axis exceeds tensor dim. axis=%d, Tensor dim=%d",
 			__FILE__, __LINE__, start_axis, this->_shape.size()));
@@ -887,7 +920,7 @@ const Tensor Tensor::flatten(uint32_t start_axis) const {
 	return result;
 }
 
-const Tensor Tensor::sum(uint32_t axis) const {
+Tensor Tensor::sum(uint32_t axis) const {
 	if (axis >= this->_shape.size()) {
 		throw std::invalid_argument(format_string("%s %d : Provided axis exceeds tensor dim. Axis=%d, Tensor dim=%d",
 			__FILE__, __LINE__, axis, this->_shape.size()));
@@ -902,72 +935,94 @@ const Tensor Tensor::sum(uint32_t axis) const {
 	}
 
 	Tensor result(result_shape);
+	if (0 == this->_size) {
+		// result is zero-filled, which is the sum of an empty axis
+		return result;
+	}
 
 	uint32_t d_i{ 1 };
 	for (uint32_t i{ axis + 1 }; i < this->_shape.size() ; ++i) {
 		d_i *= this->_shape[i];
 	}
-	#ifndef SSE
-
-	uint32_t d_j{ axis == this->_shape.size() - 1 ? this->_shape[this->_shape.size()  - 1] : 1 };
 
-	uint32_t d_k{ d_i * this->_shape[axis] };
+	const uint32_t n{ this->_size / (d_i * this->_shape[axis]) };
+	const uint32_t k{ this->_shape[axis] };
+	// chunks consist of whole [k, d_i] blocks
+	const uint32_t chunk{ ThreadPool::getParallelChunkSize(this->_size, d_i * k) };
+	const uint32_t rows_chunk{ ThreadPool::getParallelChunkSize(this->_size, d_i) / d_i };
 
-	for (uint32_t k{ 0 }; k < this->_size / d_k; ++k) {
-		for (uint32_t j{ 0 }; j < d_i; ++j) {
-			for (uint32_t i{ 0 }; i < this->_shape[axis] ; ++i) {
-				result._data[j + d_i * k] += this->_data[d_i * i + d_j * j + d_k * k];
-			}
-		}
-	}
-	#else 	// SSE
 	if (axis == this->_shape.size() - 1) {
-		SSE_tensor_last_axis_sum(this->_size / (d_i * this->_shape[axis]), this->_shape[axis], this->_data.data(), result._data.data());
+		ThreadPool::forEachChunk(this->_size, chunk, [&](uint32_t begin, uint32_t end) {
+			getKernels().tensor_last_axis_sum((end - begin) / k, k, this->_data.data() + begin, result._data.data() + begin / k);
+		});
+	}
+	else if ((1 < n) || (rows_chunk >= k)) {
+		ThreadPool::forEachChunk(this->_size, chunk, [&](uint32_t begin, uint32_t end) {
+			getKernels().tensor_axis_sum((end - begin) / (d_i * k), d_i, k, this->_data.data() + begin, result._data.data() + begin / k);
+		});
 	}
 	else {
-		SSE_tensor_axis_sum(this->_size / (d_i * this->_shape[axis]), d_i, this->_shape[axis], this->_data.data(), result._data.data());
+		// single [k, d_i] block (e.g. sum over batch axis), sums of row chunks are computed in parallel and added
+		std::vector<float> partial(((k + rows_chunk - 1) / rows_chunk) * d_i);
+
+		ThreadPool::forEachChunk(k, rows_chunk, [&](uint32_t begin, uint32_t end) {
+			getKernels().tensor_axis_sum(1, d_i, end - begin, this->_data.data() + begin * d_i, partial.data() + (begin / rows_chunk) * d_i);
+		});
+
+		std::copy(partial.begin(), partial.begin() + d_i, result._data.begin());
+		for (uint32_t i{ d_i }; i < partial.size(); i += d_i) {
+			getKernels().vector_add(d_i, result._data.data(), partial.data() + i, result._data.data());
+		}
 	}
-	#endif	// SSE
 
 	return result;
 }
 
 float Tensor::sum() const {
-	float result{ 0.0f };
+	if (0 == this->_size) {
+		return 0.0f;
+	}
+	const uint32_t chunk{ ThreadPool::getParallelChunkSize(this->_size) };
+	std::vector<float> partial((this->_size + chunk - 1) / chunk);
 	
-	#ifndef SSE
-	for (auto value : _data) {
+	ThreadPool::forEachChunk(this->_size, chunk, [&](uint32_t begin, uint32_t end) {
+		getKernels().tensor_sum(end - begin, this->_data.data() + begin, &partial[begin / chunk]);
+	});
+
+	float result{ 0.0f };
+	for (auto value : partial) {
 		result += value;
 	}
-	#else 	// SSE
-	SSE_tensor_sum(this->_size, this->_data.data(), &result);
-	#endif	// SSE
 
 	return result;
 }
 
 float Tensor::max() const {
-	float result = _data[0];
-
-	for (auto value : _data) {
-		if (value > result) {
-			result = value;
-		}
+	if (0 == this->_size) {
+		return -std::numeric_limits<float>::infinity();
 	}
+	const uint32_t chunk{ ThreadPool::getParallelChunkSize(this->_size) };
+	std::vector<float> partial((this->_size + chunk - 1) / chunk);
 
-	return result;
+	ThreadPool::forEachChunk(this->_size, chunk, [&](uint32_t begin, uint32_t end) {
+		partial[begin / chunk] = *std::max_element(this->_data.begin() + begin, this->_data.begin() + end);
+	});
+
+	return *std::max_element(partial.begin(), partial.end());
 }
 
 float Tensor::min() const {
-	float result = _data[0];
-
-	for (auto value : _data) {
-		if (value < result) {
-			result = value;
-		}
+	if (0 == this->_size) {
+		return std::numeric_limits<float>::infinity();
 	}
+	const uint32_t chunk{ ThreadPool::getParallelChunkSize(this->_size) };
+	std::vector<float> partial((this->_size + chunk - 1) / chunk);
 
-	return result;
+	ThreadPool::forEachChunk(this->_size, chunk, [&](uint32_t begin, uint32_t end) {
+		partial[begin / chunk] = *std::min_element(this->_data.begin() + begin, this->_data.begin() + end);
+	});
+
+	return *std::min_element(partial.begin(), partial.end());
 }
 
 float Tensor::mean() const {
@@ -977,7 +1032,7 @@ float Tensor::mean() const {
 
 }
 
-const Tensor Tensor::transpose() const {
+Tensor Tensor::transpose() const {
 	if (this->_shape.size() != 2) {
 		throw std::invalid_argument(format_string("%s %d : Only transpose of tensors with dim equal 2 is supported. Tensor dim=%d",
 			__FILE__, __LINE__, this->_shape.size()));
@@ -996,7 +1051,7 @@ const Tensor Tensor::transpose() const {
 	return result;
 }
 
-const Tensor Tensor::shuffle() const {
+Tensor Tensor::shuffle() const {
 	uint32_t axis{ 0 }; // currently only for first axis
 
 	Tensor result{ *this };
@@ -1024,7 +1079,7 @@ const Tensor Tensor::shuffle() const {
 	return result;
 }
 
-const Tensor Tensor::shuffle(uint32_t *pattern) const {
+Tensor Tensor::shuffle(uint32_t *pattern) const {
 	uint32_t axis{ 0 }; // currently only for first axis
 
 	Tensor result{ *this };
@@ -1058,7 +1113,7 @@ const Tensor Tensor::shuffle(uint32_t *pattern) const {
 	return result;
 }
 
-const Tensor Tensor::reshape(std::vector<uint32_t> new_shape) const {
+Tensor Tensor::reshape(std::vector<uint32_t> new_shape) const {
 	uint32_t new_size{ 1 };
 	for (auto s : new_shape) {
 		new_size *= s;
@@ -1084,7 +1139,7 @@ void Tensor::print() const {
 }
 
 bool Tensor::validateShape(const Tensor& other) const {
-	uint32_t min_dim{ this->_shape.size() < other._shape.size() ? this->_shape.size() : other._shape.size() };
+	uint32_t min_dim{ static_cast<uint32_t>(this->_shape.size() < other._shape.size() ? this->_shape.size() : other._shape.size()) };
 	
 	for (uint32_t i{ 0 }; i < min_dim; ++i) {
 		if (this->_shape[i] != other._shape[i]) {
@@ -1096,7 +1151,7 @@ bool Tensor::validateShape(const Tensor& other) const {
 }
 
 bool Tensor::validateShapeReversed(const Tensor& other) const {
-	uint32_t min_dim{ this->_shape.size() < other._shape.size() ? this->_shape.size() : other._shape.size() };
+	uint32_t min_dim{ static_cast<uint32_t>(this->_shape.size() < other._shape.size() ? this->_shape.size() : other._shape.size()) };
 	
 	for (uint32_t i{ 0 }; i < min_dim; ++i) {
 		if (this->_shape[this->_shape.size() - i - 1] != other._shape[other._shape.size() - 1 - i]) {
@@ -1107,103 +1162,98 @@ bool Tensor::validateShapeReversed(const Tensor& other) const {
 	return true;
 }
 
-const Tensor& TensorSlice::operator=(const Tensor& other) {
-	if (_slice_ranges.size() != _tensor._shape.size()) {
+void Tensor::validateSize(const Tensor& other) const {
+	if (this->_size != other._size) {
+		throw std::invalid_argument(format_string("%s %d : Tensors have different sizes. size=%d, other size=%d.",
+			__FILE__, __LINE__, this->_size, other._size));
+	}
+}
+
+void Tensor::validateRanges(Range& ranges, const std::vector<uint32_t>& shape) {
+	if (ranges.size() > shape.size()) {
 		throw std::invalid_argument(format_string("%s %d : Ranges exceed tensor shape. Ranges dim=%d, tensor dim=%d.",
-			__FILE__, __LINE__, _slice_ranges.size(), _tensor._shape.size()));
+			__FILE__, __LINE__, ranges.size(), shape.size()));
 	}
-	for (uint32_t i{ 0 }; i < _slice_ranges.size(); ++i) {
-		switch (_slice_ranges[i].size()) {
+	while (ranges.size() < shape.size()) {
+		ranges.push_back(std::vector<uint32_t>{});
+	}
+	for (uint32_t i{ 0 }; i < ranges.size(); ++i) {
+		switch (ranges[i].size()) {
 			case 0:
 				break;
 			case 1:
-				if (_slice_ranges[i][0] >= _tensor._shape[i]) {
+				if (ranges[i][0] >= shape[i]) {
+					throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][0]=%d, tensor shape[]=%d.",
+						__FILE__, __LINE__, i, i, ranges[i][0], shape[i]));
 				}
 				break;
 			case 2:
-				if (_slice_ranges[i][0] >= _slice_ranges[i][1]) {
+				if (ranges[i][0] >= ranges[i][1]) {
 					throw std::invalid_argument(format_string("%s %d : Range at %d has wrong format. First number greater or equal to second. %d >= %d.",
-						__FILE__, __LINE__, i, _slice_ranges[i][0], _slice_ranges[i][1]));
-				}
-				if (_slice_ranges[i][0] > _tensor._shape[i]) {
-					throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][0]=%d, tensor shape[]=%d.",
-						__FILE__, __LINE__, i, i, _slice_ranges[i][0], _tensor._shape[i]));
+						__FILE__, __LINE__, i, ranges[i][0], ranges[i][1]));
 				}
-				if (_slice_ranges[i][1] > _tensor._shape[i]) {
+				if (ranges[i][1] > shape[i]) {
 					throw std::invalid_argument(format_string("%s %d : Range at %d exceeds tensor dimension. Ranges[%d][1]=%d, tensor shape[]=%d.",
-						__FILE__, __LINE__, i, i, _slice_ranges[i][1], _tensor._shape[i]));
+						__FILE__, __LINE__, i, i, ranges[i][1], shape[i]));
 				}
 				break;
 			default:
 				throw std::invalid_argument(format_string("%s %d : Range at %d has wrong format. There should be max 2 numbers but are %d.",
-					__FILE__, __LINE__, _slice_ranges[i].size()));
-				break;
+					__FILE__, __LINE__, i, ranges[i].size()));
 		}
 	}
+}
 
-	std::vector<uint32_t> index(_tensor._shape.size());
+/**
+ * Shape without axes of size 1.
+ */
+static std::vector<uint32_t> squeezedShape(const std::vector<uint32_t>& shape) {
+	std::vector<uint32_t> result;
+	std::copy_if(shape.begin(), shape.end(), std::back_inserter(result), [](uint32_t s) { return 1 != s; });
+	return result;
+}
 
-	for (uint32_t i{ 0 }; i < index.size(); ++i) {
-		if (0 == _slice_ranges[i].size()) {
-			index[i] = 0;
-		}
-		else {
-			index[i] = _slice_ranges[i][0];
-		}
+const Tensor& TensorSlice::operator=(const Tensor& other) {
+	// ranges were validated by Tensor::operator[]
+	const TensorView slice_view = _tensor.view(_slice_ranges);
+
+	if (squeezedShape(slice_view._shape) != squeezedShape(other._shape)) {
+		throw std::invalid_argument(format_string("%s %d : Provided tensor has different shape than slice. Tensor dim=%d, slice dim=%d, tensor size=%d, slice size=%d.",
+			__FILE__, __LINE__, other._shape.size(), slice_view._shape.size(), other._size, slice_view._size));
 	}
 
-	while (true) {
-		// set value
-		std::vector<uint32_t> sub_index;
+	assign(slice_view, other.view());
 
-		for (uint32_t i{ 0 }; i < index.size(); ++i) {
-			if (2 == _slice_ranges[i].size()) {
-				sub_index.push_back(index[i] - _slice_ranges[i][0]);
-			}
-			else if (0 == _slice_ranges[i].size()) {
-				sub_index.push_back(index[i]);
-			}
-		}
-		
-		_tensor[index] = other[sub_index];
-
-		// increment index
-		bool inc_next = false;
-		for (int32_t i{ static_cast<int32_t>(index.size() - 1) }; i >= 0; --i) {
-			if (0 == _slice_ranges[i].size()) {
-				++index[i];
-				if (index[i] >= _tensor._shape[i]) {
-					// overflow
-					index[i] = 0;
-					inc_next = true;
-				}
-				else {
-					inc_next = false;
-					break;
-				}
-			}
-			else if (2 == _slice_ranges[i].size()) {
-				++index[i];
-				if (index[i] >= _slice_ranges[i][1]) {
-					// overfloww
-					index[i] = _slice_ranges[i][0];
-					inc_next = true;
-				}
-				else {
-					inc_next = false;
-					break;
-				}
-			}
-		}
+	return other;
+}
 
-		if (inc_next) {
-			break;
-		}
+const TensorView& TensorSlice::operator=(const TensorView& other) {
+	const TensorView slice_view = _tensor.view(_slice_ranges);
+
+	if (slice_view._size != other._size) {
+		throw std::invalid_argument(format_string("%s %d : Provided view has different size than slice. View size=%d, slice size=%d.",
+			__FILE__, __LINE__, other._size, slice_view._size));
 	}
 
+	assign(slice_view, other);
+
 	return other;
 }
 
+void TensorSlice::assign(const TensorView& slice_view, const TensorView& other) {
+	if (slice_view.isContiguous()) {
+		other.copyTo(_tensor._data.data() + slice_view._offset);
+	}
+	else if (other.isContiguous()) {
+		slice_view.copyFrom(other._data + other._offset);
+	}
+	else {
+		std::vector<float> tmp(other._size);
+		other.copyTo(tmp.data());
+		slice_view.copyFrom(tmp.data());
+	}
+}
+
 float TensorCell::operator=(float value) {
 	if (_cell_index.size() != _tensor._shape.size()) {
 		throw std::invalid_argument(format_string("%s %d : Indices dim is different than tensor dim. Indices dim=%d, tensor dim=%d.",
@@ -1225,4 +1275,264 @@ float TensorCell::operator=(float value) {
 	_tensor._data[flat_idx] = value;
 
 	return value;
-}
\ No newline at end of file
+}
+
+TensorView::TensorView(const float* data, uint32_t offset, std::vector<uint32_t> shape, std::vector<uint32_t> strides) :
+	_data(data), _offset(offset), _shape(std::move(shape)), _strides(std::move(strides)) {
+	_size = 1;
+	for (auto s : _shape) {
+		_size *= s;
+	}
+}
+
+const TensorView TensorView::operator[](Tensor::Range ranges) const {
+	Tensor::validateRanges(ranges, this->_shape);
+
+	uint32_t offset{ this->_offset };
+	std::vector<uint32_t> shape;
+	std::vector<uint32_t> strides;
+
+	for (uint32_t i{ 0 }; i < ranges.size(); ++i) {
+		switch (ranges[i].size()) {
+			case 0:
+				shape.push_back(this->_shape[i]);
+				strides.push_back(this->_strides[i]);
+				break;
+			case 1:
+				offset += ranges[i][0] * this->_strides[i];
+				break;
+			case 2:
+				offset += ranges[i][0] * this->_strides[i];
+				shape.push_back(ranges[i][1] - ranges[i][0]);
+				strides.push_back(this->_strides[i]);
+				break;
+		}
+	}
+
+	return TensorView(this->_data, offset, shape, strides);
+}
+
+float TensorView::operator[](const Tensor::Index& index) const {
+	if (index.size() != this->_shape.size()) {
+		throw std::invalid_argument(format_string("%s %d : Indices dim is different than view dim. Indices dim=%d, view dim=%d.",
+			__FILE__, __LINE__, index.size(), this->_shape.size()));
+	}
+
+	uint32_t offset{ this->_offset };
+
+	for (uint32_t i{ 0 }; i < this->_shape.size(); ++i) {
+		if (index[i] >= this->_shape[i]) {
+			throw std::invalid_argument(format_string("%s %d : Index at %d exceeds view dimension. Index[%d]=%d, view shape[]=%d.",
+				__FILE__, __LINE__, i, i, index[i], this->_shape[i]));
+		}
+		offset += index[i] * this->_strides[i];
+	}
+
+	return this->_data[offset];
+}
+
+std::vector<uint32_t> TensorView::getShape() const {
+	return _shape;
+}
+
+std::vector<uint32_t> TensorView::getStrides() const {
+	return _strides;
+}
+
+uint32_t TensorView::getDim() const {
+	return _shape.size();
+}
+
+uint32_t TensorView::getSize() const {
+	return _size;
+}
+
+bool TensorView::isContiguous() const {
+	uint32_t stride{ 1 };
+
+	for (int32_t i{ static_cast<int32_t>(this->_shape.size()) - 1 }; i >= 0; --i) {
+		if ((1 != this->_shape[i]) && (stride != this->_strides[i])) {
+			return false;
+		}
+		stride *= this->_shape[i];
+	}
+
+	return true;
+}
+
+const TensorView TensorView::reshape(std::vector<uint32_t> new_shape) const {
+	uint32_t new_size{ 1 };
+	for (auto s : new_shape) {
+		new_size *= s;
+	}
+	if (new_size != this->_size) {
+		throw std::invalid_argument(format_string("%s %d : Provided new shape changes size of view. New size=%d, old size=%d.",
+			__FILE__, __LINE__, new_size, this->_size));
+	}
+	if (!this->isContiguous()) {
+		throw std::invalid_argument(format_string("%s %d : Only contiguous view can be reshaped. View shape=%s, view strides=%s.",
+			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(this->_strides).c_str()));
+	}
+
+	std::vector<uint32_t> strides(new_shape.size());
+
+	uint32_t stride{ 1 };
+	for (int32_t i{ static_cast<int32_t>(new_shape.size()) - 1 }; i >= 0; --i) {
+		strides[i] = stride;
+		stride *= new_shape[i];
+	}
+
+	return TensorView(this->_data, this->_offset, new_shape, strides);
+}
+
+const TensorView TensorView::flatten(uint32_t from_axis) const {
+	if (from_axis >= this->_shape.size()) {
+		throw std::invalid_argument(format_string("%s %d : Provided axis exceeds view dim. axis=%d, view dim=%d",
+			__FILE__, __LINE__, from_axis, this->_shape.size()));
+	}
+
+	// flattened axes must be contiguous among themselves (axes of size 1 can be skipped)
+	uint32_t subsize{ 1 };
+	uint32_t stride{ 1 };
+	bool inner_found{ false };
+
+	for (int32_t i{ static_cast<int32_t>(this->_shape.size()) - 1 }; i >= static_cast<int32_t>(from_axis); --i) {
+		if (1 == this->_shape[i]) {
+			continue;
+		}
+		if (!inner_found) {
+			stride = this->_strides[i];
+			inner_found = true;
+		}
+		else if (this->_strides[i] != stride * subsize) {
+			throw std::invalid_argument(format_string("%s %d : Flattened axes of the view are not contiguous. View shape=%s, view strides=%s.",
+				__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(this->_strides).c_str()));
+		}
+		subsize *= this->_shape[i];
+	}
+
+	std::vector<uint32_t> shape(this->_shape.begin(), this->_shape.begin() + from_axis);
+	std::vector<uint32_t> strides(this->_strides.begin(), this->_strides.begin() + from_axis);
+
+	shape.push_back(subsize);
+	strides.push_back(stride);
+
+	return TensorView(this->_data, this->_offset, shape, strides);
+}
+
+const TensorView TensorView::transpose() const {
+	if (this->_shape.size() != 2) {
+		throw std::invalid_argument(format_string("%s %d : Only transpose of views with dim equal 2 is supported. View dim=%d",
+			__FILE__, __LINE__, this->_shape.size()));
+	}
+
+	return TensorView(this->_data, this->_offset, { this->_shape[1], this->_shape[0] }, { this->_strides[1], this->_strides[0] });
+}
+
+Tensor TensorView::dotProduct(const TensorView& other) const {
+	if ((this->_shape.size() != 2) || (other._shape.size() != 2) || (this->_shape[1] != other._shape[0])) {
+		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
+			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
+	}
+
+	Tensor result({ this->_shape[0], other._shape[1] });
+
+	gemm(this->_shape[0], other._shape[1], this->_shape[1],
+		this->_data + this->_offset, this->_strides[0], this->_strides[1],
+		other._data + other._offset, other._strides[0], other._strides[1],
+		result._data.data(), other._shape[1]);
+
+	return result;
+}
+
+Tensor TensorView::dotProductTranspose(const TensorView& other) const {
+	if ((this->_shape.size() != 2) || (other._shape.size() != 2) || (this->_shape[1] != other._shape[1])) {
+		throw std::invalid_argument(format_string("%s %d : Provided operands has wrong shapes. First operand shape=%s, second operand shape=%s",
+			__FILE__, __LINE__, vector_to_string(this->_shape).c_str(), vector_to_string(other._shape).c_str()));
+	}
+
+	return dotProduct(other.transpose());
+}
+
+/**
+ * Calls func(offset, count, stride) for runs of view values in row-major order, a run is count values starting at
+ * offset and distant by stride. Axes of size 1 are skipped and axes contiguous with the next one are merged, so runs
+ * are as long as possible (whole view is a single run if it is contiguous).
+ */
+template <typename Func>
+static void forEachRun(uint32_t offset, const std::vector<uint32_t>& shape, const std::vector<uint32_t>& strides, const Func& func) {
+	// merged axes from the most inner one
+	std::vector<uint32_t> run_shape;
+	std::vector<uint32_t> run_strides;
+
+	for (int32_t i{ static_cast<int32_t>(shape.size()) - 1 }; i >= 0; --i) {
+		if (1 == shape[i]) {
+			continue;
+		}
+		if (!run_shape.empty() && (strides[i] == run_strides.back() * run_shape.back())) {
+			run_shape.back() *= shape[i];
+		}
+		else {
+			run_shape.push_back(shape[i]);
+			run_strides.push_back(strides[i]);
+		}
+	}
+
+	if (run_shape.empty()) {
+		func(offset, 1, 1);
+		return;
+	}
+
+	const uint32_t dim{ static_cast<uint32_t>(run_shape.size()) };
+	std::vector<uint32_t> index(dim, 0);
+
+	while (true) {
+		func(offset, run_shape[0], run_strides[0]);
+
+		// increment index (all axes but the most inner one)
+		uint32_t i{ 1 };
+		for (; i < dim; ++i) {
+			offset += run_strides[i];
+			if (++index[i] < run_shape[i]) {
+				break;
+			}
+			offset -= run_strides[i] * run_shape[i];
+			index[i] = 0;
+		}
+		if (i == dim) {
+			return;
+		}
+	}
+}
+
+void TensorView::copyTo(float* dst) const {
+	forEachRun(this->_offset, this->_shape, this->_strides, [&](uint32_t offset, uint32_t count, uint32_t stride) {
+		const float* src{ this->_data + offset };
+		if (1 == stride) {
+			std::memmove(dst, src, sizeof(float) * count);
+		}
+		else {
+			for (uint32_t j{ 0 }; j < count; ++j) {
+				dst[j] = src[j * stride];
+			}
+		}
+		dst += count;
+	});
+}
+
+void TensorView::copyFrom(const float* src) const {
+	float* data{ const_cast<float*>(this->_data) };
+
+	forEachRun(this->_offset, this->_shape, this->_strides, [&](uint32_t offset, uint32_t count, uint32_t stride) {
+		float* dst{ data + offset };
+		if (1 == stride) {
+			std::memmove(dst, src, sizeof(float) * count);
+		}
+		else {
+			for (uint32_t j{ 0 }; j < count; ++j) {
+				dst[j * stride] = src[j];
+			}
+		}
+		src += count;
+	});
+}
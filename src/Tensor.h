@@ -8,75 +8,28 @@
 #include <ctime>
 #include <algorithm>
 #include <cstdio>
+#include <stdexcept>
 #include <thread>
 
+#include "TensorAllocator.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
-#ifdef SSE
-	#ifndef WIN
-		#define SSE_vector_inner_product 			_SSE_vector_inner_product
-
-		#define SSE_vector_add 						_SSE_vector_add
-		#define SSE_tensor_add 						_SSE_tensor_add
-		#define SSE_tensor_add_scalar 				_SSE_tensor_add_scalar
-
-		#define SSE_vector_sub 						_SSE_vector_sub
-		#define SSE_tensor_sub 						_SSE_tensor_sub
-		#define SSE_tensor_sub_scalar 				_SSE_tensor_sub_scalar
-		#define SSE_scalar_sub_tensor 				_SSE_scalar_sub_tensor
-
-		#define SSE_vector_mul 						_SSE_vector_mul
-		#define SSE_tensor_mul 						_SSE_tensor_mul
-		#define SSE_tensor_mul_scalar 				_SSE_tensor_mul_scalar
-
-		#define SSE_vector_div 						_SSE_vector_div
-		#define SSE_tensor_div 						_SSE_tensor_div
-		#define SSE_tensor_div_scalar 				_SSE_tensor_div_scalar
-		#define SSE_scalar_div_tensor 				_SSE_scalar_div_tensor
-		
-		#define SSE_tensor_sum 						_SSE_tensor_sum
-		#define SSE_tensor_axis_sum					_SSE_tensor_axis_sum
-		#define SSE_tensor_last_axis_sum			_SSE_tensor_last_axis_sum
-
-		#define SSE_tensor_dot_product_transpose	_SSE_tensor_dot_product_transpose
-	#endif
-	
-	extern "C" {
-		void SSE_vector_inner_product(const uint32_t n, const float* v1, const float* v2, float* r);
-
-		void SSE_vector_add(const uint32_t n, const float* v1, const float* v2, float* r);
-		void SSE_tensor_add(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
-		void SSE_tensor_add_scalar(const uint32_t n, const float* v, const float* s, float* r);
-		
-		void SSE_vector_sub(const uint32_t n, const float* v1, const float* v2, float* r);
-		void SSE_tensor_sub(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
-		void SSE_tensor_sub_scalar(const uint32_t n, const float* v, const float* s, float* r);
-		void SSE_scalar_sub_tensor(const float* s, const uint32_t n, const float* v, float* r);
-
-		void SSE_vector_mul(const uint32_t n, const float* v1, const float* v2, float* r);
-		void SSE_tensor_mul(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
-		void SSE_tensor_mul_scalar(const uint32_t n, const float* v, const float* s, float* r);
-
-		void SSE_vector_div(const uint32_t n, const float* v1, const float* v2, float* r);
-		void SSE_tensor_div(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
-		void SSE_tensor_div_scalar(const uint32_t n, const float* v, const float* s, float* r);
-		void SSE_scalar_div_tensor(const float* s, const uint32_t n, const float* v, float* r);
-		
-		void SSE_tensor_sum(const uint32_t n, const float* v, float* r);
-		void SSE_tensor_axis_sum(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r);
-		void SSE_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r);
-
-		void SSE_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r);
-	}
-#endif
-
 enum Padding : uint8_t {
 	Left = 0x01,
 	Right = 0x02,
 	Both = 0x03,
 };
 
+/**
+ * Number of values computed at once by Tensor::map and Tensor::zip in local arrays.
+ */
+constexpr uint32_t TENSOR_MAP_BLOCK{ 16 };
+
 class Tensor;
+class TensorView;
+class TensorExpressionLeaf;
+template <typename Expr> class TensorExpression;
 
 /**
  * @brief TensorSlice class used for tensor slice assignment.
@@ -84,11 +37,19 @@ class Tensor;
 class TensorSlice {
 public:
     /**
-     * Assigns a tensor values to the slice.
+     * Assigns a tensor values to the slice. Shape of the tensor has to match shape of the slice
+     * (axes selected by a single index are not part of the slice shape, other axes of size 1 are ignored).
      * @brief assign operator.
      * @param other The tensor which values are used.
      */
 	const Tensor& operator=(const Tensor& other);
+    /**
+     * Assigns values of a tensor view to the slice. Values are copied in row-major order,
+     * so the view may have different shape than the slice as long as sizes are equal.
+     * @brief assign operator.
+     * @param other The view which values are used.
+     */
+	const TensorView& operator=(const TensorView& other);
 
 private:
 	TensorSlice() = delete;
@@ -100,6 +61,13 @@ private:
      */
 	TensorSlice(Tensor& tensor, std::vector<std::vector<uint32_t> > slice_ranges) :
 		_tensor(tensor), _slice_ranges(slice_ranges) {}
+    /**
+     * Copies values of a view of equal size to the slice.
+     * @brief assign values.
+     * @param slice_view View of the slice.
+     * @param other The view which values are used.
+     */
+	void assign(const TensorView& slice_view, const TensorView& other);
 
     /**
      * The tensor which slice is represented by TensorSlice.
@@ -178,20 +146,51 @@ public:
      * @param other Another Tensor object.
      */
 	Tensor(const Tensor& other);
+    /**
+     * Construct a new Tensor object taking over values of another Tensor object.
+     * @brief Move constructor.
+	 * 
+     * @param other Another Tensor object, left empty.
+     */
+	Tensor(Tensor&& other) noexcept;
+    /**
+     * Construct a new Tensor object from values seen through a TensorView.
+     * @brief Copy constructor.
+	 * 
+     * @param view TensorView object.
+     */
+	Tensor(const TensorView& view);
+    /**
+     * Construct a new Tensor object holding result of a lazy element-wise expression (see TensorExpression.h).
+     * @brief Expression constructor.
+	 * 
+     * @param expression Expression evaluated in a single pass.
+     */
+	template <typename Expr>
+	Tensor(const TensorExpression<Expr>& expression);
     /**
      * Copies values from another Tensor objects.
      * @brief Assign operator.
 	 * 
      * @param other Another Tensor object.
      */
-	const Tensor& operator=(const Tensor& other);
+	Tensor& operator=(const Tensor& other);
     /**
-     * Moves values from another Tensor objects.
+     * Moves values from another Tensor objects. The buffer is taken over only if both tensors use the same allocator,
+     * otherwise values are copied to a buffer of this Tensor's allocator.
      * @brief Move operator.
 	 * 
-     * @param other Another Tensor object.
+     * @param other Another Tensor object, left empty.
      */
-	const Tensor& operator=(const Tensor&& other);
+	Tensor& operator=(Tensor&& other);
+    /**
+     * Evaluates lazy element-wise expression into the Tensor, values buffer is reused if the size matches.
+     * @brief Expression assign operator.
+	 * 
+     * @param expression Expression evaluated in a single pass, may refer to this Tensor.
+     */
+	template <typename Expr>
+	Tensor& operator=(const TensorExpression<Expr>& expression);
 
     /**
      * Creates a new Tensor object of given shape and values from normal distribution.
@@ -201,15 +200,38 @@ public:
 	 * @return Tensor with values sampled from Normal Distribution.
      */
 	static Tensor RandomNormal(const std::vector<uint32_t>& shape);
+    /**
+     * Arithmetic and comparison operators, applyFunction, math functions and reductions are split between threads of the global ThreadPool
+     * only for tensors of at least threshold elements, smaller tensors are processed by the calling thread.
+	 * @brief Set element count threshold of parallel execution.
+	 * 
+     * @param threshold Minimal number of elements (0 disables parallel execution).
+     */
+	static void setParallelThreshold(uint32_t threshold);
+    /**
+	 * @brief Get element count threshold of parallel execution.
+	 * 
+	 * @return Minimal number of elements processed in parallel.
+     */
+	static uint32_t getParallelThreshold();
+    /**
+     * Returns size of chunks tensor of given size is split into for parallel processing.
+	 * @brief Get parallel chunk size.
+	 * 
+     * @param size Number of elements.
+     * @param alignment Chunk size is a multiple of alignment.
+	 * @return Chunk size, equal to size if the tensor is processed by the calling thread only.
+     */
+	static uint32_t getParallelChunkSize(uint32_t size, uint32_t alignment = 16);
 
     /**
-     * Returns a slice of Tensor as a Tensor (rvalue).
+     * Returns a slice of Tensor as a Tensor (rvalue). Values of the slice are copied, view(ranges) returns it without copying.
 	 * @brief Subscript operator.
 	 * 
      * @param ranges Ranges of selected slice.
 	 * @return Slice as a Tensor.
      */
-	const Tensor operator[](std::vector<std::vector<uint32_t> > ranges) const;
+	Tensor operator[](std::vector<std::vector<uint32_t> > ranges) const;
     /**
      * Returns a slice of Tensor as a TensorSlice (lvalue).
 	 * @brief Subscript operator.
@@ -257,6 +279,23 @@ public:
 		return operator[](std::vector<uint32_t>(ini));
 	}
 
+    /**
+     * Returns a view of the whole Tensor. No values are copied, the view is valid as long as
+	 * the tensor is alive and its values are not reallocated (e.g. by assignment).
+	 * @brief Creates a TensorView of the Tensor.
+	 * 
+	 * @return View of the tensor.
+     */
+	const TensorView view() const;
+    /**
+     * Returns a slice of Tensor as a TensorView. No values are copied.
+	 * @brief Creates a TensorView of the Tensor slice.
+	 * 
+     * @param ranges Ranges of selected slice.
+	 * @return View of the slice.
+     */
+	const TensorView view(Range ranges) const;
+
     /**
      * @brief Get shape of the Tensor.
 	 * 
@@ -281,6 +320,19 @@ public:
 	 * @return Values of the tensor.
      */
 	std::vector<float> getData() const;
+    /**
+     * Values are stored in row-major order, the pointer is valid until the Tensor is resized, moved from or destroyed.
+     * @brief Get pointer to values of the Tensor.
+	 * 
+	 * @return Pointer to the first value.
+     */
+	float* getDataPointer();
+    /**
+     * @brief Get pointer to values of the Tensor.
+	 * 
+	 * @return Pointer to the first value.
+     */
+	const float* getDataPointer() const;
 
     /**
      * @brief Sets all values of the Tensor.
@@ -294,7 +346,13 @@ public:
 	 * 
      * @return Tensor with values with opposite sign.
      */
-	const Tensor operator-() const;
+	Tensor operator-() const &;
+    /**
+     * @brief Minus operator overloading, reuses values buffer of expiring tensor.
+	 * 
+     * @return Tensor with values with opposite sign.
+     */
+	Tensor operator-() &&;
 
     /**
 	 * Adds tensors element-wise and store values is left operand.
@@ -311,7 +369,15 @@ public:
 	 * @param other Right operand.
      * @return Element-wise sum of operands.
      */
-	const Tensor operator+(const Tensor& other) const;
+	Tensor operator+(const Tensor& other) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Addition operator overloading.
+	 * 
+	 * @param other Right operand.
+     * @return Element-wise sum of operands.
+     */
+	Tensor operator+(const Tensor& other) &&;
     /**
      * Adds tensor and float element-wise and store values is left operand.
      * @brief Addition assignment operator overloading.
@@ -327,7 +393,15 @@ public:
 	 * @param number Right operand.
      * @return Element-wise sum of operands.
      */
-	const Tensor operator+(float number) const;
+	Tensor operator+(float number) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Addition operator overloading.
+	 * 
+	 * @param number Right operand.
+     * @return Element-wise sum of operands.
+     */
+	Tensor operator+(float number) &&;
     /**
      * Adds float and tensor element-wise and return result as a new tensor.
      * @brief Addition operator overloading.
@@ -336,7 +410,16 @@ public:
 	 * @param other Right operand.
      * @return Element-wise sum of operands.
      */
-	friend const Tensor operator+(float number, const Tensor& other);
+	friend Tensor operator+(float number, const Tensor& other);
+    /**
+     * Same as above, but the result is computed in place of expiring right operand, so no new tensor is allocated.
+     * @brief Addition operator overloading.
+	 * 
+	 * @param number Left operand.
+	 * @param other Right operand.
+     * @return Element-wise sum of operands.
+     */
+	friend Tensor operator+(float number, Tensor&& other);
 
     /**
      * Subtracts tensors element-wise and store values is left operand.
@@ -353,7 +436,15 @@ public:
 	 * @param other Right operand.
      * @return Element-wise difference of operands.
      */
-	const Tensor operator-(const Tensor& other) const;
+	Tensor operator-(const Tensor& other) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Subtraction operator overloading.
+	 * 
+	 * @param other Right operand.
+     * @return Element-wise difference of operands.
+     */
+	Tensor operator-(const Tensor& other) &&;
     /**
      * Subtracts float from tensor element-wise and store values is left operand.
      * @brief Subtraction assignment operator overloading.
@@ -369,7 +460,15 @@ public:
 	 * @param number Right operand.
      * @return Element-wise difference of operands.
      */
-	const Tensor operator-(float number) const;
+	Tensor operator-(float number) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Subtraction operator overloading.
+	 * 
+	 * @param number Right operand.
+     * @return Element-wise difference of operands.
+     */
+	Tensor operator-(float number) &&;
     /**
      * Subtracts tensor from float element-wise and return result as a new tensor.
      * @brief Subtraction operator overloading.
@@ -378,7 +477,16 @@ public:
 	 * @param other Right operand.
      * @return Element-wise difference of operands.
      */
-	friend const Tensor operator-(float number, const Tensor& other);
+	friend Tensor operator-(float number, const Tensor& other);
+    /**
+     * Same as above, but the result is computed in place of expiring right operand, so no new tensor is allocated.
+     * @brief Subtraction operator overloading.
+	 * 
+	 * @param number Left operand.
+	 * @param other Right operand.
+     * @return Element-wise difference of operands.
+     */
+	friend Tensor operator-(float number, Tensor&& other);
 
     /**
      * Multiplies tensors element-wise and store values is left operand.
@@ -395,7 +503,15 @@ public:
 	 * @param other Right operand.
      * @return Element-wise product of operands.
      */
-	const Tensor operator*(const Tensor& other) const;
+	Tensor operator*(const Tensor& other) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Multiplication operator overloading.
+	 * 
+	 * @param other Right operand.
+     * @return Element-wise product of operands.
+     */
+	Tensor operator*(const Tensor& other) &&;
     /**
      * Multiplies tensor and float element-wise and store values is left operand.
      * @brief Multiplication assignment operator overloading.
@@ -411,7 +527,15 @@ public:
 	 * @param number Right operand.
      * @return Element-wise product of operands.
      */
-	const Tensor operator*(float number) const;
+	Tensor operator*(float number) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Multiplication operator overloading.
+	 * 
+	 * @param number Right operand.
+     * @return Element-wise product of operands.
+     */
+	Tensor operator*(float number) &&;
     /**
      * Multiplies float and tensor element-wise and return result as a new tensor.
      * @brief Multiplication operator overloading.
@@ -420,7 +544,16 @@ public:
 	 * @param other Right operand.
      * @return Element-wise product of operands.
      */
-	friend const Tensor operator*(float number, const Tensor& other);
+	friend Tensor operator*(float number, const Tensor& other);
+    /**
+     * Same as above, but the result is computed in place of expiring right operand, so no new tensor is allocated.
+     * @brief Multiplication operator overloading.
+	 * 
+	 * @param number Left operand.
+	 * @param other Right operand.
+     * @return Element-wise product of operands.
+     */
+	friend Tensor operator*(float number, Tensor&& other);
 
     /**
      * Divides tensors element-wise and store values is left operand.
@@ -437,7 +570,15 @@ public:
 	 * @param other Right operand.
      * @return Element-wise quotient of operands.
      */
-	const Tensor operator/(const Tensor& other) const;
+	Tensor operator/(const Tensor& other) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Division operator overloading.
+	 * 
+	 * @param other Right operand.
+     * @return Element-wise quotient of operands.
+     */
+	Tensor operator/(const Tensor& other) &&;
     /**
      * Divides tensor by float element-wise and store values is left operand.
      * @brief Division assignment operator overloading.
@@ -453,7 +594,15 @@ public:
 	 * @param number Right operand.
      * @return Element-wise quotient of operands.
      */
-	const Tensor operator/(float number) const;
+	Tensor operator/(float number) const &;
+    /**
+     * Same as above, but the result is computed in place of expiring left operand, so no new tensor is allocated.
+     * @brief Division operator overloading.
+	 * 
+	 * @param number Right operand.
+     * @return Element-wise quotient of operands.
+     */
+	Tensor operator/(float number) &&;
     /**
      * Divides float by tensor element-wise and return result as a new tensor.
      * @brief Division operator overloading.
@@ -462,7 +611,16 @@ public:
 	 * @param other Right operand.
      * @return Element-wise quotient of operands.
      */
-	friend const Tensor operator/(float number, const Tensor& other);
+	friend Tensor operator/(float number, const Tensor& other);
+    /**
+     * Same as above, but the result is computed in place of expiring right operand, so no new tensor is allocated.
+     * @brief Division operator overloading.
+	 * 
+	 * @param number Left operand.
+	 * @param other Right operand.
+     * @return Element-wise quotient of operands.
+     */
+	friend Tensor operator/(float number, Tensor&& other);
 
     /**
      * Compares tensors element-wise and return result as a new tensor where 1.0f is set when values are equal and 0.0f in other case.
@@ -471,7 +629,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise equal operator result of operands.
      */
-	const Tensor operator==(const Tensor& other) const;
+	Tensor operator==(const Tensor& other) const;
     /**
      * Compares tensors element-wise and return result as a new tensor where 1.0f is set when values are not equal and 0.0f in other case.
 	 * @brief Not equal operator overloading.
@@ -479,7 +637,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise not equal operator result of operands.
      */
-	const Tensor operator!=(const Tensor& other) const;
+	Tensor operator!=(const Tensor& other) const;
     /**
      * Compares tensors element-wise and return result as a new tensor where 1.0f is set when value of left operand is greater and 0.0f in other case.
 	 * @brief Greater operator overloading.
@@ -487,7 +645,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise greater operator result of operands.
      */
-	const Tensor operator>(const Tensor& other) const;
+	Tensor operator>(const Tensor& other) const;
     /**
      * Compares tensors element-wise and return result as a new tensor where 1.0f is set when value of left operand is greater or equal and 0.0f in other case.
 	 * @brief Greater or equal operator overloading.
@@ -495,7 +653,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise greater or equal operator result of operands.
      */
-	const Tensor operator>=(const Tensor& other) const;
+	Tensor operator>=(const Tensor& other) const;
     /**
      * Compares tensors element-wise and return result as a new tensor where 1.0f is set when value of left operand is less and 0.0f in other case.
 	 * @brief Less operator overloading.
@@ -503,7 +661,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise less operator result of operands.
      */
-	const Tensor operator<(const Tensor& other) const;
+	Tensor operator<(const Tensor& other) const;
     /**
      * Compares tensors element-wise and return result as a new tensor where 1.0f is set when value of left operand is less or equal and 0.0f in other case.
 	 * @brief Less or equal operator overloading.
@@ -511,7 +669,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise less or equal operator result of operands.
      */
-	const Tensor operator<=(const Tensor& other) const;
+	Tensor operator<=(const Tensor& other) const;
 	
     /**
      * Compares tensor values element-wise with float and return result as a new tensor where 1.0f is set when values are equal and 0.0f in other case.
@@ -520,7 +678,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise equal operator result of operands.
      */
-	const Tensor operator==(float other) const;
+	Tensor operator==(float other) const;
     /**
      * Compares tensor values element-wise with float and return result as a new tensor where 1.0f is set when values are not equal and 0.0f in other case.
 	 * @brief Not equal operator overloading.
@@ -528,7 +686,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise not equal operator result of operands.
      */
-	const Tensor operator!=(float other) const;
+	Tensor operator!=(float other) const;
     /**
      * Compares tensor values element-wise with float and return result as a new tensor where 1.0f is set when value of tensor is greater and 0.0f in other case.
 	 * @brief Greater operator overloading.
@@ -536,7 +694,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise greater operator result of operands.
      */
-	const Tensor operator>(float other) const;
+	Tensor operator>(float other) const;
     /**
      * Compares tensor values element-wise with float and return result as a new tensor where 1.0f is set when value of tensor is greater or equal and 0.0f in other case.
 	 * @brief Greater or equal operator overloading.
@@ -544,7 +702,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise greater or equal operator result of operands.
      */
-	const Tensor operator>=(float other) const;
+	Tensor operator>=(float other) const;
     /**
      * Compares tensor values element-wise with float and return result as a new tensor where 1.0f is set when value of tensor is less and 0.0f in other case.
 	 * @brief Less operator overloading.
@@ -552,7 +710,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise less operator result of operands.
      */
-	const Tensor operator<(float other) const;
+	Tensor operator<(float other) const;
     /**
      * Compares tensor values element-wise with float and return result as a new tensor where 1.0f is set when value of tensor is less or equal and 0.0f in other case.
 	 * @brief Less or equal operator overloading.
@@ -560,7 +718,7 @@ public:
 	 * @param other Right operand.
      * @return Element-wise less or equal operator result of operands.
      */
-	const Tensor operator<=(float other) const;
+	Tensor operator<=(float other) const;
 	
 	/**
 	 * @brief Adds padding to the Tensor.
@@ -570,50 +728,171 @@ public:
 	 * @param counts Lengths of paddings.
 	 * @return Tensor with added paddings.
 	 */
-	const Tensor addPadding(const std::vector<uint32_t>& axes, const std::vector<Padding>& paddings, const std::vector<uint32_t>& counts) const;
+	Tensor addPadding(const std::vector<uint32_t>& axes, const std::vector<Padding>& paddings, const std::vector<uint32_t>& counts) const;
 	/**
 	 * @brief Computes dot product of two operands.
 	 * 
 	 * @param other Another Tensor object.
 	 * @return Dot product result.
 	 */
-	const Tensor dotProduct(const Tensor& other) const;
+	Tensor dotProduct(const Tensor& other) const;
+	/**
+	 * @brief Computes dot product of two 2-dim operands, where the right one is a view.
+	 * 
+	 * @param other TensorView object.
+	 * @return Dot product result.
+	 */
+	Tensor dotProduct(const TensorView& other) const;
 	/**
 	 * @brief Computes dot product of left operand and transposition of right operand.
 	 * 
 	 * @param other Another Tensor object.
 	 * @return Dot product result.
 	 */
-	const Tensor dotProductTranspose(const Tensor& other) const;
+	Tensor dotProductTranspose(const Tensor& other) const;
+	/**
+	 * @brief Computes dot product of left operand and transposition of right operand, where the right one is a view.
+	 * 
+	 * @param other TensorView object.
+	 * @return Dot product result.
+	 */
+	Tensor dotProductTranspose(const TensorView& other) const;
 	/**
 	 * @brief Computes tensor product of two operands.
 	 * 
 	 * @param other Another Tensor object.
 	 * @return Tensor product result.
 	 */
-	const Tensor tensorProduct(const Tensor& other) const;
+	Tensor tensorProduct(const Tensor& other) const;
 	/**
 	 * @brief Applies function element-wise.
 	 * 
 	 * @param function Function ot be applied.
 	 * @return Tensor that contains results of the function.
 	 */
-	const Tensor applyFunction(float (*function)(float)) const;
+	Tensor applyFunction(float (*function)(float)) const;
+	/**
+	 * Unlike applyFunction the callable is a template parameter, so it is inlined and simple functions are vectorized
+	 * by the compiler. Chunks of values are split between threads of the global ThreadPool above the parallel threshold,
+	 * so func must be safe to call concurrently (e.g. use thread_local random generators, see Utils.h).
+	 * @brief Applies callable element-wise, result = func(value).
+	 * 
+	 * @param func Callable float(float).
+	 * @return Tensor that contains results of func.
+	 */
+	template <typename Func>
+	Tensor map(const Func& func) const;
+	/**
+	 * @brief Applies callable element-wise in place, value = func(value).
+	 * 
+	 * @param func Callable float(float).
+	 * @return Reference to the Tensor.
+	 */
+	template <typename Func>
+	Tensor& mapInPlace(const Func& func);
+	/**
+	 * Tensors are not broadcasted, other must have the same size.
+	 * @brief Applies callable element-wise to pairs of values, result = func(value, other_value).
+	 * 
+	 * @param other Another Tensor object.
+	 * @param func Callable float(float, float).
+	 * @return Tensor that contains results of func.
+	 */
+	template <typename Func>
+	Tensor zip(const Tensor& other, const Func& func) const;
+	/**
+	 * @brief Applies callable element-wise to pairs of values in place, value = func(value, other_value).
+	 * 
+	 * @param other Another Tensor object of the same size.
+	 * @param func Callable float(float, float).
+	 * @return Reference to the Tensor.
+	 */
+	template <typename Func>
+	Tensor& zipInPlace(const Tensor& other, const Func& func);
+	/**
+	 * @brief Applies callable element-wise to triples of values, result = func(value, other1_value, other2_value).
+	 * 
+	 * @param other1 Another Tensor object of the same size.
+	 * @param other2 Another Tensor object of the same size.
+	 * @param func Callable float(float, float, float).
+	 * @return Tensor that contains results of func.
+	 */
+	template <typename Func>
+	Tensor zip(const Tensor& other1, const Tensor& other2, const Func& func) const;
+	/**
+	 * @brief Applies callable element-wise to triples of values in place, value = func(value, other1_value, other2_value).
+	 * 
+	 * @param other1 Another Tensor object of the same size.
+	 * @param other2 Another Tensor object of the same size.
+	 * @param func Callable float(float, float, float).
+	 * @return Reference to the Tensor.
+	 */
+	template <typename Func>
+	Tensor& zipInPlace(const Tensor& other1, const Tensor& other2, const Func& func);
+	/**
+	 * @brief Computes exponent e^x element-wise with vectorized kernels (see FastMath.h for accuracy).
+	 * 
+	 * @return Tensor that contains exponents.
+	 */
+	Tensor exp() const;
+	/**
+	 * @brief Computes natural logarithm element-wise with vectorized kernels (see FastMath.h for accuracy).
+	 * 
+	 * @return Tensor that contains logarithms.
+	 */
+	Tensor log() const;
+	/**
+	 * @brief Computes hyperbolic tangent element-wise with vectorized kernels (see FastMath.h for accuracy).
+	 * 
+	 * @return Tensor that contains hyperbolic tangents.
+	 */
+	Tensor tanh() const;
+	/**
+	 * @brief Computes logistic sigmoid 1 / (1 + e^-x) element-wise with vectorized kernels (see FastMath.h for accuracy).
+	 * 
+	 * @return Tensor that contains sigmoids.
+	 */
+	Tensor sigmoid() const;
+	/**
+	 * @brief Computes exponent e^x element-wise in place.
+	 * 
+	 * @return Reference to the Tensor.
+	 */
+	Tensor& expInPlace();
+	/**
+	 * @brief Computes natural logarithm element-wise in place.
+	 * 
+	 * @return Reference to the Tensor.
+	 */
+	Tensor& logInPlace();
+	/**
+	 * @brief Computes hyperbolic tangent element-wise in place.
+	 * 
+	 * @return Reference to the Tensor.
+	 */
+	Tensor& tanhInPlace();
+	/**
+	 * @brief Computes logistic sigmoid element-wise in place.
+	 * 
+	 * @return Reference to the Tensor.
+	 */
+	Tensor& sigmoidInPlace();
 	/**
 	 * Reduces Tensor dimension so that all dimensions starting from from_axis whill be one flatted to one dimension.
+	 * Values are copied, view().flatten(from_axis) returns the result without copying.
 	 * @brief Reshapes Tensor to (from_axis + 1)-dim Tensor.
 	 * 
 	 * @param from_axis Axis from which dimensions will be reduced.
 	 * @return Flattening result.
 	 */
-	const Tensor flatten(uint32_t from_axis=0) const;
+	Tensor flatten(uint32_t from_axis=0) const;
 	/**
 	 * @brief Sums Tensor values along given axis.
 	 * 
 	 * @param axis Selected axis.
 	 * @return Tensor adter applying sum along axis.
 	 */
-	const Tensor sum(uint32_t axis) const;
+	Tensor sum(uint32_t axis) const;
 	/**
 	 * @brief Sums all tensor values.
 	 * 
@@ -623,13 +902,13 @@ public:
 	/**
 	 * @brief Finds maximum value of the Tensor.
 	 * 
-	 * @return Maximum value of the Tensor.
+	 * @return Maximum value of the Tensor, -infinity if the Tensor is empty.
 	 */
 	float max() const;
 	/**
 	 * @brief Finds minimum value of the Tensor.
 	 * 
-	 * @return Minimum value of the Tensor.
+	 * @return Minimum value of the Tensor, infinity if the Tensor is empty.
 	 */
 	float min() const;
 	/**
@@ -639,31 +918,33 @@ public:
 	 */
 	float mean() const;
 	/**
+	 * Values are copied, view().transpose() returns the result without copying.
 	 * @brief Trasposes the Tensor.
 	 * 
 	 * @return Transposed Tensor.
 	 */
-	const Tensor transpose() const;
+	Tensor transpose() const;
 	/**
 	 * @brief Shuffles Tensor values along first axis.
 	 * 
 	 * @return Shuffling result.
 	 */
-	const Tensor shuffle() const;
+	Tensor shuffle() const;
 	/**
 	 * @brief Shuffles Tensor values according to given pattern along first axis.
 	 * 
 	 * @param pattern Shuffling pattern.
 	 * @return const Tensor 
 	 */
-	const Tensor shuffle(uint32_t *pattern) const;
+	Tensor shuffle(uint32_t *pattern) const;
 	/**
+	 * Values are copied, view().reshape(new_shape) returns the result without copying.
 	 * @brief Changes shape of the Tensor.
 	 * 
 	 * @param new_shape New shape of the Tensor (size must remain same).
 	 * @return Tensor after changing shape. 
 	 */
-	const Tensor reshape(std::vector<uint32_t> new_shape) const;
+	Tensor reshape(std::vector<uint32_t> new_shape) const;
 
 	/**
 	 * @brief Prints Tensor as 'Tensor(<shape>).
@@ -681,9 +962,9 @@ private:
      */ 
 	uint32_t _size;
     /**
-     * Values of the tensor.
+     * Values of the tensor, stored in a TENSOR_ALIGNMENT aligned buffer of the active TensorAllocator.
      */ 
-	std::vector<float> _data;
+	std::vector<float, TensorAllocatorAdaptor<float>> _data;
 
     /**
      * Validates shapes of Tensors starting from most outer.
@@ -697,7 +978,264 @@ private:
      * @return True if shapes are equal up to index (counting from end) which is a minimum of both tensors dimensions.
      */
 	bool validateShapeReversed(const Tensor& other) const;
+    /**
+     * Validates ranges used for slicing and fills missing ones (whole axis).
+	 * @param ranges Ranges of selected slice.
+	 * @param shape Shape of the sliced tensor.
+     */
+	static void validateRanges(Range& ranges, const std::vector<uint32_t>& shape);
+    /**
+     * Throws std::invalid_argument if other has different size, used by zip.
+	 * @param other Another Tensor object.
+     */
+	void validateSize(const Tensor& other) const;
+    /**
+     * r[k] = func(v[k]...) for k in [0, count), count is at most TENSOR_MAP_BLOCK. Results are computed in a local array,
+     * so r may be the same as any of v and loops called with constant count are vectorized.
+     */
+	template <typename Func, typename... Values>
+	static void mapBlock(float* r, const Func& func, uint32_t count, const Values*... v);
+    /**
+     * r[i] = func(v[i]...) for i in [begin, end) computed in blocks of TENSOR_MAP_BLOCK values.
+     */
+	template <typename Func, typename... Values>
+	static void mapRange(uint32_t begin, uint32_t end, float* r, const Func& func, const Values*... v);
 
 	friend class TensorSlice;
 	friend class TensorCell;
-};
\ No newline at end of file
+	friend class TensorView;
+	friend class TensorExpressionLeaf;
+};
+
+/**
+ * @brief TensorView class that represents a Tensor (or its slice) seen through shape, strides and offset.
+ * Slicing, reshaping and transposing a view does not copy any values. Tensor methods with the same names own their
+ * result and copy values.
+ */
+class TensorView {
+public:
+    /**
+     * Returns a slice of the view as another view.
+	 * @brief Subscript operator.
+	 * 
+     * @param ranges Ranges of selected slice.
+	 * @return Slice as a TensorView.
+     */
+	const TensorView operator[](Tensor::Range ranges) const;
+    /**
+     * Returns a cell of the view as a float.
+	 * @brief Subscript operator.
+	 * 
+     * @param index Index of selected cell.
+	 * @return Cell value as float.
+     */
+	float operator[](const Tensor::Index& index) const;
+    /**
+     * Returns a cell of the view as a float.
+	 * @brief Subscript operator.
+	 * 
+     * @param ini Index of selected cell.
+	 * @return Cell value as float.
+     */
+	float operator[](const std::initializer_list<uint32_t>& ini) const
+	{
+		return operator[](Tensor::Index(ini));
+	}
+
+    /**
+     * @brief Get shape of the view.
+	 * 
+	 * @return Shape of the view.
+     */
+	std::vector<uint32_t> getShape() const;
+    /**
+     * @brief Get strides of the view (in elements).
+	 * 
+	 * @return Strides of the view.
+     */
+	std::vector<uint32_t> getStrides() const;
+    /**
+     * @brief Get dimension of the view.
+	 * 
+	 * @return Dimension of the view.
+     */
+	uint32_t getDim() const;
+    /**
+     * @brief Get size of the view.
+	 * 
+	 * @return Size of the view.
+     */
+	uint32_t getSize() const;
+    /**
+     * @brief Checks if values seen through the view are laid out in memory in row-major order without gaps.
+	 * 
+	 * @return True if view is contiguous.
+     */
+	bool isContiguous() const;
+
+	/**
+	 * @brief Changes shape of the view (view must be contiguous).
+	 * 
+	 * @param new_shape New shape of the view (size must remain same).
+	 * @return View with changed shape.
+	 */
+	const TensorView reshape(std::vector<uint32_t> new_shape) const;
+	/**
+	 * Reduces view dimension so that all dimensions starting from from_axis will be flatten to one dimension.
+	 * Flattened dimensions must be contiguous.
+	 * @brief Reshapes view to (from_axis + 1)-dim view.
+	 * 
+	 * @param from_axis Axis from which dimensions will be reduced.
+	 * @return Flattening result.
+	 */
+	const TensorView flatten(uint32_t from_axis=0) const;
+	/**
+	 * @brief Trasposes the 2-dim view (swaps strides).
+	 * 
+	 * @return Transposed view.
+	 */
+	const TensorView transpose() const;
+	/**
+	 * @brief Computes dot product of two 2-dim views.
+	 * 
+	 * @param other Another TensorView object.
+	 * @return Dot product result.
+	 */
+	Tensor dotProduct(const TensorView& other) const;
+	/**
+	 * @brief Computes dot product of left operand and transposition of right operand (both 2-dim views).
+	 * 
+	 * @param other Another TensorView object.
+	 * @return Dot product result.
+	 */
+	Tensor dotProductTranspose(const TensorView& other) const;
+
+private:
+	TensorView() = delete;
+    /**
+     * Creates a new TensorView object.
+     * @brief constructor.
+     * @param data Values of the viewed tensor.
+     * @param offset Offset of the first value seen through the view.
+     * @param shape Shape of the view.
+     * @param strides Strides of the view.
+     */
+	TensorView(const float* data, uint32_t offset, std::vector<uint32_t> shape, std::vector<uint32_t> strides);
+
+    /**
+     * @brief Copies values seen through the view to contiguous memory (row-major order).
+	 * 
+	 * @param dst Destination memory.
+     */
+	void copyTo(float* dst) const;
+    /**
+     * Copies values from contiguous memory (row-major order) to the memory seen through the view.
+	 * Used only for views of non-const tensors (TensorSlice).
+     * @brief Copies values to the view.
+	 * 
+	 * @param src Source memory.
+     */
+	void copyFrom(const float* src) const;
+
+    /**
+     * Values of the viewed tensor.
+     */ 
+	const float* _data;
+    /**
+     * Offset of the first value seen through the view.
+     */ 
+	uint32_t _offset;
+    /**
+     * Shape of the view.
+     */ 
+	std::vector<uint32_t> _shape;
+    /**
+     * Strides of the view (in elements).
+     */ 
+	std::vector<uint32_t> _strides;
+    /**
+     * Size of the view (product of all shape elements).
+     */ 
+	uint32_t _size;
+
+	friend class Tensor;
+	friend class TensorSlice;
+};
+
+template <typename Func, typename... Values>
+void Tensor::mapBlock(float* r, const Func& func, uint32_t count, const Values*... v) {
+	float values[TENSOR_MAP_BLOCK];
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		values[k] = func(v[k]...);
+	}
+	for (uint32_t k{ 0 }; k < count; ++k) {
+		r[k] = values[k];
+	}
+}
+
+template <typename Func, typename... Values>
+void Tensor::mapRange(uint32_t begin, uint32_t end, float* r, const Func& func, const Values*... v) {
+	for (uint32_t i{ begin }; i < end; i += TENSOR_MAP_BLOCK) {
+		const uint32_t count{ std::min(TENSOR_MAP_BLOCK, end - i) };
+		if (TENSOR_MAP_BLOCK == count) {
+			mapBlock(r + i, func, TENSOR_MAP_BLOCK, (v + i)...);
+		}
+		else {
+			mapBlock(r + i, func, count, (v + i)...);
+		}
+	}
+}
+
+template <typename Func>
+Tensor Tensor::map(const Func& func) const {
+	Tensor result{ *this };
+	result.mapInPlace(func);
+	return result;
+}
+
+template <typename Func>
+Tensor& Tensor::mapInPlace(const Func& func) {
+	float* values{ _data.data() };
+	ThreadPool::forEachChunk(_size, ThreadPool::getParallelChunkSize(_size), [&](uint32_t begin, uint32_t end) {
+		mapRange(begin, end, values, func, values);
+	});
+	return *this;
+}
+
+template <typename Func>
+Tensor Tensor::zip(const Tensor& other, const Func& func) const {
+	Tensor result{ *this };
+	result.zipInPlace(other, func);
+	return result;
+}
+
+template <typename Func>
+Tensor& Tensor::zipInPlace(const Tensor& other, const Func& func) {
+	validateSize(other);
+	float* values{ _data.data() };
+	const float* other_values{ other._data.data() };
+	ThreadPool::forEachChunk(_size, ThreadPool::getParallelChunkSize(_size), [&](uint32_t begin, uint32_t end) {
+		mapRange(begin, end, values, func, values, other_values);
+	});
+	return *this;
+}
+
+template <typename Func>
+Tensor Tensor::zip(const Tensor& other1, const Tensor& other2, const Func& func) const {
+	Tensor result{ *this };
+	result.zipInPlace(other1, other2, func);
+	return result;
+}
+
+template <typename Func>
+Tensor& Tensor::zipInPlace(const Tensor& other1, const Tensor& other2, const Func& func) {
+	validateSize(other1);
+	validateSize(other2);
+	float* values{ _data.data() };
+	const float* other1_values{ other1._data.data() };
+	const float* other2_values{ other2._data.data() };
+	ThreadPool::forEachChunk(_size, ThreadPool::getParallelChunkSize(_size), [&](uint32_t begin, uint32_t end) {
+		mapRange(begin, end, values, func, values, other1_values, other2_values);
+	});
+	return *this;
+}
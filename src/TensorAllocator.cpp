@@ -0,0 +1,201 @@
+#include "TensorAllocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+
+void* TensorAllocator::allocate(size_t bytes) {
+	void* ptr{ allocateBlock(bytes) };
+
+	const size_t live_bytes{ _live_bytes += bytes };
+	size_t peak_bytes{ _peak_bytes.load() };
+	while ((live_bytes > peak_bytes) && !_peak_bytes.compare_exchange_weak(peak_bytes, live_bytes)) {}
+
+	return ptr;
+}
+
+void TensorAllocator::deallocate(void* ptr, size_t bytes) {
+	if (nullptr == ptr) {
+		return;
+	}
+	_live_bytes -= bytes;
+	deallocateBlock(ptr, bytes);
+}
+
+size_t TensorAllocator::getLiveBytes() const {
+	return _live_bytes;
+}
+
+size_t TensorAllocator::getPeakBytes() const {
+	return _peak_bytes;
+}
+
+void TensorAllocator::resetPeakBytes() {
+	_peak_bytes = _live_bytes.load();
+}
+
+void* AlignedTensorAllocator::allocateBlock(size_t bytes) {
+	return ::operator new(std::max(bytes, TENSOR_ALIGNMENT), std::align_val_t{ TENSOR_ALIGNMENT });
+}
+
+void AlignedTensorAllocator::deallocateBlock(void* ptr, size_t) {
+	::operator delete(ptr, std::align_val_t{ TENSOR_ALIGNMENT });
+}
+
+PoolTensorAllocator::PoolTensorAllocator(size_t max_cached_bytes) : _max_cached_bytes{ max_cached_bytes } {}
+
+PoolTensorAllocator::~PoolTensorAllocator() {
+	releaseCached();
+}
+
+size_t PoolTensorAllocator::getCachedBytes() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _cached_bytes;
+}
+
+void PoolTensorAllocator::releaseCached() {
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	for (auto& [size, blocks] : _free_lists) {
+		for (auto block : blocks) {
+			::operator delete(block, std::align_val_t{ TENSOR_ALIGNMENT });
+		}
+	}
+	_free_lists.clear();
+	_cached_bytes = 0;
+}
+
+size_t PoolTensorAllocator::sizeClass(size_t bytes) {
+	if (bytes <= TENSOR_ALIGNMENT) {
+		return TENSOR_ALIGNMENT;
+	}
+
+	// four classes between consecutive powers of two, so less than 25% of a block is wasted
+	const size_t power{ size_t{ 1 } << (std::bit_width(bytes - 1) - 1) };
+	const size_t step{ std::max(TENSOR_ALIGNMENT, power / 4) };
+
+	return (bytes + step - 1) / step * step;
+}
+
+void* PoolTensorAllocator::allocateBlock(size_t bytes) {
+	const size_t size{ sizeClass(bytes) };
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto free_list{ _free_lists.find(size) };
+		if ((_free_lists.end() != free_list) && !free_list->second.empty()) {
+			void* block{ free_list->second.back() };
+			free_list->second.pop_back();
+			_cached_bytes -= size;
+			return block;
+		}
+	}
+
+	return ::operator new(size, std::align_val_t{ TENSOR_ALIGNMENT });
+}
+
+void PoolTensorAllocator::deallocateBlock(void* ptr, size_t bytes) {
+	const size_t size{ sizeClass(bytes) };
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_cached_bytes + size <= _max_cached_bytes) {
+			_free_lists[size].push_back(ptr);
+			_cached_bytes += size;
+			return;
+		}
+	}
+
+	::operator delete(ptr, std::align_val_t{ TENSOR_ALIGNMENT });
+}
+
+ArenaTensorAllocator::ArenaTensorAllocator(size_t chunk_size) : _chunk_size{ std::max(chunk_size, TENSOR_ALIGNMENT) } {}
+
+ArenaTensorAllocator::~ArenaTensorAllocator() {
+	for (auto& chunk : _chunks) {
+		::operator delete(chunk.data, std::align_val_t{ TENSOR_ALIGNMENT });
+	}
+}
+
+void ArenaTensorAllocator::reset() {
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_chunk_index > 0) {
+		size_t capacity{ 0 };
+		for (auto& chunk : _chunks) {
+			capacity += chunk.size;
+			::operator delete(chunk.data, std::align_val_t{ TENSOR_ALIGNMENT });
+		}
+		_chunks.clear();
+		_chunks.push_back({ static_cast<char*>(::operator new(capacity, std::align_val_t{ TENSOR_ALIGNMENT })), capacity });
+	}
+	_chunk_index = 0;
+	_offset = 0;
+}
+
+size_t ArenaTensorAllocator::getCapacity() const {
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	size_t capacity{ 0 };
+	for (auto& chunk : _chunks) {
+		capacity += chunk.size;
+	}
+	return capacity;
+}
+
+void* ArenaTensorAllocator::allocateBlock(size_t bytes) {
+	const size_t size{ (std::max(bytes, size_t{ 1 }) + TENSOR_ALIGNMENT - 1) / TENSOR_ALIGNMENT * TENSOR_ALIGNMENT };
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	while (_chunk_index < _chunks.size()) {
+		Chunk& chunk{ _chunks[_chunk_index] };
+		if (_offset + size <= chunk.size) {
+			void* block{ chunk.data + _offset };
+			_offset += size;
+			return block;
+		}
+		++_chunk_index;
+		_offset = 0;
+	}
+
+	const size_t chunk_size{ std::max(size, _chunks.empty() ? _chunk_size : 2 * _chunks.back().size) };
+	_chunks.push_back({ static_cast<char*>(::operator new(chunk_size, std::align_val_t{ TENSOR_ALIGNMENT })), chunk_size });
+	_chunk_index = _chunks.size() - 1;
+	_offset = size;
+
+	return _chunks.back().data;
+}
+
+void ArenaTensorAllocator::deallocateBlock(void*, size_t) {
+	// memory is given back by reset(), a block freed after reset may already overlap a new one
+}
+
+/**
+ * Allocator set with setTensorAllocator on the calling thread, nullptr if the default one is used.
+ */
+static thread_local TensorAllocator* g_tensor_allocator{ nullptr };
+
+/**
+ * The default allocator is never destroyed, so tensors with static storage duration can be freed at exit.
+ */
+TensorAllocator& getDefaultTensorAllocator() {
+	static PoolTensorAllocator* allocator{ new PoolTensorAllocator() };
+	return *allocator;
+}
+
+TensorAllocator& getTensorAllocator() {
+	TensorAllocator* allocator{ g_tensor_allocator };
+	return (nullptr != allocator) ? *allocator : getDefaultTensorAllocator();
+}
+
+void setTensorAllocator(TensorAllocator& allocator) {
+	g_tensor_allocator = &allocator;
+}
+
+TensorAllocatorScope::TensorAllocatorScope(TensorAllocator& allocator) : _previous{ getTensorAllocator() } {
+	setTensorAllocator(allocator);
+}
+
+TensorAllocatorScope::~TensorAllocatorScope() {
+	setTensorAllocator(_previous);
+}
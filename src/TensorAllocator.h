@@ -0,0 +1,254 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Alignment of tensor values buffers (cache line size, width of AVX-512 registers).
+ */
+constexpr size_t TENSOR_ALIGNMENT{ 64 };
+
+/**
+ * @brief Base class of allocators of tensor values buffers.
+ * Returned blocks are aligned to TENSOR_ALIGNMENT. The allocator keeps count of bytes currently allocated by tensors
+ * and of the peak of this count.
+ */
+class TensorAllocator {
+public:
+	virtual ~TensorAllocator() = default;
+
+	/**
+	 * @brief Allocates a block of memory.
+	 *
+	 * @param bytes Size of the block.
+	 * @return Pointer to the block aligned to TENSOR_ALIGNMENT.
+	 */
+	void* allocate(size_t bytes);
+	/**
+	 * @brief Frees a block of memory allocated by this allocator.
+	 *
+	 * @param ptr Pointer to the block.
+	 * @param bytes Size of the block passed to allocate.
+	 */
+	void deallocate(void* ptr, size_t bytes);
+
+	/**
+	 * @brief Get the number of bytes currently allocated.
+	 *
+	 * @return Live bytes.
+	 */
+	size_t getLiveBytes() const;
+	/**
+	 * @brief Get the maximal number of bytes allocated at once since creation or last resetPeakBytes call.
+	 *
+	 * @return Peak bytes.
+	 */
+	size_t getPeakBytes() const;
+	/**
+	 * @brief Sets peak bytes to currently allocated bytes.
+	 */
+	void resetPeakBytes();
+
+protected:
+	virtual void* allocateBlock(size_t bytes) = 0;
+	virtual void deallocateBlock(void* ptr, size_t bytes) = 0;
+
+private:
+	std::atomic<size_t> _live_bytes{ 0 };
+	std::atomic<size_t> _peak_bytes{ 0 };
+};
+
+/**
+ * @brief Allocator passing every request to aligned operator new/delete.
+ */
+class AlignedTensorAllocator : public TensorAllocator {
+protected:
+	void* allocateBlock(size_t bytes) override;
+	void deallocateBlock(void* ptr, size_t bytes) override;
+};
+
+/**
+ * @brief Allocator recycling freed blocks.
+ * Requests are rounded up to size classes (four classes per power of two) and freed blocks are kept on per-class
+ * free lists, so buffers of tensors of the same shapes created every training step are reused without calling malloc.
+ */
+class PoolTensorAllocator : public TensorAllocator {
+public:
+	/**
+	 * @brief Construct a new Pool Tensor Allocator object.
+	 *
+	 * @param max_cached_bytes Maximal number of bytes kept on free lists, blocks freed above the limit are released.
+	 */
+	explicit PoolTensorAllocator(size_t max_cached_bytes = 256 << 20);
+	~PoolTensorAllocator() override;
+
+	PoolTensorAllocator(const PoolTensorAllocator&) = delete;
+	PoolTensorAllocator& operator=(const PoolTensorAllocator&) = delete;
+
+	/**
+	 * @brief Get the number of bytes kept on free lists.
+	 *
+	 * @return Cached bytes.
+	 */
+	size_t getCachedBytes() const;
+	/**
+	 * @brief Releases all blocks kept on free lists.
+	 */
+	void releaseCached();
+	/**
+	 * @brief Returns size of block used for a request.
+	 *
+	 * @param bytes Requested size.
+	 * @return Size class (multiple of TENSOR_ALIGNMENT).
+	 */
+	static size_t sizeClass(size_t bytes);
+
+protected:
+	void* allocateBlock(size_t bytes) override;
+	void deallocateBlock(void* ptr, size_t bytes) override;
+
+private:
+	mutable std::mutex _mutex;
+	std::unordered_map<size_t, std::vector<void*>> _free_lists;
+	size_t _cached_bytes{ 0 };
+	const size_t _max_cached_bytes;
+};
+
+/**
+ * @brief Bump-pointer allocator for temporaries of a single training step.
+ * Blocks are carved from large chunks and freeing a block is a no-op, reset() makes all chunks available again in O(1).
+ * Chunks are kept between steps, so after the first step there are neither malloc calls nor page faults.
+ * Blocks allocated since the last reset must not be used after the next one.
+ */
+class ArenaTensorAllocator : public TensorAllocator {
+public:
+	/**
+	 * @brief Construct a new Arena Tensor Allocator object.
+	 *
+	 * @param chunk_size Size of the first chunk, next chunks are twice as large as the previous one.
+	 */
+	explicit ArenaTensorAllocator(size_t chunk_size = 1 << 20);
+	~ArenaTensorAllocator() override;
+
+	ArenaTensorAllocator(const ArenaTensorAllocator&) = delete;
+	ArenaTensorAllocator& operator=(const ArenaTensorAllocator&) = delete;
+
+	/**
+	 * @brief Makes all memory of the arena available again.
+	 * If the last step needed more than one chunk they are replaced by a single chunk large enough for the whole step.
+	 */
+	void reset();
+	/**
+	 * @brief Get the total size of chunks owned by the arena.
+	 *
+	 * @return Capacity in bytes.
+	 */
+	size_t getCapacity() const;
+
+protected:
+	void* allocateBlock(size_t bytes) override;
+	void deallocateBlock(void* ptr, size_t bytes) override;
+
+private:
+	struct Chunk {
+		char* data;
+		size_t size;
+	};
+
+	mutable std::mutex _mutex;
+	std::vector<Chunk> _chunks;
+	/**
+	 * Chunk blocks are currently allocated from and offset of its first free byte.
+	 */
+	size_t _chunk_index{ 0 };
+	size_t _offset{ 0 };
+	size_t _chunk_size;
+};
+
+/**
+ * @brief Returns allocator used by tensors created on the calling thread (by default a global PoolTensorAllocator).
+ * Tasks of ThreadPool::parallelFor use the allocator of the thread which started them.
+ *
+ * @return Active allocator.
+ */
+TensorAllocator& getTensorAllocator();
+/**
+ * @brief Returns the global PoolTensorAllocator used when no other allocator is set.
+ * Tensors which outlive the active scope (e.g. caches of layers) can be created from it inside an arena scope.
+ *
+ * @return Default allocator.
+ */
+TensorAllocator& getDefaultTensorAllocator();
+/**
+ * @brief Sets allocator used by tensors created on the calling thread.
+ * Tensors keep the allocator they were created with, so it must outlive them.
+ *
+ * @param allocator Allocator to be used.
+ */
+void setTensorAllocator(TensorAllocator& allocator);
+
+/**
+ * @brief Sets the active allocator for the lifetime of the object and restores the previous one on destruction.
+ */
+class TensorAllocatorScope {
+public:
+	explicit TensorAllocatorScope(TensorAllocator& allocator);
+	~TensorAllocatorScope();
+
+	TensorAllocatorScope(const TensorAllocatorScope&) = delete;
+	TensorAllocatorScope& operator=(const TensorAllocatorScope&) = delete;
+
+private:
+	TensorAllocator& _previous;
+};
+
+/**
+ * @brief Standard library allocator adaptor passing requests to a TensorAllocator (the active one by default).
+ */
+template <typename T>
+class TensorAllocatorAdaptor {
+public:
+	typedef T value_type;
+	// the destination keeps its allocator on copy and move, so a layer member assigned from a step temporary never takes
+	// over arena memory; move takes the buffer only if both tensors use the same allocator, otherwise values are moved
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::false_type propagate_on_container_move_assignment;
+	typedef std::false_type propagate_on_container_swap;
+
+	TensorAllocatorAdaptor() : _allocator{ &getTensorAllocator() } {}
+	explicit TensorAllocatorAdaptor(TensorAllocator& allocator) : _allocator{ &allocator } {}
+	template <typename U>
+	TensorAllocatorAdaptor(const TensorAllocatorAdaptor<U>& other) : _allocator{ other.getAllocator() } {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(_allocator->allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T* ptr, size_t n) {
+		_allocator->deallocate(ptr, n * sizeof(T));
+	}
+
+	/**
+	 * Copies of a tensor are allocated by the active allocator.
+	 */
+	TensorAllocatorAdaptor select_on_container_copy_construction() const {
+		return TensorAllocatorAdaptor();
+	}
+
+	TensorAllocator* getAllocator() const {
+		return _allocator;
+	}
+
+	template <typename U>
+	bool operator==(const TensorAllocatorAdaptor<U>& other) const {
+		return _allocator == other.getAllocator();
+	}
+
+private:
+	TensorAllocator* _allocator;
+};
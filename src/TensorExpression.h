@@ -0,0 +1,476 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "Tensor.h"
+#include "TensorKernels.h"
+#include "ThreadPool.h"
+
+/**
+ * Lazy element-wise Tensor expressions.
+ *
+ * lazy(t) wraps a Tensor into an expression, arithmetic operators, scalar operators, applyFunction and math functions
+ * (exp, log, tanh, sigmoid) called on expressions do not compute anything but build an expression tree. The tree is evaluated when it is assigned to a Tensor
+ * (or used to construct one) or reduced with sum()/mean(). Evaluation goes over the tensor in blocks of
+ * TENSOR_EXPRESSION_BLOCK values, every node computes its block with the active SIMD kernels (see TensorKernels.h)
+ * and intermediate blocks stay in L1 cache, so the whole expression takes a single pass over memory:
+ *
+ *     float cost = (lazy(y) * (lazy(y_hat) + 1e-9f).log()).sum();
+ *
+ * Unlike Tensor operators expressions do not broadcast, all tensors in an expression must have the same shape.
+ * Expressions keep references to tensors, so they should be evaluated within the statement that builds them.
+ */
+
+/**
+ * Number of values computed at once by each expression node.
+ */
+constexpr uint32_t TENSOR_EXPRESSION_BLOCK{ 128 };
+
+template <typename Expr> class TensorExpressionFunction;
+template <typename Expr> class TensorExpressionMath;
+
+/**
+ * Element-wise math kernel of TensorKernels (vector_exp, vector_log, vector_tanh or vector_sigmoid).
+ */
+using TensorMathKernel = void (*TensorKernels::*)(const uint32_t, const float*, float*);
+
+/**
+ * @brief Base class of all expression nodes (CRTP).
+ *
+ * Node classes provide:
+ * - BLOCKS: number of blocks needed to evaluate the node, including the block of its own result,
+ * - shape() and size() of the result,
+ * - evalBlock(kernels, begin, n, out, scratch) which computes values [begin, begin + n) into out (or returns a pointer
+ *   to them if they are already stored somewhere), scratch holds BLOCKS - 1 blocks for children results.
+ */
+template <typename Expr>
+class TensorExpression {
+public:
+	/**
+	 * @brief Returns the node as its actual type.
+	 *
+	 * @return Expression node.
+	 */
+	const Expr& self() const {
+		return static_cast<const Expr&>(*this);
+	}
+
+	/**
+	 * @brief Applies function element-wise (lazily).
+	 *
+	 * @param function Function to be applied.
+	 * @return Expression applying the function to values of this expression.
+	 */
+	TensorExpressionFunction<Expr> applyFunction(float (*function)(float)) const;
+
+	/**
+	 * @brief Computes exponent e^x element-wise (lazily) with vectorized kernels.
+	 *
+	 * @return Expression of exponents of values of this expression.
+	 */
+	TensorExpressionMath<Expr> exp() const {
+		return TensorExpressionMath<Expr>(self(), &TensorKernels::vector_exp);
+	}
+
+	/**
+	 * @brief Computes natural logarithm element-wise (lazily) with vectorized kernels.
+	 *
+	 * @return Expression of logarithms of values of this expression.
+	 */
+	TensorExpressionMath<Expr> log() const {
+		return TensorExpressionMath<Expr>(self(), &TensorKernels::vector_log);
+	}
+
+	/**
+	 * @brief Computes hyperbolic tangent element-wise (lazily) with vectorized kernels.
+	 *
+	 * @return Expression of hyperbolic tangents of values of this expression.
+	 */
+	TensorExpressionMath<Expr> tanh() const {
+		return TensorExpressionMath<Expr>(self(), &TensorKernels::vector_tanh);
+	}
+
+	/**
+	 * @brief Computes logistic sigmoid element-wise (lazily) with vectorized kernels.
+	 *
+	 * @return Expression of sigmoids of values of this expression.
+	 */
+	TensorExpressionMath<Expr> sigmoid() const {
+		return TensorExpressionMath<Expr>(self(), &TensorKernels::vector_sigmoid);
+	}
+
+	/**
+	 * @brief Evaluates the expression.
+	 *
+	 * @return Tensor holding values of the expression.
+	 */
+	Tensor eval() const {
+		return Tensor(*this);
+	}
+
+	/**
+	 * @brief Evaluates the expression into given buffer.
+	 *
+	 * @param output Buffer of size() values, may be a values buffer of a tensor used by the expression.
+	 */
+	void evalTo(float* output) const {
+		const TensorKernels& kernels{ getKernels() };
+		const uint32_t size{ self().size() };
+
+		ThreadPool::forEachChunk(size, ThreadPool::getParallelChunkSize(size, TENSOR_EXPRESSION_BLOCK), [&](uint32_t begin, uint32_t end) {
+			alignas(64) float scratch[SCRATCH_BLOCKS * TENSOR_EXPRESSION_BLOCK];
+
+			for (uint32_t block{ begin }; block < end; block += TENSOR_EXPRESSION_BLOCK) {
+				const uint32_t n{ std::min(TENSOR_EXPRESSION_BLOCK, end - block) };
+				const float* values{ self().evalBlock(kernels, block, n, output + block, scratch) };
+				if (values != output + block) {
+					std::memmove(output + block, values, sizeof(float) * n);
+				}
+			}
+		});
+	}
+
+	/**
+	 * @brief Sums all values of the expression without storing them.
+	 *
+	 * @return Sum result.
+	 */
+	float sum() const {
+		const TensorKernels& kernels{ getKernels() };
+		const uint32_t size{ self().size() };
+		if (0 == size) {
+			return 0.0f;
+		}
+		const uint32_t chunk{ ThreadPool::getParallelChunkSize(size, TENSOR_EXPRESSION_BLOCK) };
+		std::vector<float> partial((size + chunk - 1) / chunk, 0.0f);
+
+		ThreadPool::forEachChunk(size, chunk, [&](uint32_t begin, uint32_t end) {
+			// one more block for the result of the root node
+			alignas(64) float scratch[(SCRATCH_BLOCKS + 1) * TENSOR_EXPRESSION_BLOCK];
+			float result{ 0.0f };
+
+			for (uint32_t block{ begin }; block < end; block += TENSOR_EXPRESSION_BLOCK) {
+				const uint32_t n{ std::min(TENSOR_EXPRESSION_BLOCK, end - block) };
+				const float* values{ self().evalBlock(kernels, block, n, scratch, scratch + TENSOR_EXPRESSION_BLOCK) };
+				float block_sum;
+				kernels.tensor_sum(n, values, &block_sum);
+				result += block_sum;
+			}
+			partial[begin / chunk] = result;
+		});
+
+		float result{ 0.0f };
+		for (auto value : partial) {
+			result += value;
+		}
+
+		return result;
+	}
+
+	/**
+	 * @brief Computes mean value of the expression without storing its values.
+	 *
+	 * @return Mean value.
+	 */
+	float mean() const {
+		return sum() / self().size();
+	}
+
+private:
+	/**
+	 * Number of scratch blocks needed by evalBlock of the root node (at least one, so arrays are not empty).
+	 */
+	static constexpr uint32_t SCRATCH_BLOCKS{ Expr::BLOCKS > 1 ? Expr::BLOCKS - 1 : 1 };
+};
+
+/**
+ * @brief Expression leaf referring to values of a Tensor.
+ */
+class TensorExpressionLeaf : public TensorExpression<TensorExpressionLeaf> {
+public:
+	static constexpr uint32_t BLOCKS{ 0 };
+
+	explicit TensorExpressionLeaf(const Tensor& tensor) : _tensor{ tensor } {}
+
+	const std::vector<uint32_t>& shape() const {
+		return _tensor._shape;
+	}
+
+	uint32_t size() const {
+		return _tensor._size;
+	}
+
+	const float* evalBlock(const TensorKernels&, uint32_t begin, uint32_t, float*, float*) const {
+		return _tensor._data.data() + begin;
+	}
+
+private:
+	const Tensor& _tensor;
+};
+
+/**
+ * Element-wise operations used by expression nodes, computed with kernels of the active kernel set.
+ */
+struct TensorExpressionAdd {
+	static void apply(const TensorKernels& kernels, uint32_t n, const float* v1, const float* v2, float* r) {
+		kernels.vector_add(n, v1, v2, r);
+	}
+	static void applyScalar(const TensorKernels& kernels, uint32_t n, const float* v, float s, float* r) {
+		kernels.tensor_add_scalar(n, v, &s, r);
+	}
+	static void applyScalarLeft(const TensorKernels& kernels, float s, uint32_t n, const float* v, float* r) {
+		kernels.tensor_add_scalar(n, v, &s, r);
+	}
+};
+
+struct TensorExpressionSub {
+	static void apply(const TensorKernels& kernels, uint32_t n, const float* v1, const float* v2, float* r) {
+		kernels.vector_sub(n, v1, v2, r);
+	}
+	static void applyScalar(const TensorKernels& kernels, uint32_t n, const float* v, float s, float* r) {
+		kernels.tensor_sub_scalar(n, v, &s, r);
+	}
+	static void applyScalarLeft(const TensorKernels& kernels, float s, uint32_t n, const float* v, float* r) {
+		kernels.scalar_sub_tensor(&s, n, v, r);
+	}
+};
+
+struct TensorExpressionMul {
+	static void apply(const TensorKernels& kernels, uint32_t n, const float* v1, const float* v2, float* r) {
+		kernels.vector_mul(n, v1, v2, r);
+	}
+	static void applyScalar(const TensorKernels& kernels, uint32_t n, const float* v, float s, float* r) {
+		kernels.tensor_mul_scalar(n, v, &s, r);
+	}
+	static void applyScalarLeft(const TensorKernels& kernels, float s, uint32_t n, const float* v, float* r) {
+		kernels.tensor_mul_scalar(n, v, &s, r);
+	}
+};
+
+struct TensorExpressionDiv {
+	static void apply(const TensorKernels& kernels, uint32_t n, const float* v1, const float* v2, float* r) {
+		kernels.vector_div(n, v1, v2, r);
+	}
+	static void applyScalar(const TensorKernels& kernels, uint32_t n, const float* v, float s, float* r) {
+		kernels.tensor_div_scalar(n, v, &s, r);
+	}
+	static void applyScalarLeft(const TensorKernels& kernels, float s, uint32_t n, const float* v, float* r) {
+		kernels.scalar_div_tensor(&s, n, v, r);
+	}
+};
+
+/**
+ * @brief Expression node computing left <op> right, both operands have the same shape.
+ */
+template <typename Op, typename Left, typename Right>
+class TensorExpressionBinary : public TensorExpression<TensorExpressionBinary<Op, Left, Right>> {
+public:
+	static constexpr uint32_t BLOCKS{ 1 + Left::BLOCKS + Right::BLOCKS };
+
+	TensorExpressionBinary(const Left& left, const Right& right) : _left{ left }, _right{ right } {
+		if (left.shape() != right.shape()) {
+			throw std::invalid_argument(format_string("%s %d : Expression operands have different shapes. left size=%d, right size=%d.",
+				__FILE__, __LINE__, left.size(), right.size()));
+		}
+	}
+
+	const std::vector<uint32_t>& shape() const {
+		return _left.shape();
+	}
+
+	uint32_t size() const {
+		return _left.size();
+	}
+
+	const float* evalBlock(const TensorKernels& kernels, uint32_t begin, uint32_t n, float* out, float* scratch) const {
+		float* left_out{ scratch };
+		float* right_out{ scratch + Left::BLOCKS * TENSOR_EXPRESSION_BLOCK };
+
+		const float* v1{ _left.evalBlock(kernels, begin, n, left_out, left_out + TENSOR_EXPRESSION_BLOCK) };
+		const float* v2{ _right.evalBlock(kernels, begin, n, right_out, right_out + TENSOR_EXPRESSION_BLOCK) };
+		Op::apply(kernels, n, v1, v2, out);
+
+		return out;
+	}
+
+private:
+	const Left _left;
+	const Right _right;
+};
+
+/**
+ * @brief Expression node computing expression <op> number (or number <op> expression if SCALAR_LEFT is true).
+ */
+template <typename Op, typename Expr, bool SCALAR_LEFT>
+class TensorExpressionScalar : public TensorExpression<TensorExpressionScalar<Op, Expr, SCALAR_LEFT>> {
+public:
+	static constexpr uint32_t BLOCKS{ 1 + Expr::BLOCKS };
+
+	TensorExpressionScalar(const Expr& expression, float number) : _expression{ expression }, _number{ number } {}
+
+	const std::vector<uint32_t>& shape() const {
+		return _expression.shape();
+	}
+
+	uint32_t size() const {
+		return _expression.size();
+	}
+
+	const float* evalBlock(const TensorKernels& kernels, uint32_t begin, uint32_t n, float* out, float* scratch) const {
+		const float* v{ _expression.evalBlock(kernels, begin, n, scratch, scratch + TENSOR_EXPRESSION_BLOCK) };
+
+		if constexpr (SCALAR_LEFT) {
+			Op::applyScalarLeft(kernels, _number, n, v, out);
+		}
+		else {
+			Op::applyScalar(kernels, n, v, _number, out);
+		}
+
+		return out;
+	}
+
+private:
+	const Expr _expression;
+	const float _number;
+};
+
+/**
+ * @brief Expression node applying a function element-wise.
+ */
+template <typename Expr>
+class TensorExpressionFunction : public TensorExpression<TensorExpressionFunction<Expr>> {
+public:
+	static constexpr uint32_t BLOCKS{ 1 + Expr::BLOCKS };
+
+	TensorExpressionFunction(const Expr& expression, float (*function)(float)) : _expression{ expression }, _function{ function } {}
+
+	const std::vector<uint32_t>& shape() const {
+		return _expression.shape();
+	}
+
+	uint32_t size() const {
+		return _expression.size();
+	}
+
+	const float* evalBlock(const TensorKernels& kernels, uint32_t begin, uint32_t n, float* out, float* scratch) const {
+		const float* v{ _expression.evalBlock(kernels, begin, n, scratch, scratch + TENSOR_EXPRESSION_BLOCK) };
+
+		for (uint32_t i{ 0 }; i < n; ++i) {
+			out[i] = _function(v[i]);
+		}
+
+		return out;
+	}
+
+private:
+	const Expr _expression;
+	float (*const _function)(float);
+};
+
+/**
+ * @brief Expression node applying an element-wise math kernel to whole blocks.
+ */
+template <typename Expr>
+class TensorExpressionMath : public TensorExpression<TensorExpressionMath<Expr>> {
+public:
+	static constexpr uint32_t BLOCKS{ 1 + Expr::BLOCKS };
+
+	TensorExpressionMath(const Expr& expression, TensorMathKernel kernel) : _expression{ expression }, _kernel{ kernel } {}
+
+	const std::vector<uint32_t>& shape() const {
+		return _expression.shape();
+	}
+
+	uint32_t size() const {
+		return _expression.size();
+	}
+
+	const float* evalBlock(const TensorKernels& kernels, uint32_t begin, uint32_t n, float* out, float* scratch) const {
+		const float* v{ _expression.evalBlock(kernels, begin, n, scratch, scratch + TENSOR_EXPRESSION_BLOCK) };
+		(kernels.*_kernel)(n, v, out);
+		return out;
+	}
+
+private:
+	const Expr _expression;
+	const TensorMathKernel _kernel;
+};
+
+template <typename Expr>
+TensorExpressionFunction<Expr> TensorExpression<Expr>::applyFunction(float (*function)(float)) const {
+	return TensorExpressionFunction<Expr>(self(), function);
+}
+
+/**
+ * @brief Wraps a Tensor into a lazy expression.
+ *
+ * @param tensor Tensor used by the expression, it must outlive the expression.
+ * @return Expression leaf.
+ */
+inline TensorExpressionLeaf lazy(const Tensor& tensor) {
+	return TensorExpressionLeaf(tensor);
+}
+
+/**
+ * Operators building expression nodes. Tensor operand mixed with an expression is wrapped with lazy().
+ */
+#define TENSOR_EXPRESSION_OPERATOR(op, Op) \
+	template <typename Left, typename Right> \
+	TensorExpressionBinary<Op, Left, Right> operator op(const TensorExpression<Left>& left, const TensorExpression<Right>& right) { \
+		return TensorExpressionBinary<Op, Left, Right>(left.self(), right.self()); \
+	} \
+	template <typename Left> \
+	TensorExpressionBinary<Op, Left, TensorExpressionLeaf> operator op(const TensorExpression<Left>& left, const Tensor& right) { \
+		return TensorExpressionBinary<Op, Left, TensorExpressionLeaf>(left.self(), lazy(right)); \
+	} \
+	template <typename Right> \
+	TensorExpressionBinary<Op, TensorExpressionLeaf, Right> operator op(const Tensor& left, const TensorExpression<Right>& right) { \
+		return TensorExpressionBinary<Op, TensorExpressionLeaf, Right>(lazy(left), right.self()); \
+	} \
+	template <typename Left> \
+	TensorExpressionScalar<Op, Left, false> operator op(const TensorExpression<Left>& left, float number) { \
+		return TensorExpressionScalar<Op, Left, false>(left.self(), number); \
+	} \
+	template <typename Right> \
+	TensorExpressionScalar<Op, Right, true> operator op(float number, const TensorExpression<Right>& right) { \
+		return TensorExpressionScalar<Op, Right, true>(right.self(), number); \
+	}
+
+TENSOR_EXPRESSION_OPERATOR(+, TensorExpressionAdd)
+TENSOR_EXPRESSION_OPERATOR(-, TensorExpressionSub)
+TENSOR_EXPRESSION_OPERATOR(*, TensorExpressionMul)
+TENSOR_EXPRESSION_OPERATOR(/, TensorExpressionDiv)
+
+#undef TENSOR_EXPRESSION_OPERATOR
+
+template <typename Expr>
+TensorExpressionScalar<TensorExpressionMul, Expr, false> operator-(const TensorExpression<Expr>& expression) {
+	return TensorExpressionScalar<TensorExpressionMul, Expr, false>(expression.self(), -1.0f);
+}
+
+template <typename Expr>
+Tensor::Tensor(const TensorExpression<Expr>& expression) {
+	_size = expression.self().size();
+	_shape = expression.self().shape();
+	_data.resize(_size);
+
+	expression.evalTo(_data.data());
+}
+
+template <typename Expr>
+Tensor& Tensor::operator=(const TensorExpression<Expr>& expression) {
+	// if sizes differ the expression does not refer to this tensor, so the buffer can be reallocated
+	if (_size != expression.self().size()) {
+		_size = expression.self().size();
+		_data.resize(_size);
+	}
+	_shape = expression.self().shape();
+
+	expression.evalTo(_data.data());
+
+	return *this;
+}
@@ -0,0 +1,318 @@
+#include "TensorKernels.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#include "FastMath.h"
+
+static void scalar_vector_inner_product(const uint32_t n, const float* v1, const float* v2, float* r) {
+	float result{ 0.0f };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		result += v1[i] * v2[i];
+	}
+	*r = result;
+}
+
+static void scalar_vector_add(const uint32_t n, const float* v1, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v1[i] + v2[i];
+	}
+}
+
+static void scalar_tensor_add(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n1; ++i) {
+		r[i] = v1[i] + v2[i % n2];
+	}
+}
+
+static void scalar_tensor_add_scalar(const uint32_t n, const float* v, const float* s, float* r) {
+	const float value{ *s };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v[i] + value;
+	}
+}
+
+static void scalar_vector_sub(const uint32_t n, const float* v1, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v1[i] - v2[i];
+	}
+}
+
+static void scalar_tensor_sub(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n1; ++i) {
+		r[i] = v1[i] - v2[i % n2];
+	}
+}
+
+static void scalar_tensor_sub_scalar(const uint32_t n, const float* v, const float* s, float* r) {
+	const float value{ *s };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v[i] - value;
+	}
+}
+
+static void scalar_scalar_sub_tensor(const float* s, const uint32_t n, const float* v, float* r) {
+	const float value{ *s };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = value - v[i];
+	}
+}
+
+static void scalar_vector_mul(const uint32_t n, const float* v1, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v1[i] * v2[i];
+	}
+}
+
+static void scalar_tensor_mul(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n1; ++i) {
+		r[i] = v1[i] * v2[i % n2];
+	}
+}
+
+static void scalar_tensor_mul_scalar(const uint32_t n, const float* v, const float* s, float* r) {
+	const float value{ *s };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v[i] * value;
+	}
+}
+
+static void scalar_vector_div(const uint32_t n, const float* v1, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v1[i] / v2[i];
+	}
+}
+
+static void scalar_tensor_div(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r) {
+	for (uint32_t i{ 0 }; i < n1; ++i) {
+		r[i] = v1[i] / v2[i % n2];
+	}
+}
+
+static void scalar_tensor_div_scalar(const uint32_t n, const float* v, const float* s, float* r) {
+	const float value{ *s };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = v[i] / value;
+	}
+}
+
+static void scalar_scalar_div_tensor(const float* s, const uint32_t n, const float* v, float* r) {
+	const float value{ *s };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = value / v[i];
+	}
+}
+
+static void scalar_tensor_sum(const uint32_t n, const float* v, float* r) {
+	float result{ 0.0f };
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		result += v[i];
+	}
+	*r = result;
+}
+
+static void scalar_tensor_axis_sum(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		float* r_row{ r + i * m };
+		std::memset(r_row, 0, sizeof(float) * m);
+		for (uint32_t p{ 0 }; p < k; ++p) {
+			const float* v_row{ v + (i * k + p) * m };
+			for (uint32_t j{ 0 }; j < m; ++j) {
+				r_row[j] += v_row[j];
+			}
+		}
+	}
+}
+
+static void scalar_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		scalar_tensor_sum(k, v + i * k, r + i);
+	}
+}
+
+static void scalar_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		for (uint32_t j{ 0 }; j < m; ++j) {
+			scalar_vector_inner_product(k, v1 + i * k, v2 + j * k, r + i * m + j);
+		}
+	}
+}
+
+template <float (*function)(float)>
+static void scalar_vector_math(const uint32_t n, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		r[i] = function(v[i]);
+	}
+}
+
+constexpr uint32_t SCALAR_GEMM_MR{ 4 };
+constexpr uint32_t SCALAR_GEMM_NR{ 8 };
+
+static void scalar_gemm_micro_kernel(const uint32_t k, const float* a, const float* b, float* c, const uint32_t c_stride) {
+	float acc[SCALAR_GEMM_MR][SCALAR_GEMM_NR]{};
+
+	for (uint32_t p{ 0 }; p < k; ++p) {
+		const float* a_col{ a + p * SCALAR_GEMM_MR };
+		const float* b_row{ b + p * SCALAR_GEMM_NR };
+		for (uint32_t i{ 0 }; i < SCALAR_GEMM_MR; ++i) {
+			for (uint32_t j{ 0 }; j < SCALAR_GEMM_NR; ++j) {
+				acc[i][j] += a_col[i] * b_row[j];
+			}
+		}
+	}
+
+	for (uint32_t i{ 0 }; i < SCALAR_GEMM_MR; ++i) {
+		for (uint32_t j{ 0 }; j < SCALAR_GEMM_NR; ++j) {
+			c[i * c_stride + j] += acc[i][j];
+		}
+	}
+}
+
+static const TensorKernels scalar_kernels{
+	KernelsType::Scalar,
+	"scalar",
+
+	scalar_vector_inner_product,
+
+	scalar_vector_add,
+	scalar_tensor_add,
+	scalar_tensor_add_scalar,
+
+	scalar_vector_sub,
+	scalar_tensor_sub,
+	scalar_tensor_sub_scalar,
+	scalar_scalar_sub_tensor,
+
+	scalar_vector_mul,
+	scalar_tensor_mul,
+	scalar_tensor_mul_scalar,
+
+	scalar_vector_div,
+	scalar_tensor_div,
+	scalar_tensor_div_scalar,
+	scalar_scalar_div_tensor,
+
+	scalar_tensor_sum,
+	scalar_tensor_axis_sum,
+	scalar_tensor_last_axis_sum,
+
+	scalar_tensor_dot_product_transpose,
+
+	scalar_vector_math<fastExp>,
+	scalar_vector_math<fastLog>,
+	scalar_vector_math<fastTanh>,
+	scalar_vector_math<fastSigmoid>,
+
+	SCALAR_GEMM_MR,
+	SCALAR_GEMM_NR,
+	scalar_gemm_micro_kernel
+};
+
+#ifdef SSE
+static const TensorKernels sse_kernels{
+	KernelsType::Sse,
+	"sse",
+
+	SSE_vector_inner_product,
+
+	SSE_vector_add,
+	SSE_tensor_add,
+	SSE_tensor_add_scalar,
+
+	SSE_vector_sub,
+	SSE_tensor_sub,
+	SSE_tensor_sub_scalar,
+	SSE_scalar_sub_tensor,
+
+	SSE_vector_mul,
+	SSE_tensor_mul,
+	SSE_tensor_mul_scalar,
+
+	SSE_vector_div,
+	SSE_tensor_div,
+	SSE_tensor_div_scalar,
+	SSE_scalar_div_tensor,
+
+	SSE_tensor_sum,
+	SSE_tensor_axis_sum,
+	SSE_tensor_last_axis_sum,
+
+	SSE_tensor_dot_product_transpose,
+
+	// there are no assembly math kernels
+	scalar_vector_math<fastExp>,
+	scalar_vector_math<fastLog>,
+	scalar_vector_math<fastTanh>,
+	scalar_vector_math<fastSigmoid>,
+
+	// there is no assembly GEMM micro-kernel
+	SCALAR_GEMM_MR,
+	SCALAR_GEMM_NR,
+	scalar_gemm_micro_kernel
+};
+#endif	// SSE
+
+const TensorKernels* getKernels(KernelsType type) {
+	switch (type) {
+		case KernelsType::Scalar:
+			return &scalar_kernels;
+		case KernelsType::Sse:
+			#ifdef SSE
+			return &sse_kernels;
+			#else	// SSE
+			return nullptr;
+			#endif	// SSE
+		case KernelsType::Avx2:
+			return getAVX2Kernels();
+		case KernelsType::Avx512:
+			return getAVX512Kernels();
+	}
+	return nullptr;
+}
+
+/**
+ * Selects the widest supported kernel set, unless NN_TENSOR_KERNELS environment variable names a supported one.
+ */
+static const TensorKernels* selectKernels() {
+	const char* requested{ std::getenv("NN_TENSOR_KERNELS") };
+
+	if (nullptr != requested) {
+		for (auto type : { KernelsType::Scalar, KernelsType::Sse, KernelsType::Avx2, KernelsType::Avx512 }) {
+			const TensorKernels* kernels{ getKernels(type) };
+			if ((nullptr != kernels) && (0 == std::strcmp(requested, kernels->name))) {
+				return kernels;
+			}
+		}
+	}
+
+	for (auto type : { KernelsType::Avx512, KernelsType::Avx2, KernelsType::Sse }) {
+		const TensorKernels* kernels{ getKernels(type) };
+		if (nullptr != kernels) {
+			return kernels;
+		}
+	}
+
+	return &scalar_kernels;
+}
+
+static const TensorKernels*& activeKernels() {
+	static const TensorKernels* kernels{ selectKernels() };
+	return kernels;
+}
+
+const TensorKernels& getKernels() {
+	return *activeKernels();
+}
+
+bool setKernels(KernelsType type) {
+	const TensorKernels* kernels{ getKernels(type) };
+
+	if (nullptr == kernels) {
+		return false;
+	}
+
+	activeKernels() = kernels;
+
+	return true;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+#ifdef SSE
+	#ifndef WIN
+		#define SSE_vector_inner_product 			_SSE_vector_inner_product
+
+		#define SSE_vector_add 						_SSE_vector_add
+		#define SSE_tensor_add 						_SSE_tensor_add
+		#define SSE_tensor_add_scalar 				_SSE_tensor_add_scalar
+
+		#define SSE_vector_sub 						_SSE_vector_sub
+		#define SSE_tensor_sub 						_SSE_tensor_sub
+		#define SSE_tensor_sub_scalar 				_SSE_tensor_sub_scalar
+		#define SSE_scalar_sub_tensor 				_SSE_scalar_sub_tensor
+
+		#define SSE_vector_mul 						_SSE_vector_mul
+		#define SSE_tensor_mul 						_SSE_tensor_mul
+		#define SSE_tensor_mul_scalar 				_SSE_tensor_mul_scalar
+
+		#define SSE_vector_div 						_SSE_vector_div
+		#define SSE_tensor_div 						_SSE_tensor_div
+		#define SSE_tensor_div_scalar 				_SSE_tensor_div_scalar
+		#define SSE_scalar_div_tensor 				_SSE_scalar_div_tensor
+		
+		#define SSE_tensor_sum 						_SSE_tensor_sum
+		#define SSE_tensor_axis_sum					_SSE_tensor_axis_sum
+		#define SSE_tensor_last_axis_sum			_SSE_tensor_last_axis_sum
+
+		#define SSE_tensor_dot_product_transpose	_SSE_tensor_dot_product_transpose
+	#endif
+	
+	extern "C" {
+		void SSE_vector_inner_product(const uint32_t n, const float* v1, const float* v2, float* r);
+
+		void SSE_vector_add(const uint32_t n, const float* v1, const float* v2, float* r);
+		void SSE_tensor_add(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+		void SSE_tensor_add_scalar(const uint32_t n, const float* v, const float* s, float* r);
+		
+		void SSE_vector_sub(const uint32_t n, const float* v1, const float* v2, float* r);
+		void SSE_tensor_sub(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+		void SSE_tensor_sub_scalar(const uint32_t n, const float* v, const float* s, float* r);
+		void SSE_scalar_sub_tensor(const float* s, const uint32_t n, const float* v, float* r);
+
+		void SSE_vector_mul(const uint32_t n, const float* v1, const float* v2, float* r);
+		void SSE_tensor_mul(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+		void SSE_tensor_mul_scalar(const uint32_t n, const float* v, const float* s, float* r);
+
+		void SSE_vector_div(const uint32_t n, const float* v1, const float* v2, float* r);
+		void SSE_tensor_div(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+		void SSE_tensor_div_scalar(const uint32_t n, const float* v, const float* s, float* r);
+		void SSE_scalar_div_tensor(const float* s, const uint32_t n, const float* v, float* r);
+		
+		void SSE_tensor_sum(const uint32_t n, const float* v, float* r);
+		void SSE_tensor_axis_sum(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r);
+		void SSE_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r);
+
+		void SSE_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r);
+	}
+#endif
+
+/**
+ * @brief Available kernel sets.
+ */
+enum class KernelsType {
+	Scalar,
+	Sse,
+	Avx2,
+	Avx512
+};
+
+/**
+ * @brief Table of element-wise, reduction and matrix product kernels used by Tensor.
+ * All kernels have the same signatures and semantics as corresponding SSE_* routines.
+ */
+struct TensorKernels {
+	KernelsType type;
+	const char* name;
+
+	void (*vector_inner_product)(const uint32_t n, const float* v1, const float* v2, float* r);
+
+	void (*vector_add)(const uint32_t n, const float* v1, const float* v2, float* r);
+	void (*tensor_add)(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+	void (*tensor_add_scalar)(const uint32_t n, const float* v, const float* s, float* r);
+
+	void (*vector_sub)(const uint32_t n, const float* v1, const float* v2, float* r);
+	void (*tensor_sub)(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+	void (*tensor_sub_scalar)(const uint32_t n, const float* v, const float* s, float* r);
+	void (*scalar_sub_tensor)(const float* s, const uint32_t n, const float* v, float* r);
+
+	void (*vector_mul)(const uint32_t n, const float* v1, const float* v2, float* r);
+	void (*tensor_mul)(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+	void (*tensor_mul_scalar)(const uint32_t n, const float* v, const float* s, float* r);
+
+	void (*vector_div)(const uint32_t n, const float* v1, const float* v2, float* r);
+	void (*tensor_div)(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+	void (*tensor_div_scalar)(const uint32_t n, const float* v, const float* s, float* r);
+	void (*scalar_div_tensor)(const float* s, const uint32_t n, const float* v, float* r);
+
+	void (*tensor_sum)(const uint32_t n, const float* v, float* r);
+	void (*tensor_axis_sum)(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r);
+	void (*tensor_last_axis_sum)(const uint32_t n, const uint32_t k, const float* v, float* r);
+
+	void (*tensor_dot_product_transpose)(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r);
+
+	/**
+	 * Element-wise exp, log, tanh and sigmoid of n values (polynomial approximations described in FastMath.h).
+	 * r may be the same as v.
+	 */
+	void (*vector_exp)(const uint32_t n, const float* v, float* r);
+	void (*vector_log)(const uint32_t n, const float* v, float* r);
+	void (*vector_tanh)(const uint32_t n, const float* v, float* r);
+	void (*vector_sigmoid)(const uint32_t n, const float* v, float* r);
+
+	/**
+	 * GEMM micro-kernel computing c += a * b for a single [gemm_mr, gemm_nr] tile of c (see Gemm.h).
+	 * a is a packed panel of k columns with gemm_mr values each, b is a packed panel of k rows with gemm_nr values each
+	 * and c is a row-major tile with row stride c_stride.
+	 */
+	uint32_t gemm_mr;
+	uint32_t gemm_nr;
+	void (*gemm_micro_kernel)(const uint32_t k, const float* a, const float* b, float* c, const uint32_t c_stride);
+};
+
+/**
+ * @brief Returns kernels used by Tensor operations.
+ * On first use the widest kernel set supported by CPU (checked with CPUID) is selected:
+ * AVX-512, AVX2+FMA, SSE (only when built with assembly) and scalar as a fallback.
+ * Selection can be overridden with environment variable NN_TENSOR_KERNELS (scalar, sse, avx2, avx512).
+ * 
+ * @return Active kernel table.
+ */
+const TensorKernels& getKernels();
+/**
+ * @brief Returns kernel table of given type.
+ * 
+ * @param type Kernel set type.
+ * @return Kernel table or nullptr if the kernel set is not supported by CPU or not built.
+ */
+const TensorKernels* getKernels(KernelsType type);
+/**
+ * @brief Sets kernels used by Tensor operations.
+ * 
+ * @param type Kernel set type.
+ * @return True if kernel set is supported and was selected, false otherwise.
+ */
+bool setKernels(KernelsType type);
+
+/**
+ * @brief Returns AVX2+FMA kernel table (defined in TensorKernels_avx2.cpp).
+ * 
+ * @return Kernel table or nullptr if not available on this platform.
+ */
+const TensorKernels* getAVX2Kernels();
+/**
+ * @brief Returns AVX-512 kernel table (defined in TensorKernels_avx512.cpp).
+ * 
+ * @return Kernel table or nullptr if not available on this platform.
+ */
+const TensorKernels* getAVX512Kernels();
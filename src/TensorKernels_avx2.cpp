@@ -0,0 +1,493 @@
+#include "TensorKernels.h"
+
+#include <limits>
+
+#include "FastMath.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+/**
+ * AVX2+FMA kernels. Only functions marked with AVX2_TARGET are compiled with AVX2 enabled and they
+ * are all internal to this file, so no AVX2 code can leak into the rest of the library.
+ */
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+
+namespace {
+
+struct Add {
+	static AVX2_TARGET __m256 packed(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+	static float scalar(float a, float b) { return a + b; }
+};
+
+struct Sub {
+	static AVX2_TARGET __m256 packed(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+	static float scalar(float a, float b) { return a - b; }
+};
+
+struct Mul {
+	static AVX2_TARGET __m256 packed(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+	static float scalar(float a, float b) { return a * b; }
+};
+
+struct Div {
+	static AVX2_TARGET __m256 packed(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+	static float scalar(float a, float b) { return a / b; }
+};
+
+/**
+ * Sums all lanes of a.
+ */
+AVX2_TARGET inline float horizontalSum(__m256 a) {
+	__m128 sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+	return _mm_cvtss_f32(sum);
+}
+
+/**
+ * r = v1 <op> v2, where v1, v2 and r have size n.
+ */
+template <typename Op>
+AVX2_TARGET void vectorOp(const uint32_t n, const float* v1, const float* v2, float* r) {
+	uint32_t i{ 0 };
+	for (; i + 32 <= n; i += 32) {
+		const __m256 a0 = Op::packed(_mm256_loadu_ps(v1 + i), _mm256_loadu_ps(v2 + i));
+		const __m256 a1 = Op::packed(_mm256_loadu_ps(v1 + i + 8), _mm256_loadu_ps(v2 + i + 8));
+		const __m256 a2 = Op::packed(_mm256_loadu_ps(v1 + i + 16), _mm256_loadu_ps(v2 + i + 16));
+		const __m256 a3 = Op::packed(_mm256_loadu_ps(v1 + i + 24), _mm256_loadu_ps(v2 + i + 24));
+		_mm256_storeu_ps(r + i, a0);
+		_mm256_storeu_ps(r + i + 8, a1);
+		_mm256_storeu_ps(r + i + 16, a2);
+		_mm256_storeu_ps(r + i + 24, a3);
+	}
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(r + i, Op::packed(_mm256_loadu_ps(v1 + i), _mm256_loadu_ps(v2 + i)));
+	}
+	for (; i < n; ++i) {
+		r[i] = Op::scalar(v1[i], v2[i]);
+	}
+}
+
+/**
+ * r = v1 <op> v2, where v1 and r have size n1 and v2 (size n2) is applied to each row of v1.
+ */
+template <typename Op>
+AVX2_TARGET void tensorOp(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r) {
+	for (uint32_t row{ 0 }; row + n2 <= n1; row += n2) {
+		vectorOp<Op>(n2, v1 + row, v2, r + row);
+	}
+}
+
+/**
+ * r = v <op> s.
+ */
+template <typename Op>
+AVX2_TARGET void tensorScalarOp(const uint32_t n, const float* v, const float* s, float* r) {
+	const float value{ *s };
+	const __m256 b = _mm256_set1_ps(value);
+	uint32_t i{ 0 };
+	for (; i + 32 <= n; i += 32) {
+		const __m256 a0 = Op::packed(_mm256_loadu_ps(v + i), b);
+		const __m256 a1 = Op::packed(_mm256_loadu_ps(v + i + 8), b);
+		const __m256 a2 = Op::packed(_mm256_loadu_ps(v + i + 16), b);
+		const __m256 a3 = Op::packed(_mm256_loadu_ps(v + i + 24), b);
+		_mm256_storeu_ps(r + i, a0);
+		_mm256_storeu_ps(r + i + 8, a1);
+		_mm256_storeu_ps(r + i + 16, a2);
+		_mm256_storeu_ps(r + i + 24, a3);
+	}
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(r + i, Op::packed(_mm256_loadu_ps(v + i), b));
+	}
+	for (; i < n; ++i) {
+		r[i] = Op::scalar(v[i], value);
+	}
+}
+
+/**
+ * r = s <op> v.
+ */
+template <typename Op>
+AVX2_TARGET void scalarTensorOp(const float* s, const uint32_t n, const float* v, float* r) {
+	const float value{ *s };
+	const __m256 a = _mm256_set1_ps(value);
+	uint32_t i{ 0 };
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(r + i, Op::packed(a, _mm256_loadu_ps(v + i)));
+	}
+	for (; i < n; ++i) {
+		r[i] = Op::scalar(value, v[i]);
+	}
+}
+
+AVX2_TARGET void avx2_vector_inner_product(const uint32_t n, const float* v1, const float* v2, float* r) {
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+	__m256 acc2 = _mm256_setzero_ps();
+	__m256 acc3 = _mm256_setzero_ps();
+	uint32_t i{ 0 };
+	for (; i + 32 <= n; i += 32) {
+		acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(v1 + i), _mm256_loadu_ps(v2 + i), acc0);
+		acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(v1 + i + 8), _mm256_loadu_ps(v2 + i + 8), acc1);
+		acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(v1 + i + 16), _mm256_loadu_ps(v2 + i + 16), acc2);
+		acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(v1 + i + 24), _mm256_loadu_ps(v2 + i + 24), acc3);
+	}
+	for (; i + 8 <= n; i += 8) {
+		acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(v1 + i), _mm256_loadu_ps(v2 + i), acc0);
+	}
+	float result{ horizontalSum(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3))) };
+	for (; i < n; ++i) {
+		result += v1[i] * v2[i];
+	}
+	*r = result;
+}
+
+AVX2_TARGET void avx2_tensor_sum(const uint32_t n, const float* v, float* r) {
+	__m256 acc0 = _mm256_setzero_ps();
+	__m256 acc1 = _mm256_setzero_ps();
+	__m256 acc2 = _mm256_setzero_ps();
+	__m256 acc3 = _mm256_setzero_ps();
+	uint32_t i{ 0 };
+	for (; i + 32 <= n; i += 32) {
+		acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(v + i));
+		acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(v + i + 8));
+		acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(v + i + 16));
+		acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(v + i + 24));
+	}
+	for (; i + 8 <= n; i += 8) {
+		acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(v + i));
+	}
+	float result{ horizontalSum(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3))) };
+	for (; i < n; ++i) {
+		result += v[i];
+	}
+	*r = result;
+}
+
+AVX2_TARGET void avx2_tensor_axis_sum(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const float* v_block{ v + i * k * m };
+		float* r_row{ r + i * m };
+		uint32_t j{ 0 };
+		for (; j + 32 <= m; j += 32) {
+			__m256 acc0 = _mm256_setzero_ps();
+			__m256 acc1 = _mm256_setzero_ps();
+			__m256 acc2 = _mm256_setzero_ps();
+			__m256 acc3 = _mm256_setzero_ps();
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				const float* v_row{ v_block + p * m + j };
+				acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(v_row));
+				acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(v_row + 8));
+				acc2 = _mm256_add_ps(acc2, _mm256_loadu_ps(v_row + 16));
+				acc3 = _mm256_add_ps(acc3, _mm256_loadu_ps(v_row + 24));
+			}
+			_mm256_storeu_ps(r_row + j, acc0);
+			_mm256_storeu_ps(r_row + j + 8, acc1);
+			_mm256_storeu_ps(r_row + j + 16, acc2);
+			_mm256_storeu_ps(r_row + j + 24, acc3);
+		}
+		for (; j + 8 <= m; j += 8) {
+			__m256 acc = _mm256_setzero_ps();
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				acc = _mm256_add_ps(acc, _mm256_loadu_ps(v_block + p * m + j));
+			}
+			_mm256_storeu_ps(r_row + j, acc);
+		}
+		for (; j < m; ++j) {
+			float acc{ 0.0f };
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				acc += v_block[p * m + j];
+			}
+			r_row[j] = acc;
+		}
+	}
+}
+
+AVX2_TARGET void avx2_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		avx2_tensor_sum(k, v + i * k, r + i);
+	}
+}
+
+AVX2_TARGET void avx2_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const float* a{ v1 + i * k };
+		float* r_row{ r + i * m };
+		uint32_t j{ 0 };
+		// four rows of v2 at once, so each load of v1 is reused four times
+		for (; j + 4 <= m; j += 4) {
+			const float* b0{ v2 + j * k };
+			const float* b1{ b0 + k };
+			const float* b2{ b1 + k };
+			const float* b3{ b2 + k };
+			__m256 acc0 = _mm256_setzero_ps();
+			__m256 acc1 = _mm256_setzero_ps();
+			__m256 acc2 = _mm256_setzero_ps();
+			__m256 acc3 = _mm256_setzero_ps();
+			uint32_t p{ 0 };
+			for (; p + 8 <= k; p += 8) {
+				const __m256 a_p = _mm256_loadu_ps(a + p);
+				acc0 = _mm256_fmadd_ps(a_p, _mm256_loadu_ps(b0 + p), acc0);
+				acc1 = _mm256_fmadd_ps(a_p, _mm256_loadu_ps(b1 + p), acc1);
+				acc2 = _mm256_fmadd_ps(a_p, _mm256_loadu_ps(b2 + p), acc2);
+				acc3 = _mm256_fmadd_ps(a_p, _mm256_loadu_ps(b3 + p), acc3);
+			}
+			// [acc0, acc1, acc2, acc3] -> [sum(acc0), sum(acc1), sum(acc2), sum(acc3)]
+			const __m256 h01 = _mm256_hadd_ps(acc0, acc1);
+			const __m256 h23 = _mm256_hadd_ps(acc2, acc3);
+			const __m256 h = _mm256_hadd_ps(h01, h23);
+			__m128 sums = _mm_add_ps(_mm256_castps256_ps128(h), _mm256_extractf128_ps(h, 1));
+			if (p < k) {
+				alignas(16) float tail[4]{ 0.0f, 0.0f, 0.0f, 0.0f };
+				for (; p < k; ++p) {
+					tail[0] += a[p] * b0[p];
+					tail[1] += a[p] * b1[p];
+					tail[2] += a[p] * b2[p];
+					tail[3] += a[p] * b3[p];
+				}
+				sums = _mm_add_ps(sums, _mm_load_ps(tail));
+			}
+			_mm_storeu_ps(r_row + j, sums);
+		}
+		for (; j < m; ++j) {
+			avx2_vector_inner_product(k, a, v2 + j * k, r_row + j);
+		}
+	}
+}
+
+/**
+ * e^x, the polynomial of fastExp (see FastMath.h) evaluated with FMA.
+ */
+AVX2_TARGET inline __m256 exp256(__m256 x) {
+	// max and min return the second operand for NaN, so NaN is propagated
+	const __m256 clamped = _mm256_min_ps(_mm256_set1_ps(FAST_EXP_MAX), _mm256_max_ps(_mm256_set1_ps(FAST_EXP_MIN), x));
+	const __m256 magic = _mm256_set1_ps(FAST_ROUND_MAGIC);
+	const __m256 n = _mm256_sub_ps(_mm256_fmadd_ps(clamped, _mm256_set1_ps(FAST_LOG2E), magic), magic);
+	__m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(FAST_LN2_HI), clamped);
+	r = _mm256_fnmadd_ps(n, _mm256_set1_ps(FAST_LN2_LO), r);
+
+	__m256 p = _mm256_set1_ps(1.9875691500e-4f);
+	p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.3981999507e-3f));
+	p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(8.3334519073e-3f));
+	p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(4.1665795894e-2f));
+	p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(1.6666665459e-1f));
+	p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(5.0000001201e-1f));
+	const __m256 e_r = _mm256_add_ps(_mm256_fmadd_ps(p, _mm256_mul_ps(r, r), r), _mm256_set1_ps(1.0f));
+
+	// e_r * 2^n computed as in fastScale
+	const __m256i n_i = _mm256_cvtps_epi32(n);
+	const __m256i half = _mm256_srai_epi32(n_i, 1);
+	const __m256i bias = _mm256_set1_epi32(127);
+	const __m256 scale0 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(half, bias), 23));
+	const __m256 scale1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_sub_epi32(n_i, half), bias), 23));
+	__m256 result = _mm256_mul_ps(_mm256_mul_ps(e_r, scale0), scale1);
+
+	result = _mm256_blendv_ps(result, _mm256_set1_ps(std::numeric_limits<float>::infinity()),
+		_mm256_cmp_ps(x, _mm256_set1_ps(FAST_EXP_MAX), _CMP_GT_OQ));
+	return _mm256_andnot_ps(_mm256_cmp_ps(x, _mm256_set1_ps(FAST_EXP_MIN), _CMP_LT_OQ), result);
+}
+
+/**
+ * ln(x), the polynomial of fastLog evaluated with FMA.
+ */
+AVX2_TARGET inline __m256 log256(__m256 x) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	// denormals are scaled by 2^23 first
+	const __m256 denormal = _mm256_cmp_ps(x, _mm256_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ);
+	const __m256i bits = _mm256_castps_si256(_mm256_blendv_ps(x, _mm256_mul_ps(x, _mm256_set1_ps(8388608.0f)), denormal));
+	__m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+	e = _mm256_sub_ps(e, _mm256_and_ps(denormal, _mm256_set1_ps(23.0f)));
+	// mantissa in [0.5, 1)
+	__m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+		_mm256_set1_epi32(0x3f000000)));
+
+	const __m256 small = _mm256_cmp_ps(m, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+	e = _mm256_sub_ps(e, _mm256_and_ps(small, one));
+	m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(small, m)), one);
+
+	const __m256 z = _mm256_mul_ps(m, m);
+	__m256 p = _mm256_set1_ps(7.0376836292e-2f);
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.1514610310e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.1676998740e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.2420140846e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(1.4249322787e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-1.6668057665e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(2.0000714765e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(-2.4999993993e-1f));
+	p = _mm256_fmadd_ps(p, m, _mm256_set1_ps(3.3333331174e-1f));
+	__m256 y = _mm256_mul_ps(_mm256_mul_ps(p, m), z);
+	y = _mm256_fmadd_ps(e, _mm256_set1_ps(FAST_LN2_LO), y);
+	y = _mm256_fnmadd_ps(_mm256_set1_ps(0.5f), z, y);
+	__m256 result = _mm256_fmadd_ps(e, _mm256_set1_ps(FAST_LN2_HI), _mm256_add_ps(m, y));
+
+	const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+	const __m256 zero = _mm256_setzero_ps();
+	result = _mm256_blendv_ps(result, inf, _mm256_cmp_ps(x, inf, _CMP_EQ_OQ));
+	result = _mm256_blendv_ps(result, _mm256_set1_ps(std::numeric_limits<float>::quiet_NaN()), _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+	result = _mm256_blendv_ps(result, _mm256_sub_ps(zero, inf), _mm256_cmp_ps(x, zero, _CMP_EQ_OQ));
+	return _mm256_blendv_ps(result, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+}
+
+/**
+ * tanh(x), the polynomial of fastTanh evaluated with FMA.
+ */
+AVX2_TARGET inline __m256 tanh256(__m256 x) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	const __m256 z = _mm256_mul_ps(x, x);
+	__m256 p = _mm256_set1_ps(-5.70498872745e-3f);
+	p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954e-2f));
+	p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531e-2f));
+	p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036e-1f));
+	p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422e-1f));
+	const __m256 small_result = _mm256_fmadd_ps(_mm256_mul_ps(p, z), x, x);
+
+	const __m256 a = _mm256_andnot_ps(sign, x);
+	const __m256 large_abs = _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(exp256(_mm256_add_ps(a, a)), one)));
+	const __m256 large_result = _mm256_or_ps(large_abs, _mm256_and_ps(sign, x));
+
+	return _mm256_blendv_ps(large_result, small_result, _mm256_cmp_ps(a, _mm256_set1_ps(0.625f), _CMP_LT_OQ));
+}
+
+/**
+ * 1 / (1 + e^-x).
+ */
+AVX2_TARGET inline __m256 sigmoid256(__m256 x) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	return _mm256_div_ps(one, _mm256_add_ps(one, exp256(_mm256_xor_ps(x, _mm256_set1_ps(-0.0f)))));
+}
+
+struct Exp {
+	static AVX2_TARGET __m256 packed(__m256 x) { return exp256(x); }
+	static float scalar(float x) { return fastExp(x); }
+};
+
+struct Log {
+	static AVX2_TARGET __m256 packed(__m256 x) { return log256(x); }
+	static float scalar(float x) { return fastLog(x); }
+};
+
+struct Tanh {
+	static AVX2_TARGET __m256 packed(__m256 x) { return tanh256(x); }
+	static float scalar(float x) { return fastTanh(x); }
+};
+
+struct Sigmoid {
+	static AVX2_TARGET __m256 packed(__m256 x) { return sigmoid256(x); }
+	static float scalar(float x) { return fastSigmoid(x); }
+};
+
+/**
+ * r = function(v), where v and r have size n.
+ */
+template <typename Function>
+AVX2_TARGET void vectorMath(const uint32_t n, const float* v, float* r) {
+	uint32_t i{ 0 };
+	for (; i + 16 <= n; i += 16) {
+		const __m256 a0 = Function::packed(_mm256_loadu_ps(v + i));
+		const __m256 a1 = Function::packed(_mm256_loadu_ps(v + i + 8));
+		_mm256_storeu_ps(r + i, a0);
+		_mm256_storeu_ps(r + i + 8, a1);
+	}
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(r + i, Function::packed(_mm256_loadu_ps(v + i)));
+	}
+	for (; i < n; ++i) {
+		r[i] = Function::scalar(v[i]);
+	}
+}
+
+constexpr uint32_t AVX2_GEMM_MR{ 6 };
+constexpr uint32_t AVX2_GEMM_NR{ 16 };
+
+/**
+ * [6, 16] tile kept in 12 accumulators, each step broadcasts one value of a and does two FMAs with a row of b.
+ */
+AVX2_TARGET void avx2_gemm_micro_kernel(const uint32_t k, const float* a, const float* b, float* c, const uint32_t c_stride) {
+	__m256 acc[AVX2_GEMM_MR][2];
+
+	#pragma GCC unroll 6
+	for (uint32_t i{ 0 }; i < AVX2_GEMM_MR; ++i) {
+		acc[i][0] = _mm256_setzero_ps();
+		acc[i][1] = _mm256_setzero_ps();
+	}
+
+	for (uint32_t p{ 0 }; p < k; ++p) {
+		const __m256 b0 = _mm256_loadu_ps(b + p * AVX2_GEMM_NR);
+		const __m256 b1 = _mm256_loadu_ps(b + p * AVX2_GEMM_NR + 8);
+		const float* a_col{ a + p * AVX2_GEMM_MR };
+		#pragma GCC unroll 6
+		for (uint32_t i{ 0 }; i < AVX2_GEMM_MR; ++i) {
+			const __m256 a_i = _mm256_broadcast_ss(a_col + i);
+			acc[i][0] = _mm256_fmadd_ps(a_i, b0, acc[i][0]);
+			acc[i][1] = _mm256_fmadd_ps(a_i, b1, acc[i][1]);
+		}
+	}
+
+	#pragma GCC unroll 6
+	for (uint32_t i{ 0 }; i < AVX2_GEMM_MR; ++i) {
+		float* c_row{ c + i * c_stride };
+		_mm256_storeu_ps(c_row, _mm256_add_ps(_mm256_loadu_ps(c_row), acc[i][0]));
+		_mm256_storeu_ps(c_row + 8, _mm256_add_ps(_mm256_loadu_ps(c_row + 8), acc[i][1]));
+	}
+}
+
+const TensorKernels avx2_kernels{
+	KernelsType::Avx2,
+	"avx2",
+
+	avx2_vector_inner_product,
+
+	vectorOp<Add>,
+	tensorOp<Add>,
+	tensorScalarOp<Add>,
+
+	vectorOp<Sub>,
+	tensorOp<Sub>,
+	tensorScalarOp<Sub>,
+	scalarTensorOp<Sub>,
+
+	vectorOp<Mul>,
+	tensorOp<Mul>,
+	tensorScalarOp<Mul>,
+
+	vectorOp<Div>,
+	tensorOp<Div>,
+	tensorScalarOp<Div>,
+	scalarTensorOp<Div>,
+
+	avx2_tensor_sum,
+	avx2_tensor_axis_sum,
+	avx2_tensor_last_axis_sum,
+
+	avx2_tensor_dot_product_transpose,
+
+	vectorMath<Exp>,
+	vectorMath<Log>,
+	vectorMath<Tanh>,
+	vectorMath<Sigmoid>,
+
+	AVX2_GEMM_MR,
+	AVX2_GEMM_NR,
+	avx2_gemm_micro_kernel
+};
+
+}	// namespace
+
+const TensorKernels* getAVX2Kernels() {
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+		return &avx2_kernels;
+	}
+	return nullptr;
+}
+
+#else	// x86
+
+const TensorKernels* getAVX2Kernels() {
+	return nullptr;
+}
+
+#endif	// x86
@@ -0,0 +1,505 @@
+#include "TensorKernels.h"
+
+#include <limits>
+
+#include "FastMath.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+/**
+ * AVX-512 kernels. Only functions marked with AVX512_TARGET are compiled with AVX-512 enabled and they
+ * are all internal to this file, so no AVX-512 code can leak into the rest of the library.
+ * Tails shorter than 16 values are handled with masked loads and stores.
+ */
+#define AVX512_TARGET __attribute__((target("avx512f")))
+
+namespace {
+
+struct Add {
+	static AVX512_TARGET __m512 packed(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+};
+
+struct Sub {
+	static AVX512_TARGET __m512 packed(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
+};
+
+struct Mul {
+	static AVX512_TARGET __m512 packed(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
+};
+
+struct Div {
+	static AVX512_TARGET __m512 packed(__m512 a, __m512 b) { return _mm512_div_ps(a, b); }
+};
+
+/**
+ * Mask of the first n (< 16) lanes.
+ */
+inline __mmask16 tailMask(uint32_t n) {
+	return static_cast<__mmask16>((1u << n) - 1u);
+}
+
+/**
+ * Sums all lanes of a.
+ */
+AVX512_TARGET inline float horizontalSum(__m512 a) {
+	// move upper halves down and add, 16 -> 8 -> 4 lanes
+	// (maskz variants are used, since unmasked ones trigger false uninitialized warnings in GCC headers)
+	a = _mm512_add_ps(a, _mm512_maskz_shuffle_f32x4(0xFFFF, a, a, 0b00001110));
+	a = _mm512_add_ps(a, _mm512_maskz_shuffle_f32x4(0xFFFF, a, a, 0b00000001));
+	__m128 sum = _mm512_maskz_extractf32x4_ps(0xF, a, 0);
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+	return _mm_cvtss_f32(sum);
+}
+
+/**
+ * r = v1 <op> v2, where v1, v2 and r have size n.
+ */
+template <typename Op>
+AVX512_TARGET void vectorOp(const uint32_t n, const float* v1, const float* v2, float* r) {
+	uint32_t i{ 0 };
+	for (; i + 64 <= n; i += 64) {
+		const __m512 a0 = Op::packed(_mm512_loadu_ps(v1 + i), _mm512_loadu_ps(v2 + i));
+		const __m512 a1 = Op::packed(_mm512_loadu_ps(v1 + i + 16), _mm512_loadu_ps(v2 + i + 16));
+		const __m512 a2 = Op::packed(_mm512_loadu_ps(v1 + i + 32), _mm512_loadu_ps(v2 + i + 32));
+		const __m512 a3 = Op::packed(_mm512_loadu_ps(v1 + i + 48), _mm512_loadu_ps(v2 + i + 48));
+		_mm512_storeu_ps(r + i, a0);
+		_mm512_storeu_ps(r + i + 16, a1);
+		_mm512_storeu_ps(r + i + 32, a2);
+		_mm512_storeu_ps(r + i + 48, a3);
+	}
+	for (; i + 16 <= n; i += 16) {
+		_mm512_storeu_ps(r + i, Op::packed(_mm512_loadu_ps(v1 + i), _mm512_loadu_ps(v2 + i)));
+	}
+	if (i < n) {
+		const __mmask16 mask{ tailMask(n - i) };
+		// masked out lanes of v2 are set to 1 so division does not produce infinities
+		const __m512 b = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), mask, v2 + i);
+		_mm512_mask_storeu_ps(r + i, mask, Op::packed(_mm512_maskz_loadu_ps(mask, v1 + i), b));
+	}
+}
+
+/**
+ * r = v1 <op> v2, where v1 and r have size n1 and v2 (size n2) is applied to each row of v1.
+ */
+template <typename Op>
+AVX512_TARGET void tensorOp(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r) {
+	for (uint32_t row{ 0 }; row + n2 <= n1; row += n2) {
+		vectorOp<Op>(n2, v1 + row, v2, r + row);
+	}
+}
+
+/**
+ * r = v <op> s.
+ */
+template <typename Op>
+AVX512_TARGET void tensorScalarOp(const uint32_t n, const float* v, const float* s, float* r) {
+	const __m512 b = _mm512_set1_ps(*s);
+	uint32_t i{ 0 };
+	for (; i + 64 <= n; i += 64) {
+		const __m512 a0 = Op::packed(_mm512_loadu_ps(v + i), b);
+		const __m512 a1 = Op::packed(_mm512_loadu_ps(v + i + 16), b);
+		const __m512 a2 = Op::packed(_mm512_loadu_ps(v + i + 32), b);
+		const __m512 a3 = Op::packed(_mm512_loadu_ps(v + i + 48), b);
+		_mm512_storeu_ps(r + i, a0);
+		_mm512_storeu_ps(r + i + 16, a1);
+		_mm512_storeu_ps(r + i + 32, a2);
+		_mm512_storeu_ps(r + i + 48, a3);
+	}
+	for (; i + 16 <= n; i += 16) {
+		_mm512_storeu_ps(r + i, Op::packed(_mm512_loadu_ps(v + i), b));
+	}
+	if (i < n) {
+		const __mmask16 mask{ tailMask(n - i) };
+		_mm512_mask_storeu_ps(r + i, mask, Op::packed(_mm512_maskz_loadu_ps(mask, v + i), b));
+	}
+}
+
+/**
+ * r = s <op> v.
+ */
+template <typename Op>
+AVX512_TARGET void scalarTensorOp(const float* s, const uint32_t n, const float* v, float* r) {
+	const __m512 a = _mm512_set1_ps(*s);
+	uint32_t i{ 0 };
+	for (; i + 16 <= n; i += 16) {
+		_mm512_storeu_ps(r + i, Op::packed(a, _mm512_loadu_ps(v + i)));
+	}
+	if (i < n) {
+		const __mmask16 mask{ tailMask(n - i) };
+		// masked out lanes of v are set to 1 so division does not produce infinities
+		const __m512 b = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), mask, v + i);
+		_mm512_mask_storeu_ps(r + i, mask, Op::packed(a, b));
+	}
+}
+
+AVX512_TARGET void avx512_vector_inner_product(const uint32_t n, const float* v1, const float* v2, float* r) {
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+	__m512 acc2 = _mm512_setzero_ps();
+	__m512 acc3 = _mm512_setzero_ps();
+	uint32_t i{ 0 };
+	for (; i + 64 <= n; i += 64) {
+		acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(v1 + i), _mm512_loadu_ps(v2 + i), acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(v1 + i + 16), _mm512_loadu_ps(v2 + i + 16), acc1);
+		acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(v1 + i + 32), _mm512_loadu_ps(v2 + i + 32), acc2);
+		acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(v1 + i + 48), _mm512_loadu_ps(v2 + i + 48), acc3);
+	}
+	for (; i + 16 <= n; i += 16) {
+		acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(v1 + i), _mm512_loadu_ps(v2 + i), acc0);
+	}
+	if (i < n) {
+		const __mmask16 mask{ tailMask(n - i) };
+		acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, v1 + i), _mm512_maskz_loadu_ps(mask, v2 + i), acc1);
+	}
+	*r = horizontalSum(_mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+}
+
+AVX512_TARGET void avx512_tensor_sum(const uint32_t n, const float* v, float* r) {
+	__m512 acc0 = _mm512_setzero_ps();
+	__m512 acc1 = _mm512_setzero_ps();
+	__m512 acc2 = _mm512_setzero_ps();
+	__m512 acc3 = _mm512_setzero_ps();
+	uint32_t i{ 0 };
+	for (; i + 64 <= n; i += 64) {
+		acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(v + i));
+		acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(v + i + 16));
+		acc2 = _mm512_add_ps(acc2, _mm512_loadu_ps(v + i + 32));
+		acc3 = _mm512_add_ps(acc3, _mm512_loadu_ps(v + i + 48));
+	}
+	for (; i + 16 <= n; i += 16) {
+		acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(v + i));
+	}
+	if (i < n) {
+		acc1 = _mm512_add_ps(acc1, _mm512_maskz_loadu_ps(tailMask(n - i), v + i));
+	}
+	*r = horizontalSum(_mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+}
+
+AVX512_TARGET void avx512_tensor_axis_sum(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const float* v_block{ v + i * k * m };
+		float* r_row{ r + i * m };
+		uint32_t j{ 0 };
+		for (; j + 64 <= m; j += 64) {
+			__m512 acc0 = _mm512_setzero_ps();
+			__m512 acc1 = _mm512_setzero_ps();
+			__m512 acc2 = _mm512_setzero_ps();
+			__m512 acc3 = _mm512_setzero_ps();
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				const float* v_row{ v_block + p * m + j };
+				acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(v_row));
+				acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(v_row + 16));
+				acc2 = _mm512_add_ps(acc2, _mm512_loadu_ps(v_row + 32));
+				acc3 = _mm512_add_ps(acc3, _mm512_loadu_ps(v_row + 48));
+			}
+			_mm512_storeu_ps(r_row + j, acc0);
+			_mm512_storeu_ps(r_row + j + 16, acc1);
+			_mm512_storeu_ps(r_row + j + 32, acc2);
+			_mm512_storeu_ps(r_row + j + 48, acc3);
+		}
+		for (; j + 16 <= m; j += 16) {
+			__m512 acc = _mm512_setzero_ps();
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				acc = _mm512_add_ps(acc, _mm512_loadu_ps(v_block + p * m + j));
+			}
+			_mm512_storeu_ps(r_row + j, acc);
+		}
+		if (j < m) {
+			const __mmask16 mask{ tailMask(m - j) };
+			__m512 acc = _mm512_setzero_ps();
+			for (uint32_t p{ 0 }; p < k; ++p) {
+				acc = _mm512_add_ps(acc, _mm512_maskz_loadu_ps(mask, v_block + p * m + j));
+			}
+			_mm512_mask_storeu_ps(r_row + j, mask, acc);
+		}
+	}
+}
+
+AVX512_TARGET void avx512_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r) {
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		avx512_tensor_sum(k, v + i * k, r + i);
+	}
+}
+
+AVX512_TARGET void avx512_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r) {
+	const __mmask16 mask{ tailMask(k % 16) };
+
+	for (uint32_t i{ 0 }; i < n; ++i) {
+		const float* a{ v1 + i * k };
+		float* r_row{ r + i * m };
+		uint32_t j{ 0 };
+		// four rows of v2 at once, so each load of v1 is reused four times
+		for (; j + 4 <= m; j += 4) {
+			const float* b0{ v2 + j * k };
+			const float* b1{ b0 + k };
+			const float* b2{ b1 + k };
+			const float* b3{ b2 + k };
+			__m512 acc0 = _mm512_setzero_ps();
+			__m512 acc1 = _mm512_setzero_ps();
+			__m512 acc2 = _mm512_setzero_ps();
+			__m512 acc3 = _mm512_setzero_ps();
+			uint32_t p{ 0 };
+			for (; p + 16 <= k; p += 16) {
+				const __m512 a_p = _mm512_loadu_ps(a + p);
+				acc0 = _mm512_fmadd_ps(a_p, _mm512_loadu_ps(b0 + p), acc0);
+				acc1 = _mm512_fmadd_ps(a_p, _mm512_loadu_ps(b1 + p), acc1);
+				acc2 = _mm512_fmadd_ps(a_p, _mm512_loadu_ps(b2 + p), acc2);
+				acc3 = _mm512_fmadd_ps(a_p, _mm512_loadu_ps(b3 + p), acc3);
+			}
+			if (p < k) {
+				const __m512 a_p = _mm512_maskz_loadu_ps(mask, a + p);
+				acc0 = _mm512_fmadd_ps(a_p, _mm512_maskz_loadu_ps(mask, b0 + p), acc0);
+				acc1 = _mm512_fmadd_ps(a_p, _mm512_maskz_loadu_ps(mask, b1 + p), acc1);
+				acc2 = _mm512_fmadd_ps(a_p, _mm512_maskz_loadu_ps(mask, b2 + p), acc2);
+				acc3 = _mm512_fmadd_ps(a_p, _mm512_maskz_loadu_ps(mask, b3 + p), acc3);
+			}
+			r_row[j] = horizontalSum(acc0);
+			r_row[j + 1] = horizontalSum(acc1);
+			r_row[j + 2] = horizontalSum(acc2);
+			r_row[j + 3] = horizontalSum(acc3);
+		}
+		for (; j < m; ++j) {
+			avx512_vector_inner_product(k, a, v2 + j * k, r_row + j);
+		}
+	}
+}
+
+/**
+ * e^x, the polynomial of fastExp (see FastMath.h) evaluated with FMA.
+ */
+AVX512_TARGET inline __m512 exp512(__m512 x) {
+	// max and min return the second operand for NaN, so NaN is propagated
+	// (maskz variants are used, since unmasked ones trigger false uninitialized warnings in GCC headers)
+	const __m512 clamped = _mm512_maskz_min_ps(0xFFFF, _mm512_set1_ps(FAST_EXP_MAX), _mm512_maskz_max_ps(0xFFFF, _mm512_set1_ps(FAST_EXP_MIN), x));
+	const __m512 magic = _mm512_set1_ps(FAST_ROUND_MAGIC);
+	const __m512 n = _mm512_sub_ps(_mm512_fmadd_ps(clamped, _mm512_set1_ps(FAST_LOG2E), magic), magic);
+	__m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(FAST_LN2_HI), clamped);
+	r = _mm512_fnmadd_ps(n, _mm512_set1_ps(FAST_LN2_LO), r);
+
+	__m512 p = _mm512_set1_ps(1.9875691500e-4f);
+	p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.3981999507e-3f));
+	p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(8.3334519073e-3f));
+	p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(4.1665795894e-2f));
+	p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.6666665459e-1f));
+	p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(5.0000001201e-1f));
+	const __m512 e_r = _mm512_add_ps(_mm512_fmadd_ps(p, _mm512_mul_ps(r, r), r), _mm512_set1_ps(1.0f));
+
+	// e_r * 2^n computed as in fastScale
+	const __m512i n_i = _mm512_maskz_cvtps_epi32(0xFFFF, n);
+	const __m512i half = _mm512_maskz_srai_epi32(0xFFFF, n_i, 1);
+	const __m512i bias = _mm512_set1_epi32(127);
+	const __m512 scale0 = _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, _mm512_add_epi32(half, bias), 23));
+	const __m512 scale1 = _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, _mm512_add_epi32(_mm512_sub_epi32(n_i, half), bias), 23));
+	__m512 result = _mm512_mul_ps(_mm512_mul_ps(e_r, scale0), scale1);
+
+	result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_set1_ps(FAST_EXP_MAX), _CMP_GT_OQ), result,
+		_mm512_set1_ps(std::numeric_limits<float>::infinity()));
+	return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_set1_ps(FAST_EXP_MIN), _CMP_LT_OQ), result, _mm512_setzero_ps());
+}
+
+/**
+ * ln(x), the polynomial of fastLog evaluated with FMA.
+ */
+AVX512_TARGET inline __m512 log512(__m512 x) {
+	const __m512 one = _mm512_set1_ps(1.0f);
+	// denormals are scaled by 2^23 first
+	const __mmask16 denormal{ _mm512_cmp_ps_mask(x, _mm512_set1_ps(std::numeric_limits<float>::min()), _CMP_LT_OQ) };
+	const __m512i bits = _mm512_castps_si512(_mm512_mask_mul_ps(x, denormal, x, _mm512_set1_ps(8388608.0f)));
+	__m512 e = _mm512_maskz_cvtepi32_ps(0xFFFF, _mm512_sub_epi32(_mm512_maskz_srli_epi32(0xFFFF, bits, 23), _mm512_set1_epi32(126)));
+	e = _mm512_mask_sub_ps(e, denormal, e, _mm512_set1_ps(23.0f));
+	// mantissa in [0.5, 1)
+	__m512 m = _mm512_castsi512_ps(_mm512_or_epi32(_mm512_and_epi32(bits, _mm512_set1_epi32(0x007fffff)),
+		_mm512_set1_epi32(0x3f000000)));
+
+	const __mmask16 small{ _mm512_cmp_ps_mask(m, _mm512_set1_ps(0.707106781186547524f), _CMP_LT_OQ) };
+	e = _mm512_mask_sub_ps(e, small, e, one);
+	m = _mm512_sub_ps(_mm512_mask_add_ps(m, small, m, m), one);
+
+	const __m512 z = _mm512_mul_ps(m, m);
+	__m512 p = _mm512_set1_ps(7.0376836292e-2f);
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(-1.1514610310e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(1.1676998740e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(-1.2420140846e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(1.4249322787e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(-1.6668057665e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(2.0000714765e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(-2.4999993993e-1f));
+	p = _mm512_fmadd_ps(p, m, _mm512_set1_ps(3.3333331174e-1f));
+	__m512 y = _mm512_mul_ps(_mm512_mul_ps(p, m), z);
+	y = _mm512_fmadd_ps(e, _mm512_set1_ps(FAST_LN2_LO), y);
+	y = _mm512_fnmadd_ps(_mm512_set1_ps(0.5f), z, y);
+	__m512 result = _mm512_fmadd_ps(e, _mm512_set1_ps(FAST_LN2_HI), _mm512_add_ps(m, y));
+
+	const __m512 inf = _mm512_set1_ps(std::numeric_limits<float>::infinity());
+	const __m512 zero = _mm512_setzero_ps();
+	result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, inf, _CMP_EQ_OQ), result, inf);
+	result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, zero, _CMP_LT_OQ), result,
+		_mm512_set1_ps(std::numeric_limits<float>::quiet_NaN()));
+	result = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, zero, _CMP_EQ_OQ), result, _mm512_sub_ps(zero, inf));
+	return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q), result, x);
+}
+
+/**
+ * tanh(x), the polynomial of fastTanh evaluated with FMA.
+ */
+AVX512_TARGET inline __m512 tanh512(__m512 x) {
+	const __m512 one = _mm512_set1_ps(1.0f);
+	const __m512i sign = _mm512_set1_epi32(static_cast<int32_t>(0x80000000u));
+	const __m512 z = _mm512_mul_ps(x, x);
+	__m512 p = _mm512_set1_ps(-5.70498872745e-3f);
+	p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(2.06390887954e-2f));
+	p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(-5.37397155531e-2f));
+	p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(1.33314422036e-1f));
+	p = _mm512_fmadd_ps(p, z, _mm512_set1_ps(-3.33332819422e-1f));
+	const __m512 small_result = _mm512_fmadd_ps(_mm512_mul_ps(p, z), x, x);
+
+	// avx512f has no floating point bitwise operations, sign is handled with integer ones
+	const __m512i x_bits = _mm512_castps_si512(x);
+	const __m512 a = _mm512_castsi512_ps(_mm512_maskz_andnot_epi32(0xFFFF, sign, x_bits));
+	const __m512 large_abs = _mm512_sub_ps(one, _mm512_div_ps(_mm512_set1_ps(2.0f), _mm512_add_ps(exp512(_mm512_add_ps(a, a)), one)));
+	const __m512 large_result = _mm512_castsi512_ps(_mm512_or_epi32(_mm512_castps_si512(large_abs), _mm512_and_epi32(sign, x_bits)));
+
+	return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, _mm512_set1_ps(0.625f), _CMP_LT_OQ), large_result, small_result);
+}
+
+/**
+ * 1 / (1 + e^-x).
+ */
+AVX512_TARGET inline __m512 sigmoid512(__m512 x) {
+	const __m512 one = _mm512_set1_ps(1.0f);
+	return _mm512_div_ps(one, _mm512_add_ps(one, exp512(_mm512_sub_ps(_mm512_setzero_ps(), x))));
+}
+
+struct Exp {
+	static AVX512_TARGET __m512 packed(__m512 x) { return exp512(x); }
+};
+
+struct Log {
+	static AVX512_TARGET __m512 packed(__m512 x) { return log512(x); }
+};
+
+struct Tanh {
+	static AVX512_TARGET __m512 packed(__m512 x) { return tanh512(x); }
+};
+
+struct Sigmoid {
+	static AVX512_TARGET __m512 packed(__m512 x) { return sigmoid512(x); }
+};
+
+/**
+ * r = function(v), where v and r have size n.
+ */
+template <typename Function>
+AVX512_TARGET void vectorMath(const uint32_t n, const float* v, float* r) {
+	uint32_t i{ 0 };
+	for (; i + 32 <= n; i += 32) {
+		const __m512 a0 = Function::packed(_mm512_loadu_ps(v + i));
+		const __m512 a1 = Function::packed(_mm512_loadu_ps(v + i + 16));
+		_mm512_storeu_ps(r + i, a0);
+		_mm512_storeu_ps(r + i + 16, a1);
+	}
+	for (; i + 16 <= n; i += 16) {
+		_mm512_storeu_ps(r + i, Function::packed(_mm512_loadu_ps(v + i)));
+	}
+	if (i < n) {
+		const __mmask16 mask{ tailMask(n - i) };
+		// masked out lanes of v are set to 1, so they do not produce special values
+		_mm512_mask_storeu_ps(r + i, mask, Function::packed(_mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), mask, v + i)));
+	}
+}
+
+constexpr uint32_t AVX512_GEMM_MR{ 8 };
+constexpr uint32_t AVX512_GEMM_NR{ 32 };
+
+/**
+ * [8, 32] tile kept in 16 accumulators, each step broadcasts one value of a and does two FMAs with a row of b.
+ */
+AVX512_TARGET void avx512_gemm_micro_kernel(const uint32_t k, const float* a, const float* b, float* c, const uint32_t c_stride) {
+	__m512 acc[AVX512_GEMM_MR][2];
+
+	#pragma GCC unroll 8
+	for (uint32_t i{ 0 }; i < AVX512_GEMM_MR; ++i) {
+		acc[i][0] = _mm512_setzero_ps();
+		acc[i][1] = _mm512_setzero_ps();
+	}
+
+	for (uint32_t p{ 0 }; p < k; ++p) {
+		const __m512 b0 = _mm512_loadu_ps(b + p * AVX512_GEMM_NR);
+		const __m512 b1 = _mm512_loadu_ps(b + p * AVX512_GEMM_NR + 16);
+		const float* a_col{ a + p * AVX512_GEMM_MR };
+		#pragma GCC unroll 8
+		for (uint32_t i{ 0 }; i < AVX512_GEMM_MR; ++i) {
+			const __m512 a_i = _mm512_set1_ps(a_col[i]);
+			acc[i][0] = _mm512_fmadd_ps(a_i, b0, acc[i][0]);
+			acc[i][1] = _mm512_fmadd_ps(a_i, b1, acc[i][1]);
+		}
+	}
+
+	#pragma GCC unroll 8
+	for (uint32_t i{ 0 }; i < AVX512_GEMM_MR; ++i) {
+		float* c_row{ c + i * c_stride };
+		_mm512_storeu_ps(c_row, _mm512_add_ps(_mm512_loadu_ps(c_row), acc[i][0]));
+		_mm512_storeu_ps(c_row + 16, _mm512_add_ps(_mm512_loadu_ps(c_row + 16), acc[i][1]));
+	}
+}
+
+const TensorKernels avx512_kernels{
+	KernelsType::Avx512,
+	"avx512",
+
+	avx512_vector_inner_product,
+
+	vectorOp<Add>,
+	tensorOp<Add>,
+	tensorScalarOp<Add>,
+
+	vectorOp<Sub>,
+	tensorOp<Sub>,
+	tensorScalarOp<Sub>,
+	scalarTensorOp<Sub>,
+
+	vectorOp<Mul>,
+	tensorOp<Mul>,
+	tensorScalarOp<Mul>,
+
+	vectorOp<Div>,
+	tensorOp<Div>,
+	tensorScalarOp<Div>,
+	scalarTensorOp<Div>,
+
+	avx512_tensor_sum,
+	avx512_tensor_axis_sum,
+	avx512_tensor_last_axis_sum,
+
+	avx512_tensor_dot_product_transpose,
+
+	vectorMath<Exp>,
+	vectorMath<Log>,
+	vectorMath<Tanh>,
+	vectorMath<Sigmoid>,
+
+	AVX512_GEMM_MR,
+	AVX512_GEMM_NR,
+	avx512_gemm_micro_kernel
+};
+
+}	// namespace
+
+const TensorKernels* getAVX512Kernels() {
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return &avx512_kernels;
+	}
+	return nullptr;
+}
+
+#else	// x86
+
+const TensorKernels* getAVX512Kernels() {
+	return nullptr;
+}
+
+#endif	// x86
@@ -0,0 +1,926 @@
+; x86-64 (System V AMD64 ABI) implementation of SSE routines declared in Tensor.h.
+;
+; Arguments are passed in rdi, rsi, rdx, rcx, r8, r9 (in that order). Registers
+; rax, rcx, rdx, rsi, rdi, r8-r11 and all xmm registers can be clobbered, rbx and
+; r12-r15 have to be preserved. uint32_t arguments are zero-extended before they
+; are used in addressing (upper 32 bits of the argument registers are undefined).
+
+global _SSE_vector_inner_product
+
+global _SSE_vector_add
+global _SSE_tensor_add
+global _SSE_tensor_add_scalar
+
+global _SSE_vector_sub
+global _SSE_tensor_sub
+global _SSE_tensor_sub_scalar
+global _SSE_scalar_sub_tensor
+
+global _SSE_vector_mul
+global _SSE_tensor_mul
+global _SSE_tensor_mul_scalar
+
+global _SSE_vector_div
+global _SSE_tensor_div
+global _SSE_tensor_div_scalar
+global _SSE_scalar_div_tensor
+
+global _SSE_tensor_sum
+global _SSE_tensor_axis_sum
+global _SSE_tensor_last_axis_sum
+
+global _SSE_tensor_dot_product_transpose
+
+section .note.GNU-stack noalloc noexec nowrite progbits
+
+section .data
+
+section .text
+
+; Sums four lanes of xmm register %1 into its lowest lane (uses xmm15).
+%macro HORIZONTAL_SUM 1
+	movhlps	xmm15, %1
+	addps	%1, xmm15
+	movaps	xmm15, %1
+	shufps	xmm15, xmm15, 0b01010101
+	addss	%1, xmm15
+%endmacro
+
+; void SSE_vector_<op>(const uint32_t n, const float* v1, const float* v2, float* r);
+;	n - size of v1 and v2
+;	v1 - first vector
+;	v2 - second vector
+;	r - return value
+;
+; %1 - function name, %2 - packed instruction, %3 - scalar instruction
+%macro SSE_VECTOR_OP 3
+%1:
+	mov		eax, edi			; n		uint32
+	;		rsi					; *v1	float* (array)
+	;		rdx					; *v2	float* (array)
+	;		rcx					; *r	float* (array)
+
+.ps_block_loop:
+	cmp		rax, 16
+	jl		.ps_loop
+
+	sub		rax, 16
+
+	movups	xmm0, [rsi + 4*rax]
+	movups	xmm1, [rsi + 4*rax + 16]
+	movups	xmm2, [rsi + 4*rax + 32]
+	movups	xmm3, [rsi + 4*rax + 48]
+	movups	xmm4, [rdx + 4*rax]
+	movups	xmm5, [rdx + 4*rax + 16]
+	movups	xmm6, [rdx + 4*rax + 32]
+	movups	xmm7, [rdx + 4*rax + 48]
+
+	%2		xmm0, xmm4
+	%2		xmm1, xmm5
+	%2		xmm2, xmm6
+	%2		xmm3, xmm7
+
+	movups	[rcx + 4*rax], xmm0
+	movups	[rcx + 4*rax + 16], xmm1
+	movups	[rcx + 4*rax + 32], xmm2
+	movups	[rcx + 4*rax + 48], xmm3
+
+	jmp		.ps_block_loop
+
+.ps_loop:
+	cmp		rax, 4
+	jl		.ss_loop
+
+	sub		rax, 4
+
+	movups	xmm0, [rsi + 4*rax]
+	movups	xmm1, [rdx + 4*rax]
+
+	%2		xmm0, xmm1
+
+	movups	[rcx + 4*rax], xmm0
+
+	jmp		.ps_loop
+
+.ss_loop:
+	cmp		rax, 1
+	jl		.end
+
+	dec		rax
+
+	movss	xmm0, dword [rsi + 4*rax]
+	movss	xmm1, dword [rdx + 4*rax]
+
+	%3		xmm0, xmm1
+
+	movss	[rcx + 4*rax], xmm0
+
+	jmp		.ss_loop
+
+.end:
+	ret
+%endmacro
+
+; void SSE_tensor_<op>(const uint32_t n1, const float* v1, const uint32_t n2, const float* v2, float* r);
+;	n1 - size of v1
+;	v1 - first tensor
+;	n2 - size of v2 (n1 has to be multiple of n2)
+;	v2 - second tensor (applied to each row of v1)
+;	r - return value
+;
+; %1 - function name, %2 - packed instruction, %3 - scalar instruction
+%macro SSE_TENSOR_OP 3
+%1:
+	mov		r9d, edi			; n1	uint32
+	;		rsi					; *v1	float* (array)
+	mov		edx, edx			; n2	uint32
+	;		rcx					; *v2	float* (array)
+	;		r8					; *r	float* (array)
+
+	test	rdx, rdx
+	jz		.end
+
+.row_loop:
+	cmp		r9, rdx
+	jl		.end
+
+	sub		r9, rdx
+
+	lea		r10, [rsi + 4*r9]	; v1[row]
+	lea		r11, [r8 + 4*r9]	; r[row]
+
+	mov		rax, rdx
+
+.ps_block_loop:
+	cmp		rax, 16
+	jl		.ps_loop
+
+	sub		rax, 16
+
+	movups	xmm0, [r10 + 4*rax]
+	movups	xmm1, [r10 + 4*rax + 16]
+	movups	xmm2, [r10 + 4*rax + 32]
+	movups	xmm3, [r10 + 4*rax + 48]
+	movups	xmm4, [rcx + 4*rax]
+	movups	xmm5, [rcx + 4*rax + 16]
+	movups	xmm6, [rcx + 4*rax + 32]
+	movups	xmm7, [rcx + 4*rax + 48]
+
+	%2		xmm0, xmm4
+	%2		xmm1, xmm5
+	%2		xmm2, xmm6
+	%2		xmm3, xmm7
+
+	movups	[r11 + 4*rax], xmm0
+	movups	[r11 + 4*rax + 16], xmm1
+	movups	[r11 + 4*rax + 32], xmm2
+	movups	[r11 + 4*rax + 48], xmm3
+
+	jmp		.ps_block_loop
+
+.ps_loop:
+	cmp		rax, 4
+	jl		.ss_loop
+
+	sub		rax, 4
+
+	movups	xmm0, [r10 + 4*rax]
+	movups	xmm1, [rcx + 4*rax]
+
+	%2		xmm0, xmm1
+
+	movups	[r11 + 4*rax], xmm0
+
+	jmp		.ps_loop
+
+.ss_loop:
+	cmp		rax, 1
+	jl		.row_loop
+
+	dec		rax
+
+	movss	xmm0, dword [r10 + 4*rax]
+	movss	xmm1, dword [rcx + 4*rax]
+
+	%3		xmm0, xmm1
+
+	movss	[r11 + 4*rax], xmm0
+
+	jmp		.ss_loop
+
+.end:
+	ret
+%endmacro
+
+; void SSE_tensor_<op>_scalar(const uint32_t n, const float* v, const float* s, float* r);
+;	n - size of v
+;	v - tensor
+;	s - scalar
+;	r - return value (v <op> s)
+;
+; %1 - function name, %2 - packed instruction, %3 - scalar instruction
+%macro SSE_TENSOR_SCALAR_OP 3
+%1:
+	mov		eax, edi			; n		uint32
+	;		rsi					; *v	float* (array)
+	;		rdx					; *s	float* (scalar)
+	;		rcx					; *r	float* (array)
+
+	movss	xmm7, dword [rdx]
+	shufps	xmm7, xmm7, 0x0
+
+.ps_block_loop:
+	cmp		rax, 16
+	jl		.ps_loop
+
+	sub		rax, 16
+
+	movups	xmm0, [rsi + 4*rax]
+	movups	xmm1, [rsi + 4*rax + 16]
+	movups	xmm2, [rsi + 4*rax + 32]
+	movups	xmm3, [rsi + 4*rax + 48]
+
+	%2		xmm0, xmm7
+	%2		xmm1, xmm7
+	%2		xmm2, xmm7
+	%2		xmm3, xmm7
+
+	movups	[rcx + 4*rax], xmm0
+	movups	[rcx + 4*rax + 16], xmm1
+	movups	[rcx + 4*rax + 32], xmm2
+	movups	[rcx + 4*rax + 48], xmm3
+
+	jmp		.ps_block_loop
+
+.ps_loop:
+	cmp		rax, 4
+	jl		.ss_loop
+
+	sub		rax, 4
+
+	movups	xmm0, [rsi + 4*rax]
+
+	%2		xmm0, xmm7
+
+	movups	[rcx + 4*rax], xmm0
+
+	jmp		.ps_loop
+
+.ss_loop:
+	cmp		rax, 1
+	jl		.end
+
+	dec		rax
+
+	movss	xmm0, dword [rsi + 4*rax]
+
+	%3		xmm0, xmm7
+
+	movss	[rcx + 4*rax], xmm0
+
+	jmp		.ss_loop
+
+.end:
+	ret
+%endmacro
+
+; void SSE_scalar_<op>_tensor(const float* s, const uint32_t n, const float* v, float* r);
+;	s - scalar
+;	n - size of v
+;	v - tensor
+;	r - return value (s <op> v)
+;
+; %1 - function name, %2 - packed instruction, %3 - scalar instruction
+%macro SSE_SCALAR_TENSOR_OP 3
+%1:
+	;		rdi					; *s	float* (scalar)
+	mov		eax, esi			; n		uint32
+	;		rdx					; *v	float* (array)
+	;		rcx					; *r	float* (array)
+
+	movss	xmm7, dword [rdi]
+	shufps	xmm7, xmm7, 0x0
+
+.ps_block_loop:
+	cmp		rax, 16
+	jl		.ps_loop
+
+	sub		rax, 16
+
+	movups	xmm4, [rdx + 4*rax]
+	movups	xmm5, [rdx + 4*rax + 16]
+	movups	xmm6, [rdx + 4*rax + 32]
+	movups	xmm8, [rdx + 4*rax + 48]
+
+	movaps	xmm0, xmm7
+	movaps	xmm1, xmm7
+	movaps	xmm2, xmm7
+	movaps	xmm3, xmm7
+
+	%2		xmm0, xmm4
+	%2		xmm1, xmm5
+	%2		xmm2, xmm6
+	%2		xmm3, xmm8
+
+	movups	[rcx + 4*rax], xmm0
+	movups	[rcx + 4*rax + 16], xmm1
+	movups	[rcx + 4*rax + 32], xmm2
+	movups	[rcx + 4*rax + 48], xmm3
+
+	jmp		.ps_block_loop
+
+.ps_loop:
+	cmp		rax, 4
+	jl		.ss_loop
+
+	sub		rax, 4
+
+	movups	xmm1, [rdx + 4*rax]
+	movaps	xmm0, xmm7
+
+	%2		xmm0, xmm1
+
+	movups	[rcx + 4*rax], xmm0
+
+	jmp		.ps_loop
+
+.ss_loop:
+	cmp		rax, 1
+	jl		.end
+
+	dec		rax
+
+	movss	xmm1, dword [rdx + 4*rax]
+	movaps	xmm0, xmm7
+
+	%3		xmm0, xmm1
+
+	movss	[rcx + 4*rax], xmm0
+
+	jmp		.ss_loop
+
+.end:
+	ret
+%endmacro
+
+; void SSE_vector_inner_product(const uint32_t n, const float* v1, const float* v2, float* r);
+;	n - size of v1 and v2
+;	v1 - first vector
+;	v2 - second vector
+;	r - return value
+_SSE_vector_inner_product:
+	mov		eax, edi			; n		uint32
+	;		rsi					; *v1	float* (array)
+	;		rdx					; *v2	float* (array)
+	;		rcx					; *r	float* (scalar)
+
+	xorps	xmm0, xmm0
+	xorps	xmm1, xmm1
+	xorps	xmm2, xmm2
+	xorps	xmm3, xmm3
+
+.ps_block_mul_loop:
+	cmp		rax, 16
+	jl		.ps_mul_loop
+
+	sub		rax, 16
+
+	movups	xmm4, [rsi + 4*rax]
+	movups	xmm5, [rsi + 4*rax + 16]
+	movups	xmm6, [rsi + 4*rax + 32]
+	movups	xmm7, [rsi + 4*rax + 48]
+	movups	xmm8, [rdx + 4*rax]
+	movups	xmm9, [rdx + 4*rax + 16]
+	movups	xmm10, [rdx + 4*rax + 32]
+	movups	xmm11, [rdx + 4*rax + 48]
+
+	mulps	xmm4, xmm8
+	mulps	xmm5, xmm9
+	mulps	xmm6, xmm10
+	mulps	xmm7, xmm11
+
+	addps	xmm0, xmm4
+	addps	xmm1, xmm5
+	addps	xmm2, xmm6
+	addps	xmm3, xmm7
+
+	jmp		.ps_block_mul_loop
+
+.ps_mul_loop:
+	cmp		rax, 4
+	jl		.ss_mul_loop
+
+	sub		rax, 4
+
+	movups	xmm4, [rsi + 4*rax]
+	movups	xmm5, [rdx + 4*rax]
+
+	mulps	xmm4, xmm5
+	addps	xmm0, xmm4
+
+	jmp		.ps_mul_loop
+
+.ss_mul_loop:
+	cmp		rax, 1
+	jl		.end
+
+	dec		rax
+
+	movss	xmm4, dword [rsi + 4*rax]
+	movss	xmm5, dword [rdx + 4*rax]
+
+	mulss	xmm4, xmm5
+	addss	xmm0, xmm4
+
+	jmp		.ss_mul_loop
+
+.end:
+	addps	xmm0, xmm1
+	addps	xmm2, xmm3
+	addps	xmm0, xmm2
+
+	HORIZONTAL_SUM xmm0
+
+	movss	[rcx], xmm0
+
+	ret
+
+SSE_VECTOR_OP			_SSE_vector_add, addps, addss
+SSE_TENSOR_OP			_SSE_tensor_add, addps, addss
+SSE_TENSOR_SCALAR_OP	_SSE_tensor_add_scalar, addps, addss
+
+SSE_VECTOR_OP			_SSE_vector_sub, subps, subss
+SSE_TENSOR_OP			_SSE_tensor_sub, subps, subss
+SSE_TENSOR_SCALAR_OP	_SSE_tensor_sub_scalar, subps, subss
+SSE_SCALAR_TENSOR_OP	_SSE_scalar_sub_tensor, subps, subss
+
+SSE_VECTOR_OP			_SSE_vector_mul, mulps, mulss
+SSE_TENSOR_OP			_SSE_tensor_mul, mulps, mulss
+SSE_TENSOR_SCALAR_OP	_SSE_tensor_mul_scalar, mulps, mulss
+
+SSE_VECTOR_OP			_SSE_vector_div, divps, divss
+SSE_TENSOR_OP			_SSE_tensor_div, divps, divss
+SSE_TENSOR_SCALAR_OP	_SSE_tensor_div_scalar, divps, divss
+SSE_SCALAR_TENSOR_OP	_SSE_scalar_div_tensor, divps, divss
+
+; void SSE_tensor_sum(const uint32_t n, const float* v, float* r);
+;	n - size of v
+;	v - tensor
+;	r - return value
+_SSE_tensor_sum:
+	mov		eax, edi			; n		uint32
+	;		rsi					; *v	float* (array)
+	;		rdx					; *r	float* (scalar)
+
+	xorps	xmm0, xmm0
+	xorps	xmm1, xmm1
+	xorps	xmm2, xmm2
+	xorps	xmm3, xmm3
+
+.ps_block_add_loop:
+	cmp		rax, 16
+	jl		.ps_add_loop
+
+	sub		rax, 16
+
+	movups	xmm4, [rsi + 4*rax]
+	movups	xmm5, [rsi + 4*rax + 16]
+	movups	xmm6, [rsi + 4*rax + 32]
+	movups	xmm7, [rsi + 4*rax + 48]
+
+	addps	xmm0, xmm4
+	addps	xmm1, xmm5
+	addps	xmm2, xmm6
+	addps	xmm3, xmm7
+
+	jmp		.ps_block_add_loop
+
+.ps_add_loop:
+	cmp		rax, 4
+	jl		.ss_add_loop
+
+	sub		rax, 4
+
+	movups	xmm4, [rsi + 4*rax]
+
+	addps	xmm0, xmm4
+
+	jmp		.ps_add_loop
+
+.ss_add_loop:
+	cmp		rax, 1
+	jl		.end
+
+	dec		rax
+
+	movss	xmm4, dword [rsi + 4*rax]
+
+	addss	xmm0, xmm4
+
+	jmp		.ss_add_loop
+
+.end:
+	addps	xmm0, xmm1
+	addps	xmm2, xmm3
+	addps	xmm0, xmm2
+
+	HORIZONTAL_SUM xmm0
+
+	movss	[rdx], xmm0
+
+	ret
+
+; void SSE_tensor_axis_sum(const uint32_t n, const uint32_t m, const uint32_t k, const float* v, float* r);
+;	n - size of v, before axis to be sumed along
+;	m - size of v, after axis
+;	k - size of v, along axis
+;	v - input tensor
+;	r - return value
+;
+; Sums are vectorized across m (contiguous in memory), r[i,j] = sum_p v[i,p,j].
+_SSE_tensor_axis_sum:
+	mov		r9d, edi			; n		uint32
+	mov		esi, esi			; m		uint32
+	mov		edx, edx			; k		uint32
+	;		rcx					; *v	float* (array), moved to v[i,0,0] for each i
+	;		r8					; *r	float* (array), moved to r[i,0] for each i
+
+	lea		rax, [4*rsi]		; 4*m (stride of the axis in bytes)
+
+.outer_loop:
+	cmp		r9, 1				; i (0 to n-1)
+	jl		.outer_end
+
+	dec		r9
+
+	xor		r11, r11			; j (0 to m-1)
+
+.ps_block_column_loop:
+	lea		rdi, [r11 + 16]
+	cmp		rdi, rsi
+	jg		.ps_column_loop
+
+	lea		r10, [rcx + 4*r11]	; v[i,0,j]
+	mov		rdi, rdx			; p (0 to k-1)
+
+	xorps	xmm0, xmm0
+	xorps	xmm1, xmm1
+	xorps	xmm2, xmm2
+	xorps	xmm3, xmm3
+
+.ps_block_add_loop:
+	cmp		rdi, 1
+	jl		.ps_block_add_end
+
+	dec		rdi
+
+	movups	xmm4, [r10]
+	movups	xmm5, [r10 + 16]
+	movups	xmm6, [r10 + 32]
+	movups	xmm7, [r10 + 48]
+
+	addps	xmm0, xmm4
+	addps	xmm1, xmm5
+	addps	xmm2, xmm6
+	addps	xmm3, xmm7
+
+	add		r10, rax			; v[i,p+1,j]
+
+	jmp		.ps_block_add_loop
+
+.ps_block_add_end:
+	movups	[r8 + 4*r11], xmm0	; r[i,j]
+	movups	[r8 + 4*r11 + 16], xmm1
+	movups	[r8 + 4*r11 + 32], xmm2
+	movups	[r8 + 4*r11 + 48], xmm3
+
+	add		r11, 16
+
+	jmp		.ps_block_column_loop
+
+.ps_column_loop:
+	lea		rdi, [r11 + 4]
+	cmp		rdi, rsi
+	jg		.ss_column_loop
+
+	lea		r10, [rcx + 4*r11]	; v[i,0,j]
+	mov		rdi, rdx			; p (0 to k-1)
+
+	xorps	xmm0, xmm0
+
+.ps_add_loop:
+	cmp		rdi, 1
+	jl		.ps_add_end
+
+	dec		rdi
+
+	movups	xmm4, [r10]
+
+	addps	xmm0, xmm4
+
+	add		r10, rax			; v[i,p+1,j]
+
+	jmp		.ps_add_loop
+
+.ps_add_end:
+	movups	[r8 + 4*r11], xmm0	; r[i,j]
+
+	add		r11, 4
+
+	jmp		.ps_column_loop
+
+.ss_column_loop:
+	cmp		r11, rsi
+	jge		.column_end
+
+	lea		r10, [rcx + 4*r11]	; v[i,0,j]
+	mov		rdi, rdx			; p (0 to k-1)
+
+	xorps	xmm0, xmm0
+
+.ss_add_loop:
+	cmp		rdi, 1
+	jl		.ss_add_end
+
+	dec		rdi
+
+	movss	xmm4, dword [r10]
+
+	addss	xmm0, xmm4
+
+	add		r10, rax			; v[i,p+1,j]
+
+	jmp		.ss_add_loop
+
+.ss_add_end:
+	movss	[r8 + 4*r11], xmm0	; r[i,j]
+
+	inc		r11
+
+	jmp		.ss_column_loop
+
+.column_end:
+	mov		r10, rax
+	imul	r10, rdx			; 4*m*k
+	add		rcx, r10			; v[i+1,0,0]
+	add		r8, rax				; r[i+1,0]
+
+	jmp		.outer_loop
+
+.outer_end:
+	ret
+
+; void SSE_tensor_last_axis_sum(const uint32_t n, const uint32_t k, const float* v, float* r);
+;	n - size of v, before axis to be sumed along
+;	k - size of v, along axis
+;	v - input tensor
+;	r - return value
+_SSE_tensor_last_axis_sum:
+	mov		r9d, edi			; n		uint32
+	mov		esi, esi			; k		uint32
+	;		rdx					; *v	float* (array), moved to v[i,0] for each i
+	;		rcx					; *r	float* (array)
+
+	xor		r8, r8				; i (0 to n-1)
+
+.outer_loop:
+	cmp		r8, r9
+	jge		.outer_end
+
+	mov		rax, rsi			; p (0 to k-1)
+
+	xorps	xmm0, xmm0
+	xorps	xmm1, xmm1
+	xorps	xmm2, xmm2
+	xorps	xmm3, xmm3
+
+.ps_block_add_loop:
+	cmp		rax, 16
+	jl		.ps_add_loop
+
+	sub		rax, 16
+
+	movups	xmm4, [rdx + 4*rax]
+	movups	xmm5, [rdx + 4*rax + 16]
+	movups	xmm6, [rdx + 4*rax + 32]
+	movups	xmm7, [rdx + 4*rax + 48]
+
+	addps	xmm0, xmm4
+	addps	xmm1, xmm5
+	addps	xmm2, xmm6
+	addps	xmm3, xmm7
+
+	jmp		.ps_block_add_loop
+
+.ps_add_loop:
+	cmp		rax, 4
+	jl		.ss_add_loop
+
+	sub		rax, 4
+
+	movups	xmm4, [rdx + 4*rax]
+
+	addps	xmm0, xmm4
+
+	jmp		.ps_add_loop
+
+.ss_add_loop:
+	cmp		rax, 1
+	jl		.end
+
+	dec		rax
+
+	movss	xmm4, dword [rdx + 4*rax]
+
+	addss	xmm0, xmm4
+
+	jmp		.ss_add_loop
+
+.end:
+	addps	xmm0, xmm1
+	addps	xmm2, xmm3
+	addps	xmm0, xmm2
+
+	HORIZONTAL_SUM xmm0
+
+	movss	[rcx + 4*r8], xmm0	; r[i]
+
+	lea		rdx, [rdx + 4*rsi]	; v[i+1,0]
+	inc		r8
+
+	jmp		.outer_loop
+
+.outer_end:
+	ret
+
+; void SSE_tensor_dot_product_transpose(const uint32_t n, const uint32_t m, const uint32_t k, const float* v1, const float *v2, float *r);
+;	n - first dim of v1
+;	m - first dim of v2
+;	k - second dim of v1 and v2
+;	v1 - first tensor
+;	v2 - second tensor
+;	r - result (v1 dot v2^T)
+;
+; Each row of v1 is multiplied by four rows of v2 at once, so loaded values of v1
+; are reused four times. Requires SSE3 (haddps).
+_SSE_tensor_dot_product_transpose:
+	push	rbx
+	push	r12
+	push	r13
+	push	r14
+	push	r15
+
+	mov		edi, edi			; n		uint32
+	mov		esi, esi			; m		uint32
+	mov		edx, edx			; k		uint32
+	;		rcx					; *v1	float* (array), moved to v1[i,0] for each i
+	;		r8					; *v2	float* (array)
+	;		r9					; *r	float* (array), moved to r[i,0] for each i
+
+	lea		rbx, [4*rdx]		; 4*k (row stride in bytes)
+
+.outer_loop:
+	cmp		rdi, 1				; i (0 to n-1)
+	jl		.outer_end
+
+	dec		rdi
+
+	xor		r10, r10			; j (0 to m-1)
+	mov		rax, r8				; v2[j,0]
+
+.block_loop:
+	lea		r15, [r10 + 4]
+	cmp		r15, rsi
+	jg		.inner_loop
+
+	lea		r12, [rax + rbx]	; v2[j+1,0]
+	lea		r13, [r12 + rbx]	; v2[j+2,0]
+	lea		r14, [r13 + rbx]	; v2[j+3,0]
+
+	mov		r11, rdx			; p (0 to k-1)
+
+	xorps	xmm0, xmm0
+	xorps	xmm1, xmm1
+	xorps	xmm2, xmm2
+	xorps	xmm3, xmm3
+
+.ps_block_mul_loop:
+	cmp		r11, 4
+	jl		.ss_block_mul_loop
+
+	sub		r11, 4
+
+	movups	xmm4, [rcx + 4*r11]	; v1[i,p]
+	movups	xmm5, [rax + 4*r11]	; v2[j,p]
+	movups	xmm6, [r12 + 4*r11]	; v2[j+1,p]
+	movups	xmm7, [r13 + 4*r11]	; v2[j+2,p]
+	movups	xmm8, [r14 + 4*r11]	; v2[j+3,p]
+
+	mulps	xmm5, xmm4
+	mulps	xmm6, xmm4
+	mulps	xmm7, xmm4
+	mulps	xmm8, xmm4
+
+	addps	xmm0, xmm5
+	addps	xmm1, xmm6
+	addps	xmm2, xmm7
+	addps	xmm3, xmm8
+
+	jmp		.ps_block_mul_loop
+
+.ss_block_mul_loop:
+	cmp		r11, 1
+	jl		.block_end
+
+	dec		r11
+
+	movss	xmm4, dword [rcx + 4*r11]	; v1[i,p]
+	movss	xmm5, dword [rax + 4*r11]	; v2[j,p]
+	movss	xmm6, dword [r12 + 4*r11]	; v2[j+1,p]
+	movss	xmm7, dword [r13 + 4*r11]	; v2[j+2,p]
+	movss	xmm8, dword [r14 + 4*r11]	; v2[j+3,p]
+
+	mulss	xmm5, xmm4
+	mulss	xmm6, xmm4
+	mulss	xmm7, xmm4
+	mulss	xmm8, xmm4
+
+	addss	xmm0, xmm5
+	addss	xmm1, xmm6
+	addss	xmm2, xmm7
+	addss	xmm3, xmm8
+
+	jmp		.ss_block_mul_loop
+
+.block_end:
+	haddps	xmm0, xmm1
+	haddps	xmm2, xmm3
+	haddps	xmm0, xmm2
+
+	movups	[r9 + 4*r10], xmm0	; r[i,j:j+4]
+
+	add		r10, 4
+	lea		rax, [r14 + rbx]	; v2[j+4,0]
+
+	jmp		.block_loop
+
+.inner_loop:
+	cmp		r10, rsi
+	jge		.inner_end
+
+	mov		r11, rdx			; p (0 to k-1)
+
+	xorps	xmm0, xmm0
+
+.ps_mul_loop:
+	cmp		r11, 4
+	jl		.ss_mul_loop
+
+	sub		r11, 4
+
+	movups	xmm4, [rcx + 4*r11]	; v1[i,p]
+	movups	xmm5, [rax + 4*r11]	; v2[j,p]
+
+	mulps	xmm4, xmm5
+	addps	xmm0, xmm4
+
+	jmp		.ps_mul_loop
+
+.ss_mul_loop:
+	cmp		r11, 1
+	jl		.end
+
+	dec		r11
+
+	movss	xmm4, dword [rcx + 4*r11]	; v1[i,p]
+	movss	xmm5, dword [rax + 4*r11]	; v2[j,p]
+
+	mulss	xmm4, xmm5
+	addss	xmm0, xmm4
+
+	jmp		.ss_mul_loop
+
+.end:
+	HORIZONTAL_SUM xmm0
+
+	movss	[r9 + 4*r10], xmm0	; r[i,j]
+
+	inc		r10
+	add		rax, rbx			; v2[j+1,0]
+
+	jmp		.inner_loop
+
+.inner_end:
+	add		rcx, rbx			; v1[i+1,0]
+	lea		r9, [r9 + 4*rsi]	; r[i+1,0]
+
+	jmp		.outer_loop
+
+.outer_end:
+	pop		r15
+	pop		r14
+	pop		r13
+	pop		r12
+	pop		rbx
+
+	ret
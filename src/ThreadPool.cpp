@@ -0,0 +1,164 @@
+#include "ThreadPool.h"
+#include "TensorAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+uint32_t ThreadPool::_parallel_threshold{ 1 << 16 };
+
+/**
+ * Minimal number of elements processed by one parallel task.
+ */
+constexpr uint32_t PARALLEL_MIN_CHUNK{ 1 << 14 };
+
+/**
+ * Set while the thread runs parallelFor tasks, nested parallelFor calls from tasks run serially.
+ */
+static thread_local bool t_in_pool_task{ false };
+
+ThreadPool::ThreadPool(uint32_t threads_count) {
+	for (uint32_t i{ 1 }; i < threads_count; ++i) {
+		_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_job_cv.notify_all();
+
+	for (auto& worker : _workers) {
+		worker.join();
+	}
+}
+
+/**
+ * NN_NUM_THREADS if set to a positive number, hardware concurrency otherwise.
+ */
+static uint32_t defaultThreadsCount() {
+	const char* requested{ std::getenv("NN_NUM_THREADS") };
+
+	if (nullptr != requested) {
+		const int32_t threads_count{ std::atoi(requested) };
+		if (threads_count > 0) {
+			return threads_count;
+		}
+	}
+
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+ThreadPool& ThreadPool::getInstance() {
+	static ThreadPool pool(defaultThreadsCount());
+	return pool;
+}
+
+uint32_t ThreadPool::getThreadsCount() const {
+	return _workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(uint32_t count, const std::function<void(uint32_t)>& func) {
+	bool busy{ false };
+	if ((count <= 1) || _workers.empty() || t_in_pool_task || !_busy.compare_exchange_strong(busy, true)) {
+		for (uint32_t i{ 0 }; i < count; ++i) {
+			func(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_job = &func;
+		_job_allocator = &getTensorAllocator();
+		_job_count = count;
+		_next_index = 0;
+		_exception = nullptr;
+		++_generation;
+	}
+	_job_cv.notify_all();
+
+	runTasks();
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		// all tasks are taken at this point, wait for workers still running them
+		_done_cv.wait(lock, [this] { return 0 == _active_workers; });
+		_job = nullptr;
+		exception = _exception;
+	}
+	_busy = false;
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+void ThreadPool::workerLoop() {
+	uint64_t generation{ 0 };
+
+	t_in_pool_task = true;
+
+	while (true) {
+		std::unique_lock<std::mutex> lock(_mutex);
+		_job_cv.wait(lock, [this, generation] { return _stop || ((nullptr != _job) && (_generation != generation)); });
+		if (_stop) {
+			return;
+		}
+		generation = _generation;
+		++_active_workers;
+		lock.unlock();
+
+		runTasks();
+
+		lock.lock();
+		if (0 == --_active_workers) {
+			_done_cv.notify_one();
+		}
+	}
+}
+
+void ThreadPool::runTasks() {
+	const bool in_pool_task{ t_in_pool_task };
+	t_in_pool_task = true;
+	// tensors created by tasks come from the allocator of the thread which started the job
+	TensorAllocatorScope allocator_scope(*_job_allocator);
+
+	for (uint32_t i{ _next_index++ }; i < _job_count; i = _next_index++) {
+		try {
+			(*_job)(i);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_exception) {
+				_exception = std::current_exception();
+			}
+		}
+	}
+
+	t_in_pool_task = in_pool_task;
+}
+
+void ThreadPool::setParallelThreshold(uint32_t threshold) {
+	_parallel_threshold = threshold;
+}
+
+uint32_t ThreadPool::getParallelThreshold() {
+	return _parallel_threshold;
+}
+
+uint32_t ThreadPool::getParallelChunkSize(uint32_t size, uint32_t alignment) {
+	const uint32_t threads_count{ getInstance().getThreadsCount() };
+
+	if ((0 == _parallel_threshold) || (size < _parallel_threshold) || (1 == threads_count)) {
+		// never 0, so callers can divide by the chunk size of an empty range
+		return std::max(1u, size);
+	}
+
+	// a few chunks per thread, so threads finishing early can take more work
+	const uint32_t chunk{ std::max(PARALLEL_MIN_CHUNK, (size + 4 * threads_count - 1) / (4 * threads_count)) };
+
+	return std::min(size, (chunk + alignment - 1) / alignment * alignment);
+}
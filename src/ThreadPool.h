@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TensorAllocator;
+
+class ThreadPool {
+public:
+	/**
+	 * @brief Construct a new Thread Pool object.
+	 *
+	 * @param threads_count Number of threads running parallelFor tasks, including the calling thread
+	 * (threads_count - 1 worker threads are started).
+	 */
+	explicit ThreadPool(uint32_t threads_count);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @brief Returns the process-wide pool used by Tensor operations.
+	 * Its size is taken from NN_NUM_THREADS environment variable or from hardware concurrency.
+	 *
+	 * @return Global thread pool.
+	 */
+	static ThreadPool& getInstance();
+	/**
+	 * @brief Get the number of threads running tasks (worker threads and the calling thread).
+	 *
+	 * @return Number of threads.
+	 */
+	uint32_t getThreadsCount() const;
+	/**
+	 * @brief Calls func(i) for every i in [0, count) and waits until all calls are finished.
+	 * Tasks are distributed dynamically between worker threads and the calling thread.
+	 * If the pool is busy with another call or the caller is a task of a parallelFor call, tasks are run serially on the calling thread.
+	 * Tasks create tensors with the allocator active on the calling thread.
+	 * The first exception thrown by a task is rethrown after all tasks are finished.
+	 *
+	 * @param count Number of tasks.
+	 * @param func Task function.
+	 */
+	void parallelFor(uint32_t count, const std::function<void(uint32_t)>& func);
+	/**
+	 * Work of at least threshold elements is split between threads of the global pool by forEachTask and forEachChunk,
+	 * smaller work is done by the calling thread.
+	 * @brief Set element count threshold of parallel execution.
+	 *
+	 * @param threshold Minimal number of elements (0 disables parallel execution).
+	 */
+	static void setParallelThreshold(uint32_t threshold);
+	/**
+	 * @brief Get element count threshold of parallel execution.
+	 *
+	 * @return Minimal number of elements processed in parallel.
+	 */
+	static uint32_t getParallelThreshold();
+	/**
+	 * A few chunks per thread of the global pool, but not smaller than a minimal task size.
+	 * @brief Get size of chunks [0, size) is split into for parallel processing.
+	 *
+	 * @param size Number of elements.
+	 * @param alignment Chunk size is a multiple of alignment.
+	 * @return Chunk size, equal to size (at least 1) if the work is below the parallel threshold or there is only one thread.
+	 */
+	static uint32_t getParallelChunkSize(uint32_t size, uint32_t alignment = 16);
+	/**
+	 * @brief Calls func(i) for i in [0, count), tasks are split between threads of the global pool
+	 * if size is at least the parallel threshold.
+	 *
+	 * @param count Number of tasks.
+	 * @param size Number of elements processed by all tasks.
+	 * @param func Task function.
+	 */
+	template <typename Func>
+	static void forEachTask(uint32_t count, uint64_t size, const Func& func);
+	/**
+	 * @brief Calls func(begin, end) for chunks of [0, size), chunks are processed by threads of the global pool.
+	 *
+	 * @param size Number of elements.
+	 * @param chunk Number of elements of a chunk (see getParallelChunkSize), all elements are processed by the calling thread
+	 * if it is not below size.
+	 * @param func Chunk function.
+	 */
+	template <typename Func>
+	static void forEachChunk(uint32_t size, uint32_t chunk, const Func& func);
+
+private:
+	void workerLoop();
+	void runTasks();
+
+	std::vector<std::thread> _workers;
+
+	std::atomic<bool> _busy{ false };
+	std::mutex _mutex;
+	std::condition_variable _job_cv;
+	std::condition_variable _done_cv;
+
+	const std::function<void(uint32_t)>* _job{ nullptr };
+	TensorAllocator* _job_allocator{ nullptr };
+	uint32_t _job_count{ 0 };
+	uint64_t _generation{ 0 };
+	uint32_t _active_workers{ 0 };
+	bool _stop{ false };
+	std::atomic<uint32_t> _next_index{ 0 };
+	std::exception_ptr _exception;
+
+	static uint32_t _parallel_threshold;
+};
+
+template <typename Func>
+void ThreadPool::forEachTask(uint32_t count, uint64_t size, const Func& func) {
+	const uint32_t threshold{ getParallelThreshold() };
+
+	if ((0 == threshold) || (size < threshold)) {
+		for (uint32_t i{ 0 }; i < count; ++i) {
+			func(i);
+		}
+		return;
+	}
+
+	getInstance().parallelFor(count, func);
+}
+
+template <typename Func>
+void ThreadPool::forEachChunk(uint32_t size, uint32_t chunk, const Func& func) {
+	if (chunk >= size) {
+		func(0, size);
+		return;
+	}
+
+	getInstance().parallelFor((size + chunk - 1) / chunk, [&](uint32_t i) {
+		func(i * chunk, std::min(size, (i + 1) * chunk));
+	});
+}
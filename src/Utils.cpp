@@ -31,19 +31,21 @@ uint32_t* genPermutation(uint32_t n) {
 }
 
 float randNormalDistribution() {
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	static std::normal_distribution<float> d(0, 1);
+	// thread_local, so it can be used in functions applied by parallel Tensor operations
+	thread_local std::random_device rd;
+	thread_local std::mt19937 gen(rd());
+	thread_local std::normal_distribution<float> d(0, 1);
 
 	return d(gen);
 }
 
 float randUniform(float a, float b) {
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	static std::uniform_real_distribution<float> u(a, b);
+	thread_local std::random_device rd;
+	thread_local std::mt19937 gen(rd());
+	thread_local std::uniform_real_distribution<float> u(0.0f, 1.0f);
 
-	return u(gen);
+	// the distribution is shared by all calls, so it is scaled to [a, b) here
+	return a + (b - a) * u(gen);
 }
 
 double perf_counter_ns() {
@@ -35,6 +35,7 @@ uint32_t* genPermutation(uint32_t n);
 float randNormalDistribution();
 /**
  * @brief Samples Uniform Distribution.
+ * Every thread has its own generator seeded from std::random_device, it is not affected by srand().
  * 
  * @param a minimum value.
  * @param b maximum value.
@@ -0,0 +1,203 @@
+#include "WinogradConv.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Gemm.h"
+#include "Tensor.h"
+#include "ThreadPool.h"
+
+/**
+ * Number of tiles transformed and multiplied at once (rows of matrix products of transformed tiles).
+ */
+constexpr uint32_t WINOGRAD_TILES_BLOCK{ 128 };
+
+/**
+ * Number of channels (filters) transformed at once, values are kept in local arrays.
+ */
+constexpr uint32_t WINOGRAD_VECTOR_BLOCK{ 8 };
+
+/**
+ * Computes U = G g G^T of a single 3x3 filter g, values of g and U are given with strides.
+ * G = [[1, 0, 0], [1/2, 1/2, 1/2], [1/2, -1/2, 1/2], [0, 0, 1]]
+ */
+static void transformFilter(const float* g, const uint32_t g_stride, float* u, const uint32_t u_stride) {
+	float gg[4][3];
+
+	for (uint32_t b{ 0 }; b < 3; ++b) {
+		const float g0{ g[(0 * 3 + b) * g_stride] };
+		const float g1{ g[(1 * 3 + b) * g_stride] };
+		const float g2{ g[(2 * 3 + b) * g_stride] };
+		gg[0][b] = g0;
+		gg[1][b] = 0.5f * (g0 + g1 + g2);
+		gg[2][b] = 0.5f * (g0 - g1 + g2);
+		gg[3][b] = g2;
+	}
+
+	for (uint32_t a{ 0 }; a < 4; ++a) {
+		u[(a * 4 + 0) * u_stride] = gg[a][0];
+		u[(a * 4 + 1) * u_stride] = 0.5f * (gg[a][0] + gg[a][1] + gg[a][2]);
+		u[(a * 4 + 2) * u_stride] = 0.5f * (gg[a][0] - gg[a][1] + gg[a][2]);
+		u[(a * 4 + 3) * u_stride] = gg[a][2];
+	}
+}
+
+void winogradTransformFilters(const float* weights, const uint32_t channels, const uint32_t filters_count, float* transformed) {
+	const uint32_t stride{ channels * filters_count };
+
+	for (uint32_t c{ 0 }; c < channels; ++c) {
+		for (uint32_t f{ 0 }; f < filters_count; ++f) {
+			transformFilter(weights + c * filters_count + f, stride, transformed + c * filters_count + f, stride);
+		}
+	}
+}
+
+void winogradTransformFiltersBackward(const float* weights, const uint32_t channels, const uint32_t filters_count, float* transformed) {
+	const uint32_t stride{ channels * filters_count };
+	float rotated[9];
+
+	for (uint32_t c{ 0 }; c < channels; ++c) {
+		for (uint32_t f{ 0 }; f < filters_count; ++f) {
+			for (uint32_t t{ 0 }; t < 9; ++t) {
+				rotated[8 - t] = weights[t * stride + c * filters_count + f];
+			}
+			transformFilter(rotated, 1, transformed + f * channels + c, stride);
+		}
+	}
+}
+
+void winogradConv(const float* x, const uint32_t batch_size, const uint32_t height, const uint32_t width, const uint32_t channels,
+	const float* transformed, const uint32_t filters_count, const float* biases, float* y) {
+	const uint32_t tiles_height{ (height + 1) / 2 };
+	const uint32_t tiles_width{ (width + 1) / 2 };
+	const uint32_t tiles{ batch_size * tiles_height * tiles_width };
+	const uint32_t blocks{ (tiles + WINOGRAD_TILES_BLOCK - 1) / WINOGRAD_TILES_BLOCK };
+	const uint64_t size{ static_cast<uint64_t>(batch_size) * height * width * 9 * channels };
+
+	ThreadPool::forEachTask(blocks, size, [&](uint32_t block) {
+		const uint32_t first_tile{ block * WINOGRAD_TILES_BLOCK };
+		const uint32_t tiles_count{ std::min(WINOGRAD_TILES_BLOCK, tiles - first_tile) };
+
+		// v[xi][tile][c] and m[xi][tile][f] for every position xi of 4x4 transformed tile
+		thread_local std::vector<float> v;
+		thread_local std::vector<float> m;
+		thread_local std::vector<float> zeros;
+		thread_local std::vector<float> dropped;
+		v.resize(static_cast<size_t>(WINOGRAD_TILE_SIZE) * tiles_count * channels);
+		m.resize(static_cast<size_t>(WINOGRAD_TILE_SIZE) * tiles_count * filters_count);
+		zeros.assign(channels, 0.0f);
+		dropped.resize(filters_count);
+		const size_t v_stride{ static_cast<size_t>(tiles_count) * channels };
+		const size_t m_stride{ static_cast<size_t>(tiles_count) * filters_count };
+
+		// V = B^T d B, B^T = [[1, 0, -1, 0], [0, 1, 1, 0], [0, -1, 1, 0], [0, 1, 0, -1]], computed for all channels at once
+		for (uint32_t tile{ 0 }; tile < tiles_count; ++tile) {
+			const uint32_t tile_index{ first_tile + tile };
+			const uint32_t i{ tile_index / (tiles_height * tiles_width) };
+			const int32_t y_begin{ static_cast<int32_t>(tile_index / tiles_width % tiles_height) * 2 - 1 };
+			const int32_t x_begin{ static_cast<int32_t>(tile_index % tiles_width) * 2 - 1 };
+
+			// pixels of the input tile, zeros outside of the image
+			const float* d[4][4];
+			for (int32_t a{ 0 }; a < 4; ++a) {
+				for (int32_t b{ 0 }; b < 4; ++b) {
+					const int32_t y_in{ y_begin + a };
+					const int32_t x_in{ x_begin + b };
+					const bool inside{ (y_in >= 0) && (y_in < static_cast<int32_t>(height)) && (x_in >= 0) && (x_in < static_cast<int32_t>(width)) };
+					d[a][b] = inside ? x + ((static_cast<size_t>(i) * height + y_in) * width + x_in) * channels : zeros.data();
+				}
+			}
+
+			float* v_tile{ v.data() + tile * channels };
+			for (uint32_t c{ 0 }; c < channels; c += WINOGRAD_VECTOR_BLOCK) {
+				const uint32_t count{ std::min(WINOGRAD_VECTOR_BLOCK, channels - c) };
+				float dd[4][4][WINOGRAD_VECTOR_BLOCK]{};
+				for (uint32_t a{ 0 }; a < 4; ++a) {
+					for (uint32_t b{ 0 }; b < 4; ++b) {
+						std::copy(d[a][b] + c, d[a][b] + c + count, dd[a][b]);
+					}
+				}
+
+				float bd[4][4][WINOGRAD_VECTOR_BLOCK];
+				for (uint32_t b{ 0 }; b < 4; ++b) {
+					for (uint32_t j{ 0 }; j < WINOGRAD_VECTOR_BLOCK; ++j) {
+						bd[0][b][j] = dd[0][b][j] - dd[2][b][j];
+						bd[1][b][j] = dd[1][b][j] + dd[2][b][j];
+						bd[2][b][j] = dd[2][b][j] - dd[1][b][j];
+						bd[3][b][j] = dd[1][b][j] - dd[3][b][j];
+					}
+				}
+
+				for (uint32_t a{ 0 }; a < 4; ++a) {
+					float vv[4][WINOGRAD_VECTOR_BLOCK];
+					for (uint32_t j{ 0 }; j < WINOGRAD_VECTOR_BLOCK; ++j) {
+						vv[0][j] = bd[a][0][j] - bd[a][2][j];
+						vv[1][j] = bd[a][1][j] + bd[a][2][j];
+						vv[2][j] = bd[a][2][j] - bd[a][1][j];
+						vv[3][j] = bd[a][1][j] - bd[a][3][j];
+					}
+					for (uint32_t b{ 0 }; b < 4; ++b) {
+						std::copy(vv[b], vv[b] + count, v_tile + (a * 4 + b) * v_stride + c);
+					}
+				}
+			}
+		}
+
+		// M[xi] = V[xi] * U[xi], [tiles, c] * [c, f] = [tiles, f]
+		for (uint32_t xi{ 0 }; xi < WINOGRAD_TILE_SIZE; ++xi) {
+			gemm(tiles_count, filters_count, channels,
+				v.data() + xi * v_stride, channels, 1,
+				transformed + static_cast<size_t>(xi) * channels * filters_count, filters_count, 1,
+				m.data() + xi * m_stride, filters_count);
+		}
+
+		// Y = A^T M A, A^T = [[1, 1, 1, 0], [0, 1, -1, -1]], computed for all filters at once
+		for (uint32_t tile{ 0 }; tile < tiles_count; ++tile) {
+			const uint32_t tile_index{ first_tile + tile };
+			const uint32_t i{ tile_index / (tiles_height * tiles_width) };
+			const uint32_t y_pos{ tile_index / tiles_width % tiles_height * 2 };
+			const uint32_t x_pos{ tile_index % tiles_width * 2 };
+
+			// output pixels outside of the image (odd height or width) are written to a dropped buffer
+			float* out[2][2];
+			for (uint32_t a{ 0 }; a < 2; ++a) {
+				for (uint32_t b{ 0 }; b < 2; ++b) {
+					const bool inside{ (y_pos + a < height) && (x_pos + b < width) };
+					out[a][b] = inside ? y + ((static_cast<size_t>(i) * height + y_pos + a) * width + x_pos + b) * filters_count : dropped.data();
+				}
+			}
+
+			const float* m_tile{ m.data() + tile * filters_count };
+			for (uint32_t f{ 0 }; f < filters_count; f += WINOGRAD_VECTOR_BLOCK) {
+				const uint32_t count{ std::min(WINOGRAD_VECTOR_BLOCK, filters_count - f) };
+				float mm[4][4][WINOGRAD_VECTOR_BLOCK]{};
+				float bias[WINOGRAD_VECTOR_BLOCK]{};
+				for (uint32_t xi{ 0 }; xi < WINOGRAD_TILE_SIZE; ++xi) {
+					std::copy(m_tile + xi * m_stride + f, m_tile + xi * m_stride + f + count, mm[xi / 4][xi % 4]);
+				}
+				if (nullptr != biases) {
+					std::copy(biases + f, biases + f + count, bias);
+				}
+
+				float yy[2][2][WINOGRAD_VECTOR_BLOCK];
+				for (uint32_t j{ 0 }; j < WINOGRAD_VECTOR_BLOCK; ++j) {
+					float am[2][4];
+					for (uint32_t b{ 0 }; b < 4; ++b) {
+						am[0][b] = mm[0][b][j] + mm[1][b][j] + mm[2][b][j];
+						am[1][b] = mm[1][b][j] - mm[2][b][j] - mm[3][b][j];
+					}
+					for (uint32_t a{ 0 }; a < 2; ++a) {
+						yy[a][0][j] = am[a][0] + am[a][1] + am[a][2] + bias[j];
+						yy[a][1][j] = am[a][1] - am[a][2] - am[a][3] + bias[j];
+					}
+				}
+
+				for (uint32_t a{ 0 }; a < 2; ++a) {
+					for (uint32_t b{ 0 }; b < 2; ++b) {
+						std::copy(yy[a][b], yy[a][b] + count, out[a][b] + f);
+					}
+				}
+			}
+		}
+	});
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Number of values of a transformed Winograd F(2x2, 3x3) tile (4 x 4).
+ */
+constexpr uint32_t WINOGRAD_TILE_SIZE{ 16 };
+
+/**
+ * @brief Transforms 3x3 filters for winogradConv (U = G g G^T for every channel and filter).
+ *
+ * @param weights Filters of shape [3, 3, channels, filters_count].
+ * @param channels Number of channels.
+ * @param filters_count Number of filters.
+ * @param transformed Output of shape [WINOGRAD_TILE_SIZE, channels, filters_count].
+ */
+void winogradTransformFilters(const float* weights, const uint32_t channels, const uint32_t filters_count, float* transformed);
+
+/**
+ * @brief Transforms 3x3 filters for the input gradient pass of winogradConv.
+ * Filters are rotated by 180 degrees and their channel axes are swapped before the transform.
+ *
+ * @param weights Filters of shape [3, 3, channels, filters_count].
+ * @param channels Number of channels.
+ * @param filters_count Number of filters.
+ * @param transformed Output of shape [WINOGRAD_TILE_SIZE, filters_count, channels].
+ */
+void winogradTransformFiltersBackward(const float* weights, const uint32_t channels, const uint32_t filters_count, float* transformed);
+
+/**
+ * @brief Convolution of NHWC images with 3x3 filters, stride 1 and "same" padding using Winograd F(2x2, 3x3).
+ * Every 2x2 block of output pixels is computed from transformed 4x4 input tile with 16 multiplications per
+ * channel and filter instead of 36. Products of transformed tiles and filters are computed as 16 matrix products
+ * (one per tile position) by gemm for blocks of tiles, blocks are split between threads of the global ThreadPool.
+ * Passing dy and filters transformed by winogradTransformFiltersBackward gives the input gradient.
+ *
+ * @param x Images of shape [batch_size, height, width, channels].
+ * @param batch_size Number of images.
+ * @param height Height of images.
+ * @param width Width of images.
+ * @param channels Number of channels.
+ * @param transformed Filters transformed by winogradTransformFilters of shape [WINOGRAD_TILE_SIZE, channels, filters_count].
+ * @param filters_count Number of filters.
+ * @param biases Biases of shape [filters_count], may be nullptr.
+ * @param y Output of shape [batch_size, height, width, filters_count].
+ */
+void winogradConv(const float* x, const uint32_t batch_size, const uint32_t height, const uint32_t width, const uint32_t channels,
+	const float* transformed, const uint32_t filters_count, const float* biases, float* y);
@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include "src/ActivationLayer.h"
+#include "src/NeuralNetwork.h"
 #include "src/Tensor.h"
 #include "src/Utils.h"
 
@@ -19,6 +20,26 @@ static void BM_ActivationLayerSigmoidForwardPropagation(benchmark::State& state)
 static void BM_ActivationLayerSigmoidBackwardPropagation(benchmark::State& state) {
     Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
     ActivationLayer layer = ActivationLayer({ M }, ActivationFun::Sigmoid);
+    layer.forwardPropagation(dx, false);
+
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+}
+
+static void BM_ActivationLayerTanhForwardPropagation(benchmark::State& state) {
+    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::Tanh);
+
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+}
+
+static void BM_ActivationLayerTanhBackwardPropagation(benchmark::State& state) {
+    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    ActivationLayer layer = ActivationLayer({ M }, ActivationFun::Tanh);
+    layer.forwardPropagation(dx, false);
 
     for (auto _ : state) {
         Tensor c = layer.backwardPropagation(dx);
@@ -37,6 +58,7 @@ static void BM_ActivationLayerReLUForwardPropagation(benchmark::State& state) {
 static void BM_ActivationLayerReLUBackwardPropagation(benchmark::State& state) {
     Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
     ActivationLayer layer = ActivationLayer({ M }, ActivationFun::ReLU);
+    layer.forwardPropagation(dx, false);
 
     for (auto _ : state) {
         Tensor c = layer.backwardPropagation(dx);
@@ -55,15 +77,59 @@ static void BM_ActivationLayerLeakyReLUForwardPropagation(benchmark::State& stat
 static void BM_ActivationLayerLeakyReLUBackwardPropagation(benchmark::State& state) {
     Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
     ActivationLayer layer = ActivationLayer({ M }, ActivationFun::LeakyReLU);
+    layer.forwardPropagation(dx, false);
+
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+}
+
+static void BM_ActivationLayerSoftmaxForwardAndBackwardPropagation(benchmark::State& state) {
+    constexpr uint32_t classes = 1000;
+    Tensor x = Tensor({ N, classes }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ N, classes }).applyFunction([](float) { return randNormalDistribution(); });
+    ActivationLayer layer = ActivationLayer({ classes }, ActivationFun::Softmax);
 
     for (auto _ : state) {
+        Tensor y = layer.forwardPropagation(x, false);
         Tensor c = layer.backwardPropagation(dx);
     }
 }
 
+static void BM_SoftmaxCategoricalCrossentropy(benchmark::State& state) {
+    constexpr uint32_t classes = 1000;
+    Tensor x = Tensor({ N, classes }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor y = Tensor({ N, classes });
+    for (uint32_t i{ 0 }; i < N; ++i) {
+        y[{ i, i % classes }] = 1.0f;
+    }
+
+    for (auto _ : state) {
+        float cost = NeuralNetwork::softmax_categorical_crossentropy(x, y);
+        Tensor c = NeuralNetwork::softmax_categorical_crossentropy_d(x, y);
+        benchmark::DoNotOptimize(cost);
+    }
+}
+
+static void BM_SigmoidBinaryCrossentropy(benchmark::State& state) {
+    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor y = Tensor({ N, M }).applyFunction([](float) { return randUniform(0.0f, 1.0f); });
+
+    for (auto _ : state) {
+        float cost = NeuralNetwork::sigmoid_binary_crossentropy(x, y);
+        Tensor c = NeuralNetwork::sigmoid_binary_crossentropy_d(x, y);
+        benchmark::DoNotOptimize(cost);
+    }
+}
+
 BENCHMARK(BM_ActivationLayerSigmoidForwardPropagation);
 BENCHMARK(BM_ActivationLayerSigmoidBackwardPropagation);
+BENCHMARK(BM_ActivationLayerTanhForwardPropagation);
+BENCHMARK(BM_ActivationLayerTanhBackwardPropagation);
 BENCHMARK(BM_ActivationLayerReLUForwardPropagation);
 BENCHMARK(BM_ActivationLayerReLUBackwardPropagation);
 BENCHMARK(BM_ActivationLayerLeakyReLUForwardPropagation);
-BENCHMARK(BM_ActivationLayerLeakyReLUBackwardPropagation);
\ No newline at end of file
+BENCHMARK(BM_ActivationLayerLeakyReLUBackwardPropagation);
+BENCHMARK(BM_ActivationLayerSoftmaxForwardAndBackwardPropagation);
+BENCHMARK(BM_SoftmaxCategoricalCrossentropy);
+BENCHMARK(BM_SigmoidBinaryCrossentropy);
\ No newline at end of file
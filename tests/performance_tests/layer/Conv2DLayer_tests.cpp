@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include "src/Conv2DLayer.h"
+#include "src/DepthwiseConv2DLayer.h"
 #include "src/Tensor.h"
 #include "src/Utils.h"
 
@@ -9,7 +10,7 @@ constexpr uint32_t M = 32;
 
 static void BM_Conv2DLayerForwardPropagation(benchmark::State& state) {
     Tensor x = Tensor({ N, M, M, 3 }).applyFunction([](float) { return randNormalDistribution(); });
-    Conv2DLayer layer = Conv2DLayer({ M, M, 3 }, 5, 3);
+    Conv2DLayer layer = Conv2DLayer({ M, M, 3 }, 5, 3, 1, ConvPadding::Same, 1, 1, static_cast<ConvAlgorithm>(state.range(0)));
 
     for (auto _ : state) {
         Tensor c = layer.forwardPropagation(x);
@@ -19,7 +20,7 @@ static void BM_Conv2DLayerForwardPropagation(benchmark::State& state) {
 static void BM_Conv2DLayerBackwardPropagation(benchmark::State& state) {
     Tensor x = Tensor({ N, M, M, 3 }).applyFunction([](float) { return randNormalDistribution(); });
     Tensor dx = Tensor({ N, M, M, 5 }).applyFunction([](float) { return randNormalDistribution(); });
-    Conv2DLayer layer = Conv2DLayer({ M, M, 3 }, 5, 3);
+    Conv2DLayer layer = Conv2DLayer({ M, M, 3 }, 5, 3, 1, ConvPadding::Same, 1, 1, static_cast<ConvAlgorithm>(state.range(0)));
     
     layer.initCachedGradient();
     layer.forwardPropagation(x, false);
@@ -29,5 +30,83 @@ static void BM_Conv2DLayerBackwardPropagation(benchmark::State& state) {
     }
 }
 
-BENCHMARK(BM_Conv2DLayerForwardPropagation);
-BENCHMARK(BM_Conv2DLayerBackwardPropagation);
\ No newline at end of file
+static void BM_Conv2DLayerAlgorithms(benchmark::State& state) {
+    const uint32_t channels = static_cast<uint32_t>(state.range(1));
+    Tensor x = Tensor({ N, M, M, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ N, M, M, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ M, M, channels }, channels, 3, 1, ConvPadding::Same, 1, 1, static_cast<ConvAlgorithm>(state.range(0)));
+
+    layer.initCachedGradient();
+
+    for (auto _ : state) {
+        layer.forwardPropagation(x, false);
+        Tensor c = layer.backwardPropagation(dx);
+    }
+}
+
+static void BM_Conv2DLayerLargeFilters(benchmark::State& state) {
+    const uint32_t filter_size = static_cast<uint32_t>(state.range(1));
+    Tensor x = Tensor({ N, M, M, 16 }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ M, M, 16 }, 16, filter_size, 1, ConvPadding::Same, 1, 1, static_cast<ConvAlgorithm>(state.range(0)));
+
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+}
+
+static void BM_Conv2DLayerStrides(benchmark::State& state) {
+    const uint32_t stride = static_cast<uint32_t>(state.range(1));
+    Tensor x = Tensor({ N, M, M, 16 }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer layer = Conv2DLayer({ M, M, 16 }, 16, 3, stride, ConvPadding::Same, 1, 1, static_cast<ConvAlgorithm>(state.range(0)));
+    Tensor dx = Tensor({ N, M / stride, M / stride, 16 }).applyFunction([](float) { return randNormalDistribution(); });
+
+    layer.initCachedGradient();
+
+    for (auto _ : state) {
+        layer.forwardPropagation(x, false);
+        Tensor c = layer.backwardPropagation(dx);
+    }
+}
+
+static void BM_Conv2DLayerSeparable(benchmark::State& state) {
+    const uint32_t channels = static_cast<uint32_t>(state.range(1));
+    Tensor x = Tensor({ N, M, M, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ N, M, M, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Conv2DLayer full_layer = Conv2DLayer({ M, M, channels }, channels, 3);
+    DepthwiseConv2DLayer depthwise_layer = DepthwiseConv2DLayer({ M, M, channels }, 3);
+    Conv2DLayer pointwise_layer = Conv2DLayer(depthwise_layer, channels, 1);
+
+    full_layer.initCachedGradient();
+    depthwise_layer.initCachedGradient();
+    pointwise_layer.initCachedGradient();
+
+    for (auto _ : state) {
+        if (0 == state.range(0)) {
+            full_layer.forwardPropagation(x, false);
+            Tensor c = full_layer.backwardPropagation(dx);
+        }
+        else {
+            pointwise_layer.forwardPropagation(depthwise_layer.forwardPropagation(x, false), false);
+            Tensor c = depthwise_layer.backwardPropagation(pointwise_layer.backwardPropagation(dx));
+        }
+    }
+}
+
+BENCHMARK(BM_Conv2DLayerForwardPropagation)
+    ->Arg(static_cast<int>(ConvAlgorithm::Im2col))
+    ->Arg(static_cast<int>(ConvAlgorithm::Direct))
+    ->Arg(static_cast<int>(ConvAlgorithm::Winograd));
+BENCHMARK(BM_Conv2DLayerBackwardPropagation)
+    ->Arg(static_cast<int>(ConvAlgorithm::Im2col))
+    ->Arg(static_cast<int>(ConvAlgorithm::Direct))
+    ->Arg(static_cast<int>(ConvAlgorithm::Winograd));
+BENCHMARK(BM_Conv2DLayerAlgorithms)
+    ->ArgsProduct({ { static_cast<int>(ConvAlgorithm::Im2col), static_cast<int>(ConvAlgorithm::Direct), static_cast<int>(ConvAlgorithm::Winograd) },
+                    { 4, 16, 64 } });
+BENCHMARK(BM_Conv2DLayerLargeFilters)
+    ->ArgsProduct({ { static_cast<int>(ConvAlgorithm::Im2col), static_cast<int>(ConvAlgorithm::Direct), static_cast<int>(ConvAlgorithm::FFT) },
+                    { 5, 7, 9, 11, 13 } });
+BENCHMARK(BM_Conv2DLayerStrides)
+    ->ArgsProduct({ { static_cast<int>(ConvAlgorithm::Im2col), static_cast<int>(ConvAlgorithm::Direct) }, { 1, 2 } });
+BENCHMARK(BM_Conv2DLayerSeparable)
+    ->ArgsProduct({ { 0, 1 }, { 16, 64 } });
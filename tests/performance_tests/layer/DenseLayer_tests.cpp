@@ -1,22 +1,55 @@
 #include <benchmark/benchmark.h>
+#include <atomic>
 
+#include "src/ActivationLayer.h"
 #include "src/DenseLayer.h"
 #include "src/Tensor.h"
+#include "src/TensorAllocator.h"
 #include "src/Utils.h"
 
 constexpr uint32_t N = 100;
 constexpr uint32_t M = 100;
 
+/**
+ * Allocator counting tensor buffers allocated while it is active, blocks are taken from the default allocator.
+ */
+class CountingTensorAllocator : public TensorAllocator {
+public:
+    uint64_t getAllocations() const {
+        return _allocations;
+    }
+
+protected:
+    void* allocateBlock(size_t bytes) override {
+        ++_allocations;
+        return getDefaultTensorAllocator().allocate(bytes);
+    }
+
+    void deallocateBlock(void* ptr, size_t bytes) override {
+        getDefaultTensorAllocator().deallocate(ptr, bytes);
+    }
+
+private:
+    std::atomic<uint64_t> _allocations{ 0 };
+};
+
 static void BM_DenseLayerForwardPropagation(benchmark::State& state) {
+    // declared first, so it outlives tensors of the layer
+    CountingTensorAllocator allocator;
     Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
     DenseLayer layer = DenseLayer({ M }, M);
 
+    TensorAllocatorScope scope(allocator);
+
     for (auto _ : state) {
         Tensor c = layer.forwardPropagation(x);
     }
+    state.counters["allocations"] = benchmark::Counter(allocator.getAllocations(), benchmark::Counter::kAvgIterations);
 }
 
 static void BM_DenseLayerBackwardPropagation(benchmark::State& state) {
+    // declared first, so it outlives tensors of the layer
+    CountingTensorAllocator allocator;
     Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
     Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
     DenseLayer layer = DenseLayer({ M }, M);
@@ -24,10 +57,42 @@ static void BM_DenseLayerBackwardPropagation(benchmark::State& state) {
     layer.initCachedGradient();
     layer.forwardPropagation(x, false);
 
+    TensorAllocatorScope scope(allocator);
+
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+    state.counters["allocations"] = benchmark::Counter(allocator.getAllocations(), benchmark::Counter::kAvgIterations);
+}
+
+static void BM_DenseLayerWithActivation(benchmark::State& state) {
+    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer dense_layer = DenseLayer({ M }, M);
+    ActivationLayer activation_layer = ActivationLayer(dense_layer, ActivationFun::ReLU);
+
+    dense_layer.initCachedGradient();
+
+    for (auto _ : state) {
+        Tensor y = activation_layer.forwardPropagation(dense_layer.forwardPropagation(x, false), false);
+        Tensor c = dense_layer.backwardPropagation(activation_layer.backwardPropagation(dx));
+    }
+}
+
+static void BM_DenseLayerFusedActivation(benchmark::State& state) {
+    Tensor x = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ N, M }).applyFunction([](float) { return randNormalDistribution(); });
+    DenseLayer layer = DenseLayer({ M }, M, ActivationFun::ReLU);
+
+    layer.initCachedGradient();
+
     for (auto _ : state) {
+        Tensor y = layer.forwardPropagation(x, false);
         Tensor c = layer.backwardPropagation(dx);
     }
 }
 
 BENCHMARK(BM_DenseLayerForwardPropagation);
-BENCHMARK(BM_DenseLayerBackwardPropagation);
\ No newline at end of file
+BENCHMARK(BM_DenseLayerBackwardPropagation);
+BENCHMARK(BM_DenseLayerWithActivation);
+BENCHMARK(BM_DenseLayerFusedActivation);
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include "src/Pool2DLayer.h"
+#include "src/Tensor.h"
+#include "src/Utils.h"
+
+constexpr uint32_t N = 10;
+constexpr uint32_t M = 32;
+
+static void BM_Pool2DLayerForwardPropagation(benchmark::State& state) {
+    const uint32_t channels = static_cast<uint32_t>(state.range(1));
+    Tensor x = Tensor({ N, M, M, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Pool2DLayer layer = Pool2DLayer({ M, M, channels }, 2, static_cast<PoolMode>(state.range(0)));
+
+    for (auto _ : state) {
+        Tensor c = layer.forwardPropagation(x);
+    }
+}
+
+static void BM_Pool2DLayerBackwardPropagation(benchmark::State& state) {
+    const uint32_t channels = static_cast<uint32_t>(state.range(1));
+    Tensor x = Tensor({ N, M, M, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor dx = Tensor({ N, M / 2, M / 2, channels }).applyFunction([](float) { return randNormalDistribution(); });
+    Pool2DLayer layer = Pool2DLayer({ M, M, channels }, 2, static_cast<PoolMode>(state.range(0)));
+
+    layer.forwardPropagation(x, false);
+
+    for (auto _ : state) {
+        Tensor c = layer.backwardPropagation(dx);
+    }
+}
+
+static void BM_Pool2DLayerOverlappingAndGlobal(benchmark::State& state) {
+    Tensor x = Tensor({ N, M, M, 64 }).applyFunction([](float) { return randNormalDistribution(); });
+    Pool2DLayer layer = (0 == state.range(1))
+        ? Pool2DLayer({ M, M, 64 }, 3, static_cast<PoolMode>(state.range(0)), 2, ConvPadding::Same)
+        : Pool2DLayer({ M, M, 64 }, static_cast<PoolMode>(state.range(0)));
+    std::vector<uint32_t> dx_shape{ layer.getOutputShape() };
+    dx_shape.insert(dx_shape.begin(), N);
+    Tensor dx = Tensor(dx_shape).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        layer.forwardPropagation(x, false);
+        Tensor c = layer.backwardPropagation(dx);
+    }
+}
+
+BENCHMARK(BM_Pool2DLayerForwardPropagation)
+    ->ArgsProduct({ { static_cast<int>(PoolMode::Max), static_cast<int>(PoolMode::Average) }, { 3, 16, 64 } });
+BENCHMARK(BM_Pool2DLayerBackwardPropagation)
+    ->ArgsProduct({ { static_cast<int>(PoolMode::Max), static_cast<int>(PoolMode::Average) }, { 3, 16, 64 } });
+BENCHMARK(BM_Pool2DLayerOverlappingAndGlobal)
+    ->ArgsProduct({ { static_cast<int>(PoolMode::Max), static_cast<int>(PoolMode::Average) }, { 0, 1 } });
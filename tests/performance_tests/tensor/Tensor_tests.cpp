@@ -1,6 +1,10 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
 
 #include "src/Tensor.h"
+#include "src/TensorExpression.h"
+#include "src/TensorKernels.h"
 #include "src/Utils.h"
 
 constexpr uint32_t N = 10000;
@@ -161,12 +165,173 @@ static void BM_TensorRowSum(benchmark::State& state) {
     }
 }
 
+static void BM_TensorApplyFunctionExp(benchmark::State& state) {
+    Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor b = a.applyFunction(expf);
+    }
+}
+
+static void BM_TensorApplyFunctionLeakyReLU(benchmark::State& state) {
+    Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor b = a.applyFunction([](float x) { return std::max(x, 0.1f * x); });
+    }
+}
+
+static void BM_TensorMapLeakyReLU(benchmark::State& state) {
+    Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor b = a.map([](float x) { return std::max(x, 0.1f * x); });
+    }
+}
+
+static void BM_TensorZip(benchmark::State& state) {
+    Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor c = a.zip(b, [](float x, float y) { return x > 0.0f ? y : 0.0f; });
+    }
+}
+
+static void BM_TensorExp(benchmark::State& state) {
+    Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor b = a.exp();
+    }
+}
+
+static void BM_TensorBinaryCrossentropyEager(benchmark::State& state) {
+    Tensor y_hat = Tensor({ M, N }).applyFunction([](float) { return randUniform(0.0f, 1.0f); });
+    Tensor y = Tensor({ M, N }).applyFunction([](float) { return randUniform(0.0f, 1.0f) > 0.5f ? 1.0f : 0.0f; });
+
+    for (auto _ : state) {
+        float cost = (y * (y_hat + 1e-9f).applyFunction(logf) + (1.0f - y) * (1.0f - y_hat + 1e-9f).applyFunction(logf)).sum();
+        benchmark::DoNotOptimize(cost);
+    }
+}
+
+static void BM_TensorBinaryCrossentropyExpression(benchmark::State& state) {
+    Tensor y_hat = Tensor({ M, N }).applyFunction([](float) { return randUniform(0.0f, 1.0f); });
+    Tensor y = Tensor({ M, N }).applyFunction([](float) { return randUniform(0.0f, 1.0f) > 0.5f ? 1.0f : 0.0f; });
+
+    for (auto _ : state) {
+        float cost = (lazy(y) * (lazy(y_hat) + 1e-9f).applyFunction(logf) + (1.0f - lazy(y)) * (1.0f - lazy(y_hat) + 1e-9f).applyFunction(logf)).sum();
+        benchmark::DoNotOptimize(cost);
+    }
+}
+
+static void BM_TensorSlice(benchmark::State& state) {
+    const Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor c = a[Tensor::Range({ { 0, M >> 1 } })];
+    }
+}
+
+static void BM_TensorViewSlice(benchmark::State& state) {
+    const Tensor a = Tensor({ M, N }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        TensorView c = a.view(Tensor::Range({ { 0, M >> 1 } }));
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+static void BM_TensorViewTransposedDotProduct(benchmark::State& state) {
+    Tensor a = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ M, M }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor c = a.view().transpose().dotProduct(b.view());
+    }
+}
+
+/**
+ * Reports floating point operations per second of [n, n] x [n, n] matrix multiplication.
+ */
+static void setMatMulFlops(benchmark::State& state, uint32_t n) {
+    state.counters["FLOPS"] = benchmark::Counter(2.0 * n * n * n, benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+}
+
+static void BM_MatMulNaive(benchmark::State& state) {
+    const uint32_t n = state.range(0);
+    Tensor a = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+    const std::vector<float> a_data = a.getData();
+    const std::vector<float> b_data = b.getData();
+
+    for (auto _ : state) {
+        // triple loop previously used by Tensor::dotProduct
+        std::vector<float> c(n * n, 0.0f);
+        for (uint32_t i{ 0 }; i < n; ++i) {
+            for (uint32_t j{ 0 }; j < n; ++j) {
+                for (uint32_t k{ 0 }; k < n; ++k) {
+                    c[i * n + j] += a_data[i * n + k] * b_data[k * n + j];
+                }
+            }
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    setMatMulFlops(state, n);
+}
+
+static void BM_MatMulDotProductTransposeKernel(benchmark::State& state) {
+    const uint32_t n = state.range(0);
+    Tensor a = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+    const std::vector<float> a_data = a.getData();
+    const std::vector<float> b_data = b.getData();
+
+    for (auto _ : state) {
+        // one inner product per element of the result, previously used by Tensor::dotProductTranspose
+        std::vector<float> c(n * n);
+        getKernels().tensor_dot_product_transpose(n, n, n, a_data.data(), b_data.data(), c.data());
+        benchmark::DoNotOptimize(c.data());
+    }
+    setMatMulFlops(state, n);
+}
+
+static void BM_MatMulGemmDotProduct(benchmark::State& state) {
+    const uint32_t n = state.range(0);
+    Tensor a = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor c = a.dotProduct(b);
+    }
+    setMatMulFlops(state, n);
+}
+
+static void BM_MatMulGemmDotProductTranspose(benchmark::State& state) {
+    const uint32_t n = state.range(0);
+    Tensor a = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+    Tensor b = Tensor({ n, n }).applyFunction([](float) { return randNormalDistribution(); });
+
+    for (auto _ : state) {
+        Tensor c = a.dotProductTranspose(b);
+    }
+    setMatMulFlops(state, n);
+}
+
 BENCHMARK(BM_Tensor1D1DDotProduct);
 BENCHMARK(BM_Tensor2D1DDotProduct);
 BENCHMARK(BM_Tensor2D2DDotProduct);
 
 BENCHMARK(BM_TensorDotProductTranspose);
 
+BENCHMARK(BM_TensorViewTransposedDotProduct);
+
+BENCHMARK(BM_MatMulNaive)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_MatMulDotProductTransposeKernel)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_MatMulGemmDotProduct)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(BM_MatMulGemmDotProductTranspose)->RangeMultiplier(4)->Range(64, 1024);
+
 BENCHMARK(BM_TensorTensorProduct);
 
 BENCHMARK(BM_TensorAddition);
@@ -182,4 +347,16 @@ BENCHMARK(BM_TensorDivisionScalar);
 BENCHMARK(BM_TensorCompareScalar);
 
 BENCHMARK(BM_TensorSum);
-BENCHMARK(BM_TensorRowSum);
\ No newline at end of file
+BENCHMARK(BM_TensorRowSum);
+
+BENCHMARK(BM_TensorApplyFunctionExp);
+BENCHMARK(BM_TensorExp);
+BENCHMARK(BM_TensorApplyFunctionLeakyReLU);
+BENCHMARK(BM_TensorMapLeakyReLU);
+BENCHMARK(BM_TensorZip);
+
+BENCHMARK(BM_TensorBinaryCrossentropyEager);
+BENCHMARK(BM_TensorBinaryCrossentropyExpression);
+
+BENCHMARK(BM_TensorSlice);
+BENCHMARK(BM_TensorViewSlice);
\ No newline at end of file
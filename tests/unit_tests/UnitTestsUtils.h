@@ -1,2 +1,65 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "src/Layer.h"
+#include "src/Tensor.h"
+
 #define EPSILON (0.001f)
-#define ASSERT_EQ_EPS(expected, actual) ASSERT_LE(fabs((expected) - (actual)), EPSILON);
\ No newline at end of file
+#define ASSERT_EQ_EPS(expected, actual) ASSERT_LE(fabs((expected) - (actual)), EPSILON);
+
+/**
+ * Asserts that backward propagation of a layer linear in its input matches the numerical gradient.
+ * sum(forward(x) * dx) changes by backward(dx)[i] * delta when x[i] changes by delta.
+ * Call with ASSERT_NO_FATAL_FAILURE, a failed assertion returns from the helper only.
+ */
+inline void assertBackwardMatchesNumericalGradient(Layer& layer, Tensor x, const Tensor& dx) {
+    layer.initCachedGradient();
+    layer.forwardPropagation(x, false);
+    const Tensor backward = layer.backwardPropagation(dx);
+
+    const float delta{ 0.5f };
+    const float base = (layer.forwardPropagation(x) * dx).sum();
+    const std::vector<float> values = x.getData();
+    const std::vector<float> gradient = backward.getData();
+    for (uint32_t i{ 0 }; i < values.size(); ++i) {
+        std::vector<float> shifted = values;
+        shifted[i] += delta;
+        x.setValues(shifted);
+        const float numerical = ((layer.forwardPropagation(x) * dx).sum() - base) / delta;
+        ASSERT_LE(fabs(numerical - gradient[i]), 0.01f) << "index " << i;
+    }
+}
+
+/**
+ * Asserts that two layers with equal weights give the same forward and backward propagation results,
+ * weights gradients are compared through forward propagation results after a weights update.
+ * Call with ASSERT_NO_FATAL_FAILURE, a failed assertion returns from the helper only.
+ */
+inline void assertLayersGiveSameResults(Layer& reference_layer, Layer& layer, const Tensor& x, const Tensor& dx) {
+    reference_layer.initCachedGradient();
+    layer.initCachedGradient();
+
+    const Tensor expected_forward = reference_layer.forwardPropagation(x, false);
+    const Tensor actual_forward = layer.forwardPropagation(x, false);
+    const Tensor expected_backward = reference_layer.backwardPropagation(dx);
+    const Tensor actual_backward = layer.backwardPropagation(dx);
+
+    reference_layer.updateWeights(1.0f, 0.0f);
+    layer.updateWeights(1.0f, 0.0f);
+    const Tensor expected_updated = reference_layer.forwardPropagation(x);
+    const Tensor actual_updated = layer.forwardPropagation(x);
+
+    for (auto [expected, actual] : { std::make_pair(&expected_forward, &actual_forward),
+                                     std::make_pair(&expected_backward, &actual_backward),
+                                     std::make_pair(&expected_updated, &actual_updated) }) {
+        const std::vector<float> expected_values = expected->getData();
+        const std::vector<float> actual_values = actual->getData();
+        ASSERT_EQ(expected_values.size(), actual_values.size());
+        for (uint32_t i{ 0 }; i < expected_values.size(); ++i) {
+            ASSERT_LE(fabs(expected_values[i] - actual_values[i]), 1e-3f) << "index=" << i;
+        }
+    }
+}
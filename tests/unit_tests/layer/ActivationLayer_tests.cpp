@@ -85,4 +85,118 @@ TEST(ActivationLayer_test, ReLUActivationValuesTest) {
     ASSERT_EQ_EPS(0.0f,  const_cast<const Tensor&>(backward)[{ 0 }]);
     ASSERT_EQ_EPS(0.4f,  const_cast<const Tensor&>(backward)[{ 1 }]);
     ASSERT_EQ_EPS(-1.5f, const_cast<const Tensor&>(backward)[{ 2 }]);
-}
\ No newline at end of file
+}
+TEST(ActivationLayer_test, SoftmaxActivationValuesTest) {
+    Tensor tensor = Tensor({ 2, 3 });
+    Tensor tensor_d = Tensor({ 2, 3 });
+    ActivationLayer layer = ActivationLayer({ 3 }, ActivationFun::Softmax);
+
+    tensor.setValues({
+        1.0f, 2.0f, 3.0f,
+        0.0f, 0.0f, 0.0f
+        });
+
+    tensor_d.setValues({
+        1.0f, 0.0f, 0.0f,
+        0.5f, -0.5f, 1.0f
+        });
+
+    const Tensor forward = layer.forwardPropagation(tensor, false);
+    const Tensor backward = layer.backwardPropagation(tensor_d);
+
+    ASSERT_EQ_EPS(0.09003f, (forward[{ 0, 0 }]));
+    ASSERT_EQ_EPS(0.24473f, (forward[{ 0, 1 }]));
+    ASSERT_EQ_EPS(0.66524f, (forward[{ 0, 2 }]));
+    ASSERT_EQ_EPS(0.33333f, (forward[{ 1, 0 }]));
+    ASSERT_EQ_EPS(0.33333f, (forward[{ 1, 1 }]));
+    ASSERT_EQ_EPS(0.33333f, (forward[{ 1, 2 }]));
+
+    ASSERT_EQ_EPS( 0.08193f, (backward[{ 0, 0 }]));
+    ASSERT_EQ_EPS(-0.02203f, (backward[{ 0, 1 }]));
+    ASSERT_EQ_EPS(-0.05989f, (backward[{ 0, 2 }]));
+    ASSERT_EQ_EPS( 0.05556f, (backward[{ 1, 0 }]));
+    ASSERT_EQ_EPS(-0.27778f, (backward[{ 1, 1 }]));
+    ASSERT_EQ_EPS( 0.22222f, (backward[{ 1, 2 }]));
+}
+
+TEST(ActivationLayer_test, SoftmaxOfEmptyBatchShouldBeEmpty) {
+    ActivationLayer layer = ActivationLayer({ 3 }, ActivationFun::Softmax);
+
+    const Tensor forward = layer.forwardPropagation(Tensor({ 0, 3 }), false);
+    const Tensor backward = layer.backwardPropagation(Tensor({ 0, 3 }));
+
+    ASSERT_EQ(0u, forward.getSize());
+    ASSERT_EQ(0u, backward.getSize());
+}
+
+TEST(ActivationLayer_test, InPlaceForwardShouldReuseInputBufferAndMatchForward) {
+    const Tensor x = Tensor::RandomNormal({ 5, 13 });
+    const Tensor dy = Tensor::RandomNormal({ 5, 13 });
+
+    for (ActivationFun fun : { ActivationFun::ReLU, ActivationFun::LeakyReLU, ActivationFun::Sigmoid, ActivationFun::Tanh, ActivationFun::Softmax }) {
+        ActivationLayer layer = ActivationLayer({ 13 }, fun);
+
+        const Tensor expected = layer.forwardPropagation(x, false);
+        const Tensor expected_d = layer.backwardPropagation(dy);
+
+        Tensor input = x;
+        const float* buffer = input.getDataPointer();
+        const Tensor result = layer.forwardPropagationInPlace(std::move(input), false);
+        const Tensor result_d = layer.backwardPropagation(dy);
+
+        ASSERT_EQ(buffer, result.getDataPointer());
+        ASSERT_EQ(x.getShape(), result.getShape());
+        ASSERT_EQ(x.getShape(), result_d.getShape());
+        for (uint32_t i{ 0 }; i < x.getSize(); ++i) {
+            ASSERT_EQ(expected.getData()[i], result.getData()[i]);
+            ASSERT_EQ(expected_d.getData()[i], result_d.getData()[i]);
+        }
+    }
+}
+
+TEST(ActivationLayer_test, LeakyReLUActivationValuesTest) {
+    Tensor tensor = Tensor({ 3 });
+    Tensor tensor_d = Tensor({ 3 });
+    ActivationLayer layer = ActivationLayer({ 3 }, ActivationFun::LeakyReLU);
+
+    tensor.setValues({
+        -1.0f, 0.25f, 1.0f
+        });
+
+    tensor_d.setValues({
+        0.25f, 0.4f, -1.5f
+        });
+
+    const Tensor forward = layer.forwardPropagationInPlace(std::move(tensor), false);
+    const Tensor backward = layer.backwardPropagation(tensor_d);
+
+    ASSERT_EQ_EPS(-0.1f,  forward[{ 0 }]);
+    ASSERT_EQ_EPS(0.25f,  forward[{ 1 }]);
+    ASSERT_EQ_EPS(1.0f,   forward[{ 2 }]);
+
+    ASSERT_EQ_EPS(0.025f, backward[{ 0 }]);
+    ASSERT_EQ_EPS(0.4f,   backward[{ 1 }]);
+    ASSERT_EQ_EPS(-1.5f,  backward[{ 2 }]);
+}
+
+TEST(ActivationLayer_test, WhenGradientSizeDoesNotMatchReLUOutputBackwardShouldThrow) {
+    ActivationLayer layer = ActivationLayer({ 40 }, ActivationFun::ReLU);
+
+    layer.forwardPropagation(Tensor::RandomNormal({ 1, 40 }), false);
+
+    ASSERT_THROW(layer.backwardPropagation(Tensor({ 2, 40 })), std::invalid_argument);
+}
+
+TEST(ActivationLayer_test, ReLUForwardShouldNotLeaveCachedOutput) {
+    const Tensor x = Tensor::RandomNormal({ 2, 40 });
+
+    for (ActivationFun fun : { ActivationFun::ReLU, ActivationFun::LeakyReLU }) {
+        ActivationLayer layer = ActivationLayer({ 40 }, fun);
+
+        layer.forwardPropagation(x, false);
+        ASSERT_EQ(0u, layer.getCachedOutput().getSize());
+
+        layer.forwardPropagationInPlace(Tensor(x), false);
+        ASSERT_EQ(0u, layer.getCachedOutput().getSize());
+    }
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "src/Conv2DGeometry.h"
+
+TEST(Conv2DGeometry_test, SamePaddingShouldKeepCeilOfSizeOverStride) {
+    const Conv2DGeometry unit(5, 6, 3);
+    ASSERT_EQ(5u, unit.output_height);
+    ASSERT_EQ(6u, unit.output_width);
+    ASSERT_EQ(1u, unit.padding_top);
+    ASSERT_EQ(1u, unit.padding_left);
+    ASSERT_TRUE(unit.isUnitSame());
+
+    const Conv2DGeometry strided(7, 8, 3, 2);
+    ASSERT_EQ(4u, strided.output_height);
+    ASSERT_EQ(4u, strided.output_width);
+    ASSERT_EQ(1u, strided.padding_top);
+    ASSERT_EQ(0u, strided.padding_left);
+    ASSERT_FALSE(strided.isUnitSame());
+
+    const Conv2DGeometry dilated(6, 6, 3, 1, 2);
+    ASSERT_EQ(5u, dilated.getEffectiveFilterSize());
+    ASSERT_EQ(6u, dilated.output_height);
+    ASSERT_EQ(2u, dilated.padding_top);
+}
+
+TEST(Conv2DGeometry_test, ValidPaddingShouldUseOnlyFiltersInsideOfInput) {
+    const Conv2DGeometry valid(7, 8, 3, 2, 1, ConvPadding::Valid);
+    ASSERT_EQ(3u, valid.output_height);
+    ASSERT_EQ(3u, valid.output_width);
+    ASSERT_EQ(0u, valid.padding_top);
+    ASSERT_EQ(0u, valid.padding_left);
+
+    const Conv2DGeometry dilated(9, 5, 3, 1, 2, ConvPadding::Valid);
+    ASSERT_EQ(5u, dilated.output_height);
+    ASSERT_EQ(1u, dilated.output_width);
+
+    ASSERT_THROW(Conv2DGeometry(4, 4, 3, 1, 2, ConvPadding::Valid), std::invalid_argument);
+    ASSERT_THROW(Conv2DGeometry(4, 4, 3, 0), std::invalid_argument);
+}
+
+TEST(Conv2DGeometry_test, TapsRangeShouldCoverTapsInsideOfInput) {
+    const Conv2DGeometry geometry(6, 6, 4, 1, 2);
+    uint32_t begin, end;
+
+    geometry.getTapsRange(-3, 6, begin, end);
+    ASSERT_EQ(2u, begin);
+    ASSERT_EQ(4u, end);
+
+    geometry.getTapsRange(1, 6, begin, end);
+    ASSERT_EQ(0u, begin);
+    ASSERT_EQ(3u, end);
+
+    geometry.getTapsRange(-8, 6, begin, end);
+    ASSERT_EQ(begin, end);
+}
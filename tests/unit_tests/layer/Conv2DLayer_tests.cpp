@@ -33,6 +33,31 @@ TEST(Conv2DLayer_test, Conv2DLayerBackwardPropagationOutputShapeTest) {
     ASSERT_EQ(5, (int)result.getShape()[3]);
 }
 
+TEST(Conv2DLayer_test, Conv2DLayerStridedOutputShapeTest) {
+    Tensor tensor = Tensor({ 2, 7, 8, 3 });
+    Conv2DLayer same_layer = Conv2DLayer({ 7, 8, 3 }, 4, 3, 2);
+    Conv2DLayer valid_layer = Conv2DLayer({ 7, 8, 3 }, 4, 3, 2, ConvPadding::Valid);
+    Conv2DLayer dilated_layer = Conv2DLayer({ 7, 8, 3 }, 4, 3, 1, ConvPadding::Valid, 3);
+
+    ASSERT_EQ((std::vector<uint32_t>{ 4, 4, 4 }), same_layer.getOutputShape());
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 3, 4 }), valid_layer.getOutputShape());
+    ASSERT_EQ((std::vector<uint32_t>{ 1, 2, 4 }), dilated_layer.getOutputShape());
+
+    for (Conv2DLayer* layer : { &same_layer, &valid_layer, &dilated_layer }) {
+        std::vector<uint32_t> expected_shape{ layer->getOutputShape() };
+        expected_shape.insert(expected_shape.begin(), 2);
+
+        layer->initCachedGradient();
+        const Tensor result = layer->forwardPropagation(tensor, false);
+        const Tensor backward = layer->backwardPropagation(Tensor(expected_shape));
+
+        ASSERT_EQ(expected_shape, result.getShape());
+        ASSERT_EQ(tensor.getShape(), backward.getShape());
+    }
+
+    ASSERT_THROW(Conv2DLayer({ 4, 4, 3 }, 4, 5, 1, ConvPadding::Valid), std::invalid_argument);
+}
+
 TEST(Conv2DLayer_test, Conv2DLayerForwardAndBackwardPropagationReturnValuesTest) {
     Tensor tensor = Tensor({ 1, 3, 4, 2 });
     Tensor tensor_d = Tensor({ 1, 3, 4, 3 });
@@ -126,4 +151,211 @@ TEST(Conv2DLayer_test, Conv2DLayerForwardAndBackwardPropagationReturnValuesTest)
     ASSERT_EQ_EPS( 11.5f, (backward[{ 0, 2, 2, 1 }]));
     ASSERT_EQ_EPS( -3.0f, (backward[{ 0, 2, 3, 0 }]));
     ASSERT_EQ_EPS( -1.0f, (backward[{ 0, 2, 3, 1 }]));
-}
\ No newline at end of file
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerBackwardPropagationShouldMatchNumericalGradient) {
+    const Tensor tensor = Tensor::RandomNormal({ 2, 5, 4, 3 });
+    const Tensor tensor_d = Tensor::RandomNormal({ 2, 5, 4, 2 });
+    Conv2DLayer layer = Conv2DLayer({ 5, 4, 3 }, 2, 3);
+
+    ASSERT_NO_FATAL_FAILURE(assertBackwardMatchesNumericalGradient(layer, tensor, tensor_d));
+}
+
+TEST(Conv2DLayer_test, StridedConv2DLayerBackwardPropagationShouldMatchNumericalGradient) {
+    const Tensor tensor = Tensor::RandomNormal({ 2, 7, 6, 2 });
+    Conv2DLayer layer = Conv2DLayer({ 7, 6, 2 }, 3, 3, 2, ConvPadding::Same, 2);
+    std::vector<uint32_t> output_shape{ layer.getOutputShape() };
+    output_shape.insert(output_shape.begin(), 2);
+    const Tensor tensor_d = Tensor::RandomNormal(output_shape);
+
+    ASSERT_NO_FATAL_FAILURE(assertBackwardMatchesNumericalGradient(layer, tensor, tensor_d));
+}
+
+TEST(Conv2DLayer_test, Conv2DLayerAlgorithmsShouldGiveSameResults) {
+    for (ConvAlgorithm algorithm : { ConvAlgorithm::Direct, ConvAlgorithm::Winograd, ConvAlgorithm::FFT }) {
+        for (uint32_t filter_size : { 1u, 2u, 3u, 5u, 8u }) {
+            SCOPED_TRACE(testing::Message() << "algorithm=" << static_cast<int>(algorithm) << " filter_size=" << filter_size);
+            const Tensor tensor = Tensor::RandomNormal({ 2, 5, 7, 3 });
+            const Tensor tensor_d = Tensor::RandomNormal({ 2, 5, 7, 11 });
+            Conv2DLayer reference_layer = Conv2DLayer({ 5, 7, 3 }, 11, filter_size, 1, ConvPadding::Same, 1, 1, ConvAlgorithm::Im2col);
+            Conv2DLayer layer = Conv2DLayer({ 5, 7, 3 }, 11, filter_size, 1, ConvPadding::Same, 1, 1, algorithm);
+
+            const Tensor weights = Tensor::RandomNormal({ filter_size, filter_size, 3, 11 });
+            const Tensor biases = Tensor::RandomNormal({ 11 });
+            for (Conv2DLayer* l : { &reference_layer, &layer }) {
+                l->setWeights(weights.getData());
+                l->setBiases(biases.getData());
+            }
+
+            ASSERT_NO_FATAL_FAILURE(assertLayersGiveSameResults(reference_layer, layer, tensor, tensor_d));
+        }
+    }
+}
+
+static void expectTransformedFiltersOutsideArena(ConvAlgorithm algorithm, uint32_t filter_size) {
+    ArenaTensorAllocator allocator;
+    Conv2DLayer layer = Conv2DLayer({ 6, 6, 3 }, 4, filter_size, 1, ConvPadding::Same, 1, 1, algorithm);
+    const Tensor tensor = Tensor::RandomNormal({ 2, 6, 6, 3 });
+
+    // same allocator usage as a training step followed by a test batch in NeuralNetwork::fit
+    {
+        TensorAllocatorScope scope(allocator);
+        layer.initCachedGradient();
+        const Tensor output = layer.forwardPropagation(tensor, false);
+        const Tensor gradient = layer.backwardPropagation(output);
+    }
+    layer.updateWeights(0.1f, 0.0f);
+    allocator.reset();
+    {
+        TensorAllocatorScope scope(allocator);
+        const Tensor output = layer.forwardPropagation(tensor);
+    }
+    ASSERT_EQ(0u, allocator.getLiveBytes());
+
+    // overwrite memory of the arena before predicting outside of it
+    allocator.reset();
+    {
+        TensorAllocatorScope scope(allocator);
+        Tensor garbage = Tensor::RandomNormal({ 1 << 16 });
+    }
+    const std::vector<float> cached = layer.forwardPropagation(tensor).getData();
+    layer.setAlgorithm(algorithm);
+    const std::vector<float> rebuilt = layer.forwardPropagation(tensor).getData();
+
+    ASSERT_EQ(rebuilt.size(), cached.size());
+    for (uint32_t i{ 0 }; i < rebuilt.size(); ++i) {
+        ASSERT_EQ(rebuilt[i], cached[i]) << "algorithm=" << static_cast<int>(algorithm) << " index=" << i;
+    }
+}
+
+TEST(Conv2DLayer_test, WinogradFiltersShouldNotBeCachedInArena) {
+    expectTransformedFiltersOutsideArena(ConvAlgorithm::Winograd, 3);
+}
+
+TEST(Conv2DLayer_test, FFTFiltersShouldNotBeCachedInArena) {
+    expectTransformedFiltersOutsideArena(ConvAlgorithm::FFT, 3);
+    expectTransformedFiltersOutsideArena(ConvAlgorithm::Auto, 11);
+}
+
+TEST(Conv2DLayer_test, FFTFiltersShouldBeRebuiltForInputOfOtherSize) {
+    Conv2DLayer reference_layer = Conv2DLayer({ 6, 6, 3 }, 4, 3, 1, ConvPadding::Same, 1, 1, ConvAlgorithm::Im2col);
+    Conv2DLayer layer = Conv2DLayer({ 6, 6, 3 }, 4, 3, 1, ConvPadding::Same, 1, 1, ConvAlgorithm::FFT);
+    const Tensor weights = Tensor::RandomNormal({ 3, 3, 3, 4 });
+    for (Conv2DLayer* l : { &reference_layer, &layer }) {
+        l->setWeights(weights.getData());
+    }
+
+    // spectra are computed for the declared input shape first, then for larger and smaller images
+    for (const std::vector<uint32_t>& shape : { std::vector<uint32_t>{ 2, 6, 6, 3 }, std::vector<uint32_t>{ 1, 11, 9, 3 },
+                                                std::vector<uint32_t>{ 3, 4, 5, 3 } }) {
+        SCOPED_TRACE(testing::Message() << "height=" << shape[1] << " width=" << shape[2]);
+        const Tensor tensor = Tensor::RandomNormal(shape);
+        const Tensor tensor_d = Tensor::RandomNormal({ shape[0], shape[1], shape[2], 4 });
+
+        ASSERT_NO_FATAL_FAILURE(assertLayersGiveSameResults(reference_layer, layer, tensor, tensor_d));
+    }
+}
+
+TEST(Conv2DLayer_test, StridedAndDilatedConv2DLayerAlgorithmsShouldGiveSameResults) {
+    struct Params { uint32_t filter_size, stride, dilation; ConvPadding padding; };
+    for (ConvAlgorithm algorithm : { ConvAlgorithm::Direct, ConvAlgorithm::Winograd, ConvAlgorithm::FFT }) {
+        for (const Params& params : { Params{ 3, 2, 1, ConvPadding::Same }, Params{ 3, 2, 1, ConvPadding::Valid },
+                                      Params{ 3, 1, 2, ConvPadding::Same }, Params{ 2, 3, 2, ConvPadding::Valid },
+                                      Params{ 4, 2, 1, ConvPadding::Same }, Params{ 3, 1, 1, ConvPadding::Valid } }) {
+            SCOPED_TRACE(testing::Message() << "algorithm=" << static_cast<int>(algorithm) << " filter_size=" << params.filter_size
+                << " stride=" << params.stride << " dilation=" << params.dilation);
+            Conv2DLayer reference_layer = Conv2DLayer({ 9, 8, 3 }, 5, params.filter_size, params.stride, params.padding, params.dilation,
+                1, ConvAlgorithm::Im2col);
+            Conv2DLayer layer = Conv2DLayer({ 9, 8, 3 }, 5, params.filter_size, params.stride, params.padding, params.dilation, 1, algorithm);
+            std::vector<uint32_t> output_shape{ layer.getOutputShape() };
+            output_shape.insert(output_shape.begin(), 2);
+            const Tensor tensor = Tensor::RandomNormal({ 2, 9, 8, 3 });
+            const Tensor tensor_d = Tensor::RandomNormal(output_shape);
+
+            const Tensor weights = Tensor::RandomNormal({ params.filter_size, params.filter_size, 3, 5 });
+            const Tensor biases = Tensor::RandomNormal({ 5 });
+            for (Conv2DLayer* l : { &reference_layer, &layer }) {
+                l->setWeights(weights.getData());
+                l->setBiases(biases.getData());
+            }
+
+            ASSERT_NO_FATAL_FAILURE(assertLayersGiveSameResults(reference_layer, layer, tensor, tensor_d));
+        }
+    }
+}
+
+TEST(Conv2DLayer_test, GroupedConv2DLayerShouldMatchConvolutionsOfGroups) {
+    const uint32_t groups{ 3 }, group_channels{ 2 }, group_filters{ 4 }, filter_size{ 3 };
+    const uint32_t channels{ groups * group_channels }, filters{ groups * group_filters };
+    Conv2DLayer layer = Conv2DLayer({ 7, 6, channels }, filters, filter_size, 2, ConvPadding::Same, 1, groups);
+    const Tensor tensor = Tensor::RandomNormal({ 2, 7, 6, channels });
+    const Tensor weights = Tensor::RandomNormal({ filter_size, filter_size, group_channels, filters });
+    const Tensor biases = Tensor::RandomNormal({ filters });
+    std::vector<uint32_t> output_shape{ layer.getOutputShape() };
+    output_shape.insert(output_shape.begin(), 2);
+    const Tensor tensor_d = Tensor::RandomNormal(output_shape);
+
+    ASSERT_EQ(filter_size * filter_size * group_channels * filters + filters, layer.getParamsCount());
+
+    layer.setWeights(weights.getData());
+    layer.setBiases(biases.getData());
+    layer.initCachedGradient();
+    const std::vector<float> forward = layer.forwardPropagation(tensor, false).getData();
+    const std::vector<float> backward = layer.backwardPropagation(tensor_d).getData();
+    layer.updateWeights(1.0f, 0.0f);
+    const std::vector<float> updated = layer.forwardPropagation(tensor).getData();
+
+    // every group is a plain convolution of its channels with its filters
+    const uint32_t pixels{ 2 * 7 * 6 };
+    const uint32_t output_pixels{ tensor_d.getSize() / filters };
+    for (uint32_t g{ 0 }; g < groups; ++g) {
+        Conv2DLayer group_layer = Conv2DLayer({ 7, 6, group_channels }, group_filters, filter_size, 2);
+        Tensor group_tensor({ 2, 7, 6, group_channels });
+        Tensor group_tensor_d({ output_shape[0], output_shape[1], output_shape[2], group_filters });
+        std::vector<float> group_values(group_tensor.getSize()), group_values_d(group_tensor_d.getSize());
+        std::vector<float> group_weights(filter_size * filter_size * group_channels * group_filters), group_biases(group_filters);
+        for (uint32_t p{ 0 }; p < pixels; ++p) {
+            for (uint32_t c{ 0 }; c < group_channels; ++c) {
+                group_values[p * group_channels + c] = tensor.getData()[p * channels + g * group_channels + c];
+            }
+        }
+        for (uint32_t p{ 0 }; p < output_pixels; ++p) {
+            for (uint32_t f{ 0 }; f < group_filters; ++f) {
+                group_values_d[p * group_filters + f] = tensor_d.getData()[p * filters + g * group_filters + f];
+            }
+        }
+        for (uint32_t t{ 0 }; t < filter_size * filter_size * group_channels; ++t) {
+            for (uint32_t f{ 0 }; f < group_filters; ++f) {
+                group_weights[t * group_filters + f] = weights.getData()[t * filters + g * group_filters + f];
+            }
+        }
+        for (uint32_t f{ 0 }; f < group_filters; ++f) {
+            group_biases[f] = biases.getData()[g * group_filters + f];
+        }
+        group_tensor.setValues(group_values);
+        group_tensor_d.setValues(group_values_d);
+        group_layer.setWeights(group_weights);
+        group_layer.setBiases(group_biases);
+        group_layer.initCachedGradient();
+
+        const std::vector<float> group_forward = group_layer.forwardPropagation(group_tensor, false).getData();
+        const std::vector<float> group_backward = group_layer.backwardPropagation(group_tensor_d).getData();
+        group_layer.updateWeights(1.0f, 0.0f);
+        const std::vector<float> group_updated = group_layer.forwardPropagation(group_tensor).getData();
+
+        for (uint32_t p{ 0 }; p < output_pixels; ++p) {
+            for (uint32_t f{ 0 }; f < group_filters; ++f) {
+                ASSERT_LE(fabs(group_forward[p * group_filters + f] - forward[p * filters + g * group_filters + f]), 1e-3f);
+                ASSERT_LE(fabs(group_updated[p * group_filters + f] - updated[p * filters + g * group_filters + f]), 1e-3f);
+            }
+        }
+        for (uint32_t p{ 0 }; p < pixels; ++p) {
+            for (uint32_t c{ 0 }; c < group_channels; ++c) {
+                ASSERT_LE(fabs(group_backward[p * group_channels + c] - backward[p * channels + g * group_channels + c]), 1e-3f);
+            }
+        }
+    }
+
+    ASSERT_THROW(Conv2DLayer({ 7, 6, 6 }, 8, 3, 1, ConvPadding::Same, 1, 4), std::invalid_argument);
+    ASSERT_THROW(Conv2DLayer({ 7, 6, 6 }, 8, 3, 1, ConvPadding::Same, 1, 0), std::invalid_argument);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "src/DenseLayer.h"
+#include "src/ActivationLayer.h"
 #include "tests/unit_tests/UnitTestsUtils.h"
 
 TEST(DenseLayer_test, DenseLayerForwardPropagationOutputShapeTest) {
@@ -66,4 +67,52 @@ TEST(DenseLayer_test, DenseLayerForwardAndBackwardPropagationReturnValuesTest) {
     ASSERT_EQ_EPS(-23.7976f,  (backward[{ 1, 0 }]));
     ASSERT_EQ_EPS( 10.71966f, (backward[{ 1, 1 }]));
     ASSERT_EQ_EPS(-27.5218f,  (backward[{ 1, 2 }]));
-}
\ No newline at end of file
+}
+TEST(DenseLayer_test, FusedDenseLayerShouldMatchDenseAndActivationLayers) {
+    const uint32_t batch_size{ 13 }, input_size{ 35 }, neurons_count{ 21 };
+    Tensor x = Tensor::RandomNormal({ batch_size, input_size });
+    Tensor dy = Tensor::RandomNormal({ batch_size, neurons_count });
+    Tensor weights = Tensor::RandomNormal({ neurons_count, input_size });
+    Tensor biases = Tensor::RandomNormal({ neurons_count });
+    std::vector<float> weights_values(weights.getDataPointer(), weights.getDataPointer() + weights.getSize());
+    std::vector<float> biases_values(biases.getDataPointer(), biases.getDataPointer() + biases.getSize());
+
+    for (auto activation_fun : { ActivationFun::ReLU, ActivationFun::LeakyReLU, ActivationFun::Sigmoid, ActivationFun::Tanh }) {
+        DenseLayer dense_layer = DenseLayer({ input_size }, neurons_count);
+        ActivationLayer activation_layer = ActivationLayer(dense_layer, activation_fun);
+        DenseLayer fused_layer = DenseLayer({ input_size }, neurons_count, activation_fun);
+
+        for (DenseLayer* layer : { &dense_layer, &fused_layer }) {
+            layer->setWeights(weights_values);
+            layer->setBiases(biases_values);
+            layer->initCachedGradient();
+        }
+
+        const Tensor expected = activation_layer.forwardPropagation(dense_layer.forwardPropagation(x, false), false);
+        const Tensor actual = fused_layer.forwardPropagation(x, false);
+        const Tensor expected_d = dense_layer.backwardPropagation(activation_layer.backwardPropagation(dy));
+        const Tensor actual_d = fused_layer.backwardPropagation(dy);
+
+        ASSERT_EQ(expected.getShape(), actual.getShape());
+        ASSERT_EQ(expected_d.getShape(), actual_d.getShape());
+        for (uint32_t i{ 0 }; i < expected.getSize(); ++i) {
+            ASSERT_EQ_EPS(expected.getDataPointer()[i], actual.getDataPointer()[i]);
+        }
+        for (uint32_t i{ 0 }; i < expected_d.getSize(); ++i) {
+            ASSERT_EQ_EPS(expected_d.getDataPointer()[i], actual_d.getDataPointer()[i]);
+        }
+
+        // gradients of weights and biases are compared through outputs after the update
+        dense_layer.updateWeights(0.1f, 0.0f);
+        fused_layer.updateWeights(0.1f, 0.0f);
+        const Tensor expected_updated = activation_layer.forwardPropagation(dense_layer.forwardPropagation(x));
+        const Tensor actual_updated = fused_layer.forwardPropagation(x);
+        for (uint32_t i{ 0 }; i < expected_updated.getSize(); ++i) {
+            ASSERT_EQ_EPS(expected_updated.getDataPointer()[i], actual_updated.getDataPointer()[i]);
+        }
+    }
+}
+
+TEST(DenseLayer_test, FusedDenseLayerShouldRejectSoftmax) {
+    ASSERT_THROW(DenseLayer({ 3 }, 2, ActivationFun::Softmax), std::invalid_argument);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "src/Conv2DLayer.h"
+#include "src/DepthwiseConv2DLayer.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(DepthwiseConv2DLayer_test, DepthwiseConv2DLayerOutputShapeTest) {
+    Tensor tensor = Tensor({ 2, 7, 8, 3 });
+    DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ 7, 8, 3 }, 3);
+    DepthwiseConv2DLayer strided_layer = DepthwiseConv2DLayer({ 7, 8, 3 }, 3, 2, ConvPadding::Valid, 1, 2);
+
+    ASSERT_EQ((std::vector<uint32_t>{ 7, 8, 3 }), layer.getOutputShape());
+    ASSERT_EQ((std::vector<uint32_t>{ 3, 3, 6 }), strided_layer.getOutputShape());
+    ASSERT_EQ(3u * 3u * 3u * 2u + 6u, strided_layer.getParamsCount());
+
+    for (DepthwiseConv2DLayer* l : { &layer, &strided_layer }) {
+        std::vector<uint32_t> expected_shape{ l->getOutputShape() };
+        expected_shape.insert(expected_shape.begin(), 2);
+
+        l->initCachedGradient();
+        const Tensor result = l->forwardPropagation(tensor, false);
+        const Tensor backward = l->backwardPropagation(Tensor(expected_shape));
+
+        ASSERT_EQ(expected_shape, result.getShape());
+        ASSERT_EQ(tensor.getShape(), backward.getShape());
+    }
+
+    ASSERT_THROW(DepthwiseConv2DLayer({ 7, 8, 3 }, 3, 1, ConvPadding::Same, 1, 0), std::invalid_argument);
+}
+
+TEST(DepthwiseConv2DLayer_test, DepthwiseConv2DLayerShouldMatchGroupedConv2DLayer) {
+    struct Params { uint32_t channels, multiplier, filter_size, stride, dilation; ConvPadding padding; };
+    for (const Params& params : { Params{ 3, 1, 3, 1, 1, ConvPadding::Same }, Params{ 18, 1, 3, 2, 1, ConvPadding::Same },
+                                  Params{ 5, 4, 3, 1, 2, ConvPadding::Same }, Params{ 4, 3, 2, 3, 1, ConvPadding::Valid },
+                                  Params{ 17, 2, 5, 1, 1, ConvPadding::Valid } }) {
+        SCOPED_TRACE(testing::Message() << "channels=" << params.channels << " multiplier=" << params.multiplier);
+        const uint32_t outputs{ params.channels * params.multiplier };
+        // weights [s, s, c, m] of depthwise convolution are weights [s, s, 1, c m] of convolution with a group per channel
+        Conv2DLayer reference_layer = Conv2DLayer({ 9, 8, params.channels }, outputs, params.filter_size, params.stride, params.padding,
+            params.dilation, params.channels);
+        DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ 9, 8, params.channels }, params.filter_size, params.stride, params.padding,
+            params.dilation, params.multiplier);
+        ASSERT_EQ(reference_layer.getOutputShape(), layer.getOutputShape());
+
+        std::vector<uint32_t> output_shape{ layer.getOutputShape() };
+        output_shape.insert(output_shape.begin(), 2);
+        const Tensor tensor = Tensor::RandomNormal({ 2, 9, 8, params.channels });
+        const Tensor tensor_d = Tensor::RandomNormal(output_shape);
+        const Tensor weights = Tensor::RandomNormal({ params.filter_size, params.filter_size, params.channels, params.multiplier });
+        const Tensor biases = Tensor::RandomNormal({ outputs });
+
+        reference_layer.setWeights(weights.getData());
+        reference_layer.setBiases(biases.getData());
+        layer.setWeights(weights.getData());
+        layer.setBiases(biases.getData());
+
+        ASSERT_NO_FATAL_FAILURE(assertLayersGiveSameResults(reference_layer, layer, tensor, tensor_d));
+    }
+}
+
+TEST(DepthwiseConv2DLayer_test, DepthwiseConv2DLayerBackwardPropagationShouldMatchNumericalGradient) {
+    const Tensor tensor = Tensor::RandomNormal({ 2, 7, 6, 3 });
+    DepthwiseConv2DLayer layer = DepthwiseConv2DLayer({ 7, 6, 3 }, 3, 2, ConvPadding::Same, 2, 2);
+    std::vector<uint32_t> output_shape{ layer.getOutputShape() };
+    output_shape.insert(output_shape.begin(), 2);
+    const Tensor tensor_d = Tensor::RandomNormal(output_shape);
+
+    ASSERT_NO_FATAL_FAILURE(assertBackwardMatchesNumericalGradient(layer, tensor, tensor_d));
+}
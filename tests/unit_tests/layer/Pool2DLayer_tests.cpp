@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "src/DenseLayer.h"
 #include "src/Pool2DLayer.h"
 #include "tests/unit_tests/UnitTestsUtils.h"
 
@@ -71,17 +72,17 @@ TEST(Pool2DLayer_test, Pool2DLayerAverageBackwardPropagation) {
     ASSERT_EQ( 1, result.getShape()[3]);
     
     ASSERT_EQ_EPS(    1.75f, (result[{ 0, 0, 0, 0 }]));
-    ASSERT_EQ_EPS(     3.5f, (result[{ 0, 0, 1, 0 }]));
-    ASSERT_EQ_EPS(    8.25f, (result[{ 0, 0, 2, 0 }]));
-    ASSERT_EQ_EPS(    11.0f, (result[{ 0, 0, 3, 0 }]));
-    ASSERT_EQ_EPS(    -2.0f, (result[{ 1, 0, 0, 0 }]));
-    ASSERT_EQ_EPS(     0.0f, (result[{ 1, 0, 1, 0 }]));
-    ASSERT_EQ_EPS(  11.875f, (result[{ 1, 0, 2, 0 }]));
-    ASSERT_EQ_EPS(    12.5f, (result[{ 1, 0, 3, 0 }]));
-    ASSERT_EQ_EPS(    20.0f, (result[{ 1, 3, 0, 0 }]));
-    ASSERT_EQ_EPS(    35.0f, (result[{ 1, 3, 1, 0 }]));
-    ASSERT_EQ_EPS(  -11.25f, (result[{ 1, 3, 2, 0 }]));
-    ASSERT_EQ_EPS(    2.25f, (result[{ 1, 3, 3, 0 }]));
+    ASSERT_EQ_EPS(    1.75f, (result[{ 0, 0, 1, 0 }]));
+    ASSERT_EQ_EPS(    2.75f, (result[{ 0, 0, 2, 0 }]));
+    ASSERT_EQ_EPS(    2.75f, (result[{ 0, 0, 3, 0 }]));
+    ASSERT_EQ_EPS(     1.0f, (result[{ 1, 0, 0, 0 }]));
+    ASSERT_EQ_EPS(     1.0f, (result[{ 1, 0, 1, 0 }]));
+    ASSERT_EQ_EPS(   0.625f, (result[{ 1, 0, 2, 0 }]));
+    ASSERT_EQ_EPS(   0.625f, (result[{ 1, 0, 3, 0 }]));
+    ASSERT_EQ_EPS(     2.5f, (result[{ 1, 3, 0, 0 }]));
+    ASSERT_EQ_EPS(     2.5f, (result[{ 1, 3, 1, 0 }]));
+    ASSERT_EQ_EPS(   -0.75f, (result[{ 1, 3, 2, 0 }]));
+    ASSERT_EQ_EPS(   -0.75f, (result[{ 1, 3, 3, 0 }]));
 }
 
 TEST(Pool2DLayer_test, Pool2DLayerMaxForwardPropagation) {
@@ -209,3 +210,187 @@ TEST(Pool2DLayer_test, Pool2DLayerMaxForwardPropagationTensorWithChannels) {
     ASSERT_EQ( 19.0f, (result[{ 1, 1, 1, 0 }]));
     ASSERT_EQ( 20.0f, (result[{ 1, 1, 1, 1 }]));
 }
+
+TEST(Pool2DLayer_test, Pool2DLayerShouldMatchNaivePoolingWithManyChannels) {
+    // 19 channels cover a full block of channels and a partial one, the input has two leading batch dimensions
+    const uint32_t channels{ 19 }, pool_size{ 3 };
+    const Tensor tensor = Tensor::RandomNormal({ 2, 3, 6, 9, channels });
+    const Tensor tensor_d = Tensor::RandomNormal({ 2, 3, 2, 3, channels });
+
+    for (PoolMode mode : { PoolMode::Max, PoolMode::Average }) {
+        Pool2DLayer layer = Pool2DLayer({ 6, 9, channels }, pool_size, mode);
+        const Tensor result = layer.forwardPropagation(tensor, false);
+        const Tensor backward = layer.backwardPropagation(tensor_d);
+        ASSERT_EQ((std::vector<uint32_t>{ 2, 3, 2, 3, channels }), result.getShape());
+        ASSERT_EQ(tensor.getShape(), backward.getShape());
+
+        const std::vector<float> x = tensor.getData();
+        const std::vector<float> dy = tensor_d.getData();
+        const std::vector<float> y = result.getData();
+        const std::vector<float> inference_y = layer.forwardPropagation(tensor).getData();
+        std::vector<float> expected_dx(x.size(), 0.0f);
+        for (uint32_t i{ 0 }; i < 6; ++i) {
+            for (uint32_t oy{ 0 }; oy < 2; ++oy) {
+                for (uint32_t ox{ 0 }; ox < 3; ++ox) {
+                    for (uint32_t c{ 0 }; c < channels; ++c) {
+                        const uint32_t out{ ((i * 2 + oy) * 3 + ox) * channels + c };
+                        float expected{ (PoolMode::Max == mode) ? -INFINITY : 0.0f };
+                        uint32_t argmax{ 0 };
+                        for (uint32_t a{ 0 }; a < pool_size; ++a) {
+                            for (uint32_t b{ 0 }; b < pool_size; ++b) {
+                                const uint32_t in{ ((i * 6 + oy * pool_size + a) * 9 + ox * pool_size + b) * channels + c };
+                                if (PoolMode::Average == mode) {
+                                    expected += x[in] / (pool_size * pool_size);
+                                    expected_dx[in] = dy[out] / (pool_size * pool_size);
+                                }
+                                else if (x[in] > expected) {
+                                    expected = x[in];
+                                    argmax = in;
+                                }
+                            }
+                        }
+                        if (PoolMode::Max == mode) {
+                            expected_dx[argmax] = dy[out];
+                        }
+                        ASSERT_EQ_EPS(expected, y[out]);
+                        ASSERT_EQ_EPS(expected, inference_y[out]);
+                    }
+                }
+            }
+        }
+
+        const std::vector<float> dx = backward.getData();
+        for (uint32_t i{ 0 }; i < dx.size(); ++i) {
+            ASSERT_EQ_EPS(expected_dx[i], dx[i]);
+        }
+    }
+}
+
+TEST(Pool2DLayer_test, OverlappingPool2DLayerShouldMatchNaivePooling) {
+    struct Params { uint32_t pool_size, stride; ConvPadding padding; };
+    const uint32_t channels{ 5 };
+    const Tensor tensor = Tensor::RandomNormal({ 2, 7, 6, channels });
+
+    for (PoolMode mode : { PoolMode::Max, PoolMode::Average }) {
+        for (const Params& params : { Params{ 3, 2, ConvPadding::Same }, Params{ 3, 2, ConvPadding::Valid },
+                                      Params{ 3, 1, ConvPadding::Same }, Params{ 2, 3, ConvPadding::Valid } }) {
+            Pool2DLayer layer = Pool2DLayer({ 7, 6, channels }, params.pool_size, mode, params.stride, params.padding);
+            const Conv2DGeometry geometry(7, 6, params.pool_size, params.stride, 1, params.padding);
+            ASSERT_EQ((std::vector<uint32_t>{ geometry.output_height, geometry.output_width, channels }), layer.getOutputShape());
+
+            const Tensor tensor_d = Tensor::RandomNormal({ 2, geometry.output_height, geometry.output_width, channels });
+            const std::vector<float> y = layer.forwardPropagation(tensor, false).getData();
+            const std::vector<float> dx = layer.backwardPropagation(tensor_d).getData();
+            const std::vector<float> x = tensor.getData();
+            const std::vector<float> dy = tensor_d.getData();
+
+            // windows overlap, so gradients of all windows containing a pixel are summed, padding is not pooled
+            std::vector<float> expected_dx(x.size(), 0.0f);
+            for (uint32_t i{ 0 }; i < 2; ++i) {
+                for (uint32_t oy{ 0 }; oy < geometry.output_height; ++oy) {
+                    for (uint32_t ox{ 0 }; ox < geometry.output_width; ++ox) {
+                        for (uint32_t c{ 0 }; c < channels; ++c) {
+                            const uint32_t out{ ((i * geometry.output_height + oy) * geometry.output_width + ox) * channels + c };
+                            std::vector<uint32_t> window;
+                            for (uint32_t a{ 0 }; a < params.pool_size; ++a) {
+                                for (uint32_t b{ 0 }; b < params.pool_size; ++b) {
+                                    const int32_t y_in{ static_cast<int32_t>(oy * params.stride + a) - static_cast<int32_t>(geometry.padding_top) };
+                                    const int32_t x_in{ static_cast<int32_t>(ox * params.stride + b) - static_cast<int32_t>(geometry.padding_left) };
+                                    if ((y_in >= 0) && (y_in < 7) && (x_in >= 0) && (x_in < 6)) {
+                                        window.push_back(((i * 7 + y_in) * 6 + x_in) * channels + c);
+                                    }
+                                }
+                            }
+                            ASSERT_LT(0u, window.size());
+
+                            float expected{ (PoolMode::Max == mode) ? -INFINITY : 0.0f };
+                            uint32_t argmax{ window[0] };
+                            for (uint32_t in : window) {
+                                if (PoolMode::Average == mode) {
+                                    expected += x[in] / window.size();
+                                    expected_dx[in] += dy[out] / window.size();
+                                }
+                                else if (x[in] > expected) {
+                                    expected = x[in];
+                                    argmax = in;
+                                }
+                            }
+                            if (PoolMode::Max == mode) {
+                                expected_dx[argmax] += dy[out];
+                            }
+                            ASSERT_EQ_EPS(expected, y[out]);
+                        }
+                    }
+                }
+            }
+
+            for (uint32_t i{ 0 }; i < dx.size(); ++i) {
+                ASSERT_EQ_EPS(expected_dx[i], dx[i]);
+            }
+        }
+    }
+}
+
+TEST(Pool2DLayer_test, GlobalPool2DLayerShouldReduceEveryChannel) {
+    const uint32_t channels{ 19 };
+    const Tensor tensor = Tensor::RandomNormal({ 3, 5, 4, channels });
+    const Tensor tensor_d = Tensor::RandomNormal({ 3, channels });
+
+    for (PoolMode mode : { PoolMode::Max, PoolMode::Average }) {
+        Pool2DLayer layer = Pool2DLayer({ 5, 4, channels }, mode);
+        DenseLayer dense_layer = DenseLayer(layer, 10);
+        ASSERT_EQ((std::vector<uint32_t>{ channels }), layer.getOutputShape());
+        ASSERT_EQ(0u, layer.getParamsCount());
+
+        const Tensor result = layer.forwardPropagation(tensor, false);
+        ASSERT_EQ((std::vector<uint32_t>{ 3, channels }), result.getShape());
+        ASSERT_EQ((std::vector<uint32_t>{ 3, 10 }), dense_layer.forwardPropagation(result).getShape());
+        const std::vector<float> y = result.getData();
+        const std::vector<float> dx = layer.backwardPropagation(tensor_d).getData();
+        const std::vector<float> x = tensor.getData();
+        const std::vector<float> dy = tensor_d.getData();
+
+        std::vector<float> expected_dx(x.size(), 0.0f);
+        for (uint32_t i{ 0 }; i < 3; ++i) {
+            for (uint32_t c{ 0 }; c < channels; ++c) {
+                float expected{ (PoolMode::Max == mode) ? -INFINITY : 0.0f };
+                uint32_t argmax{ 0 };
+                for (uint32_t p{ 0 }; p < 20; ++p) {
+                    const uint32_t in{ (i * 20 + p) * channels + c };
+                    if (PoolMode::Average == mode) {
+                        expected += x[in] / 20.0f;
+                        expected_dx[in] = dy[i * channels + c] / 20.0f;
+                    }
+                    else if (x[in] > expected) {
+                        expected = x[in];
+                        argmax = in;
+                    }
+                }
+                if (PoolMode::Max == mode) {
+                    expected_dx[argmax] = dy[i * channels + c];
+                }
+                ASSERT_EQ_EPS(expected, y[i * channels + c]);
+            }
+        }
+
+        for (uint32_t i{ 0 }; i < dx.size(); ++i) {
+            ASSERT_EQ_EPS(expected_dx[i], dx[i]);
+        }
+    }
+}
+
+TEST(Pool2DLayer_test, WhenGradientShapeDoesNotMatchOutputBackwardShouldThrow) {
+    Pool2DLayer layer = Pool2DLayer({ 4, 4, 3 }, 2, PoolMode::Max);
+    Pool2DLayer global_layer = Pool2DLayer({ 4, 4, 3 }, PoolMode::Max);
+
+    ASSERT_THROW(layer.backwardPropagation(Tensor({ 2, 2, 2, 3 })), std::invalid_argument);
+
+    layer.forwardPropagation(Tensor::RandomNormal({ 2, 4, 4, 3 }), false);
+    global_layer.forwardPropagation(Tensor::RandomNormal({ 2, 4, 4, 3 }), false);
+
+    ASSERT_NO_THROW(layer.backwardPropagation(Tensor({ 2, 2, 2, 3 })));
+    ASSERT_THROW(layer.backwardPropagation(Tensor({ 3, 2, 2, 3 })), std::invalid_argument);
+    ASSERT_THROW(layer.backwardPropagation(Tensor({ 2, 4, 4, 3 })), std::invalid_argument);
+    ASSERT_NO_THROW(global_layer.backwardPropagation(Tensor({ 2, 3 })));
+    ASSERT_THROW(global_layer.backwardPropagation(Tensor({ 2, 2, 2, 3 })), std::invalid_argument);
+}
@@ -33,6 +33,89 @@ TEST(NeuralNetwork_test, BinaryCrossentropyTest) {
     ASSERT_EQ_EPS(-0.59185f, (result_d[{ 1, 1 }]));
 }
 
+TEST(NeuralNetwork_test, SoftmaxCategoricalCrossentropyShouldMatchSoftmaxFollowedByCategoricalCrossentropy) {
+    const uint32_t batch_size{ 5 }, classes{ 1003 };
+    Tensor logits = Tensor::RandomNormal({ batch_size, classes });
+    Tensor y = Tensor({ batch_size, classes });
+    for (uint32_t i{ 0 }; i < batch_size; ++i) {
+        y[{ i, (i * 211) % classes }] = 1.0f;
+    }
+
+    ActivationLayer softmax_layer = ActivationLayer({ classes }, ActivationFun::Softmax);
+    const Tensor y_hat = softmax_layer.forwardPropagation(logits);
+
+    const float expected = NeuralNetwork::categorical_crossentropy(y_hat, y);
+    const float actual = NeuralNetwork::softmax_categorical_crossentropy(logits, y);
+    const Tensor actual_d = NeuralNetwork::softmax_categorical_crossentropy_d(logits, y);
+
+    ASSERT_EQ_EPS(expected, actual);
+    ASSERT_EQ(logits.getShape(), actual_d.getShape());
+    for (uint32_t i{ 0 }; i < batch_size; ++i) {
+        for (uint32_t j{ 0 }; j < classes; ++j) {
+            ASSERT_EQ_EPS((y_hat[{ i, j }] - const_cast<const Tensor&>(y)[{ i, j }]), (actual_d[{ i, j }]));
+        }
+    }
+}
+
+TEST(NeuralNetwork_test, SoftmaxCategoricalCrossentropyShouldBeFiniteForLargeLogits) {
+    Tensor logits = Tensor({ 1, 3 });
+    Tensor y = Tensor({ 1, 3 });
+
+    logits.setValues({ 1000.0f, 0.0f, -1000.0f });
+    y.setValues({ 0.0f, 1.0f, 0.0f });
+
+    const float result = NeuralNetwork::softmax_categorical_crossentropy(logits, y);
+    const Tensor result_d = NeuralNetwork::softmax_categorical_crossentropy_d(logits, y);
+
+    ASSERT_EQ_EPS(1000.0f, result);
+    ASSERT_EQ_EPS(1.0f,  (result_d[{ 0, 0 }]));
+    ASSERT_EQ_EPS(-1.0f, (result_d[{ 0, 1 }]));
+    ASSERT_EQ_EPS(0.0f,  (result_d[{ 0, 2 }]));
+}
+
+TEST(NeuralNetwork_test, SigmoidBinaryCrossentropyShouldMatchSigmoidFollowedByBinaryCrossentropy) {
+    const uint32_t batch_size{ 7 }, outputs{ 1001 };
+    Tensor logits = Tensor::RandomNormal({ batch_size, outputs });
+    Tensor y = Tensor({ batch_size, outputs });
+    for (uint32_t i{ 0 }; i < batch_size; ++i) {
+        for (uint32_t j{ i % 3 }; j < outputs; j += 3) {
+            y[{ i, j }] = 1.0f;
+        }
+    }
+
+    ActivationLayer sigmoid_layer = ActivationLayer({ outputs }, ActivationFun::Sigmoid);
+    const Tensor y_hat = sigmoid_layer.forwardPropagation(logits);
+
+    const float expected = NeuralNetwork::binary_crossentropy(y_hat, y);
+    const float actual = NeuralNetwork::sigmoid_binary_crossentropy(logits, y);
+    const Tensor actual_d = NeuralNetwork::sigmoid_binary_crossentropy_d(logits, y);
+
+    ASSERT_EQ_EPS(expected, actual);
+    ASSERT_EQ(logits.getShape(), actual_d.getShape());
+    for (uint32_t i{ 0 }; i < batch_size; ++i) {
+        for (uint32_t j{ 0 }; j < outputs; ++j) {
+            ASSERT_EQ_EPS((y_hat[{ i, j }] - const_cast<const Tensor&>(y)[{ i, j }]), (actual_d[{ i, j }]));
+        }
+    }
+}
+
+TEST(NeuralNetwork_test, SigmoidBinaryCrossentropyShouldBeFiniteForLargeLogits) {
+    Tensor logits = Tensor({ 1, 4 });
+    Tensor y = Tensor({ 1, 4 });
+
+    logits.setValues({ 1000.0f, -1000.0f, 200.0f, -200.0f });
+    y.setValues({ 0.0f, 1.0f, 1.0f, 0.0f });
+
+    const float result = NeuralNetwork::sigmoid_binary_crossentropy(logits, y);
+    const Tensor result_d = NeuralNetwork::sigmoid_binary_crossentropy_d(logits, y);
+
+    ASSERT_EQ_EPS(500.0f, result);
+    ASSERT_EQ_EPS(1.0f,  (result_d[{ 0, 0 }]));
+    ASSERT_EQ_EPS(-1.0f, (result_d[{ 0, 1 }]));
+    ASSERT_EQ_EPS(0.0f,  (result_d[{ 0, 2 }]));
+    ASSERT_EQ_EPS(0.0f,  (result_d[{ 0, 3 }]));
+}
+
 TEST(NeuralNetwork_test, PredictShouldReturnTensor) {
     Tensor tensor = Tensor({ 2, 2 });
     const Tensor (*activation_fun)(const Tensor & x) = [](const Tensor& x) -> const Tensor { return x * x; };
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <tuple>
+#include "src/Gemm.h"
+#include "src/TensorKernels.h"
+#include "src/Utils.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+static std::vector<float> randomMatrix(uint32_t rows, uint32_t cols) {
+    std::vector<float> result(rows * cols);
+    for (auto& value : result) {
+        value = randUniform(-1.0f, 1.0f);
+    }
+    return result;
+}
+
+/**
+ * c = a * b with a given by [m, k] row-major matrix and b given by strides.
+ */
+static std::vector<float> referenceGemm(uint32_t m, uint32_t n, uint32_t k,
+    const std::vector<float>& a, const std::vector<float>& b, uint32_t b_row_stride, uint32_t b_col_stride) {
+    std::vector<float> result(m * n, 0.0f);
+    for (uint32_t i{ 0 }; i < m; ++i) {
+        for (uint32_t j{ 0 }; j < n; ++j) {
+            for (uint32_t p{ 0 }; p < k; ++p) {
+                result[i * n + j] += a[i * k + p] * b[p * b_row_stride + j * b_col_stride];
+            }
+        }
+    }
+    return result;
+}
+
+TEST(Gemm_test, ShouldMatchReferenceForAllKernels) {
+    const KernelsType active_type{ getKernels().type };
+
+    for (auto type : { KernelsType::Scalar, KernelsType::Sse, KernelsType::Avx2, KernelsType::Avx512 }) {
+        if (!setKernels(type)) {
+            continue;
+        }
+        // sizes not divisible by tile sizes, k larger than the k block and size large enough to be split between threads
+        for (auto [m, n, k] : { std::tuple{ 1u, 1u, 1u }, std::tuple{ 7u, 13u, 5u }, std::tuple{ 33u, 40u, 300u }, std::tuple{ 200u, 17u, 64u }, std::tuple{ 500u, 150u, 70u } }) {
+            std::vector<float> a = randomMatrix(m, k);
+            std::vector<float> b = randomMatrix(k, n);
+            std::vector<float> expected = referenceGemm(m, n, k, a, b, n, 1);
+            std::vector<float> actual(m * n, 1.0f);
+
+            gemm(m, n, k, a.data(), k, 1, b.data(), n, 1, actual.data(), n);
+
+            for (uint32_t i{ 0 }; i < m * n; ++i) {
+                ASSERT_LE(fabs(expected[i] - actual[i]), EPSILON) << getKernels().name << " m=" << m << " n=" << n << " k=" << k;
+            }
+        }
+    }
+
+    ASSERT_TRUE(setKernels(active_type));
+}
+
+TEST(Gemm_test, ShouldMultiplyByTransposedOperand) {
+    const uint32_t m{ 19 }, n{ 23 }, k{ 41 };
+    std::vector<float> a = randomMatrix(m, k);
+    // b is stored as [n, k] matrix, so b^T is used
+    std::vector<float> b = randomMatrix(n, k);
+    std::vector<float> expected = referenceGemm(m, n, k, a, b, 1, k);
+    std::vector<float> actual(m * n);
+
+    gemm(m, n, k, a.data(), k, 1, b.data(), 1, k, actual.data(), n);
+
+    for (uint32_t i{ 0 }; i < m * n; ++i) {
+        ASSERT_EQ_EPS(expected[i], actual[i]);
+    }
+}
+
+TEST(Gemm_test, ShouldAccumulate) {
+    const uint32_t m{ 9 }, n{ 10 }, k{ 11 };
+    std::vector<float> a = randomMatrix(m, k);
+    std::vector<float> b = randomMatrix(k, n);
+    std::vector<float> expected = referenceGemm(m, n, k, a, b, n, 1);
+    std::vector<float> actual(m * n, 2.0f);
+
+    gemm(m, n, k, a.data(), k, 1, b.data(), n, 1, actual.data(), n, true);
+
+    for (uint32_t i{ 0 }; i < m * n; ++i) {
+        ASSERT_EQ_EPS(expected[i] + 2.0f, actual[i]);
+    }
+}
+
+TEST(Gemm_test, EpilogueShouldAddBiasesAndApplyActivation) {
+    // k larger than the k block, so the epilogue must be applied only after the last block
+    const uint32_t m{ 37 }, n{ 29 }, k{ 300 };
+    std::vector<float> a = randomMatrix(m, k);
+    std::vector<float> b = randomMatrix(k, n);
+    std::vector<float> bias = randomMatrix(1, n);
+    std::vector<float> product = referenceGemm(m, n, k, a, b, n, 1);
+
+    for (auto activation : { GemmActivation::None, GemmActivation::ReLU, GemmActivation::LeakyReLU, GemmActivation::Sigmoid, GemmActivation::Tanh }) {
+        std::vector<float> actual(m * n);
+        const GemmEpilogue epilogue{ bias.data(), activation };
+
+        gemm(m, n, k, a.data(), k, 1, b.data(), n, 1, actual.data(), n, false, &epilogue);
+
+        for (uint32_t i{ 0 }; i < m; ++i) {
+            for (uint32_t j{ 0 }; j < n; ++j) {
+                const float z{ product[i * n + j] + bias[j] };
+                float expected{ z };
+                switch (activation) {
+                case GemmActivation::ReLU: expected = z > 0.0f ? z : 0.0f; break;
+                case GemmActivation::LeakyReLU: expected = z > 0.0f ? z : 0.1f * z; break;
+                case GemmActivation::Sigmoid: expected = 1.0f / (1.0f + expf(-z)); break;
+                case GemmActivation::Tanh: expected = tanhf(z); break;
+                default: break;
+                }
+                ASSERT_EQ_EPS(expected, actual[i * n + j]);
+            }
+        }
+    }
+}
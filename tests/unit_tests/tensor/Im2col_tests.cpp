@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "src/Im2col.h"
+#include "src/Tensor.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(Im2col_test, Im2colShouldMatchPaddedPatches) {
+    const uint32_t batch_size{ 2 }, height{ 4 }, width{ 5 }, channels{ 3 }, filter_size{ 3 };
+    const Tensor x = Tensor::RandomNormal({ batch_size, height, width, channels });
+    const Tensor x_pad = x.addPadding({ 1, 2 }, { Both, Both }, { 1, 1 });
+    Tensor rects({ batch_size * height * width, filter_size * filter_size * channels });
+
+    im2col(x.getDataPointer(), batch_size, channels, Conv2DGeometry(height, width, filter_size), rects.getDataPointer());
+
+    for (uint32_t i{ 0 }; i < batch_size; ++i) {
+        for (uint32_t y{ 0 }; y < height; ++y) {
+            for (uint32_t x_pos{ 0 }; x_pos < width; ++x_pos) {
+                const uint32_t row{ (i * height + y) * width + x_pos };
+                const Tensor expected = x_pad[Tensor::Range{ { i, i + 1 }, { y, y + filter_size }, { x_pos, x_pos + filter_size } }];
+                const Tensor actual = const_cast<const Tensor&>(rects)[Tensor::Range{ { row, row + 1 } }];
+                ASSERT_EQ(expected.getData(), actual.getData()) << "i=" << i << " y=" << y << " x=" << x_pos;
+            }
+        }
+    }
+}
+
+TEST(Im2col_test, Col2imShouldBeTransposeOfIm2col) {
+    const uint32_t batch_size{ 2 }, height{ 6 }, width{ 3 }, channels{ 2 }, filter_size{ 5 };
+    const Tensor x = Tensor::RandomNormal({ batch_size, height, width, channels });
+    const Tensor r = Tensor::RandomNormal({ batch_size * height * width, filter_size * filter_size * channels });
+    Tensor rects({ batch_size * height * width, filter_size * filter_size * channels });
+    Tensor folded({ batch_size, height, width, channels });
+
+    im2col(x.getDataPointer(), batch_size, channels, Conv2DGeometry(height, width, filter_size), rects.getDataPointer());
+    col2im(r.getDataPointer(), batch_size, channels, Conv2DGeometry(height, width, filter_size), folded.getDataPointer());
+
+    // <im2col(x), r> = <x, col2im(r)>
+    ASSERT_LE(fabs((rects * r).sum() - (x * folded).sum()), EPSILON * 10);
+}
+
+TEST(Im2col_test, Im2colShouldMatchStridedAndDilatedPatches) {
+    const uint32_t batch_size{ 2 }, height{ 7 }, width{ 6 }, channels{ 2 }, filter_size{ 3 };
+    const Tensor x = Tensor::RandomNormal({ batch_size, height, width, channels });
+
+    for (const Conv2DGeometry& geometry : { Conv2DGeometry(height, width, filter_size, 2, 1, ConvPadding::Same),
+                                            Conv2DGeometry(height, width, filter_size, 1, 2, ConvPadding::Same),
+                                            Conv2DGeometry(height, width, filter_size, 2, 2, ConvPadding::Valid),
+                                            Conv2DGeometry(height, width, filter_size, 3, 1, ConvPadding::Valid) }) {
+        const uint32_t rect_size{ filter_size * filter_size * channels };
+        Tensor rects({ batch_size * geometry.output_height * geometry.output_width, rect_size });
+        im2col(x.getDataPointer(), batch_size, channels, geometry, rects.getDataPointer());
+
+        const std::vector<float> values = x.getData();
+        const std::vector<float> patches = rects.getData();
+        for (uint32_t row{ 0 }; row < batch_size * geometry.output_height * geometry.output_width; ++row) {
+            const uint32_t i{ row / (geometry.output_height * geometry.output_width) };
+            const uint32_t y{ row / geometry.output_width % geometry.output_height };
+            const uint32_t x_pos{ row % geometry.output_width };
+            for (uint32_t t{ 0 }; t < rect_size; ++t) {
+                const int32_t y_in = y * geometry.stride + t / (filter_size * channels) * geometry.dilation - geometry.padding_top;
+                const int32_t x_in = x_pos * geometry.stride + t / channels % filter_size * geometry.dilation - geometry.padding_left;
+                const bool inside = (y_in >= 0) && (y_in < static_cast<int32_t>(height)) && (x_in >= 0) && (x_in < static_cast<int32_t>(width));
+                const float expected = inside ? values[((i * height + y_in) * width + x_in) * channels + t % channels] : 0.0f;
+                ASSERT_EQ(expected, patches[row * rect_size + t])
+                    << "stride=" << geometry.stride << " dilation=" << geometry.dilation << " row=" << row << " tap=" << t;
+            }
+        }
+    }
+}
+
+TEST(Im2col_test, Col2imShouldBeTransposeOfStridedAndDilatedIm2col) {
+    const uint32_t batch_size{ 2 }, height{ 8 }, width{ 5 }, channels{ 3 }, filter_size{ 2 };
+    const Tensor x = Tensor::RandomNormal({ batch_size, height, width, channels });
+
+    for (const Conv2DGeometry& geometry : { Conv2DGeometry(height, width, filter_size, 2, 1, ConvPadding::Same),
+                                            Conv2DGeometry(height, width, filter_size, 2, 3, ConvPadding::Same),
+                                            Conv2DGeometry(height, width, filter_size, 3, 2, ConvPadding::Valid) }) {
+        const uint32_t rows{ batch_size * geometry.output_height * geometry.output_width };
+        const Tensor r = Tensor::RandomNormal({ rows, filter_size * filter_size * channels });
+        Tensor rects({ rows, filter_size * filter_size * channels });
+        Tensor folded({ batch_size, height, width, channels });
+
+        im2col(x.getDataPointer(), batch_size, channels, geometry, rects.getDataPointer());
+        col2im(r.getDataPointer(), batch_size, channels, geometry, folded.getDataPointer());
+
+        ASSERT_LE(fabs((rects * r).sum() - (x * folded).sum()), EPSILON * 10)
+            << "stride=" << geometry.stride << " dilation=" << geometry.dilation;
+    }
+}
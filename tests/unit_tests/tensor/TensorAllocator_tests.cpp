@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include "src/DenseLayer.h"
+#include "src/Tensor.h"
+#include "src/TensorAllocator.h"
+#include "src/ThreadPool.h"
+
+TEST(TensorAllocator_test, AllocatedBlocksShouldBeAligned) {
+    PoolTensorAllocator pool_allocator;
+    AlignedTensorAllocator aligned_allocator;
+
+    for (TensorAllocator* allocator : { static_cast<TensorAllocator*>(&pool_allocator), static_cast<TensorAllocator*>(&aligned_allocator) }) {
+        for (size_t bytes : { 1u, 4u, 100u, 4096u, 123457u }) {
+            void* ptr = allocator->allocate(bytes);
+            ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % TENSOR_ALIGNMENT) << "bytes=" << bytes;
+            allocator->deallocate(ptr, bytes);
+        }
+    }
+}
+
+TEST(TensorAllocator_test, SizeClassShouldFitRequestWithLimitedWaste) {
+    for (size_t bytes{ 1 }; bytes < (1 << 20); bytes = bytes * 3 / 2 + 1) {
+        const size_t size = PoolTensorAllocator::sizeClass(bytes);
+        ASSERT_GE(size, bytes);
+        ASSERT_EQ(0u, size % TENSOR_ALIGNMENT);
+        ASSERT_TRUE((size <= TENSOR_ALIGNMENT) || (size - bytes < bytes / 3 + TENSOR_ALIGNMENT)) << "bytes=" << bytes << " size=" << size;
+    }
+}
+
+TEST(TensorAllocator_test, FreedBlockShouldBeReused) {
+    PoolTensorAllocator allocator;
+
+    void* first = allocator.allocate(1000);
+    allocator.deallocate(first, 1000);
+    ASSERT_EQ(PoolTensorAllocator::sizeClass(1000), allocator.getCachedBytes());
+
+    // same size class
+    void* second = allocator.allocate(990);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(0u, allocator.getCachedBytes());
+    allocator.deallocate(second, 990);
+
+    allocator.releaseCached();
+    ASSERT_EQ(0u, allocator.getCachedBytes());
+}
+
+TEST(TensorAllocator_test, BlocksAboveCacheLimitShouldBeReleased) {
+    PoolTensorAllocator allocator(1024);
+
+    void* first = allocator.allocate(1024);
+    void* second = allocator.allocate(1024);
+    allocator.deallocate(first, 1024);
+    allocator.deallocate(second, 1024);
+
+    ASSERT_EQ(1024u, allocator.getCachedBytes());
+}
+
+TEST(TensorAllocator_test, ShouldCountLiveAndPeakBytes) {
+    PoolTensorAllocator allocator;
+
+    void* first = allocator.allocate(100);
+    void* second = allocator.allocate(200);
+    ASSERT_EQ(300u, allocator.getLiveBytes());
+    allocator.deallocate(first, 100);
+    ASSERT_EQ(200u, allocator.getLiveBytes());
+    ASSERT_EQ(300u, allocator.getPeakBytes());
+
+    allocator.resetPeakBytes();
+    ASSERT_EQ(200u, allocator.getPeakBytes());
+    allocator.deallocate(second, 200);
+    ASSERT_EQ(0u, allocator.getLiveBytes());
+}
+
+TEST(TensorAllocator_test, TensorsShouldUseActiveAllocator) {
+    PoolTensorAllocator allocator;
+
+    {
+        TensorAllocatorScope scope(allocator);
+        Tensor a({ 10, 10 });
+        ASSERT_EQ(400u, allocator.getLiveBytes());
+        Tensor b = a + 1.0f;
+        ASSERT_EQ(800u, allocator.getLiveBytes());
+    }
+    ASSERT_EQ(0u, allocator.getLiveBytes());
+    ASSERT_EQ(800u, allocator.getPeakBytes());
+}
+
+TEST(TensorAllocator_test, ArenaShouldReuseMemoryAfterReset) {
+    ArenaTensorAllocator allocator(4096);
+
+    void* first = allocator.allocate(100);
+    void* second = allocator.allocate(100);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(second) % TENSOR_ALIGNMENT);
+    ASSERT_NE(first, second);
+    allocator.deallocate(first, 100);
+    allocator.deallocate(second, 100);
+    ASSERT_EQ(0u, allocator.getLiveBytes());
+
+    allocator.reset();
+    ASSERT_EQ(first, allocator.allocate(100));
+}
+
+TEST(TensorAllocator_test, ArenaShouldMergeChunksOnReset) {
+    ArenaTensorAllocator allocator(1024);
+
+    for (uint32_t i{ 0 }; i < 10; ++i) {
+        allocator.allocate(1000);
+    }
+    const size_t capacity = allocator.getCapacity();
+    ASSERT_GE(capacity, 10000u);
+
+    allocator.reset();
+    ASSERT_EQ(capacity, allocator.getCapacity());
+    void* first = allocator.allocate(1000);
+    for (uint32_t i{ 1 }; i < 10; ++i) {
+        // whole step fits in the merged chunk
+        ASSERT_EQ(static_cast<char*>(first) + i * 1024, allocator.allocate(1000));
+    }
+}
+
+TEST(TensorAllocator_test, ScopeShouldRestorePreviousAllocator) {
+    TensorAllocator& default_allocator = getTensorAllocator();
+    ArenaTensorAllocator allocator;
+
+    {
+        TensorAllocatorScope scope(allocator);
+        ASSERT_EQ(&allocator, &getTensorAllocator());
+
+        Tensor a({ 16 });
+        ASSERT_EQ(64u, allocator.getLiveBytes());
+    }
+
+    ASSERT_EQ(&default_allocator, &getTensorAllocator());
+}
+
+TEST(TensorAllocator_test, ScopeShouldOnlyAffectCallingThread) {
+    ArenaTensorAllocator allocator;
+    TensorAllocatorScope scope(allocator);
+    TensorAllocator* other_thread_allocator{ nullptr };
+
+    std::thread other_thread([&]() { other_thread_allocator = &getTensorAllocator(); });
+    other_thread.join();
+
+    ASSERT_EQ(&getDefaultTensorAllocator(), other_thread_allocator);
+    ASSERT_EQ(&allocator, &getTensorAllocator());
+}
+
+TEST(TensorAllocator_test, PoolTasksShouldUseAllocatorOfCallingThread) {
+    ThreadPool pool(4);
+    ArenaTensorAllocator allocator;
+    std::vector<TensorAllocator*> task_allocators(64, nullptr);
+
+    {
+        TensorAllocatorScope scope(allocator);
+        pool.parallelFor(task_allocators.size(), [&](uint32_t i) { task_allocators[i] = &getTensorAllocator(); });
+    }
+    pool.parallelFor(task_allocators.size(), [&](uint32_t i) {
+        ASSERT_EQ(&allocator, task_allocators[i]) << "task " << i;
+        task_allocators[i] = &getTensorAllocator();
+    });
+
+    for (auto task_allocator : task_allocators) {
+        ASSERT_EQ(&getDefaultTensorAllocator(), task_allocator);
+    }
+}
+
+TEST(TensorAllocator_test, TensorMovedInArenaScopeShouldKeepItsAllocator) {
+    ArenaTensorAllocator allocator;
+    Tensor member({ 16 });
+
+    {
+        TensorAllocatorScope scope(allocator);
+        member = Tensor({ 32 });
+        member[{ 31 }] = 1.0f;
+    }
+
+    ASSERT_EQ(0u, allocator.getLiveBytes());
+    allocator.reset();
+    {
+        TensorAllocatorScope scope(allocator);
+        Tensor garbage({ 32 });
+        garbage += 5.0f;
+        ASSERT_EQ(1.0f, (const_cast<const Tensor&>(member)[{ 31 }]));
+    }
+}
+
+TEST(TensorAllocator_test, MoveConstructedTensorShouldTakeBufferWithItsAllocator) {
+    ArenaTensorAllocator allocator;
+    std::optional<Tensor> source;
+
+    {
+        TensorAllocatorScope scope(allocator);
+        source.emplace(std::vector<uint32_t>{ 16 });
+    }
+    const float* buffer = source->getDataPointer();
+    const size_t default_live_bytes = getDefaultTensorAllocator().getLiveBytes();
+    const Tensor moved(std::move(*source));
+
+    // moved outside of the arena scope without copying values to the default allocator
+    ASSERT_EQ(buffer, moved.getDataPointer());
+    ASSERT_EQ(64u, allocator.getLiveBytes());
+    ASSERT_EQ(default_live_bytes, getDefaultTensorAllocator().getLiveBytes());
+}
+
+TEST(TensorAllocator_test, ArenaScopeShouldLeaveNoLayerMemberInArena) {
+    ArenaTensorAllocator allocator;
+    DenseLayer layer({ 8 }, 4, ActivationFun::ReLU);
+
+    {
+        TensorAllocatorScope scope(allocator);
+        layer.initCachedGradient();
+        const Tensor x = Tensor::RandomNormal({ 2, 8 });
+        const Tensor y = layer.forwardPropagation(x, false);
+        const Tensor dx = layer.backwardPropagation(y);
+    }
+    layer.updateWeights(0.1f, 0.5f);
+
+    ASSERT_EQ(0u, allocator.getLiveBytes());
+}
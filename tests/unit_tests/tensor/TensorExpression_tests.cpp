@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "src/Tensor.h"
+#include "src/TensorExpression.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+static void assertTensorsEqual(const Tensor& expected, const Tensor& actual) {
+    ASSERT_EQ(expected.getShape(), actual.getShape());
+    std::vector<float> expected_data = expected.getData();
+    std::vector<float> actual_data = actual.getData();
+    for (uint32_t i{ 0 }; i < expected_data.size(); ++i) {
+        ASSERT_LE(fabs(expected_data[i] - actual_data[i]), EPSILON * std::max(1.0f, std::fabs(expected_data[i]))) << "index " << i;
+    }
+}
+
+TEST(TensorExpression_test, WhenEvaluatedShouldMatchTensorOperators) {
+    // size not divisible by expression block size
+    const Tensor a = Tensor::RandomNormal({ 3, 131 });
+    const Tensor b = Tensor::RandomNormal({ 3, 131 });
+    const Tensor c = Tensor::RandomNormal({ 3, 131 }) + 5.0f;
+
+    assertTensorsEqual(a + b, lazy(a) + lazy(b));
+    assertTensorsEqual(a - b, lazy(a) - b);
+    assertTensorsEqual(a * b, a * lazy(b));
+    assertTensorsEqual(a / c, lazy(a) / lazy(c));
+    assertTensorsEqual(a + 2.0f, lazy(a) + 2.0f);
+    assertTensorsEqual(2.0f - a, 2.0f - lazy(a));
+    assertTensorsEqual(a * 3.0f, 3.0f * lazy(a));
+    assertTensorsEqual(1.0f / c, 1.0f / lazy(c));
+    assertTensorsEqual(c / 4.0f, lazy(c) / 4.0f);
+    assertTensorsEqual(-a, -lazy(a));
+    assertTensorsEqual(c.applyFunction(logf), lazy(c).applyFunction(logf));
+    assertTensorsEqual(a * (b + 1.0f) - (2.0f - c) / c.applyFunction(sqrtf),
+        lazy(a) * (lazy(b) + 1.0f) - (2.0f - lazy(c)) / lazy(c).applyFunction(sqrtf));
+    assertTensorsEqual(c.log(), lazy(c).log());
+    assertTensorsEqual(a.exp() * b.tanh() + (a - b).sigmoid(), lazy(a).exp() * lazy(b).tanh() + (lazy(a) - lazy(b)).sigmoid());
+}
+
+TEST(TensorExpression_test, WhenReducedShouldMatchTensorReductions) {
+    const Tensor a = Tensor::RandomNormal({ 1000 });
+    const Tensor b = Tensor::RandomNormal({ 1000 });
+
+    ASSERT_LE(fabs((a * b).sum() - (lazy(a) * lazy(b)).sum()), EPSILON * std::max(1.0f, std::fabs((a * b).sum())));
+    ASSERT_EQ_EPS((a - b).mean(), (lazy(a) - lazy(b)).mean());
+}
+
+TEST(TensorExpression_test, WhenAssignedToOperandShouldComputeInPlace) {
+    Tensor a({ 2, 300 });
+    a.setValues(std::vector<float>(600, 3.0f));
+    const Tensor b = Tensor::RandomNormal({ 2, 300 });
+    const Tensor expected = a * a + b;
+
+    a = lazy(a) * lazy(a) + lazy(b);
+
+    assertTensorsEqual(expected, a);
+}
+
+TEST(TensorExpression_test, WhenAssignedToTensorOfDifferentShapeShouldTakeExpressionShape) {
+    Tensor a({ 4 });
+    const Tensor b = Tensor::RandomNormal({ 2, 3 });
+
+    a = lazy(b) * 2.0f;
+
+    assertTensorsEqual(b * 2.0f, a);
+}
+
+TEST(TensorExpression_test, WhenShapesDifferShouldThrow) {
+    const Tensor a({ 2, 3 });
+    const Tensor b({ 3, 2 });
+
+    ASSERT_THROW(lazy(a) + lazy(b), std::invalid_argument);
+}
+
+TEST(TensorExpression_test, WhenAboveParallelThresholdResultsShouldMatchSerialResults) {
+    const uint32_t threshold{ Tensor::getParallelThreshold() };
+    const Tensor a = Tensor::RandomNormal({ 300, 257 });
+    const Tensor b = Tensor::RandomNormal({ 300, 257 });
+
+    Tensor::setParallelThreshold(0);
+    const Tensor expected = lazy(a) * (lazy(b) + 1.0f) - 2.0f;
+    const float expected_sum{ (lazy(a) * lazy(a)).sum() };
+    Tensor::setParallelThreshold(1);
+    const Tensor actual = lazy(a) * (lazy(b) + 1.0f) - 2.0f;
+    const float actual_sum{ (lazy(a) * lazy(a)).sum() };
+    Tensor::setParallelThreshold(threshold);
+
+    assertTensorsEqual(expected, actual);
+    ASSERT_LE(fabs(expected_sum - actual_sum), EPSILON * expected_sum);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "src/TensorKernels.h"
+#include "src/Utils.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+static std::vector<float> randomVector(uint32_t n) {
+    std::vector<float> result(n);
+    for (auto& value : result) {
+        value = randUniform(0.5f, 1.5f);
+    }
+    return result;
+}
+
+static std::vector<const TensorKernels*> supportedKernels() {
+    std::vector<const TensorKernels*> result;
+    for (auto type : { KernelsType::Sse, KernelsType::Avx2, KernelsType::Avx512 }) {
+        if (nullptr != getKernels(type)) {
+            result.push_back(getKernels(type));
+        }
+    }
+    return result;
+}
+
+TEST(TensorKernels_test, ScalarKernelsShouldBeAlwaysAvailable) {
+    const KernelsType active_type{ getKernels().type };
+
+    ASSERT_NE(nullptr, getKernels(KernelsType::Scalar));
+    ASSERT_TRUE(setKernels(KernelsType::Scalar));
+    ASSERT_EQ(KernelsType::Scalar, getKernels().type);
+    ASSERT_TRUE(setKernels(active_type));
+}
+
+TEST(TensorKernels_test, ElementWiseKernelsShouldMatchScalarKernels) {
+    const TensorKernels* reference = getKernels(KernelsType::Scalar);
+
+    for (auto kernels : supportedKernels()) {
+        for (uint32_t n : { 1u, 7u, 16u, 33u, 130u }) {
+            for (uint32_t rows : { 1u, 3u }) {
+                const uint32_t size{ n * rows };
+                std::vector<float> v1 = randomVector(size);
+                std::vector<float> v2 = randomVector(size);
+                std::vector<float> expected(size);
+                std::vector<float> actual(size);
+                const float s{ 0.75f };
+
+                auto check = [&](const char* op) {
+                    for (uint32_t i{ 0 }; i < size; ++i) {
+                        ASSERT_LE(fabs(expected[i] - actual[i]), EPSILON) << kernels->name << " " << op << " n=" << n << " i=" << i;
+                    }
+                };
+
+                reference->vector_add(size, v1.data(), v2.data(), expected.data());
+                kernels->vector_add(size, v1.data(), v2.data(), actual.data());
+                check("vector_add");
+                reference->tensor_sub(size, v1.data(), n, v2.data(), expected.data());
+                kernels->tensor_sub(size, v1.data(), n, v2.data(), actual.data());
+                check("tensor_sub");
+                reference->tensor_mul(size, v1.data(), n, v2.data(), expected.data());
+                kernels->tensor_mul(size, v1.data(), n, v2.data(), actual.data());
+                check("tensor_mul");
+                reference->vector_div(size, v1.data(), v2.data(), expected.data());
+                kernels->vector_div(size, v1.data(), v2.data(), actual.data());
+                check("vector_div");
+                reference->tensor_add_scalar(size, v1.data(), &s, expected.data());
+                kernels->tensor_add_scalar(size, v1.data(), &s, actual.data());
+                check("tensor_add_scalar");
+                reference->tensor_mul_scalar(size, v1.data(), &s, expected.data());
+                kernels->tensor_mul_scalar(size, v1.data(), &s, actual.data());
+                check("tensor_mul_scalar");
+                reference->scalar_sub_tensor(&s, size, v1.data(), expected.data());
+                kernels->scalar_sub_tensor(&s, size, v1.data(), actual.data());
+                check("scalar_sub_tensor");
+                reference->scalar_div_tensor(&s, size, v1.data(), expected.data());
+                kernels->scalar_div_tensor(&s, size, v1.data(), actual.data());
+                check("scalar_div_tensor");
+            }
+        }
+    }
+}
+
+TEST(TensorKernels_test, ReductionKernelsShouldMatchScalarKernels) {
+    const TensorKernels* reference = getKernels(KernelsType::Scalar);
+
+    for (auto kernels : supportedKernels()) {
+        for (uint32_t n : { 1u, 3u, 5u }) {
+            for (uint32_t m : { 1u, 9u, 40u }) {
+                for (uint32_t k : { 1u, 17u, 70u }) {
+                    std::vector<float> v = randomVector(n * m * k);
+                    std::vector<float> v2 = randomVector(m * k);
+                    std::vector<float> expected(n * m);
+                    std::vector<float> actual(n * m);
+                    float expected_value;
+                    float actual_value;
+
+                    reference->tensor_sum(n * m * k, v.data(), &expected_value);
+                    kernels->tensor_sum(n * m * k, v.data(), &actual_value);
+                    ASSERT_LE(fabs(expected_value - actual_value), EPSILON * expected_value) << kernels->name;
+
+                    reference->vector_inner_product(m * k, v.data(), v2.data(), &expected_value);
+                    kernels->vector_inner_product(m * k, v.data(), v2.data(), &actual_value);
+                    ASSERT_LE(fabs(expected_value - actual_value), EPSILON * expected_value) << kernels->name;
+
+                    reference->tensor_axis_sum(n, m, k, v.data(), expected.data());
+                    kernels->tensor_axis_sum(n, m, k, v.data(), actual.data());
+                    for (uint32_t i{ 0 }; i < n * m; ++i) {
+                        ASSERT_LE(fabs(expected[i] - actual[i]), EPSILON * expected[i]) << kernels->name << " tensor_axis_sum";
+                    }
+
+                    reference->tensor_last_axis_sum(n * m, k, v.data(), expected.data());
+                    kernels->tensor_last_axis_sum(n * m, k, v.data(), actual.data());
+                    for (uint32_t i{ 0 }; i < n * m; ++i) {
+                        ASSERT_LE(fabs(expected[i] - actual[i]), EPSILON * expected[i]) << kernels->name << " tensor_last_axis_sum";
+                    }
+
+                    // [n*m, k] * [m, k]^T = [n*m, m]
+                    std::vector<float> expected_product(n * m * m);
+                    std::vector<float> actual_product(n * m * m);
+                    reference->tensor_dot_product_transpose(n * m, m, k, v.data(), v2.data(), expected_product.data());
+                    kernels->tensor_dot_product_transpose(n * m, m, k, v.data(), v2.data(), actual_product.data());
+                    for (uint32_t i{ 0 }; i < n * m * m; ++i) {
+                        ASSERT_LE(fabs(expected_product[i] - actual_product[i]), EPSILON * expected_product[i]) << kernels->name << " tensor_dot_product_transpose";
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(TensorKernels_test, MathKernelsShouldMatchStandardFunctions) {
+    std::vector<const TensorKernels*> all_kernels = supportedKernels();
+    all_kernels.push_back(getKernels(KernelsType::Scalar));
+
+    // values in [-40, 40] and their exponents for log, odd size so every kernel has a tail
+    const uint32_t size{ 1001 };
+    std::vector<float> x(size);
+    std::vector<float> positive(size);
+    for (uint32_t i{ 0 }; i < size; ++i) {
+        x[i] = -40.0f + 80.0f * i / (size - 1);
+        positive[i] = expf(x[i] * 2.0f);
+    }
+    std::vector<float> actual(size);
+
+    // relative error of a few ulps, the kernels are accurate to 2 ulps (see FastMath.h)
+    const float tolerance{ 8.0f * std::numeric_limits<float>::epsilon() };
+    auto check = [&](const char* name, const TensorKernels* kernels, const std::vector<float>& v, double (*expected_fun)(double)) {
+        for (uint32_t i{ 0 }; i < size; ++i) {
+            const double expected{ expected_fun(v[i]) };
+            ASSERT_LE(fabs(expected - actual[i]), tolerance * fabs(expected)) << kernels->name << " " << name << " x=" << v[i];
+        }
+    };
+
+    for (auto kernels : all_kernels) {
+        kernels->vector_exp(size, x.data(), actual.data());
+        check("exp", kernels, x, [](double value) { return std::exp(value); });
+        kernels->vector_log(size, positive.data(), actual.data());
+        check("log", kernels, positive, [](double value) { return std::log(value); });
+        kernels->vector_tanh(size, x.data(), actual.data());
+        check("tanh", kernels, x, [](double value) { return std::tanh(value); });
+        kernels->vector_sigmoid(size, x.data(), actual.data());
+        check("sigmoid", kernels, x, [](double value) { return 1.0 / (1.0 + std::exp(-value)); });
+
+        // in place
+        actual = x;
+        kernels->vector_exp(size, actual.data(), actual.data());
+        check("in place exp", kernels, x, [](double value) { return std::exp(value); });
+    }
+}
+
+TEST(TensorKernels_test, MathKernelsShouldHandleSpecialValues) {
+    std::vector<const TensorKernels*> all_kernels = supportedKernels();
+    all_kernels.push_back(getKernels(KernelsType::Scalar));
+
+    const float inf{ std::numeric_limits<float>::infinity() };
+    const float nan{ std::numeric_limits<float>::quiet_NaN() };
+    const std::vector<float> x{ inf, -inf, 0.0f, -1.0f, 100.0f, -110.0f, nan };
+    std::vector<float> actual(x.size());
+
+    for (auto kernels : all_kernels) {
+        kernels->vector_exp(x.size(), x.data(), actual.data());
+        ASSERT_EQ(inf, actual[0]) << kernels->name;
+        ASSERT_EQ(0.0f, actual[1]) << kernels->name;
+        ASSERT_EQ(1.0f, actual[2]) << kernels->name;
+        ASSERT_EQ(inf, actual[4]) << kernels->name;
+        ASSERT_EQ(0.0f, actual[5]) << kernels->name;
+        ASSERT_TRUE(std::isnan(actual[6])) << kernels->name;
+
+        kernels->vector_log(x.size(), x.data(), actual.data());
+        ASSERT_EQ(inf, actual[0]) << kernels->name;
+        ASSERT_TRUE(std::isnan(actual[1])) << kernels->name;
+        ASSERT_EQ(-inf, actual[2]) << kernels->name;
+        ASSERT_TRUE(std::isnan(actual[3])) << kernels->name;
+        ASSERT_TRUE(std::isnan(actual[6])) << kernels->name;
+
+        kernels->vector_tanh(x.size(), x.data(), actual.data());
+        ASSERT_EQ(1.0f, actual[0]) << kernels->name;
+        ASSERT_EQ(-1.0f, actual[1]) << kernels->name;
+        ASSERT_EQ(0.0f, actual[2]) << kernels->name;
+        ASSERT_TRUE(std::isnan(actual[6])) << kernels->name;
+
+        kernels->vector_sigmoid(x.size(), x.data(), actual.data());
+        ASSERT_EQ(1.0f, actual[0]) << kernels->name;
+        ASSERT_EQ(0.0f, actual[1]) << kernels->name;
+        ASSERT_EQ(0.5f, actual[2]) << kernels->name;
+        ASSERT_EQ(1.0f, actual[4]) << kernels->name;
+        ASSERT_EQ(0.0f, actual[5]) << kernels->name;
+        ASSERT_TRUE(std::isnan(actual[6])) << kernels->name;
+    }
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
 #include "src/Tensor.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
 
 TEST(Tensor_test, WhenGetValueShouldReturnProperItem) {
     Tensor tensor = Tensor({ 3, 3 });
@@ -683,6 +686,76 @@ TEST(Tensor_test, ApplyFunctionShouldApplyGivenFunctionToTensor) {
     ASSERT_EQ(8.0f, (result[{ 1, 1 }]));
 }
 
+TEST(Tensor_test, MathFunctionsShouldMatchStandardFunctions) {
+    Tensor tensor = Tensor({ 3, 7 });
+    for (uint32_t i{ 0 }; i < 21; ++i) {
+        tensor[{ i / 7, i % 7 }] = 0.5f * i - 5.0f;
+    }
+    const Tensor positive = tensor * tensor + 0.25f;
+
+    const Tensor exp_result = tensor.exp();
+    const Tensor log_result = positive.log();
+    const Tensor tanh_result = tensor.tanh();
+    const Tensor sigmoid_result = tensor.sigmoid();
+
+    ASSERT_EQ(tensor.getShape(), exp_result.getShape());
+    for (uint32_t i{ 0 }; i < 21; ++i) {
+        const float x{ 0.5f * i - 5.0f };
+        ASSERT_EQ_EPS(expf(x), (exp_result[{ i / 7, i % 7 }]));
+        ASSERT_EQ_EPS(logf(x * x + 0.25f), (log_result[{ i / 7, i % 7 }]));
+        ASSERT_EQ_EPS(tanhf(x), (tanh_result[{ i / 7, i % 7 }]));
+        ASSERT_EQ_EPS(1.0f / (1.0f + expf(-x)), (sigmoid_result[{ i / 7, i % 7 }]));
+    }
+}
+
+TEST(Tensor_test, MapAndZipShouldApplyGivenCallableToEveryElement) {
+    Tensor a = Tensor({ 3, 7 });
+    Tensor b = Tensor({ 3, 7 });
+    Tensor c = Tensor({ 21 });
+    for (uint32_t i{ 0 }; i < 21; ++i) {
+        a[{ i / 7, i % 7 }] = 0.5f * i - 5.0f;
+        b[{ i / 7, i % 7 }] = 0.25f * i;
+        c[{ i }] = 2.0f;
+    }
+    const float slope{ 0.1f };
+
+    const Tensor mapped = a.map([slope](float x) { return x > 0.0f ? x : slope * x; });
+    const Tensor zipped = a.zip(b, [](float x, float y) { return x * y; });
+    const Tensor zipped3 = a.zip(b, c, [](float x, float y, float z) { return x + y * z; });
+
+    ASSERT_EQ(a.getShape(), mapped.getShape());
+    ASSERT_EQ(a.getShape(), zipped.getShape());
+    ASSERT_EQ(a.getShape(), zipped3.getShape());
+    for (uint32_t i{ 0 }; i < 21; ++i) {
+        const float x{ 0.5f * i - 5.0f };
+        const float y{ 0.25f * i };
+        ASSERT_EQ(x > 0.0f ? x : slope * x, (mapped[{ i / 7, i % 7 }]));
+        ASSERT_EQ(x * y, (zipped[{ i / 7, i % 7 }]));
+        ASSERT_EQ(x + y * 2.0f, (zipped3[{ i / 7, i % 7 }]));
+    }
+
+    a.mapInPlace([](float x) { return x + 1.0f; });
+    b.zipInPlace(c, [](float y, float z) { return y - z; });
+    c.zipInPlace(a, b, [](float z, float x, float y) { return z * x + y; });
+    for (uint32_t i{ 0 }; i < 21; ++i) {
+        const float x{ 0.5f * i - 4.0f };
+        const float y{ 0.25f * i - 2.0f };
+        ASSERT_EQ(x, a.getData()[i]);
+        ASSERT_EQ(y, b.getData()[i]);
+        ASSERT_EQ(2.0f * x + y, c.getData()[i]);
+    }
+}
+
+TEST(Tensor_test, WhenZippedTensorsHaveDifferentSizesShouldThrow) {
+    Tensor a = Tensor({ 3, 7 });
+    const Tensor b = Tensor({ 3, 6 });
+    const auto add = [](float x, float y) { return x + y; };
+
+    ASSERT_THROW(a.zip(b, add), std::invalid_argument);
+    ASSERT_THROW(a.zipInPlace(b, add), std::invalid_argument);
+    ASSERT_THROW(a.zip(a, b, [](float x, float y, float z) { return x + y + z; }), std::invalid_argument);
+}
+
 TEST(Tensor_test, TensorSumTest) {
     Tensor tensor = Tensor({ 2, 3, 2 });
 
@@ -701,6 +774,17 @@ TEST(Tensor_test, TensorSumTest) {
     ASSERT_EQ(78.0f, result);
 }
 
+TEST(Tensor_test, WhenTensorIsEmptyReductionsShouldNotFail) {
+    const Tensor tensor = Tensor({ 0 });
+    const Tensor matrix = Tensor({ 0, 3 });
+
+    ASSERT_EQ(0.0f, tensor.sum());
+    ASSERT_EQ(-std::numeric_limits<float>::infinity(), tensor.max());
+    ASSERT_EQ(std::numeric_limits<float>::infinity(), tensor.min());
+    ASSERT_EQ(std::vector<float>({ 0.0f, 0.0f, 0.0f }), matrix.sum(0).getData());
+    ASSERT_LT(0u, ThreadPool::getParallelChunkSize(0));
+}
+
 TEST(Tensor_test, SumAcrossFirstAxisOf2DTensor) {
     Tensor tensor = Tensor({ 4, 2 });
 
@@ -874,4 +958,251 @@ TEST(Tensor_test, TensorShuffleWithPatternShouldRearrangeValues) {
     ASSERT_EQ(7.0f, (result[{ 1, 0 }]));
     ASSERT_EQ(1.0f, (result[{ 2, 0 }]));
     ASSERT_EQ(3.0f, (result[{ 3, 0 }]));
-}
\ No newline at end of file
+}
+TEST(Tensor_test, ViewOfSubTensorShouldReferenceProperValuesWithoutCopy) {
+    Tensor tensor = Tensor({ 2, 3, 4 });
+
+    tensor.setValues({
+         1.0f,  2.0f,  3.0f,  4.0f,
+         5.0f,  6.0f,  7.0f,  8.0f,
+         9.0f, 10.0f, 11.0f, 12.0f,
+
+        13.0f, 14.0f, 15.0f, 16.0f,
+        17.0f, 18.0f, 19.0f, 20.0f,
+        21.0f, 22.0f, 23.0f, 24.0f
+    });
+
+    const TensorView view = tensor.view({ { 1 }, {}, { 1, 3 } });
+
+    ASSERT_EQ(2u, view.getDim());
+    ASSERT_EQ(3u, view.getShape()[0]);
+    ASSERT_EQ(2u, view.getShape()[1]);
+    ASSERT_FALSE(view.isContiguous());
+
+    ASSERT_EQ(14.0f, (view[{ 0, 0 }]));
+    ASSERT_EQ(15.0f, (view[{ 0, 1 }]));
+    ASSERT_EQ(23.0f, (view[{ 2, 1 }]));
+
+    tensor[{ 1, 2, 2 }] = -1.0f;
+
+    ASSERT_EQ(-1.0f, (view[{ 2, 1 }]));
+
+    const Tensor sub_tensor = view;
+
+    ASSERT_EQ(2u, sub_tensor.getDim());
+    ASSERT_EQ(14.0f, (sub_tensor[{ 0, 0 }]));
+    ASSERT_EQ(18.0f, (sub_tensor[{ 1, 0 }]));
+    ASSERT_EQ(19.0f, (sub_tensor[{ 1, 1 }]));
+    ASSERT_EQ(-1.0f, (sub_tensor[{ 2, 1 }]));
+}
+
+TEST(Tensor_test, WhenViewTransposedShouldSwapAxes) {
+    Tensor tensor = Tensor({ 2, 3 });
+
+    tensor.setValues({
+        1.0f, 2.0f, 3.0f,
+        4.0f, 5.0f, 6.0f
+    });
+
+    const TensorView view = tensor.view().transpose();
+
+    ASSERT_EQ(3u, view.getShape()[0]);
+    ASSERT_EQ(2u, view.getShape()[1]);
+    ASSERT_EQ(1u, view.getStrides()[0]);
+    ASSERT_EQ(3u, view.getStrides()[1]);
+
+    const Tensor result = view;
+
+    ASSERT_EQ(1.0f, (result[{ 0, 0 }]));
+    ASSERT_EQ(4.0f, (result[{ 0, 1 }]));
+    ASSERT_EQ(2.0f, (result[{ 1, 0 }]));
+    ASSERT_EQ(5.0f, (result[{ 1, 1 }]));
+    ASSERT_EQ(3.0f, (result[{ 2, 0 }]));
+    ASSERT_EQ(6.0f, (result[{ 2, 1 }]));
+}
+
+TEST(Tensor_test, WhenViewReshapedOrFlattenedShouldKeepValues) {
+    Tensor tensor = Tensor({ 2, 3, 2 });
+
+    tensor.setValues({
+         1.0f,  2.0f,
+         3.0f,  4.0f,
+         5.0f,  6.0f,
+
+         7.0f,  8.0f,
+         9.0f, 10.0f,
+        11.0f, 12.0f
+    });
+
+    const TensorView reshaped = tensor.view().reshape({ 3, 4 });
+
+    ASSERT_EQ(5.0f, (reshaped[{ 1, 0 }]));
+    ASSERT_EQ(12.0f, (reshaped[{ 2, 3 }]));
+
+    const TensorView flattened = tensor.view({ {}, { 1, 3 } }).flatten(1);
+
+    ASSERT_EQ(2u, flattened.getDim());
+    ASSERT_EQ(4u, flattened.getShape()[1]);
+    ASSERT_EQ(3.0f, (flattened[{ 0, 0 }]));
+    ASSERT_EQ(6.0f, (flattened[{ 0, 3 }]));
+    ASSERT_EQ(12.0f, (flattened[{ 1, 3 }]));
+
+    ASSERT_THROW(tensor.view({ {}, { 1, 3 } }).reshape({ 8 }), std::invalid_argument);
+    ASSERT_THROW(tensor.view({ {}, { 0, 2 }, {} }).flatten(), std::invalid_argument);
+}
+
+TEST(Tensor_test, WhenViewsAreMatricesDotProductShouldReturnMatricesProduct) {
+    Tensor tensor_a = Tensor({ 2, 3 });
+    Tensor tensor_b = Tensor({ 2, 3 });
+
+    tensor_a.setValues({
+        1.0f, .5f,   2.0f,
+        .25f, .125f, 1.0f
+        });
+
+    tensor_b.setValues({
+        16.0f, 8.0f, 4.0f,
+        4.0f,  2.0f, 2.0f
+        });
+
+    const Tensor result = tensor_a.view().dotProduct(tensor_b.view().transpose());
+    const Tensor result_transpose = tensor_a.view().transpose().dotProduct(tensor_b.view());
+
+    ASSERT_EQ(2, (int)result.getDim());
+    ASSERT_EQ(28.0f, (result[{ 0, 0 }]));
+    ASSERT_EQ( 9.0f, (result[{ 0, 1 }]));
+    ASSERT_EQ( 9.0f, (result[{ 1, 0 }]));
+    ASSERT_EQ(3.25f, (result[{ 1, 1 }]));
+
+    ASSERT_EQ(3u, result_transpose.getShape()[0]);
+    ASSERT_EQ(3u, result_transpose.getShape()[1]);
+    ASSERT_EQ(17.0f, (result_transpose[{ 0, 0 }]));
+    ASSERT_EQ(4.25f, (result_transpose[{ 1, 1 }]));
+    ASSERT_EQ(10.0f, (result_transpose[{ 2, 2 }]));
+}
+
+TEST(Tensor_test, WhenViewAssignedToSliceValuesShouldBeCopied) {
+    Tensor tensor = Tensor({ 2, 3 });
+    Tensor source = Tensor({ 3, 2 });
+
+    source.setValues({
+        1.0f, 2.0f,
+        3.0f, 4.0f,
+        5.0f, 6.0f
+    });
+
+    tensor[{ {}, { 0, 3 } }] = source.view().transpose();
+
+    ASSERT_EQ(1.0f, (const_cast<const Tensor&>(tensor)[{ 0, 0 }]));
+    ASSERT_EQ(3.0f, (const_cast<const Tensor&>(tensor)[{ 0, 1 }]));
+    ASSERT_EQ(5.0f, (const_cast<const Tensor&>(tensor)[{ 0, 2 }]));
+    ASSERT_EQ(2.0f, (const_cast<const Tensor&>(tensor)[{ 1, 0 }]));
+    ASSERT_EQ(4.0f, (const_cast<const Tensor&>(tensor)[{ 1, 1 }]));
+    ASSERT_EQ(6.0f, (const_cast<const Tensor&>(tensor)[{ 1, 2 }]));
+
+    tensor[{ {{ 1 }}, {{ 0, 3 }} }] = source.view({ {}, { 0 } });
+
+    ASSERT_EQ(1.0f, (const_cast<const Tensor&>(tensor)[{ 1, 0 }]));
+    ASSERT_EQ(3.0f, (const_cast<const Tensor&>(tensor)[{ 1, 1 }]));
+    ASSERT_EQ(5.0f, (const_cast<const Tensor&>(tensor)[{ 1, 2 }]));
+}
+
+TEST(Tensor_test, WhenAboveParallelThresholdResultsShouldMatchSerialResults) {
+    const uint32_t threshold{ Tensor::getParallelThreshold() };
+    const Tensor a = Tensor::RandomNormal({ 300, 257 });
+    const Tensor b = Tensor::RandomNormal({ 300, 257 });
+    const Tensor row = Tensor::RandomNormal({ 257 });
+    const Tensor c = Tensor::RandomNormal({ 4, 150, 257 });
+
+    auto compute = [&]() {
+        std::vector<Tensor> results;
+        results.push_back(a + b);
+        results.push_back(a + row);
+        results.push_back(a - b);
+        results.push_back(a * 0.5f);
+        results.push_back(2.0f / (a + 10.0f));
+        results.push_back(a > b);
+        results.push_back(a <= 0.0f);
+        results.push_back(a.applyFunction([](float x) { return x * x; }));
+        results.push_back(a.tanh());
+        results.push_back(a.zip(b, a, [](float x, float y, float z) { return x * y + z; }));
+        results.push_back(a.sum(0));
+        results.push_back(a.sum(1));
+        results.push_back(c.sum(0));
+        results.push_back(c.sum(1));
+        Tensor reductions({ 3 });
+        reductions.setValues({ a.sum(), a.max(), a.min() });
+        results.push_back(reductions);
+        return results;
+    };
+
+    Tensor::setParallelThreshold(0);
+    std::vector<Tensor> expected = compute();
+    Tensor::setParallelThreshold(1);
+    std::vector<Tensor> actual = compute();
+    Tensor::setParallelThreshold(threshold);
+
+    for (uint32_t i{ 0 }; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].getShape(), actual[i].getShape());
+        std::vector<float> expected_data = expected[i].getData();
+        std::vector<float> actual_data = actual[i].getData();
+        for (uint32_t j{ 0 }; j < expected_data.size(); ++j) {
+            ASSERT_LE(fabs(expected_data[j] - actual_data[j]), 0.001f * std::max(1.0f, std::fabs(expected_data[j]))) << "result " << i << " index " << j;
+        }
+    }
+}
+
+TEST(Tensor_test, SliceShouldCopyValuesOfSelectedRanges) {
+    const Tensor tensor = Tensor::RandomNormal({ 3, 4, 5, 6 });
+
+    // single index, partial range and whole axes, so inner axes are merged into runs
+    const Tensor slice = tensor[{ { 1, 3 }, { 2 }, {}, { 1, 5 } }];
+
+    ASSERT_EQ(std::vector<uint32_t>({ 2, 5, 4 }), slice.getShape());
+    for (uint32_t i{ 0 }; i < 2; ++i) {
+        for (uint32_t j{ 0 }; j < 5; ++j) {
+            for (uint32_t k{ 0 }; k < 4; ++k) {
+                ASSERT_EQ((tensor[{ i + 1, 2, j, k + 1 }]), (slice[{ i, j, k }]));
+            }
+        }
+    }
+
+    const Tensor contiguous = tensor[{ { 1 }, { 1, 3 } }];
+    ASSERT_EQ(std::vector<uint32_t>({ 2, 5, 6 }), contiguous.getShape());
+    ASSERT_EQ((tensor[{ 1, 2, 4, 5 }]), (contiguous[{ 1, 4, 5 }]));
+}
+
+TEST(Tensor_test, WhenTensorAssignedToSliceValuesShouldBeCopied) {
+    Tensor tensor({ 3, 4, 5 });
+    const Tensor values = Tensor::RandomNormal({ 2, 3 });
+
+    tensor[{ { 1, 3 }, { 2 }, { 1, 4 } }] = values;
+
+    const Tensor& const_tensor = tensor;
+    for (uint32_t i{ 0 }; i < 3; ++i) {
+        for (uint32_t j{ 0 }; j < 4; ++j) {
+            for (uint32_t k{ 0 }; k < 5; ++k) {
+                const bool in_slice = (i >= 1) && (2 == j) && (k >= 1) && (k < 4);
+                ASSERT_EQ((in_slice ? values[{ i - 1, k - 1 }] : 0.0f), (const_tensor[{ i, j, k }]));
+            }
+        }
+    }
+
+    ASSERT_THROW((tensor[{ { 0, 2 }, { 2 }, { 1, 3 } }] = values), std::invalid_argument);
+}
+
+TEST(Tensor_test, WhenTensorWithDifferentShapeAssignedToSliceShouldThrow) {
+    Tensor tensor({ 3, 4, 5 });
+    const Tensor transposed = Tensor::RandomNormal({ 3, 2 });
+    const Tensor row = Tensor::RandomNormal({ 1, 3 });
+
+    ASSERT_THROW((tensor[{ { 1, 3 }, { 2 }, { 1, 4 } }] = transposed), std::invalid_argument);
+
+    // axes of size 1 are ignored
+    tensor[{ { 1 }, { 2 }, { 1, 4 } }] = row;
+
+    const Tensor& const_tensor = tensor;
+    for (uint32_t k{ 0 }; k < 3; ++k) {
+        ASSERT_EQ((row[{ 0, k }]), (const_tensor[{ 1, 2, k + 1 }]));
+    }
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include "src/FFT.h"
+#include "src/Utils.h"
+#include "tests/unit_tests/UnitTestsUtils.h"
+
+TEST(FFT_test, ForwardShouldMatchDiscreteFourierTransform) {
+    for (uint32_t size : { 1u, 2u, 8u, 32u }) {
+        std::vector<float> re(size), im(size);
+        for (uint32_t n{ 0 }; n < size; ++n) {
+            re[n] = randNormalDistribution();
+            im[n] = randNormalDistribution();
+        }
+        std::vector<float> result_re = re, result_im = im;
+
+        FFT(size).forward(result_re.data(), result_im.data());
+
+        for (uint32_t k{ 0 }; k < size; ++k) {
+            double expected_re{ 0.0 }, expected_im{ 0.0 };
+            for (uint32_t n{ 0 }; n < size; ++n) {
+                const double angle{ -2.0 * std::numbers::pi * k * n / size };
+                expected_re += re[n] * cos(angle) - im[n] * sin(angle);
+                expected_im += re[n] * sin(angle) + im[n] * cos(angle);
+            }
+            ASSERT_LE(fabs(expected_re - result_re[k]), 1e-4) << "size=" << size << " k=" << k;
+            ASSERT_LE(fabs(expected_im - result_im[k]), 1e-4) << "size=" << size << " k=" << k;
+        }
+    }
+}
+
+TEST(FFT_test, InverseShouldRestoreValuesMultipliedBySize) {
+    const uint32_t size{ 64 };
+    std::vector<float> re(size), im(size);
+    for (uint32_t n{ 0 }; n < size; ++n) {
+        re[n] = randNormalDistribution();
+        im[n] = randNormalDistribution();
+    }
+    std::vector<float> result_re = re, result_im = im;
+    const FFT fft(size);
+
+    fft.forward(result_re.data(), result_im.data());
+    fft.inverse(result_re.data(), result_im.data());
+
+    for (uint32_t n{ 0 }; n < size; ++n) {
+        ASSERT_LE(fabs(re[n] - result_re[n] / size), EPSILON);
+        ASSERT_LE(fabs(im[n] - result_im[n] / size), EPSILON);
+    }
+}
+
+TEST(FFT_test, SizeShouldBePowerOfTwo) {
+    ASSERT_THROW(FFT(12), std::invalid_argument);
+    ASSERT_EQ(16u, FFT::transformSize(9));
+    ASSERT_EQ(16u, FFT::transformSize(16));
+}
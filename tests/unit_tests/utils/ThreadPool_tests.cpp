@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include "src/ThreadPool.h"
+
+TEST(ThreadPool_test, ParallelForShouldRunEachTaskOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<uint32_t>> calls(1000);
+
+    ASSERT_EQ(4, pool.getThreadsCount());
+
+    for (uint32_t run{ 0 }; run < 10; ++run) {
+        pool.parallelFor(calls.size(), [&](uint32_t i) { ++calls[i]; });
+    }
+
+    for (auto& value : calls) {
+        ASSERT_EQ(10, value);
+    }
+}
+
+TEST(ThreadPool_test, NestedParallelForShouldRunSerially) {
+    ThreadPool pool(4);
+    std::atomic<uint32_t> calls{ 0 };
+
+    std::atomic<uint32_t> other_thread_calls{ 0 };
+
+    pool.parallelFor(8, [&](uint32_t) {
+        const std::thread::id task_thread{ std::this_thread::get_id() };
+        pool.parallelFor(8, [&](uint32_t) {
+            ++calls;
+            if (std::this_thread::get_id() != task_thread) {
+                ++other_thread_calls;
+            }
+        });
+    });
+
+    ASSERT_EQ(64, calls);
+    ASSERT_EQ(0, other_thread_calls);
+}
+
+TEST(ThreadPool_test, ConcurrentParallelForCallsShouldRunEachTaskOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<uint32_t>> calls(1000);
+
+    std::vector<std::thread> callers;
+    for (uint32_t caller{ 0 }; caller < 4; ++caller) {
+        callers.emplace_back([&]() {
+            for (uint32_t run{ 0 }; run < 10; ++run) {
+                pool.parallelFor(calls.size(), [&](uint32_t i) { ++calls[i]; });
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    for (auto& value : calls) {
+        ASSERT_EQ(40, value);
+    }
+}
+
+TEST(ThreadPool_test, ParallelForShouldRethrowTaskException) {
+    ThreadPool pool(4);
+    std::atomic<uint32_t> calls{ 0 };
+
+    ASSERT_THROW(pool.parallelFor(100, [&](uint32_t i) {
+        ++calls;
+        if (i == 50) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+    ASSERT_EQ(100, calls);
+
+    // pool is still usable
+    calls = 0;
+    pool.parallelFor(100, [&](uint32_t) { ++calls; });
+    ASSERT_EQ(100, calls);
+}